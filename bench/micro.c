@@ -0,0 +1,180 @@
+/* micro-benchmarks for the C parts of the interpreter, 'make bench' runs these
+
+      $ make misc-compiled/bench-micro && misc-compiled/bench-micro
+
+this prints one line of json for each benchmark, in the same format as bench/utils.ö
+*/
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <src/allobjects.h>
+#include <src/builtins.h>
+#include <src/gc.h>
+#include <src/interpreter.h>
+#include <src/objects/mapping.h>
+#include <src/objects/string.h>
+#include <src/objectsystem.h>
+#include <src/timing.h>
+#include <src/tokenizer.h>
+#include <src/unicode.h>
+#include <src/utf8.h>
+
+#define ITERATIONS 50
+#define WARMUP 5
+
+static struct Interpreter *interp;
+
+// there's no reasonable way to recover from errors here
+static void check(bool ok, char *what)
+{
+	if (!ok) {
+		fprintf(stderr, "bench-micro: %s failed\n", what);
+		exit(1);
+	}
+}
+
+static void run(char *name, void (*func)(void))
+{
+	for (int i=0; i < WARMUP; i++)
+		func();
+
+	uint64_t times[ITERATIONS];
+	uint64_t allocs[ITERATIONS];
+	for (int i=0; i < ITERATIONS; i++) {
+		unsigned long long allocsbefore = interp->objectsallocated;
+		uint64_t start = timing_monotonic_ns();
+		func();
+		times[i] = timing_monotonic_ns() - start;
+		allocs[i] = interp->objectsallocated - allocsbefore;
+	}
+
+	struct TimingSummary t = timing_summarize(times, ITERATIONS);
+	struct TimingSummary a = timing_summarize(allocs, ITERATIONS);
+	printf("{\"name\":\"%s\",\"iterations\":%d,\"min_ns\":%llu,\"mean_ns\":%llu,\"median_ns\":%llu,\"p99_ns\":%llu,\"stddev_ns\":%llu,\"allocs\":%llu}\n",
+		name, ITERATIONS, (unsigned long long)t.min, (unsigned long long)t.mean, (unsigned long long)t.median,
+		(unsigned long long)t.p99, (unsigned long long)t.stddev, (unsigned long long)a.mean);
+	fflush(stdout);
+}
+
+
+#define NKEYS 1000
+static struct Object *keys[NKEYS];
+
+static void mapping_set_get(void)
+{
+	struct Object *map = mappingobject_newempty(interp);
+	check(map != NULL, "mappingobject_newempty()");
+	for (int i=0; i < NKEYS; i++)
+		check(mappingobject_set(interp, map, keys[i], keys[i]), "mappingobject_set()");
+	for (int i=0; i < NKEYS; i++) {
+		struct Object *val;
+		check(mappingobject_get(interp, map, keys[i], &val) == 1, "mappingobject_get()");
+		OBJECT_DECREF(interp, val);
+	}
+	OBJECT_DECREF(interp, map);
+}
+
+
+// allobjects only cares about the pointers, so these don't need to be real objects
+#define NFAKEOBJECTS 10000
+static struct Object fakeobjects[NFAKEOBJECTS];
+
+static void allobjects_add_remove(void)
+{
+	struct AllObjects ao;
+	check(allobjects_init(&ao), "allobjects_init()");
+	for (int i=0; i < NFAKEOBJECTS; i++)
+		check(allobjects_add(&ao, &fakeobjects[i]), "allobjects_add()");
+	for (int i=0; i < NFAKEOBJECTS; i++)
+		check(allobjects_remove(&ao, &fakeobjects[i]), "allobjects_remove()");
+	allobjects_free(ao);
+}
+
+
+static char *source;
+static size_t sourcelen;
+
+static void tokenize(void)
+{
+	struct TokenArray arr;
+	check(token_ize(interp, source, sourcelen, &arr), "token_ize()");
+	tokenarray_free(arr);
+}
+
+
+static char *text;
+static size_t textlen;
+
+static void utf8_roundtrip(void)
+{
+	struct UnicodeString ustr;
+	check(utf8_decode(interp, text, textlen, &ustr), "utf8_decode()");
+
+	char *utf8;
+	size_t utf8len;
+	check(utf8_encode(interp, ustr, &utf8, &utf8len), "utf8_encode()");
+	assert(utf8len == textlen);
+	free(ustr.val);
+	free(utf8);
+}
+
+
+// returns the content of a file, exits on error
+static char *read_file(char *path, size_t *len)
+{
+	FILE *f = fopen(path, "rb");
+	check(f != NULL, path);
+
+	size_t size = 4096;
+	char *buf = malloc(size);
+	check(buf != NULL, "malloc()");
+	*len = 0;
+	size_t n;
+	while ((n = fread(buf + *len, 1, size - *len, f)) > 0) {
+		*len += n;
+		if (*len == size) {
+			size *= 2;
+			check((buf = realloc(buf, size)) != NULL, "realloc()");
+		}
+	}
+	check(!ferror(f), path);
+	fclose(f);
+	return buf;
+}
+
+int main(void)
+{
+	check((interp = interpreter_new("bench-micro")) != NULL, "interpreter_new()");
+	check(builtins_setup(interp), "builtins_setup()");
+
+	for (int i=0; i < NKEYS; i++)
+		check((keys[i] = stringobject_newfromfmt(interp, "key %L", (long long)i)) != NULL, "stringobject_newfromfmt()");
+	run("c_mapping_set_get", mapping_set_get);
+	for (int i=0; i < NKEYS; i++)
+		OBJECT_DECREF(interp, keys[i]);
+
+	run("c_allobjects_add_remove", allobjects_add_remove);
+
+	// this must be run in the project root, like 'make bench' does
+	source = read_file("std/io.ö", &sourcelen);
+	run("c_tokenizer", tokenize);
+	free(source);
+
+	char sample[] = "Hellö Wörld! 我能吞下玻璃而不伤身体。 print \"hello\";\n";
+	textlen = (sizeof(sample) - 1) * 10000;
+	check((text = malloc(textlen)) != NULL, "malloc()");
+	for (size_t i=0; i < 10000; i++)
+		memcpy(text + i*(sizeof(sample) - 1), sample, sizeof(sample) - 1);
+	run("c_utf8_roundtrip", utf8_roundtrip);
+	free(text);
+
+	builtins_teardown(interp);
+	gc_run(interp);
+	interpreter_free(interp);
+	return 0;
+}
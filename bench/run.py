@@ -0,0 +1,107 @@
+#!/usr/bin/env python3
+"""Run the benchmarks and compare the results with a baseline.
+
+'make bench' runs this. Each benchmark prints one line of JSON, see
+bench/utils.ö and bench/micro.c. The results are written to a JSON file that
+looks like {"benchmarks": {"fib": {"median_ns": 123, ...}, ...}}, and
+another file like that can be used as a baseline.
+"""
+
+import argparse
+import glob
+import json
+import os
+import shutil
+import subprocess
+import sys
+
+MICRO = os.path.join('misc-compiled', 'bench-micro')
+TEMP_DIR = 'bench-temp'
+
+
+def run_command(command):
+    print("running", ' '.join(command), file=sys.stderr)
+    output = subprocess.run(command, stdout=subprocess.PIPE, check=True).stdout
+    return [json.loads(line) for line in output.decode('utf-8').splitlines()
+            if line.startswith('{')]
+
+
+def run_all(filter_):
+    # the ö benchmarks create files here
+    shutil.rmtree(TEMP_DIR, ignore_errors=True)
+    os.mkdir(TEMP_DIR)
+
+    commands = [[MICRO]]
+    for path in sorted(glob.glob(os.path.join('bench', '*.ö'))):
+        if os.path.basename(path) != 'utils.ö':
+            commands.append([os.path.join('.', 'ö'), path])
+
+    results = {}
+    try:
+        for command in commands:
+            if filter_ and not any(filter_ in part for part in command):
+                continue
+            for result in run_command(command):
+                results[result.pop('name')] = result
+    finally:
+        shutil.rmtree(TEMP_DIR, ignore_errors=True)
+    return results
+
+
+def compare(results, baseline, threshold):
+    """Print a table and return names of benchmarks that got slower."""
+    regressions = []
+    print("%-28s %14s %14s %9s" % ("benchmark", "baseline ns", "median ns", "change"))
+    for name, result in results.items():
+        if name not in baseline:
+            print("%-28s %14s %14d %9s" % (name, "-", result['median_ns'], "new"))
+            continue
+
+        old = baseline[name]['median_ns']
+        new = result['median_ns']
+        change = (new - old) / old * 100 if old else 0
+        marker = ''
+        if change > threshold:
+            regressions.append(name)
+            marker = '  <-- slower'
+        print("%-28s %14d %14d %+8.1f%%%s" % (name, old, new, change, marker))
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('--output', metavar='FILE', required=True,
+                        help="write the results here")
+    parser.add_argument('--baseline', metavar='FILE',
+                        help="compare with results from this file, if it exists")
+    parser.add_argument('--threshold', type=float, default=10, metavar='PERCENT',
+                        help="fail if a median is this much slower than in the baseline "
+                             "(default: %(default)s)")
+    parser.add_argument('--filter', metavar='TEXT',
+                        help="run only benchmark files whose name contains TEXT")
+    args = parser.parse_args()
+
+    results = run_all(args.filter)
+    with open(args.output, 'w') as file:
+        json.dump({'benchmarks': results}, file, indent=2, sort_keys=True)
+        file.write('\n')
+    print("wrote", args.output, file=sys.stderr)
+
+    if args.baseline is None:
+        return
+    if not os.path.exists(args.baseline):
+        print("%s doesn't exist, run 'make bench-baseline' to create it" % args.baseline,
+              file=sys.stderr)
+        return
+
+    with open(args.baseline, 'r') as file:
+        baseline = json.load(file)['benchmarks']
+    regressions = compare(results, baseline, args.threshold)
+    if regressions:
+        print("%d benchmarks are more than %g%% slower than the baseline: %s" % (
+            len(regressions), args.threshold, ', '.join(regressions)), file=sys.stderr)
+        sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()
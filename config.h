@@ -0,0 +1,5 @@
+// generated by ./configure
+#ifndef CONFIG_H
+#define CONFIG_H
+#define HAVE_READLINE
+#endif   // CONFIG_H
@@ -62,6 +62,8 @@ int main(int argc, char **argv)
 	RUN_TEST(test_objects_simple);
 	RUN_TEST(test_objects_function);
 	RUN_TEST(test_objects_string);
+	RUN_TEST(test_objects_string_kinds);
+	RUN_TEST(test_objects_string_slices);
 	RUN_TEST(test_objects_string_newfromfmt);
 	RUN_TEST(test_objects_array_many_elems);
 	RUN_TEST(test_objects_mapping_huge);
@@ -77,7 +79,32 @@ int main(int argc, char **argv)
 	RUN_TEST(test_ast_attributes_and_methods);
 	RUN_TEST(test_ast_function_call_statement);
 
+	RUN_TEST(test_astcache_roundtrip);
+	RUN_TEST(test_astcache_invalid);
+
+	RUN_TEST(test_embed_reset);
+	RUN_TEST(test_embed_snapshot);
+	RUN_TEST(test_embed_pool);
+
+	RUN_TEST(test_heapimage_roundtrip);
+	RUN_TEST(test_heapimage_invalid);
+
+	RUN_TEST(test_profiler_calls);
+	RUN_TEST(test_sampler_folded_output);
+	RUN_TEST(test_perfmap_entries);
+
+	RUN_TEST(test_serialize_roundtrip);
+	RUN_TEST(test_serialize_errors);
+
+	RUN_TEST(test_timing_summarize);
+	RUN_TEST(test_timing_clocks);
+
 	RUN_TEST(test_tokenizer_tokenize);
+	RUN_TEST(test_tokenizer_empty);
+	RUN_TEST(test_tokenizer_utf8);
+
+	RUN_TEST(test_utf8_long_strings);
+	RUN_TEST(test_utf8_validation);
 
 	builtins_teardown(testinterp);
 	gc_run(testinterp);
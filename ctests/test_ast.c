@@ -81,66 +81,43 @@ void test_ast_nodes_and_their_refcount_stuff(void)
 }
 
 
-// these assume ascii for simplicity
 static struct Object *parse_expression_string(char *s)
 {
-	struct UnicodeString hugestring;
-	hugestring.len = strlen(s);
-	hugestring.val = bmalloc(sizeof(unicode_char) * hugestring.len);
-	// can't use memcpy because types differ
-	for (size_t i=0; i < strlen(s); i++)
-		hugestring.val[i] = s[i];
-
-	struct Token *tok1st = token_ize(testinterp, hugestring);
-	buttert(tok1st);
-	free(hugestring.val);
-
-	struct Token *tmp = tok1st;
+	struct TokenArray tokens;
+	buttert(token_ize(testinterp, s, strlen(s), &tokens));
+
+	struct Token *tmp = tokens.tokens;
 	struct Object *node = parse_expression(testinterp, "<test>", &tmp);
-	buttert(!tmp);
-	token_freeall(tok1st);
+	buttert(tmp->kind == TOKEN_END);
+	tokenarray_free(tokens);
 	buttert2(node, s);
 	return node;
 }
 static struct Object *parse_statement_string(char *s)
 {
-	struct UnicodeString hugestring;
-	hugestring.len = strlen(s);
-	hugestring.val = bmalloc(sizeof(unicode_char) * hugestring.len);
-	// can't use memcpy because types differ
-	for (size_t i=0; i < hugestring.len; i++)
-		hugestring.val[i] = s[i];
-
-	struct Token *tok1st = token_ize(testinterp, hugestring);
-	buttert(tok1st);
-	free(hugestring.val);
-
-	struct Token *tmp = tok1st;
+	struct TokenArray tokens;
+	buttert(token_ize(testinterp, s, strlen(s), &tokens));
+
+	struct Token *tmp = tokens.tokens;
 	struct Object *node = parse_statement(testinterp, "<test>", &tmp);
-	token_freeall(tok1st);
+	tokenarray_free(tokens);
 	buttert2(node, s);
 	return node;
 }
 
 // THIS USES ASCII
-static int ustr_equals_charp(struct UnicodeString ustr, char *charp)
+static int stringobject_equals_charp(struct Object *strobj, char *charp)
 {
-	if(ustr.len != strlen(charp))
+	if (STRINGOBJECT_LEN(strobj) != strlen(charp))
 		return 0;
 
-	for (size_t i=0; i < ustr.len; i++) {
-		if (ustr.val[i] != (unicode_char) charp[i])
+	for (size_t i=0; i < STRINGOBJECT_LEN(strobj); i++) {
+		if (STRINGOBJECT_GET(strobj, i) != (unicode_char) charp[i])
 			return 0;
 	}
 	return 1;
 }
 
-// THIS USES ASCII
-static int stringobject_equals_charp(struct Object *strobj, char *charp)
-{
-	return ustr_equals_charp(*((struct UnicodeString *) strobj->objdata.data), charp);
-}
-
 
 void test_ast_strings(void)
 {
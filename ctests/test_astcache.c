@@ -0,0 +1,105 @@
+#include <src/astcache.h>
+#include <src/interpreter.h>
+#include <src/objects/array.h>
+#include <src/objects/astnode.h>
+#include <src/objectsystem.h>
+#include <src/parse.h>
+#include <src/tokenizer.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "utils.h"
+
+static char code[] =
+	"var x = [1 \"hellö\" {print (x.y + 2);}];\n"
+	"x.get 0 a:b c:(d == e);\n"
+	"x.y = (x `same_object` x);\n"
+	"x = \"hellö\";\n";
+
+static struct Object *parse(void)
+{
+	struct TokenArray tokens;
+	buttert(token_ize(testinterp, code, strlen(code), &tokens));
+	struct Object *statements = arrayobject_newempty(testinterp);
+	buttert(statements);
+
+	struct Token *curtok = tokens.tokens;
+	while (curtok->kind != TOKEN_END) {
+		struct Object *node = parse_statement(testinterp, "<test>", &curtok);
+		buttert(node);
+		buttert(arrayobject_push(testinterp, statements, node));
+		OBJECT_DECREF(testinterp, node);
+	}
+	tokenarray_free(tokens);
+	return statements;
+}
+
+void test_astcache_roundtrip(void)
+{
+	struct AstCacheSource src = { .hash = astcache_hash(code, strlen(code)), .size = strlen(code), .mtime = 123 };
+	struct Object *statements = parse();
+
+	char *data;
+	size_t datalen;
+	buttert(astcache_dump(testinterp, statements, src, &data, &datalen));
+
+	struct Object *loaded;
+	buttert(astcache_load(testinterp, data, datalen, &src, "<test>", &loaded) == 1);
+	buttert(ARRAYOBJECT_LEN(loaded) == ARRAYOBJECT_LEN(statements));
+	for (size_t i=0; i < ARRAYOBJECT_LEN(loaded); i++) {
+		struct AstNodeObjectData *a = ARRAYOBJECT_GET(loaded, i)->objdata.data;
+		struct AstNodeObjectData *b = ARRAYOBJECT_GET(statements, i)->objdata.data;
+		buttert(a->kind == b->kind);
+		buttert(a->lineno == b->lineno);
+		buttert(strcmp(a->filename, "<test>") == 0);
+	}
+
+	// dumping the loaded nodes must give exactly the same data
+	char *data2;
+	size_t datalen2;
+	buttert(astcache_dump(testinterp, loaded, src, &data2, &datalen2));
+	buttert(datalen2 == datalen);
+	buttert(memcmp(data, data2, datalen) == 0);
+	free(data2);
+
+	OBJECT_DECREF(testinterp, loaded);
+	OBJECT_DECREF(testinterp, statements);
+	free(data);
+}
+
+void test_astcache_invalid(void)
+{
+	struct AstCacheSource src = { .hash = astcache_hash(code, strlen(code)), .size = strlen(code), .mtime = 123 };
+	struct Object *statements = parse();
+	char *data;
+	size_t datalen;
+	buttert(astcache_dump(testinterp, statements, src, &data, &datalen));
+	OBJECT_DECREF(testinterp, statements);
+
+	struct Object *loaded;
+	struct AstCacheSource othersrc = src;
+	othersrc.mtime++;
+	buttert(astcache_load(testinterp, data, datalen, &othersrc, "<test>", &loaded) == -1);
+	othersrc = src;
+	othersrc.hash++;
+	buttert(astcache_load(testinterp, data, datalen, &othersrc, "<test>", &loaded) == -1);
+
+	// NULL src means not checking it
+	buttert(astcache_load(testinterp, data, datalen, NULL, "<test>", &loaded) == 1);
+	OBJECT_DECREF(testinterp, loaded);
+
+	// every truncation must be detected without crashing or throwing
+	for (size_t len = 0; len < datalen; len++)
+		buttert(astcache_load(testinterp, data, len, &src, "<test>", &loaded) == -1);
+
+	// the version is right after the magic
+	data[5]++;
+	buttert(astcache_load(testinterp, data, datalen, &src, "<test>", &loaded) == -1);
+	data[5]--;
+	data[0] = 'x';
+	buttert(astcache_load(testinterp, data, datalen, &src, "<test>", &loaded) == -1);
+
+	buttert(!testinterp->err);
+	free(data);
+}
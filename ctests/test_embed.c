@@ -0,0 +1,102 @@
+#include <src/embed.h>
+#include <src/interpreter.h>
+#include <src/objects/array.h>
+#include <src/objects/mapping.h>
+#include <src/objects/scope.h>
+#include <src/objectsystem.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include "utils.h"
+
+static char code[] =
+	"String.getters.set \"lol\" (lambda \"this\" returning:true { return \"lol\"; });\n"
+	"var eq_array = (import \"<std>/operators\").eq_array;\n"
+	"eq_array.push print;\n"
+	"var stacks = (import \"<std>/stacks\");\n"    // builtins.ö imports the other std libraries
+	"func \"f\" { f; };\n"    // a reference cycle: function -> its definition scope -> function
+	"var cycle = [];\n"
+	"cycle.push cycle;\n"
+	"print = \"lol\";\n";
+
+// checks that print is a function again, without writing to stdout
+static char printcheck[] = "assert ((get_class print) `same_object` (get_class get_class));";
+
+static bool run(struct EmbedInterp *ei, char *s)
+{
+	return embed_run(ei, "<test>", s, strlen(s));
+}
+
+void test_embed_reset(void)
+{
+	struct EmbedInterp *ei = embed_new("testargv0");
+	buttert(ei);
+	struct Interpreter *interp = ei->interp;
+
+	// running once first makes sure that everything that is created lazily exists already
+	buttert(run(ei, code));
+	buttert(embed_reset(ei));
+
+	size_t nobjects = interp->allobjects.size;
+	size_t nvars = MAPPINGOBJECT_SIZE(SCOPEOBJECT_LOCALVARS(interp->builtinscope));
+	size_t nlibs = MAPPINGOBJECT_SIZE(interp->importstuff.filelibcache);
+	size_t neq = ARRAYOBJECT_LEN(interp->oparrays.eq);
+
+	buttert(run(ei, code));
+	buttert(run(ei, "var lel = 123;"));   // creates nothing in the built-in scope
+	buttert(MAPPINGOBJECT_SIZE(interp->importstuff.filelibcache) == nlibs + 1);
+	buttert(ARRAYOBJECT_LEN(interp->oparrays.eq) == neq + 1);
+	buttert(!run(ei, "\"x\".lol;"));    // print was replaced with a string
+	buttert(interp->err);
+
+	buttert(embed_reset(ei));
+	buttert(!interp->err);
+	buttert(MAPPINGOBJECT_SIZE(SCOPEOBJECT_LOCALVARS(interp->builtinscope)) == nvars);
+	buttert(MAPPINGOBJECT_SIZE(interp->importstuff.filelibcache) == nlibs);
+	buttert(ARRAYOBJECT_LEN(interp->oparrays.eq) == neq);
+	buttert(interp->allobjects.size == nobjects);
+
+	buttert(!run(ei, "\"x\".lol;"));    // the getter is gone
+	buttert(interp->err);
+	buttert(embed_reset(ei));
+	buttert(run(ei, printcheck));
+	embed_free(ei);
+}
+
+void test_embed_snapshot(void)
+{
+	struct EmbedInterp *ei = embed_new("testargv0");
+	buttert(ei);
+	buttert(run(ei, "var stacks = (import \"<std>/stacks\");"));
+	size_t nlibs = MAPPINGOBJECT_SIZE(ei->interp->importstuff.filelibcache);
+	
+	buttert(embed_reset(ei));
+	buttert(MAPPINGOBJECT_SIZE(ei->interp->importstuff.filelibcache) == nlibs - 1);
+
+	buttert(run(ei, "var stacks = (import \"<std>/stacks\");"));
+	buttert(embed_snapshot(ei));
+	buttert(embed_reset(ei));
+	buttert(MAPPINGOBJECT_SIZE(ei->interp->importstuff.filelibcache) == nlibs);
+	embed_free(ei);
+}
+
+void test_embed_pool(void)
+{
+	struct EmbedPool *pool = embedpool_new("testargv0", 2);
+	buttert(pool);
+
+	struct EmbedInterp *a = embedpool_checkout(pool);
+	struct EmbedInterp *b = embedpool_checkout(pool);
+	buttert(a && b && a != b);
+	buttert(!embedpool_checkout(pool));
+
+	buttert(run(a, "print = \"lol\";"));
+	embedpool_checkin(pool, a);
+	struct EmbedInterp *c = embedpool_checkout(pool);
+	buttert(c == a);
+	buttert(run(c, printcheck));
+
+	embedpool_checkin(pool, b);
+	embedpool_checkin(pool, c);
+	embedpool_free(pool);
+}
@@ -0,0 +1,98 @@
+#include <src/builtins.h>
+#include <src/gc.h>
+#include <src/heapimage.h>
+#include <src/interpreter.h>
+#include <src/objects/mapping.h>
+#include <src/objects/scope.h>
+#include <src/objectsystem.h>
+#include <src/run.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "utils.h"
+
+// uses methods, closures, string slices, oparrays, error classes and cached imports from the image
+static char code[] =
+	"var operators = (import \"<std>/operators\");\n"
+	"func \"adder n\" returning:true { return (lambda \"x\" returning:true { return (x + n); }); };\n"
+	"assert (((adder 2) 3) == 5);\n"
+	"assert (\"hello world\".(slice 2 9) == \"llo wor\");\n"
+	"assert ([1 2 3] == [1 2 3]);\n"
+	"var caught = false;\n"
+	"catch { throw (new ValueError \"x\"); } ValueError { caught = true; };\n"
+	"assert caught;\n";
+
+static struct Interpreter *new_setup_interp(void)
+{
+	struct Interpreter *interp = interpreter_new("testargv0");
+	buttert(interp);
+	buttert(builtins_setup(interp));
+	buttert(run_builtinsfile(interp));
+	return interp;
+}
+
+static void free_interp(struct Interpreter *interp)
+{
+	builtins_teardown(interp);
+	gc_run(interp);    // checks refcounts, so this catches refcounts that the image got wrong
+	interpreter_free(interp);
+}
+
+void test_heapimage_roundtrip(void)
+{
+	struct Interpreter *orig = new_setup_interp();
+	char *image;
+	size_t len;
+	buttert(heapimage_dump(orig, &image, &len));
+	size_t nobjects = orig->allobjects.size;
+	size_t nvars = MAPPINGOBJECT_SIZE(SCOPEOBJECT_LOCALVARS(orig->builtinscope));
+	free_interp(orig);
+
+	struct Interpreter *interp = interpreter_new("testargv0");
+	buttert(interp);
+	buttert(heapimage_load(interp, image, len));
+	free(image);
+	buttert(interp->allobjects.size == nobjects);
+	buttert(MAPPINGOBJECT_SIZE(SCOPEOBJECT_LOCALVARS(interp->builtinscope)) == nvars);
+
+	struct Object *scope = scopeobject_newsub(interp, interp->builtinscope);
+	buttert(scope);
+	buttert(run_string(interp, "<test>", code, strlen(code), scope));
+	OBJECT_DECREF(interp, scope);
+
+	// an interpreter loaded from an image can write an image too
+	buttert(heapimage_dump(interp, &image, &len));
+	free(image);
+	free_interp(interp);
+}
+
+void test_heapimage_invalid(void)
+{
+	struct Interpreter *orig = new_setup_interp();
+	char *image;
+	size_t len;
+	buttert(heapimage_dump(orig, &image, &len));
+	free_interp(orig);
+
+	struct Interpreter *interp = interpreter_new("testargv0");
+	buttert(interp);
+
+	// truncated images must not leak or leave objects behind, checking every length would be slow
+	for (size_t n = 0; n < len; n += 1 + n/7) {
+		buttert(!heapimage_load(interp, image, n));
+		buttert(interp->allobjects.size == 0);
+		buttert(!interp->builtinscope);
+	}
+
+	// an image from another std directory must not be used
+	char *stdpath = interp->stdpath;
+	interp->stdpath = "/nonexistent/std";
+	buttert(!heapimage_load(interp, image, len));
+	buttert(interp->allobjects.size == 0);
+	interp->stdpath = stdpath;
+
+	buttert(heapimage_load(interp, image, len));
+	free(image);
+	free_interp(interp);
+}
@@ -101,15 +101,97 @@ void test_objects_string(void)
 
 	for (size_t i=0; i < sizeof(strs)/sizeof(strs[0]); i++) {
 		buttert(strs[i]);
-		struct UnicodeString *data = strs[i]->objdata.data;
-		buttert(data);
-		buttert(data->len == 2);
-		buttert(data->val[0] == ODOTDOT);
-		buttert(data->val[1] == odotdot);
+		buttert(STRINGOBJECT_LEN(strs[i]) == 2);
+		buttert(STRINGOBJECT_GET(strs[i], 0) == ODOTDOT);
+		buttert(STRINGOBJECT_GET(strs[i], 1) == odotdot);
 		OBJECT_DECREF(testinterp, strs[i]);
 	}
 }
 
+void test_objects_string_kinds(void)
+{
+	// each string gets the smallest kind that fits all of its characters
+	char *utf8s[] = { "hello", "Öö", "\xe2\x82\xac", "\xf0\x9d\x84\x9e" };   // last ones are euro sign and a musical symbol
+	int kinds[] = { 1, 1, 2, 4 };
+	struct Object *strs[4];
+	for (int i=0; i < 4; i++) {
+		buttert((strs[i] = stringobject_newfromcharptr(testinterp, utf8s[i])));
+		buttert(STRINGOBJECT_DATA(strs[i])->kind == kinds[i]);
+	}
+	buttert(STRINGOBJECT_GET(strs[2], 0) == 0x20ac);
+	buttert(STRINGOBJECT_GET(strs[3], 0) == 0x1d11e);
+
+	// a string created from utf-32 must be equal to the same string created from utf-8
+	unicode_char euroval = 0x20ac;
+	struct Object *euro = stringobject_newfromustr_copy(testinterp, (struct UnicodeString){ .len = 1, .val = &euroval });
+	buttert(euro);
+	buttert(STRINGOBJECT_DATA(euro)->kind == 2);
+	buttert(stringobject_equal(euro, strs[2]));
+	stringobject_ensurehash(euro);
+	stringobject_ensurehash(strs[2]);
+	buttert(euro->hash == strs[2]->hash);
+	buttert(!stringobject_equal(euro, strs[3]));
+	OBJECT_DECREF(testinterp, euro);
+
+	// converting back must give the same utf-8 and utf-32
+	for (int i=0; i < 4; i++) {
+		char *utf8;
+		size_t utf8len;
+		buttert(stringobject_toutf8(testinterp, strs[i], &utf8, &utf8len));
+		buttert(utf8len == strlen(utf8s[i]));
+		buttert(memcmp(utf8, utf8s[i], utf8len) == 0);
+		free(utf8);
+
+		struct UnicodeString u;
+		buttert(stringobject_getustr(testinterp, strs[i], &u));
+		buttert(u.len == STRINGOBJECT_LEN(strs[i]));
+		for (size_t j=0; j < u.len; j++)
+			buttert(u.val[j] == STRINGOBJECT_GET(strs[i], j));
+		free(u.val);
+
+		OBJECT_DECREF(testinterp, strs[i]);
+	}
+}
+
+void test_objects_string_slices(void)
+{
+	char utf8[1001];
+	memset(utf8, 'a', 1000);
+	utf8[1000] = 0;
+	struct Object *s = stringobject_newfromcharptr(testinterp, utf8);
+	buttert(s);
+
+	// big slices share the characters with the parent, even when slicing a slice
+	struct Object *start = integerobject_newfromlonglong(testinterp, 100);
+	struct Object *big = method_call_yesret(testinterp, s, "slice", start, NULL);
+	buttert(big);
+	buttert(STRINGOBJECT_LEN(big) == 900);
+	buttert(STRINGOBJECT_DATA(big)->parent == s);
+	buttert(STRINGOBJECT_DATA(big)->val == (char *) STRINGOBJECT_DATA(s)->val + 100);
+	struct Object *bigger = method_call_yesret(testinterp, big, "slice", start, NULL);
+	buttert(bigger);
+	buttert(STRINGOBJECT_DATA(bigger)->parent == s);
+	buttert(STRINGOBJECT_LEN(bigger) == 800);
+
+	// small slices are copied, so they don't keep the big string alive
+	struct Object *end = integerobject_newfromlonglong(testinterp, 110);
+	struct Object *small = method_call_yesret(testinterp, s, "slice", start, end, NULL);
+	buttert(small);
+	buttert(STRINGOBJECT_LEN(small) == 10);
+	buttert(STRINGOBJECT_DATA(small)->parent == NULL);
+
+	// the parent must stay alive as long as the slices need it
+	OBJECT_DECREF(testinterp, s);
+	OBJECT_DECREF(testinterp, big);
+	buttert(STRINGOBJECT_GET(bigger, 799) == 'a');
+	stringobject_ensurehash(bigger);
+
+	OBJECT_DECREF(testinterp, bigger);
+	OBJECT_DECREF(testinterp, small);
+	OBJECT_DECREF(testinterp, start);
+	OBJECT_DECREF(testinterp, end);
+}
+
 void test_objects_string_newfromfmt(void)
 {
 	unicode_char bval = 'b';
@@ -127,10 +209,9 @@ void test_objects_string_newfromfmt(void)
 	OBJECT_DECREF(testinterp, i);
 
 	char shouldB[] = "-a-b-c-123-123-%-";
-	struct UnicodeString *s = res->objdata.data;
-	buttert(s->len == strlen(shouldB));
-	for (unsigned int i=0; i < s->len; i++)
-		buttert(s->val[i] == (unsigned char) shouldB[i]);
+	buttert(STRINGOBJECT_LEN(res) == strlen(shouldB));
+	for (unsigned int i=0; i < STRINGOBJECT_LEN(res); i++)
+		buttert(STRINGOBJECT_GET(res, i) == (unsigned char) shouldB[i]);
 
 	OBJECT_DECREF(testinterp, res);
 }
@@ -0,0 +1,59 @@
+#include <src/interpreter.h>
+#include <src/objects/scope.h>
+#include <src/objectsystem.h>
+#include <src/perfmap.h>
+#include <src/run.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "utils.h"
+
+#if defined(__linux__) && (defined(__x86_64__) || defined(__aarch64__))
+#include <unistd.h>
+
+void test_perfmap_entries(void)
+{
+	char code[] =
+		"func \"f x\" returning:true {\n"
+		"    return (x + 1);\n"
+		"};\n"
+		"assert ((f 1) == 2);\n"
+		"assert ((f 2) == 3);\n";
+
+	char path[100];
+	sprintf(path, "/tmp/perf-%ld.map", (long)getpid());
+	remove(path);
+
+	buttert(perfmap_start(testinterp));
+	struct Object *scope = scopeobject_newsub(testinterp, testinterp->builtinscope);
+	buttert(scope);
+	buttert(run_string(testinterp, "<test>", code, strlen(code), scope));
+	OBJECT_DECREF(testinterp, scope);
+	perfmap_stop(testinterp);
+	buttert(!testinterp->perfmap);
+
+	FILE *f = fopen(path, "r");
+	buttert(f);
+	char line[1000];
+	int found = 0;
+	while (fgets(line, sizeof line, f)) {
+		unsigned long start, size;
+		int namestart;
+		buttert(sscanf(line, "%lx %lx %n", &start, &size, &namestart) == 2);
+		buttert(start != 0 && size != 0);
+		if (strcmp(line + namestart, "ö f (<test>:2)\n") == 0)
+			found++;
+	}
+	buttert(found == 1);    // two calls, but only one trampoline
+	fclose(f);
+	buttert(remove(path) == 0);
+}
+
+#else
+
+void test_perfmap_entries(void)
+{
+	buttert(!perfmap_start(testinterp));
+}
+
+#endif
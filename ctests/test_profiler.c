@@ -0,0 +1,56 @@
+#include <src/interpreter.h>
+#include <src/objects/scope.h>
+#include <src/objectsystem.h>
+#include <src/profiler.h>
+#include <src/run.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "utils.h"
+
+#define PATH "ctests-profile.tmp"
+
+void test_profiler_calls(void)
+{
+	char code[] =
+		"func \"f x\" {\n"
+		"    var y = x;\n"
+		"};\n"
+		"f 1; f 2; f 3;\n";
+
+	buttert(profiler_start(testinterp));
+	struct Object *scope = scopeobject_newsub(testinterp, testinterp->builtinscope);
+	buttert(scope);
+	buttert(run_string(testinterp, "<test>", code, strlen(code), scope));
+	OBJECT_DECREF(testinterp, scope);
+	buttert(profiler_writefile(testinterp, PATH));
+	profiler_stop(testinterp);
+	buttert(!testinterp->err);
+
+	FILE *f = fopen(PATH, "r");
+	buttert(f);
+	char line[500];
+	buttert(fgets(line, sizeof line, f));
+	buttert(strncmp(line, "calls\t", 6) == 0);
+
+	bool found = false;
+	while (fgets(line, sizeof line, f)) {
+		unsigned long long calls, incl, excl, inclallocs, exclallocs;
+		char name[100], file[100];
+		size_t lineno;
+		if (sscanf(line, "%llu\t%llu\t%llu\t%llu\t%llu\t%99[^\t]\t%99[^\t]\t%zu",
+				&calls, &incl, &excl, &inclallocs, &exclallocs, name, file, &lineno) == 8 &&
+				strcmp(name, "f") == 0) {
+			buttert(!found);
+			found = true;
+			buttert(calls == 3);
+			buttert(strcmp(file, "<test>") == 0);
+			buttert(lineno == 2);    // the body starts here
+			buttert(excl <= incl);
+			buttert(exclallocs <= inclallocs);
+		}
+	}
+	buttert(found);
+	fclose(f);
+	buttert(remove(PATH) == 0);
+}
@@ -0,0 +1,46 @@
+#include <src/interpreter.h>
+#include <src/objects/scope.h>
+#include <src/objectsystem.h>
+#include <src/run.h>
+#include <src/sampler.h>
+#include <stdio.h>
+#include <string.h>
+#include "utils.h"
+
+#define PATH "ctests-samples.tmp"
+
+void test_sampler_folded_output(void)
+{
+	// must run long enough to get at least one sample, even with a kernel that has a slow timer
+	char code[] =
+		"for { var i = 0; } { (i < 20000) } { i = (i+1); } {\n"
+		"    var x = (i + 1);\n"
+		"};\n";
+
+	buttert(sampler_start(testinterp, 1000));
+	buttert(!sampler_start(testinterp, 1000));    // only one at a time, and fails quietly
+	struct Object *scope = scopeobject_newsub(testinterp, testinterp->builtinscope);
+	buttert(scope);
+	buttert(run_string(testinterp, "<test>", code, strlen(code), scope));
+	OBJECT_DECREF(testinterp, scope);
+	buttert(sampler_stop(testinterp, PATH));
+	buttert(!testinterp->sampler);
+
+	FILE *f = fopen(PATH, "r");
+	buttert(f);
+	char line[1000];
+	unsigned long total = 0;
+	while (fgets(line, sizeof line, f)) {
+		// the outermost frame is always the for loop
+		buttert(strncmp(line, "<test>:1", strlen("<test>:1")) == 0);
+		char *space = strrchr(line, ' ');
+		buttert(space);
+		unsigned long count;
+		buttert(sscanf(space, " %lu\n", &count) == 1);
+		buttert(count >= 1);
+		total += count;
+	}
+	buttert(total >= 1);
+	fclose(f);
+	buttert(remove(PATH) == 0);
+}
@@ -0,0 +1,131 @@
+#include <src/interpreter.h>
+#include <src/objects/array.h>
+#include <src/objects/bytearray.h>
+#include <src/objects/integer.h>
+#include <src/objects/mapping.h>
+#include <src/objects/option.h>
+#include <src/objects/string.h>
+#include <src/objectsystem.h>
+#include <src/operator.h>
+#include <src/serialize.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "utils.h"
+
+static struct Object *create_value(void)
+{
+	struct Object *map = mappingobject_newempty(testinterp);
+	struct Object *key = stringobject_newfromcharptr(testinterp, "hellö");
+	struct Object *neg = integerobject_newfromlonglong(testinterp, -1234567890123LL);
+	buttert(map && key && neg);
+	buttert(mappingobject_set(testinterp, map, key, neg));
+	OBJECT_DECREF(testinterp, key);
+	OBJECT_DECREF(testinterp, neg);
+
+	unsigned char *bytes = bmalloc(3);
+	memcpy(bytes, "\x00\xff\x7f", 3);
+	struct Object *bytearr = bytearrayobject_new(testinterp, bytes, 3);
+	struct Object *opt = optionobject_new(testinterp, testinterp->builtins.yes);
+	struct Object *zero = integerobject_newfromlonglong(testinterp, 0);
+	buttert(bytearr && opt && zero);
+
+	struct Object *elems[] = { map, bytearr, opt, zero, testinterp->builtins.no, testinterp->builtins.none };
+	struct Object *arr = arrayobject_new(testinterp, elems, sizeof(elems)/sizeof(elems[0]));
+	buttert(arr);
+	OBJECT_DECREF(testinterp, map);
+	OBJECT_DECREF(testinterp, bytearr);
+	OBJECT_DECREF(testinterp, opt);
+	OBJECT_DECREF(testinterp, zero);
+	return arr;
+}
+
+static void clear_error(void)
+{
+	buttert(testinterp->err);
+	OBJECT_DECREF(testinterp, testinterp->err);
+	testinterp->err = NULL;
+}
+
+void test_serialize_roundtrip(void)
+{
+	struct Object *val = create_value();
+	struct SerializeBuf buf = {0};
+	buttert(serialize_dump(testinterp, val, &buf));
+
+	// two values in the same buffer are loaded one after another
+	size_t firstlen = buf.len;
+	buttert(serialize_dump(testinterp, val, &buf));
+	buttert(buf.len == 2*firstlen);
+
+	size_t pos = 0;
+	struct Object *loaded = serialize_load(testinterp, buf.data, buf.len, &pos);
+	buttert(loaded);
+	buttert(pos == firstlen);
+	buttert(operator_eqint(testinterp, val, loaded) == 1);
+
+	struct Object *loaded2 = serialize_load(testinterp, buf.data, buf.len, &pos);
+	buttert(loaded2);
+	buttert(pos == buf.len);
+	buttert(operator_eqint(testinterp, val, loaded2) == 1);
+
+	// dumping the loaded value must give exactly the same data
+	struct SerializeBuf buf2 = {0};
+	buttert(serialize_dump(testinterp, loaded, &buf2));
+	buttert(buf2.len == firstlen);
+	buttert(memcmp(buf.data, buf2.data, firstlen) == 0);
+
+	serialize_discard(buf.data, buf.len);
+	serialize_discard(buf2.data, buf2.len);
+	free(buf.data);
+	free(buf2.data);
+	OBJECT_DECREF(testinterp, loaded);
+	OBJECT_DECREF(testinterp, loaded2);
+	OBJECT_DECREF(testinterp, val);
+}
+
+void test_serialize_errors(void)
+{
+	struct Object *val = create_value();
+	struct SerializeBuf buf = {0};
+	buttert(serialize_dump(testinterp, val, &buf));
+	size_t goodlen = buf.len;
+
+	// a failed dump leaves the buffer as it was
+	struct Object *elems[] = { val, testinterp->builtins.Object };
+	struct Object *bad = arrayobject_new(testinterp, elems, 2);
+	buttert(bad);
+	buttert(!serialize_dump(testinterp, bad, &buf));
+	clear_error();
+	buttert(buf.len == goodlen);
+
+	OBJECT_DECREF(testinterp, bad);
+
+	// arrays that contain themselves
+	struct Object *loop = arrayobject_newempty(testinterp);
+	buttert(loop);
+	buttert(arrayobject_push(testinterp, loop, loop));
+	buttert(!serialize_dump(testinterp, loop, &buf));
+	clear_error();
+	buttert(buf.len == goodlen);
+	struct Object *popped = arrayobject_pop(testinterp, loop);   // break the reference cycle
+	buttert(popped == loop);
+	OBJECT_DECREF(testinterp, popped);
+	OBJECT_DECREF(testinterp, loop);
+
+	// every truncation must be detected without crashing
+	for (size_t len = 0; len < goodlen; len++) {
+		size_t pos = 0;
+		buttert(!serialize_load(testinterp, buf.data, len, &pos));
+		clear_error();
+	}
+
+	size_t pos = 0;
+	buf.data[0] = 'x';
+	buttert(!serialize_load(testinterp, buf.data, buf.len, &pos));
+	clear_error();
+
+	free(buf.data);
+	OBJECT_DECREF(testinterp, val);
+}
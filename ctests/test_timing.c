@@ -0,0 +1,40 @@
+#include <src/timing.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "utils.h"
+
+void test_timing_summarize(void)
+{
+	uint64_t values[] = { 7, 1, 5, 3 };
+	struct TimingSummary sum = timing_summarize(values, 4);
+	buttert(values[0] == 1 && values[3] == 7);   // sorted
+	buttert(sum.min == 1);
+	buttert(sum.max == 7);
+	buttert(sum.mean == 4);
+	buttert(sum.median == 4);    // halfway between 3 and 5
+	buttert(sum.p99 == 7);
+	buttert(sum.stddev == 2);    // sqrt(5), rounded down
+
+	uint64_t many[200];
+	for (size_t i=0; i < 200; i++)
+		many[i] = 200 - i;
+	sum = timing_summarize(many, 200);
+	buttert(sum.median == 100);
+	buttert(sum.p99 == 198);
+	buttert(sum.stddev == 57);
+
+	uint64_t one = 123;
+	sum = timing_summarize(&one, 1);
+	buttert(sum.min == 123 && sum.max == 123 && sum.median == 123 && sum.p99 == 123 && sum.stddev == 0);
+}
+
+void test_timing_clocks(void)
+{
+	uint64_t a = timing_monotonic_ns();
+	uint64_t b = timing_monotonic_ns();
+	buttert(b >= a);
+
+	uint64_t cpu;
+	buttert(timing_threadcpu_ns(&cpu));
+	buttert(cpu > 0);
+}
@@ -1,7 +1,6 @@
 #include <src/interpreter.h>
 #include <src/tokenizer.h>
-#include <src/unicode.h>
-#include <src/utf8.h>
+#include <src/objectsystem.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdlib.h>
@@ -9,25 +8,15 @@
 #include "utils.h"
 
 
-static char *unicode_to_utf8_ending_with_0(struct UnicodeString unicode)
-{
-	char *utf8;
-	size_t utf8len;
-	buttert(utf8_encode(testinterp, unicode, &utf8, &utf8len));
-	buttert((utf8=realloc(utf8, utf8len+1)));
-	utf8[utf8len]=0;
-	return utf8;
-}
-
 struct Token *check_token(struct Token *tok, char kind, char *str, size_t lineno) {
 	buttert(tok->kind == kind);
 	buttert(tok->lineno == lineno);
 
-	char *tokstr = unicode_to_utf8_ending_with_0(tok->str);
-	buttert(strcmp(tokstr, str) == 0);
-	free(tokstr);
+	// the tokens are utf8 and point to the source, so they aren't \0-terminated
+	buttert(tok->str.len == strlen(str));
+	buttert(memcmp(tok->str.val, str, tok->str.len) == 0);
 
-	return tok->next;
+	return tok+1;
 }
 
 void test_tokenizer_tokenize(void)
@@ -41,15 +30,12 @@ void test_tokenizer_tokenize(void)
 	int utf8codelen = strlen(utf8code);
 	utf8code[5] = 0;    // must not break anything
 
-	struct UnicodeString code;
-	buttert(utf8_decode(testinterp, utf8code, utf8codelen, &code) == true);
-
-	struct Token *tok1st = token_ize(testinterp, code);
-	buttert(tok1st);
+	struct TokenArray tokens;
+	buttert(token_ize(testinterp, utf8code, utf8codelen, &tokens));
 	buttert(!testinterp->err);
-	free(code.val);
+	buttert(tokens.len == 15);
 
-	struct Token *curtok = tok1st;
+	struct Token *curtok = tokens.tokens;
 	curtok = check_token(curtok, TOKEN_KEYWORD, "var", 2);
 	curtok = check_token(curtok, TOKEN_ID, "abc", 2);
 	curtok = check_token(curtok, TOKEN_OP, "=", 2);
@@ -65,7 +51,44 @@ void test_tokenizer_tokenize(void)
 	curtok = check_token(curtok, TOKEN_INT, "2", 5);
 	curtok = check_token(curtok, TOKEN_ID, "bäd", 5);
 	curtok = check_token(curtok, TOKEN_OP, ";", 5);
-	buttert(!curtok);
+	buttert(curtok->kind == TOKEN_END);
+
+	tokenarray_free(tokens);
+}
+
+void test_tokenizer_empty(void)
+{
+	char utf8code[] = " \n# only a cömment\n";
+
+	struct TokenArray tokens;
+	buttert(token_ize(testinterp, utf8code, strlen(utf8code), &tokens));
+	buttert(tokens.len == 0);
+	buttert(tokens.tokens[0].kind == TOKEN_END);
+	tokenarray_free(tokens);
+
+	buttert(token_ize(testinterp, NULL, 0, &tokens));
+	buttert(tokens.len == 0);
+	buttert(tokens.tokens[0].kind == TOKEN_END);
+	tokenarray_free(tokens);
+}
+
+void test_tokenizer_utf8(void)
+{
+	// the keyword check must not see "var" at the start of a non-ascii identifier
+	char utf8code[] = "var varö";
+	struct TokenArray tokens;
+	buttert(token_ize(testinterp, utf8code, strlen(utf8code), &tokens));
+	buttert(tokens.len == 2);
+	struct Token *curtok = tokens.tokens;
+	curtok = check_token(curtok, TOKEN_KEYWORD, "var", 1);
+	curtok = check_token(curtok, TOKEN_ID, "varö", 1);
+	buttert(curtok->kind == TOKEN_END);
+	tokenarray_free(tokens);
 
-	token_freeall(tok1st);
+	// invalid utf8 is an error everywhere, including comments
+	char badcode[] = "print 1; # \xff\n";
+	buttert(!token_ize(testinterp, badcode, strlen(badcode), &tokens));
+	buttert(testinterp->err);
+	OBJECT_DECREF(testinterp, testinterp->err);
+	testinterp->err = NULL;
 }
@@ -39,3 +39,124 @@ void test_copying(void)
 	free(c->val);
 	free(c);
 }
+
+// long enough for the simd code in utf8.c, with non-ascii at different places in the simd blocks
+void test_utf8_long_strings(void)
+{
+	char *pieces[] = { "ö", "日", "\xf0\x9d\x84\x9e" };   // the last one is a 4-byte musical symbol
+	char utf8[2000];
+	size_t utf8len = 0;
+	size_t npieces = 0;
+	for (int i=0; utf8len < sizeof(utf8) - 100; i++) {
+		for (int j=0; j < i % 40; j++)
+			utf8[utf8len++] = 'a' + j%26;
+		strcpy(utf8 + utf8len, pieces[i%3]);
+		utf8len += strlen(pieces[i%3]);
+		npieces++;
+	}
+
+	struct UnicodeString u;
+	buttert(utf8_decode(testinterp, utf8, utf8len, &u));
+	char *back;
+	size_t backlen;
+	buttert(utf8_encode(testinterp, u, &back, &backlen));
+	buttert(backlen == utf8len);
+	buttert(memcmp(back, utf8, utf8len) == 0);
+	free(back);
+
+	// every piece is 1 character
+	size_t nonascii = 0;
+	for (size_t i=0; i < u.len; i++) {
+		if (u.val[i] >= 0x80)
+			nonascii++;
+		else
+			buttert('a' <= u.val[i] && u.val[i] <= 'z');
+	}
+	buttert(nonascii == npieces);
+	free(u.val);
+
+	// an error at the end of a long ascii run must not be missed
+	memset(utf8, 'x', 100);
+	utf8[99] = (char)0xff;
+	buttert(!utf8_decode(testinterp, utf8, 100, &u));
+	buttert(testinterp->err);
+	OBJECT_DECREF(testinterp, testinterp->err);
+	testinterp->err = NULL;
+}
+
+// decodes one character at a time, without the simd code that utf8_decode() may use
+static bool decode_slowly(char *utf8, size_t utf8len, struct UnicodeString *u)
+{
+	u->len = 0;
+	while (utf8len > 0) {
+		int n = utf8_decodechar(testinterp, utf8, utf8len, &u->val[u->len]);
+		if (n == -1) {
+			OBJECT_DECREF(testinterp, testinterp->err);
+			testinterp->err = NULL;
+			return false;
+		}
+		u->len++;
+		utf8 += n;
+		utf8len -= n;
+	}
+	return true;
+}
+
+// utf8_decode() may check everything with simd before decoding, it must agree with utf8_decodechar()
+void test_utf8_validation(void)
+{
+	// valid characters of each length, and bytes that are interesting for the checks
+	char *pieces[] = { "a", "\x7f", "ö", "\xdf\xbf", "日", "\xe0\xa0\x80", "\xed\x9f\xbf", "\xef\xbf\xbf",
+		"\xf0\x90\x80\x80", "\xf4\x8f\xbf\xbf" };
+	unsigned char bytes[] = { 0x00, 0x80, 0x8f, 0x90, 0x9f, 0xa0, 0xbf, 0xc0, 0xc1, 0xc2, 0xdf, 0xe0, 0xe1,
+		0xed, 0xef, 0xf0, 0xf1, 0xf4, 0xf5, 0xf8, 0xff };
+	// overlong, surrogate and too big, these have nothing else wrong with them
+	char *badpieces[] = { "\xc1\xbf", "\xe0\x9f\xbf", "\xed\xa0\x80", "\xed\xbf\xbf", "\xf0\x8f\xbf\xbf",
+		"\xf4\x90\x80\x80", "\xf5\x80\x80\x80" };
+	char utf8[200];
+	unicode_char slowval[200];
+	unsigned long rng = 1;
+	int nvalid = 0, ninvalid = 0;
+
+	for (int iter = 0; iter < 20000; iter++) {
+		size_t utf8len = 0;
+		size_t target = 32 + iter % 100;
+		while (utf8len < target) {
+			rng = rng*1103515245 + 12345;
+			unsigned long r = (rng >> 16) % 1000;
+			// mostly valid, with sometimes a random byte or a bad character anywhere in a simd block
+			if (r < 6)
+				utf8[utf8len++] = (char)bytes[(rng >> 8) % sizeof(bytes)];
+			else if (r < 9) {
+				char *p = badpieces[(rng >> 8) % (sizeof(badpieces)/sizeof(badpieces[0]))];
+				memcpy(utf8 + utf8len, p, strlen(p));
+				utf8len += strlen(p);
+			} else {
+				char *p = pieces[r % (sizeof(pieces)/sizeof(pieces[0]))];
+				memcpy(utf8 + utf8len, p, strlen(p));
+				utf8len += strlen(p);
+			}
+		}
+
+		struct UnicodeString slow = { .val = slowval };
+		bool slowok = decode_slowly(utf8, utf8len, &slow);
+
+		struct UnicodeString u;
+		bool ok = utf8_decode(testinterp, utf8, utf8len, &u);
+		buttert(ok == slowok);
+		if (ok) {
+			buttert(u.len == slow.len);
+			buttert(memcmp(u.val, slow.val, u.len*sizeof(unicode_char)) == 0);
+			free(u.val);
+			nvalid++;
+		} else {
+			buttert(testinterp->err);
+			OBJECT_DECREF(testinterp, testinterp->err);
+			testinterp->err = NULL;
+			ninvalid++;
+		}
+	}
+
+	// make sure that both cases were actually tested
+	buttert(nvalid > 1000 && ninvalid > 1000);
+}
@@ -0,0 +1,88 @@
+// parses an ö file and writes its astcache_dump() to stdout
+// the Makefile uses this for embedding a parsed src/builtins.ö to the interpreter
+// this is linked with a run.c compiled with ASTGEN defined, because the real run.c needs this program's output
+// error handling is assert like in xd.c, except for errors in the ö code
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <src/astcache.h>
+#include <src/builtins.h>
+#include <src/gc.h>
+#include <src/interpreter.h>
+#include <src/objects/array.h>
+#include <src/objects/errors.h>
+#include <src/objectsystem.h>
+#include <src/parse.h>
+#include <src/tokenizer.h>
+
+#define CHUNKSIZE 4096
+
+
+int main(int argc, char **argv)
+{
+	assert(argc == 2);
+	FILE *f = fopen(argv[1], "rb");
+	assert(f);
+
+	char *code = NULL;
+	size_t codelen = 0;
+	size_t allocated = 0;
+	while (!feof(f)) {
+		if (codelen == allocated)
+			assert((code = realloc(code, allocated += CHUNKSIZE)));
+		codelen += fread(code + codelen, 1, allocated - codelen, f);
+		assert(!ferror(f));
+	}
+	fclose(f);
+
+	struct Interpreter *interp = interpreter_new(argv[0]);
+	assert(interp);
+	assert(builtins_setup(interp));
+
+	struct TokenArray tokens;
+	struct Object *statements = NULL;
+	if (!token_ize(interp, code, codelen, &tokens))
+		goto error;
+	assert((statements = arrayobject_newempty(interp)));
+
+	struct Token *curtok = tokens.tokens;
+	while (curtok->kind != TOKEN_END) {
+		struct Object *stmtnode = parse_statement(interp, argv[1], &curtok);
+		if (!stmtnode) {
+			tokenarray_free(tokens);
+			goto error;
+		}
+		assert(arrayobject_push(interp, statements, stmtnode));
+		OBJECT_DECREF(interp, stmtnode);
+	}
+	tokenarray_free(tokens);
+
+	char *data;
+	size_t datalen;
+	struct AstCacheSource src = { .hash = astcache_hash(code, codelen), .size = codelen, .mtime = 0 };
+	assert(astcache_dump(interp, statements, src, &data, &datalen));
+	assert(fwrite(data, 1, datalen, stdout) == datalen);
+	free(data);
+
+	OBJECT_DECREF(interp, statements);
+	builtins_teardown(interp);
+	gc_run(interp);
+	interpreter_free(interp);
+	free(code);
+	return 0;
+
+error:
+	if (statements)
+		OBJECT_DECREF(interp, statements);
+	struct Object *err = interp->err;
+	interp->err = NULL;
+	errorobject_print(interp, err);
+	OBJECT_DECREF(interp, err);
+	builtins_teardown(interp);
+	gc_run(interp);
+	interpreter_free(interp);
+	free(code);
+	return 1;
+}
@@ -0,0 +1,173 @@
+#!/usr/bin/env python3
+"""Find out what keeps objects alive in a heap dump.
+
+Create a heap dump with 'ö --heap-dump-at-exit=PATH' or (runtime.dump_heap PATH),
+and then run this:
+
+    $ python3 misc/heapanalyze.py PATH
+
+The output shows how many bytes each class keeps alive. The retained size of an
+object is the size of everything that would be freed if the object was freed,
+and it's computed with a dominator tree. See src/heapdump.h for the format.
+"""
+
+import argparse
+import collections
+import json
+import sys
+
+
+def load(file):
+    header = json.loads(file.readline())
+    if header.get('heapdump') != 1:
+        sys.exit("%s: not a heap dump file" % file.name)
+
+    objects = [json.loads(line) for line in file if line.strip()]
+    index = {obj['id']: i for i, obj in enumerate(objects)}
+    classnames = {obj['id']: obj['name'] for obj in objects if 'name' in obj}
+    return objects, index, classnames
+
+
+def find_roots(objects, index):
+    # like gc_collect(), references that don't come from other objects come from C code
+    incoming = [0] * len(objects)
+    for obj in objects:
+        for ref in obj['refs']:
+            if ref in index:
+                incoming[index[ref]] += 1
+    return [i for i, obj in enumerate(objects) if obj['refcount'] > incoming[i]]
+
+
+def reverse_postorder(successors, start):
+    order = []
+    visited = {start}
+    stack = [(start, iter(successors[start]))]
+    while stack:
+        node, children = stack[-1]
+        for child in children:
+            if child not in visited:
+                visited.add(child)
+                stack.append((child, iter(successors[child])))
+                break
+        else:
+            stack.pop()
+            order.append(node)
+    order.reverse()
+    return order
+
+
+def dominators(successors, start):
+    """Return (idom, rpo) with the algorithm of Cooper, Harvey and Kennedy.
+
+    idom[node] is None for nodes not reachable from start.
+    """
+    rpo = reverse_postorder(successors, start)
+    number = {node: i for i, node in enumerate(rpo)}
+
+    predecessors = collections.defaultdict(list)
+    for node in rpo:
+        for child in successors[node]:
+            predecessors[child].append(node)
+
+    idom = [None] * len(successors)
+    idom[start] = start
+
+    def intersect(a, b):
+        while a != b:
+            while number[a] > number[b]:
+                a = idom[a]
+            while number[b] > number[a]:
+                b = idom[b]
+        return a
+
+    changed = True
+    while changed:
+        changed = False
+        for node in rpo[1:]:
+            new = None
+            for pred in predecessors[node]:
+                if idom[pred] is not None:
+                    new = pred if new is None else intersect(pred, new)
+            if idom[node] != new:
+                idom[node] = new
+                changed = True
+    return idom, rpo
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('dumpfile', type=argparse.FileType('r', encoding='utf-8'))
+    parser.add_argument('--top', type=int, default=10, metavar='N',
+                        help="also show the N objects that retain the most (default: %(default)s)")
+    args = parser.parse_args()
+
+    with args.dumpfile:
+        objects, index, classnames = load(args.dumpfile)
+
+    def class_of(i):
+        return classnames.get(objects[i]['class'], '?') if i < len(objects) else '<roots>'
+
+    # the last node is a fake root that refers to all the real roots
+    fakeroot = len(objects)
+    successors = [[index[ref] for ref in obj['refs'] if ref in index] for obj in objects]
+    successors.append(find_roots(objects, index))
+    idom, rpo = dominators(successors, fakeroot)
+
+    # idom[node] is always before node in rpo
+    size = [obj['size'] for obj in objects] + [0]
+    retained = size[:]
+    for node in reversed(rpo[1:]):
+        retained[idom[node]] += retained[node]
+
+    children = collections.defaultdict(list)
+    for node in rpo[1:]:
+        children[idom[node]].append(node)
+
+    # an Array inside an Array must not be counted twice for Array
+    # so only objects that aren't dominated by another object of the same class are counted for the class
+    count = collections.Counter()
+    shallow = collections.Counter()
+    retained_by_class = collections.Counter()
+    on_path = collections.Counter()
+    stack = [(fakeroot, False)]
+    while stack:
+        node, leaving = stack.pop()
+        name = class_of(node)
+        if leaving:
+            on_path[name] -= 1
+            continue
+        if node != fakeroot:
+            count[name] += 1
+            shallow[name] += size[node]
+            if on_path[name] == 0:
+                retained_by_class[name] += retained[node]
+        on_path[name] += 1
+        stack.append((node, True))
+        stack.extend((child, False) for child in children[node])
+
+    print("%d objects, %d bytes reachable, %d roots" % (
+        len(objects), retained[fakeroot], len(successors[fakeroot])))
+    print()
+    print("%10s %12s %12s  %s" % ("count", "shallow", "retained", "class"))
+    for name, value in retained_by_class.most_common():
+        print("%10d %12d %12d  %s" % (count[name], shallow[name], value, name))
+
+    if args.top > 0:
+        print()
+        print("%12s  %s" % ("retained", "object"))
+        biggest = sorted(rpo[1:], key=retained.__getitem__, reverse=True)[:args.top]
+        for node in biggest:
+            print("%12d  %s %s" % (retained[node], class_of(node), objects[node]['id']))
+
+    # cycles that nothing outside them refers to, gc_collect() would free these
+    unreachable = [i for i in range(len(objects)) if idom[i] is None]
+    if unreachable:
+        print()
+        print("%d objects (%d bytes) are not reachable from any root:" % (
+            len(unreachable), sum(size[i] for i in unreachable)))
+        for name, n in collections.Counter(map(class_of, unreachable)).most_common():
+            print("%10d  %s" % (n, name))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,86 @@
+/* compile and run like this (in project root):
+
+      $ make misc-compiled/utf8_speedtest && misc-compiled/utf8_speedtest
+
+this measures how fast utf8_decode() and utf8_encode() are with different kinds of text
+the results are in gigabytes of utf8 per second
+*/
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>   // posix only, and gettimeofday is "obsolete" according to my man page :(
+#include <src/interpreter.h>
+#include <src/unicode.h>
+#include <src/utf8.h>
+
+#define CORPUS_SIZE (16*1000*1000)
+#define NTIMES 20
+
+struct Corpus {
+	char *name;
+	char *sample;    // repeated until the corpus is big enough
+};
+
+static struct Corpus corpora[] = {
+	{ "ascii", "The quick brown fox jumps over the lazy dog. print \"hello world\";\n" },
+	{ "finnish", "Hyvää päivää! Tämä lause on kirjoitettu suomeksi, ja siinä on ääkkösiä. Öljyä ja säätä.\n" },
+	{ "cjk", "我能吞下玻璃而不伤身体。私はガラスを食べられます。それは私を傷つけません。\n" },
+};
+
+static unsigned long microseconds_since(struct timeval start)
+{
+	struct timeval end;
+	gettimeofday(&end, NULL);
+	return (end.tv_sec - start.tv_sec)*1000*1000 + (end.tv_usec - start.tv_usec);
+}
+
+static void print_speed(char *what, size_t nbytes, unsigned long usec)
+{
+	// bytes per microsecond is megabytes per second
+	printf("  %-8s %6.2f GB/s\n", what, (double)nbytes * NTIMES / usec / 1000.0);
+}
+
+int main(int argc, char **argv)
+{
+	struct Interpreter *interp = interpreter_new(argv[0]);
+	assert(interp);
+
+	char *utf8 = malloc(CORPUS_SIZE);
+	assert(utf8);
+
+	for (size_t c = 0; c < sizeof(corpora)/sizeof(corpora[0]); c++) {
+		size_t samplelen = strlen(corpora[c].sample);
+		size_t utf8len = 0;
+		while (utf8len + samplelen <= CORPUS_SIZE) {
+			memcpy(utf8 + utf8len, corpora[c].sample, samplelen);
+			utf8len += samplelen;
+		}
+		printf("%s (%zu bytes):\n", corpora[c].name, utf8len);
+
+		struct UnicodeString u;
+		struct timeval start;
+		gettimeofday(&start, NULL);
+		for (int i=0; i < NTIMES; i++) {
+			assert(utf8_decode(interp, utf8, utf8len, &u));
+			if (i != NTIMES-1)
+				free(u.val);
+		}
+		print_speed("decode", utf8len, microseconds_since(start));
+
+		char *back;
+		size_t backlen;
+		gettimeofday(&start, NULL);
+		for (int i=0; i < NTIMES; i++) {
+			assert(utf8_encode(interp, u, &back, &backlen));
+			free(back);
+		}
+		print_speed("encode", utf8len, microseconds_since(start));
+		free(u.val);
+	}
+
+	free(utf8);
+	interpreter_free(interp);
+	return 0;
+}
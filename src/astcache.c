@@ -0,0 +1,673 @@
+/* the format, all fixed-size numbers are little-endian:
+
+	magic           "\xc3\x96" "ast", i.e. "Öast" in utf8
+	version         4 bytes, ASTCACHE_VERSION
+	source hash     8 bytes
+	source size     8 bytes
+	source mtime    8 bytes, signed
+	nstrings        varint
+	strings         nstrings times: length as varint, then that many code points as varints
+	nstatements     varint
+	statements      nstatements nodes
+
+a varint is 7 bits per byte with the highest bit set in all bytes except the last (LEB128)
+a node is the kind character, lineno as a varint and then the kind's info:
+
+	AST_INT         the value, 8 bytes, signed
+	AST_STR         string index
+	AST_ARRAY       number of nodes, nodes
+	AST_BLOCK       number of nodes, nodes
+	AST_GETVAR      string index
+	AST_GETATTR     objnode, string index
+	AST_CREATEVAR   string index, valnode
+	AST_SETVAR      string index, valnode
+	AST_SETATTR     objnode, string index, valnode
+	AST_CALL        funcnode, number of args, args, number of opts, opts as (string index, node) pairs
+	AST_OPCALL      operator as one byte, lhs, rhs
+
+all strings (variable names, attribute names, string literals etc) are in the string table once
+and the nodes refer to them by index, so loading creates one String object per distinct string
+*/
+
+#include "astcache.h"
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "interpreter.h"
+#include "objects/array.h"
+#include "objects/astnode.h"
+#include "objects/errors.h"
+#include "objects/integer.h"
+#include "objects/mapping.h"
+#include "objects/string.h"
+#include "objectsystem.h"
+#include "operator.h"
+#include "unicode.h"
+
+#define MAGIC "\xc3\x96" "ast"
+#define MAGIC_LEN (sizeof(MAGIC) - 1)
+#define HEADER_LEN (MAGIC_LEN + 4 + 8 + 8 + 8)
+
+
+uint64_t astcache_hash(const char *data, size_t len)
+{
+	uint64_t hash = UINT64_C(14695981039346656037);
+	for (size_t i=0; i < len; i++) {
+		hash ^= (unsigned char)data[i];
+		hash *= UINT64_C(1099511628211);
+	}
+	return hash;
+}
+
+
+struct Buffer {
+	unsigned char *val;
+	size_t len;
+	size_t nallocated;
+};
+
+static bool buffer_add(struct Interpreter *interp, struct Buffer *buf, const void *data, size_t len)
+{
+	if (len == 0)    // data may be NULL
+		return true;
+
+	if (buf->len + len > buf->nallocated) {
+		size_t newsize = buf->nallocated ? buf->nallocated : 1024;
+		while (buf->len + len > newsize)
+			newsize *= 2;
+
+		unsigned char *ptr = realloc(buf->val, newsize);
+		if (!ptr) {
+			errorobject_thrownomem(interp);
+			return false;
+		}
+		buf->val = ptr;
+		buf->nallocated = newsize;
+	}
+
+	memcpy(buf->val + buf->len, data, len);
+	buf->len += len;
+	return true;
+}
+
+static bool buffer_addfixed(struct Interpreter *interp, struct Buffer *buf, uint64_t val, size_t nbytes)
+{
+	unsigned char bytes[8];
+	assert(nbytes <= sizeof(bytes));
+	for (size_t i=0; i < nbytes; i++)
+		bytes[i] = (unsigned char)(val >> (8*i));
+	return buffer_add(interp, buf, bytes, nbytes);
+}
+
+static bool buffer_addvarint(struct Interpreter *interp, struct Buffer *buf, uint64_t val)
+{
+	unsigned char bytes[10];    // ceil(64/7) = 10
+	size_t n = 0;
+	do {
+		bytes[n] = val & 0x7f;
+		val >>= 7;
+		if (val)
+			bytes[n] |= 0x80;
+		n++;
+	} while (val);
+	return buffer_add(interp, buf, bytes, n);
+}
+
+
+struct Dumper {
+	struct Interpreter *interp;
+	struct Buffer nodes;
+	struct Buffer strings;
+	struct Object *stringindexes;   // Mapping from Strings to Integers
+	size_t nstrings;
+};
+
+static bool dump_string(struct Dumper *d, struct Object *s)
+{
+	struct Object *indexobj;
+	int status = mappingobject_get(d->interp, d->stringindexes, s, &indexobj);
+	if (status == -1)
+		return false;
+	if (status == 1) {
+		long long index = integerobject_tolonglong(indexobj);
+		OBJECT_DECREF(d->interp, indexobj);
+		return buffer_addvarint(d->interp, &d->nodes, (uint64_t)index);
+	}
+
+	// not seen yet, add to the string table
+	if (!(indexobj = integerobject_newfromlonglong(d->interp, (long long)d->nstrings)))
+		return false;
+	bool ok = mappingobject_set(d->interp, d->stringindexes, s, indexobj);
+	OBJECT_DECREF(d->interp, indexobj);
+	if (!ok)
+		return false;
+
+	if (!buffer_addvarint(d->interp, &d->strings, STRINGOBJECT_LEN(s)))
+		return false;
+	for (size_t i=0; i < STRINGOBJECT_LEN(s); i++) {
+		if (!buffer_addvarint(d->interp, &d->strings, STRINGOBJECT_GET(s, i)))
+			return false;
+	}
+
+	return buffer_addvarint(d->interp, &d->nodes, d->nstrings++);
+}
+
+static bool dump_node(struct Dumper *d, struct Object *node);
+
+static bool dump_nodearray(struct Dumper *d, struct Object *arr)
+{
+	if (!buffer_addvarint(d->interp, &d->nodes, ARRAYOBJECT_LEN(arr)))
+		return false;
+	for (size_t i=0; i < ARRAYOBJECT_LEN(arr); i++) {
+		if (!dump_node(d, ARRAYOBJECT_GET(arr, i)))
+			return false;
+	}
+	return true;
+}
+
+static bool dump_node(struct Dumper *d, struct Object *node)
+{
+	struct AstNodeObjectData *data = node->objdata.data;
+	unsigned char kind = (unsigned char)data->kind;
+	if (!buffer_add(d->interp, &d->nodes, &kind, 1) ||
+		!buffer_addvarint(d->interp, &d->nodes, data->lineno))
+		return false;
+
+	switch (data->kind) {
+#define info_as(X) ((struct X *) data->info)
+	case AST_INT:
+		return buffer_addfixed(d->interp, &d->nodes, (uint64_t)integerobject_tolonglong(info_as(AstIntOrStrInfo)), 8);
+	case AST_STR:
+		return dump_string(d, info_as(AstIntOrStrInfo));
+	case AST_ARRAY:
+	case AST_BLOCK:
+		return dump_nodearray(d, info_as(AstArrayOrBlockInfo));
+	case AST_GETVAR:
+		return dump_string(d, info_as(AstGetVarInfo)->varname);
+	case AST_GETATTR:
+		return dump_node(d, info_as(AstGetAttrInfo)->objnode) &&
+			dump_string(d, info_as(AstGetAttrInfo)->name);
+	case AST_CREATEVAR:
+	case AST_SETVAR:
+		return dump_string(d, info_as(AstCreateOrSetVarInfo)->varname) &&
+			dump_node(d, info_as(AstCreateOrSetVarInfo)->valnode);
+	case AST_SETATTR:
+		return dump_node(d, info_as(AstSetAttrInfo)->objnode) &&
+			dump_string(d, info_as(AstSetAttrInfo)->attr) &&
+			dump_node(d, info_as(AstSetAttrInfo)->valnode);
+	case AST_CALL:
+	{
+		if (!dump_node(d, info_as(AstCallInfo)->funcnode) ||
+			!dump_nodearray(d, info_as(AstCallInfo)->args) ||
+			!buffer_addvarint(d->interp, &d->nodes, MAPPINGOBJECT_SIZE(info_as(AstCallInfo)->opts)))
+			return false;
+
+		struct MappingObjectIter iter;
+		mappingobject_iterbegin(&iter, info_as(AstCallInfo)->opts);
+		while (mappingobject_iternext(&iter)) {
+			if (!dump_string(d, iter.key) || !dump_node(d, iter.value))
+				return false;
+		}
+		return true;
+	}
+	case AST_OPCALL:
+	{
+		unsigned char op = (unsigned char)info_as(AstOpCallInfo)->op;
+		return buffer_add(d->interp, &d->nodes, &op, 1) &&
+			dump_node(d, info_as(AstOpCallInfo)->lhs) &&
+			dump_node(d, info_as(AstOpCallInfo)->rhs);
+	}
+#undef info_as
+	default:
+		assert(0);    // unknown kind
+		return false;
+	}
+}
+
+bool astcache_dump(struct Interpreter *interp, struct Object *statements, struct AstCacheSource src, char **res, size_t *reslen)
+{
+	struct Dumper d = { .interp = interp, .nodes = {0}, .strings = {0}, .nstrings = 0 };
+	if (!(d.stringindexes = mappingobject_newempty(interp)))
+		return false;
+
+	struct Buffer out = {0};
+	bool ok = dump_nodearray(&d, statements) &&
+		buffer_add(interp, &out, MAGIC, MAGIC_LEN) &&
+		buffer_addfixed(interp, &out, ASTCACHE_VERSION, 4) &&
+		buffer_addfixed(interp, &out, src.hash, 8) &&
+		buffer_addfixed(interp, &out, src.size, 8) &&
+		buffer_addfixed(interp, &out, (uint64_t)src.mtime, 8) &&
+		buffer_addvarint(interp, &out, d.nstrings) &&
+		buffer_add(interp, &out, d.strings.val, d.strings.len) &&
+		buffer_add(interp, &out, d.nodes.val, d.nodes.len);
+
+	OBJECT_DECREF(interp, d.stringindexes);
+	free(d.strings.val);
+	free(d.nodes.val);
+	if (!ok) {
+		free(out.val);
+		return false;
+	}
+
+	*res = (char *)out.val;
+	*reslen = out.len;
+	return true;
+}
+
+
+struct Loader {
+	struct Interpreter *interp;
+	const unsigned char *ptr;
+	const unsigned char *end;
+	char *filename;
+	struct Object **strings;
+	size_t nstrings;
+	bool invalid;     // true if a node returned NULL because of bad data instead of an error
+};
+
+static bool read_fixed(struct Loader *l, size_t nbytes, uint64_t *res)
+{
+	if ((size_t)(l->end - l->ptr) < nbytes) {
+		l->invalid = true;
+		return false;
+	}
+	*res = 0;
+	for (size_t i=0; i < nbytes; i++)
+		*res |= (uint64_t)l->ptr[i] << (8*i);
+	l->ptr += nbytes;
+	return true;
+}
+
+static bool read_varint(struct Loader *l, uint64_t *res)
+{
+	*res = 0;
+	for (unsigned int shift = 0; shift < 64; shift += 7) {
+		if (l->ptr == l->end)
+			break;
+		unsigned char byte = *l->ptr++;
+		*res |= (uint64_t)(byte & 0x7f) << shift;
+		if (!(byte & 0x80))
+			return true;
+	}
+	l->invalid = true;
+	return false;
+}
+
+// counts are checked against the amount of data left, so that bad data can't make this allocate a lot
+static bool read_count(struct Loader *l, size_t *res)
+{
+	uint64_t val;
+	if (!read_varint(l, &val))
+		return false;
+	if (val > (uint64_t)(l->end - l->ptr)) {
+		l->invalid = true;
+		return false;
+	}
+	*res = (size_t)val;
+	return true;
+}
+
+// returns a borrowed reference
+static struct Object *read_string(struct Loader *l)
+{
+	uint64_t index;
+	if (!read_varint(l, &index))
+		return NULL;
+	if (index >= l->nstrings) {
+		l->invalid = true;
+		return NULL;
+	}
+	return l->strings[index];
+}
+
+static bool load_strings(struct Loader *l)
+{
+	size_t n;
+	if (!read_count(l, &n))
+		return false;
+	if (n == 0)
+		return true;
+
+	if (!(l->strings = malloc(n * sizeof(struct Object*)))) {
+		errorobject_thrownomem(l->interp);
+		return false;
+	}
+
+	for ( ; l->nstrings < n; l->nstrings++) {
+		struct UnicodeString ustr;
+		if (!read_count(l, &ustr.len))
+			return false;
+
+		// malloc(0) may return NULL
+		if (!(ustr.val = malloc(ustr.len ? ustr.len*sizeof(unicode_char) : 1))) {
+			errorobject_thrownomem(l->interp);
+			return false;
+		}
+		for (size_t i=0; i < ustr.len; i++) {
+			uint64_t c;
+			if (!read_varint(l, &c) || c > 0x10ffff) {
+				l->invalid = true;
+				free(ustr.val);
+				return false;
+			}
+			ustr.val[i] = (unicode_char)c;
+		}
+
+		if (!(l->strings[l->nstrings] = stringobject_newfromustr(l->interp, ustr)))
+			return false;
+	}
+	return true;
+}
+
+static struct Object *load_node(struct Loader *l);
+
+// RETURNS A NEW REFERENCE
+static struct Object *load_nodearray(struct Loader *l)
+{
+	size_t n;
+	if (!read_count(l, &n))
+		return NULL;
+
+	struct Object *arr = arrayobject_newwithcapacity(l->interp, n);
+	if (!arr)
+		return NULL;
+
+	for (size_t i=0; i < n; i++) {
+		struct Object *node = load_node(l);
+		if (!node) {
+			OBJECT_DECREF(l->interp, arr);
+			return NULL;
+		}
+		bool ok = arrayobject_push(l->interp, arr, node);
+		OBJECT_DECREF(l->interp, node);
+		if (!ok) {
+			OBJECT_DECREF(l->interp, arr);
+			return NULL;
+		}
+	}
+	return arr;
+}
+
+// like read_string, but returns a new reference
+static struct Object *read_string_newref(struct Loader *l)
+{
+	struct Object *s = read_string(l);
+	if (s)
+		OBJECT_INCREF(l->interp, s);
+	return s;
+}
+
+// returns info for a node of the given kind, or NULL
+static void *load_info(struct Loader *l, char kind)
+{
+	switch (kind) {
+	case AST_INT:
+	{
+		uint64_t val;
+		if (!read_fixed(l, 8, &val))
+			return NULL;
+		// the cast is implementation-defined for big values, but it's the same thing that dumping did
+		return integerobject_newfromlonglong(l->interp, (long long)val);
+	}
+	case AST_STR:
+		return read_string_newref(l);
+	case AST_ARRAY:
+	case AST_BLOCK:
+		return load_nodearray(l);
+	case AST_GETVAR:
+	{
+		struct AstGetVarInfo *info = malloc(sizeof(*info));
+		if (!info) {
+			errorobject_thrownomem(l->interp);
+			return NULL;
+		}
+		if (!(info->varname = read_string_newref(l))) {
+			free(info);
+			return NULL;
+		}
+		return info;
+	}
+	case AST_GETATTR:
+	{
+		struct AstGetAttrInfo *info = malloc(sizeof(*info));
+		if (!info) {
+			errorobject_thrownomem(l->interp);
+			return NULL;
+		}
+		if (!(info->objnode = load_node(l))) {
+			free(info);
+			return NULL;
+		}
+		if (!(info->name = read_string_newref(l))) {
+			OBJECT_DECREF(l->interp, info->objnode);
+			free(info);
+			return NULL;
+		}
+		return info;
+	}
+	case AST_CREATEVAR:
+	case AST_SETVAR:
+	{
+		struct AstCreateOrSetVarInfo *info = malloc(sizeof(*info));
+		if (!info) {
+			errorobject_thrownomem(l->interp);
+			return NULL;
+		}
+		if (!(info->varname = read_string_newref(l))) {
+			free(info);
+			return NULL;
+		}
+		if (!(info->valnode = load_node(l))) {
+			OBJECT_DECREF(l->interp, info->varname);
+			free(info);
+			return NULL;
+		}
+		return info;
+	}
+	case AST_SETATTR:
+	{
+		struct AstSetAttrInfo *info = malloc(sizeof(*info));
+		if (!info) {
+			errorobject_thrownomem(l->interp);
+			return NULL;
+		}
+		if (!(info->objnode = load_node(l))) {
+			free(info);
+			return NULL;
+		}
+		if (!(info->attr = read_string_newref(l))) {
+			OBJECT_DECREF(l->interp, info->objnode);
+			free(info);
+			return NULL;
+		}
+		if (!(info->valnode = load_node(l))) {
+			OBJECT_DECREF(l->interp, info->attr);
+			OBJECT_DECREF(l->interp, info->objnode);
+			free(info);
+			return NULL;
+		}
+		return info;
+	}
+	case AST_CALL:
+	{
+		struct AstCallInfo *info = malloc(sizeof(*info));
+		if (!info) {
+			errorobject_thrownomem(l->interp);
+			return NULL;
+		}
+		if (!(info->funcnode = load_node(l)))
+			goto callerror1;
+		if (!(info->args = load_nodearray(l)))
+			goto callerror2;
+		if (!(info->opts = mappingobject_newempty(l->interp)))
+			goto callerror3;
+
+		size_t nopts;
+		if (!read_count(l, &nopts))
+			goto callerror4;
+		for (size_t i=0; i < nopts; i++) {
+			struct Object *name = read_string(l);
+			if (!name)
+				goto callerror4;
+			struct Object *valnode = load_node(l);
+			if (!valnode)
+				goto callerror4;
+			bool ok = mappingobject_set(l->interp, info->opts, name, valnode);
+			OBJECT_DECREF(l->interp, valnode);
+			if (!ok)
+				goto callerror4;
+		}
+		return info;
+
+	callerror4:
+		OBJECT_DECREF(l->interp, info->opts);
+	callerror3:
+		OBJECT_DECREF(l->interp, info->args);
+	callerror2:
+		OBJECT_DECREF(l->interp, info->funcnode);
+	callerror1:
+		free(info);
+		return NULL;
+	}
+	case AST_OPCALL:
+	{
+		uint64_t op;
+		if (!read_fixed(l, 1, &op))
+			return NULL;
+		if (op > OPERATOR_LE) {
+			l->invalid = true;
+			return NULL;
+		}
+
+		struct AstOpCallInfo *info = malloc(sizeof(*info));
+		if (!info) {
+			errorobject_thrownomem(l->interp);
+			return NULL;
+		}
+		info->op = (enum Operator)op;
+		if (!(info->lhs = load_node(l))) {
+			free(info);
+			return NULL;
+		}
+		if (!(info->rhs = load_node(l))) {
+			OBJECT_DECREF(l->interp, info->lhs);
+			free(info);
+			return NULL;
+		}
+		return info;
+	}
+	default:
+		l->invalid = true;
+		return NULL;
+	}
+}
+
+// frees an info returned by load_info(), for when creating the node fails
+static void free_info(struct Interpreter *interp, char kind, void *info)
+{
+	switch (kind) {
+#define info_as(X) ((struct X *) info)
+	case AST_INT:
+	case AST_STR:
+	case AST_ARRAY:
+	case AST_BLOCK:
+		OBJECT_DECREF(interp, (struct Object *)info);
+		return;
+	case AST_GETVAR:
+		OBJECT_DECREF(interp, info_as(AstGetVarInfo)->varname);
+		break;
+	case AST_GETATTR:
+		OBJECT_DECREF(interp, info_as(AstGetAttrInfo)->objnode);
+		OBJECT_DECREF(interp, info_as(AstGetAttrInfo)->name);
+		break;
+	case AST_CREATEVAR:
+	case AST_SETVAR:
+		OBJECT_DECREF(interp, info_as(AstCreateOrSetVarInfo)->varname);
+		OBJECT_DECREF(interp, info_as(AstCreateOrSetVarInfo)->valnode);
+		break;
+	case AST_SETATTR:
+		OBJECT_DECREF(interp, info_as(AstSetAttrInfo)->objnode);
+		OBJECT_DECREF(interp, info_as(AstSetAttrInfo)->attr);
+		OBJECT_DECREF(interp, info_as(AstSetAttrInfo)->valnode);
+		break;
+	case AST_CALL:
+		OBJECT_DECREF(interp, info_as(AstCallInfo)->funcnode);
+		OBJECT_DECREF(interp, info_as(AstCallInfo)->args);
+		OBJECT_DECREF(interp, info_as(AstCallInfo)->opts);
+		break;
+	case AST_OPCALL:
+		OBJECT_DECREF(interp, info_as(AstOpCallInfo)->lhs);
+		OBJECT_DECREF(interp, info_as(AstOpCallInfo)->rhs);
+		break;
+#undef info_as
+	default:
+		assert(0);
+	}
+	free(info);
+}
+
+// RETURNS A NEW REFERENCE
+static struct Object *load_node(struct Loader *l)
+{
+	uint64_t kind, lineno;
+	if (!read_fixed(l, 1, &kind) || !read_varint(l, &lineno))
+		return NULL;
+
+	void *info = load_info(l, (char)kind);
+	if (!info)
+		return NULL;
+
+	struct Object *node = astnodeobject_new(l->interp, (char)kind, l->filename, (size_t)lineno, info);
+	if (!node)
+		free_info(l->interp, (char)kind, info);
+	return node;
+}
+
+int astcache_load(struct Interpreter *interp, const char *data, size_t len, const struct AstCacheSource *src, char *filename, struct Object **statements)
+{
+	struct Loader l = {
+		.interp = interp,
+		.ptr = (const unsigned char *)data,
+		.end = (const unsigned char *)data + len,
+		.filename = filename,
+		.strings = NULL,
+		.nstrings = 0,
+		.invalid = false,
+	};
+
+	if (len < HEADER_LEN || memcmp(data, MAGIC, MAGIC_LEN) != 0)
+		return -1;
+	l.ptr += MAGIC_LEN;
+
+	uint64_t version, hash, size, mtime;
+	read_fixed(&l, 4, &version);
+	read_fixed(&l, 8, &hash);
+	read_fixed(&l, 8, &size);
+	read_fixed(&l, 8, &mtime);
+	if (version != ASTCACHE_VERSION)
+		return -1;
+	if (src && (hash != src->hash || size != src->size || mtime != (uint64_t)src->mtime))
+		return -1;
+
+	int status;
+	struct Object *res = NULL;
+	if (load_strings(&l) && (res = load_nodearray(&l))) {
+		if (l.ptr == l.end) {
+			*statements = res;
+			status = 1;
+		} else {
+			OBJECT_DECREF(interp, res);     // garbage at end
+			status = -1;
+		}
+	} else {
+		status = l.invalid ? -1 : 0;
+	}
+
+	for (size_t i=0; i < l.nstrings; i++)
+		OBJECT_DECREF(interp, l.strings[i]);
+	free(l.strings);
+	return status;
+}
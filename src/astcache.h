@@ -0,0 +1,42 @@
+// binary serialization of parsed code, so that files don't need to be tokenized and parsed every time
+#ifndef ASTCACHE_H
+#define ASTCACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "interpreter.h"     // IWYU pragma: keep
+#include "objectsystem.h"    // IWYU pragma: keep
+
+// bump this whenever the format or the meaning of any ast node changes
+// there's no other interpreter version number, so this is also what invalidates caches from older interpreters
+#define ASTCACHE_VERSION 1
+
+// describes the source code that the cache was created from
+// a cache is used only if everything in this matches the current source file
+struct AstCacheSource {
+	uint64_t hash;    // from astcache_hash()
+	uint64_t size;    // in bytes
+	int64_t mtime;    // st_mtime of the file, or 0 if the code didn't come from a file
+};
+
+// 64-bit FNV-1a, never fails
+uint64_t astcache_hash(const char *data, size_t len);
+
+// statements must be an Array of AstNodes, e.g. from parsing a file
+// on success, *res is set to a buffer that must be free()'d
+// throws an error and returns false on failure
+bool astcache_dump(struct Interpreter *interp, struct Object *statements, struct AstCacheSource src, char **res, size_t *reslen);
+
+/* creates an Array of AstNodes from data that came from astcache_dump()
+filename is used for the nodes, just like when parsing
+if src is not NULL, the data must have been dumped with the same src
+
+return values:
+	1	success, *statements is set to a new reference
+	0	an error has been thrown
+	-1	data is not a valid cache for src (wrong version, corrupted, stale etc), nothing was thrown
+*/
+int astcache_load(struct Interpreter *interp, const char *data, size_t len, const struct AstCacheSource *src, char *filename, struct Object **statements);
+
+#endif    // ASTCACHE_H
@@ -14,6 +14,9 @@ example:
 	// var will be 0 after all calls
 
 these functions return the new value of var
+
+ATOMIC_SIGNAL_FENCE() makes sure that memory writes before it are done before writes after it,
+as seen by a signal handler running in the same thread (see sampler.c)
 */
 
 #ifndef ATOMICINCRDECR_H
@@ -30,11 +33,13 @@ these functions return the new value of var
 	#if defined(__clang__) || (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7))
 		#define ATOMIC_INCR(var) __atomic_add_fetch(&(var), 1, __ATOMIC_SEQ_CST)
 		#define ATOMIC_DECR(var) __atomic_sub_fetch(&(var), 1, __ATOMIC_SEQ_CST)
+		#define ATOMIC_SIGNAL_FENCE() __atomic_signal_fence(__ATOMIC_SEQ_CST)
 	#else
 		// older gcc's have __sync builtins
 		// https://gcc.gnu.org/onlinedocs/gcc-4.7.0/gcc/_005f_005fsync-Builtins.html#g_t_005f_005fsync-Builtins
 		#define ATOMIC_INCR(var) __sync_add_and_fetch(&(var), 1);
 		#define ATOMIC_DECR(var) __sync_sub_and_fetch(&(var), 1);
+		#define ATOMIC_SIGNAL_FENCE() __sync_synchronize()
 	#endif
 // TODO: windows atomics and maybe a really dumb lock fallback
 #else
@@ -3,20 +3,27 @@
 #include <errno.h>
 #include <limits.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include "attribute.h"
 #include "check.h"
+#include "heapdump.h"
 #include "import.h"
 #include "interpreter.h"
 #include "lambdabuiltin.h"
 #include "objectsystem.h"
+#include "parallel.h"
+#include "stats.h"
+#include "threads.h"
+#include "timing.h"
 #include "objects/array.h"
 #include "objects/astnode.h"
 #include "objects/block.h"
 #include "objects/bool.h"
 #include "objects/bytearray.h"
+#include "objects/channel.h"
 #include "objects/classobject.h"
 #include "objects/errors.h"
 #include "objects/file.h"
@@ -29,6 +36,7 @@
 #include "objects/scope.h"
 #include "objects/stackframe.h"
 #include "objects/string.h"
+#include "objects/stringbuilder.h"
 #include "utf8.h"
 
 
@@ -221,10 +229,9 @@ static struct Object *utf8_encode_builtin(struct Interpreter *interp, struct Obj
 	if (!check_args(interp, args, interp->builtins.String, NULL)) return NULL;
 	if (!check_no_opts(interp, opts)) return NULL;
 
-	struct UnicodeString unicode = *(struct UnicodeString*) ARRAYOBJECT_GET(args, 0)->objdata.data;
 	char *utf8;
 	size_t utf8len;
-	if (!utf8_encode(interp, unicode, &utf8, &utf8len))
+	if (!stringobject_toutf8(interp, ARRAYOBJECT_GET(args, 0), &utf8, &utf8len))
 		return NULL;
 
 	// i think the compiler will optimize this on platforms where char is unsigned or signed char pointers cast nicely
@@ -277,6 +284,15 @@ static struct Object *utf8_decode_builtin(struct Interpreter *interp, struct Obj
 	return stringobject_newfromustr(interp, unicode);
 }
 
+static struct Object *utf8_incomplete_tail_builtin(struct Interpreter *interp, struct ObjectData nulldata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, interp->builtins.ByteArray, NULL)) return NULL;
+	if (!check_no_opts(interp, opts)) return NULL;
+
+	struct Object *b = ARRAYOBJECT_GET(args, 0);
+	return integerobject_newfromlonglong(interp, (long long) utf8_incompletelen(BYTEARRAYOBJECT_DATA(b), BYTEARRAYOBJECT_LEN(b)));
+}
+
 // like chr in python
 // TODO: this should be a string method or something like that, but there are no classmethods yet :(
 static struct Object *chr(struct Interpreter *interp, struct ObjectData nulldata, struct Object *args, struct Object *opts)
@@ -319,19 +335,15 @@ static bool print(struct Interpreter *interp, struct ObjectData nulldata, struct
 	if (!check_args(interp, args, interp->builtins.String, NULL)) return NULL;
 	if (!check_no_opts(interp, opts)) return NULL;
 
-	char *utf8;
-	size_t utf8len;
-	if (!utf8_encode(interp, *((struct UnicodeString *) ARRAYOBJECT_GET(args, 0)->objdata.data), &utf8, &utf8len))
-		return false;
-
-	// fwrite in c99: if size or nmemb is zero, fwrite returns zero
+	// this goes to stdout's buffer without a malloc, see io.stdout in std/io.ö for controlling the buffering
 	// errno for fwrite and putchar probably doesn't work on windows because c99 says nothing about it
 	errno = 0;
-	bool ok = utf8len ? fwrite(utf8, utf8len, 1, stdout)>0 : true;
-	free(utf8);
-	if (ok)
-		ok = (putchar('\n') != EOF);
-	if (!ok) {
+	int status = stringobject_writeutf8(interp, ARRAYOBJECT_GET(args, 0), stdout);
+	if (status == 0)
+		return false;
+	if (status == 1 && putchar('\n') == EOF)
+		status = -1;
+	if (status == -1) {
 		if (errno == 0)
 			errorobject_throwfmt(interp, "IoError", "printing failed");
 		else
@@ -399,6 +411,134 @@ static struct Object *new(struct Interpreter *interp, struct ObjectData nulldata
 }
 
 
+// std/runtime.ö hides this
+static struct Object *runtime_stats(struct Interpreter *interp, struct ObjectData nulldata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, NULL)) return NULL;
+	if (!check_no_opts(interp, opts)) return NULL;
+	return stats_tomapping(interp);
+}
+
+// std/runtime.ö hides this too, it's much cheaper than runtime_stats
+static struct Object *runtime_objects_allocated(struct Interpreter *interp, struct ObjectData nulldata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, NULL)) return NULL;
+	if (!check_no_opts(interp, opts)) return NULL;
+	return integerobject_newfromlonglong(interp, (long long)interp->objectsallocated);
+}
+
+// std/runtime.ö hides this too
+static bool runtime_dump_heap(struct Interpreter *interp, struct ObjectData nulldata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, interp->builtins.String, NULL)) return false;
+	if (!check_no_opts(interp, opts)) return false;
+
+	char *utf8;
+	size_t len;
+	if (!stringobject_toutf8(interp, ARRAYOBJECT_GET(args, 0), &utf8, &len))
+		return false;
+
+	// add terminating \0
+	char *path = realloc(utf8, len+1);
+	if (!path) {
+		free(utf8);
+		errorobject_thrownomem(interp);
+		return false;
+	}
+	path[len] = 0;
+
+	bool ok = heapdump_write(interp, path);
+	free(path);
+	return ok;
+}
+
+// std/time.ö hides these
+static struct Object *time_monotonic_ns(struct Interpreter *interp, struct ObjectData nulldata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, NULL)) return NULL;
+	if (!check_no_opts(interp, opts)) return NULL;
+	return integerobject_newfromlonglong(interp, (long long)timing_monotonic_ns());
+}
+
+static struct Object *time_thread_cpu_ns(struct Interpreter *interp, struct ObjectData nulldata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, NULL)) return NULL;
+	if (!check_no_opts(interp, opts)) return NULL;
+
+	uint64_t ns;
+	if (!timing_threadcpu_ns(&ns)) {
+		errorobject_throwfmt(interp, "ValueError", "cpu time of a thread is not supported on this platform");
+		return NULL;
+	}
+	return integerobject_newfromlonglong(interp, (long long)ns);
+}
+
+// sorting and computing things like standard deviation would be slow in ö, and ö doesn't have floats
+static struct Object *time_summarize(struct Interpreter *interp, struct ObjectData nulldata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, interp->builtins.Array, NULL)) return NULL;
+	if (!check_no_opts(interp, opts)) return NULL;
+	struct Object *arr = ARRAYOBJECT_GET(args, 0);
+
+	size_t n = ARRAYOBJECT_LEN(arr);
+	if (n == 0) {
+		errorobject_throwfmt(interp, "ValueError", "cannot summarize an empty array");
+		return NULL;
+	}
+
+	uint64_t *values = malloc(sizeof(uint64_t) * n);
+	if (!values) {
+		errorobject_thrownomem(interp);
+		return NULL;
+	}
+	for (size_t i=0; i < n; i++) {
+		struct Object *val = ARRAYOBJECT_GET(arr, i);
+		if (!check_type(interp, interp->builtins.Integer, val)) {
+			free(values);
+			return NULL;
+		}
+		long long ll = integerobject_tolonglong(val);
+		if (ll < 0) {
+			errorobject_throwfmt(interp, "ValueError", "expected non-negative integers, got %D", val);
+			free(values);
+			return NULL;
+		}
+		values[i] = (uint64_t)ll;
+	}
+
+	struct TimingSummary sum = timing_summarize(values, n);
+	free(values);
+
+	struct Object *res = mappingobject_newempty(interp);
+	if (!res)
+		return NULL;
+
+	struct { char *name; uint64_t val; } items[] = {
+		{ "min", sum.min }, { "max", sum.max }, { "mean", sum.mean },
+		{ "median", sum.median }, { "p99", sum.p99 }, { "stddev", sum.stddev },
+	};
+	for (size_t i=0; i < sizeof(items)/sizeof(items[0]); i++) {
+		struct Object *key = stringobject_newfromcharptr(interp, items[i].name);
+		if (!key)
+			goto error;
+		struct Object *val = integerobject_newfromlonglong(interp, (long long)items[i].val);
+		if (!val) {
+			OBJECT_DECREF(interp, key);
+			goto error;
+		}
+		bool ok = mappingobject_set(interp, res, key, val);
+		OBJECT_DECREF(interp, key);
+		OBJECT_DECREF(interp, val);
+		if (!ok)
+			goto error;
+	}
+	return res;
+
+error:
+	OBJECT_DECREF(interp, res);
+	return NULL;
+}
+
 // every objects may have an attrdata mapping, values of simple attributes go there
 // attrdata is first set to NULL and created when needed
 // see also definition of struct Object
@@ -443,6 +583,17 @@ static bool add_function_noret(struct Interpreter *interp, char *name, functiono
 	return add_function(interp, name, scfunc);
 }
 
+// io.ö deletes these from the built-in scope and wraps them in StringWrappers
+static bool add_std_file(struct Interpreter *interp, char *name, FILE *f)
+{
+	struct Object *file = fileobject_newstd(interp, f);
+	if (!file)
+		return false;
+	bool ok = interpreter_addbuiltin(interp, name, file);
+	OBJECT_DECREF(interp, file);
+	return ok;
+}
+
 bool builtins_setup(struct Interpreter *interp)
 {
 	if (!(interp->builtins.Object = objectobject_createclass_noerr(interp))) goto nomem;
@@ -506,6 +657,9 @@ bool builtins_setup(struct Interpreter *interp)
 	if (!(interp->builtins.ArbitraryAttribs = libraryobject_createaaclass(interp))) goto error;
 	if (!(interp->builtins.Library = libraryobject_createclass(interp))) goto error;
 	if (!(interp->builtins.File = fileobject_createclass(interp))) goto error;
+	if (!(interp->builtins.StringBuilder = stringbuilderobject_createclass(interp))) goto error;
+	if (!(interp->builtins.Channel = channelobject_createclass(interp))) goto error;
+	if (!(interp->builtins.Thread = threadobject_createclass(interp))) goto error;
 
 	if (!(interp->builtinscope = scopeobject_newbuiltin(interp))) goto error;
 
@@ -530,6 +684,7 @@ bool builtins_setup(struct Interpreter *interp)
 	if (!interpreter_addbuiltin(interp, "Block", interp->builtins.Block)) goto error;
 	if (!interpreter_addbuiltin(interp, "Bool", interp->builtins.Bool)) goto error;
 	if (!interpreter_addbuiltin(interp, "ByteArray", interp->builtins.ByteArray)) goto error;
+	if (!interpreter_addbuiltin(interp, "Channel", interp->builtins.Channel)) goto error;
 	if (!interpreter_addbuiltin(interp, "Error", interp->builtins.Error)) goto error;
 	if (!interpreter_addbuiltin(interp, "File", interp->builtins.File)) goto error;
 	if (!interpreter_addbuiltin(interp, "Integer", interp->builtins.Integer)) goto error;
@@ -540,6 +695,8 @@ bool builtins_setup(struct Interpreter *interp)
 	if (!interpreter_addbuiltin(interp, "Option", interp->builtins.Option)) goto error;
 	if (!interpreter_addbuiltin(interp, "Scope", interp->builtins.Scope)) goto error;
 	if (!interpreter_addbuiltin(interp, "String", interp->builtins.String)) goto error;
+	if (!interpreter_addbuiltin(interp, "StringBuilder", interp->builtins.StringBuilder)) goto error;
+	if (!interpreter_addbuiltin(interp, "Thread", interp->builtins.Thread)) goto error;
 	if (!interpreter_addbuiltin(interp, "true", interp->builtins.yes)) goto error;
 	if (!interpreter_addbuiltin(interp, "false", interp->builtins.no)) goto error;
 	if (!interpreter_addbuiltin(interp, "none", interp->builtins.none)) goto error;
@@ -564,7 +721,25 @@ bool builtins_setup(struct Interpreter *interp)
 	if (!add_function_noret(interp, "for", for_)) goto error;
 	if (!add_function_yesret(interp, "utf8_encode", utf8_encode_builtin)) goto error;
 	if (!add_function_yesret(interp, "utf8_decode", utf8_decode_builtin)) goto error;
+	if (!add_function_yesret(interp, "utf8_incomplete_tail", utf8_incomplete_tail_builtin)) goto error;
 	if (!add_function_yesret(interp, "chr", chr)) goto error;
+	if (!add_function_yesret(interp, "map_file", fileobject_mapfile)) goto error;
+	if (!add_function_yesret(interp, "runtime_stats", runtime_stats)) goto error;
+	if (!add_function_noret(interp, "runtime_dump_heap", runtime_dump_heap)) goto error;
+	if (!add_function_yesret(interp, "runtime_objects_allocated", runtime_objects_allocated)) goto error;
+	if (!add_function_yesret(interp, "time_monotonic_ns", time_monotonic_ns)) goto error;
+	if (!add_function_yesret(interp, "time_thread_cpu_ns", time_thread_cpu_ns)) goto error;
+	if (!add_function_yesret(interp, "time_summarize", time_summarize)) goto error;
+	if (!add_function_yesret(interp, "threads_start_block", threads_start_block)) goto error;
+	if (!add_function_yesret(interp, "threads_start_function", threads_start_function)) goto error;
+	if (!add_function_yesret(interp, "threads_start_worker", threads_start_worker)) goto error;
+	if (!add_function_noret(interp, "threads_throw", threads_throw)) goto error;
+	if (!add_function_yesret(interp, "threads_caller_filename", threads_caller_filename)) goto error;
+	if (!add_function_yesret(interp, "parallel_map", parallel_map)) goto error;
+	if (!add_function_yesret(interp, "parallel_cpu_count", parallel_cpu_count)) goto error;
+	if (!add_std_file(interp, "stdin", stdin)) goto error;
+	if (!add_std_file(interp, "stdout", stdout)) goto error;
+	if (!add_std_file(interp, "stderr", stderr)) goto error;
 
 	// compile like this:   $ CFLAGS=-DDEBUG_BUILTINS make clean all
 #ifdef DEBUG_BUILTINS
@@ -576,6 +751,7 @@ bool builtins_setup(struct Interpreter *interp)
 	debug(builtins.Block);
 	debug(builtins.Bool);
 	debug(builtins.ByteArray);
+	debug(builtins.Channel);
 	debug(builtins.Class);
 	debug(builtins.Error);
 	debug(builtins.Function);
@@ -588,6 +764,8 @@ bool builtins_setup(struct Interpreter *interp)
 	debug(builtins.Scope);
 	debug(builtins.StackFrame);
 	debug(builtins.String);
+	debug(builtins.StringBuilder);
+	debug(builtins.Thread);
 	debug(builtins.yes);
 	debug(builtins.no);
 	debug(builtins.none);
@@ -624,6 +802,7 @@ void builtins_teardown(struct Interpreter *interp)
 	TEARDOWN(builtins.Block);
 	TEARDOWN(builtins.Bool);
 	TEARDOWN(builtins.ByteArray);
+	TEARDOWN(builtins.Channel);
 	TEARDOWN(builtins.Class);
 	TEARDOWN(builtins.Error);
 	TEARDOWN(builtins.File);
@@ -637,6 +816,8 @@ void builtins_teardown(struct Interpreter *interp)
 	TEARDOWN(builtins.Scope);
 	TEARDOWN(builtins.StackFrame);
 	TEARDOWN(builtins.String);
+	TEARDOWN(builtins.StringBuilder);
+	TEARDOWN(builtins.Thread);
 	TEARDOWN(builtins.yes);
 	TEARDOWN(builtins.no);
 	TEARDOWN(builtins.none);
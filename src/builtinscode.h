@@ -0,0 +1,595 @@
+0xc3, 0x96, 0x61, 0x73, 0x74, 0x1, 0, 0, 0, 0x9e, 0x24, 0xbf, 0xae, 0x96, 0x3, 
+0xbe, 0x51, 0x9a, 0x3a, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xd3, 0x1, 
+0x5, 0x43, 0x6c, 0x61, 0x73, 0x73, 0x9, 0x67, 0x65, 0x74, 0x5f, 0x63, 0x6c, 
+0x61, 0x73, 0x73, 0x6, 0x53, 0x74, 0x72, 0x69, 0x6e, 0x67, 0x8, 0x41, 0x72, 
+0x67, 0x45, 0x72, 0x72, 0x6f, 0x72, 0x3, 0x6e, 0x65, 0x77, 0x5, 0x45, 0x72, 
+0x72, 0x6f, 0x72, 0xb, 0x41, 0x73, 0x73, 0x65, 0x72, 0x74, 0x45, 0x72, 0x72, 
+0x6f, 0x72, 0xb, 0x41, 0x74, 0x74, 0x72, 0x69, 0x62, 0x45, 0x72, 0x72, 0x6f, 
+0x72, 0x7, 0x49, 0x6f, 0x45, 0x72, 0x72, 0x6f, 0x72, 0x8, 0x4b, 0x65, 0x79, 
+0x45, 0x72, 0x72, 0x6f, 0x72, 0x9, 0x4d, 0x61, 0x74, 0x68, 0x45, 0x72, 0x72, 
+0x6f, 0x72, 0x9, 0x54, 0x79, 0x70, 0x65, 0x45, 0x72, 0x72, 0x6f, 0x72, 0xa, 
+0x56, 0x61, 0x6c, 0x75, 0x65, 0x45, 0x72, 0x72, 0x6f, 0x72, 0xd, 0x56, 0x61, 
+0x72, 0x69, 0x61, 0x62, 0x6c, 0x65, 0x45, 0x72, 0x72, 0x6f, 0x72, 0x6, 0x6c, 
+0x61, 0x6d, 0x62, 0x64, 0x61, 0x3, 0x66, 0x20, 0x78, 0x1, 0x5f, 0x1, 0x66, 0x1, 
+0x78, 0x10, 0x64, 0x65, 0x66, 0x69, 0x6e, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x5f, 
+0x73, 0x63, 0x6f, 0x70, 0x65, 0xa, 0x6c, 0x6f, 0x63, 0x61, 0x6c, 0x5f, 0x76, 
+0x61, 0x72, 0x73, 0xe, 0x67, 0x65, 0x74, 0x5f, 0x61, 0x6e, 0x64, 0x5f, 0x64, 
+0x65, 0x6c, 0x65, 0x74, 0x65, 0xa, 0x61, 0x64, 0x64, 0x5f, 0x6d, 0x65, 0x74, 
+0x68, 0x6f, 0x64, 0x1b, 0x6b, 0x6c, 0x61, 0x73, 0x73, 0x20, 0x6e, 0x61, 0x6d, 
+0x65, 0x20, 0x6c, 0x61, 0x6d, 0x62, 0x64, 0x61, 0x5f, 0x77, 0x69, 0x74, 0x68, 
+0x5f, 0x74, 0x68, 0x69, 0x73, 0x6, 0x67, 0x65, 0x74, 0x74, 0x65, 0x72, 0x4, 
+0x74, 0x68, 0x69, 0x73, 0x6, 0x72, 0x65, 0x73, 0x75, 0x6c, 0x74, 0x10, 0x6c, 
+0x61, 0x6d, 0x62, 0x64, 0x61, 0x5f, 0x77, 0x69, 0x74, 0x68, 0x5f, 0x74, 0x68, 
+0x69, 0x73, 0x7, 0x70, 0x61, 0x72, 0x74, 0x69, 0x61, 0x6c, 0x4, 0x6e, 0x61, 
+0x6d, 0x65, 0x7, 0x20, 0x6d, 0x65, 0x74, 0x68, 0x6f, 0x64, 0x6, 0x72, 0x65, 
+0x74, 0x75, 0x72, 0x6e, 0x9, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x69, 0x6e, 
+0x67, 0x4, 0x74, 0x72, 0x75, 0x65, 0xa, 0x67, 0x65, 0x74, 0x74, 0x65, 0x72, 
+0x20, 0x6f, 0x66, 0x20, 0x5, 0x6b, 0x6c, 0x61, 0x73, 0x73, 0x7, 0x67, 0x65, 
+0x74, 0x74, 0x65, 0x72, 0x73, 0x3, 0x73, 0x65, 0x74, 0xf, 0x74, 0x6f, 0x5f, 
+0x64, 0x65, 0x62, 0x75, 0x67, 0x5f, 0x73, 0x74, 0x72, 0x69, 0x6e, 0x67, 0xa, 
+0x3c, 0x46, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x1, 0x3e, 0x7, 
+0x3c, 0x43, 0x6c, 0x61, 0x73, 0x73, 0x20, 0x1, 0x3c, 0x2, 0x3a, 0x20, 0x7, 
+0x6d, 0x65, 0x73, 0x73, 0x61, 0x67, 0x65, 0x4, 0x42, 0x6f, 0x6f, 0x6c, 0x5, 
+0x73, 0x65, 0x74, 0x75, 0x70, 0x5, 0x74, 0x68, 0x72, 0x6f, 0x77, 0x3a, 0x63, 
+0x61, 0x6e, 0x6e, 0x6f, 0x74, 0x20, 0x63, 0x72, 0x65, 0x61, 0x74, 0x65, 0x20, 
+0x6e, 0x65, 0x77, 0x20, 0x42, 0x6f, 0x6f, 0x6c, 0x20, 0x6f, 0x62, 0x6a, 0x65, 
+0x63, 0x74, 0x73, 0x2c, 0x20, 0x75, 0x73, 0x65, 0x20, 0x74, 0x72, 0x75, 0x65, 
+0x20, 0x61, 0x6e, 0x64, 0x20, 0x66, 0x61, 0x6c, 0x73, 0x65, 0x20, 0x69, 0x6e, 
+0x73, 0x74, 0x65, 0x61, 0x64, 0x7, 0x4d, 0x61, 0x70, 0x70, 0x69, 0x6e, 0x67, 
+0x5, 0x66, 0x61, 0x6c, 0x73, 0x65, 0x3, 0x67, 0x65, 0x74, 0x6, 0x4f, 0x70, 
+0x74, 0x69, 0x6f, 0x6e, 0x2, 0x69, 0x66, 0xb, 0x73, 0x61, 0x6d, 0x65, 0x5f, 
+0x6f, 0x62, 0x6a, 0x65, 0x63, 0x74, 0x4, 0x6e, 0x6f, 0x6e, 0x65, 0x9, 0x3c, 
+0x4f, 0x70, 0x74, 0x69, 0x6f, 0x6e, 0x3a, 0x20, 0x9, 0x67, 0x65, 0x74, 0x5f, 
+0x76, 0x61, 0x6c, 0x75, 0x65, 0x11, 0x67, 0x65, 0x74, 0x5f, 0x77, 0x69, 0x74, 
+0x68, 0x5f, 0x66, 0x61, 0x6c, 0x6c, 0x62, 0x61, 0x63, 0x6b, 0xc, 0x74, 0x68, 
+0x69, 0x73, 0x20, 0x64, 0x65, 0x66, 0x61, 0x75, 0x6c, 0x74, 0x7, 0x64, 0x65, 
+0x66, 0x61, 0x75, 0x6c, 0x74, 0x7, 0x49, 0x6e, 0x74, 0x65, 0x67, 0x65, 0x72, 
+0x9, 0x74, 0x6f, 0x5f, 0x73, 0x74, 0x72, 0x69, 0x6e, 0x67, 0x2, 0x28, 0x30, 
+0x1, 0x29, 0x5, 0x41, 0x72, 0x72, 0x61, 0x79, 0x6, 0x6c, 0x65, 0x6e, 0x67, 
+0x74, 0x68, 0x2, 0x5b, 0x5d, 0xd, 0x53, 0x74, 0x72, 0x69, 0x6e, 0x67, 0x42, 
+0x75, 0x69, 0x6c, 0x64, 0x65, 0x72, 0x6, 0x61, 0x70, 0x70, 0x65, 0x6e, 0x64, 
+0x1, 0x5b, 0x3, 0x66, 0x6f, 0x72, 0x1, 0x69, 0x1, 0x20, 0x1, 0x5d, 0x5, 0x62, 
+0x75, 0x69, 0x6c, 0x64, 0x11, 0x73, 0x74, 0x61, 0x63, 0x6b, 0x66, 0x72, 0x61, 
+0x6d, 0x65, 0x5f, 0x6f, 0x70, 0x74, 0x69, 0x6f, 0x6e, 0x5, 0x63, 0x61, 0x74, 
+0x63, 0x68, 0xe, 0x31, 0x20, 0x2b, 0x20, 0x32, 0x20, 0x69, 0x73, 0x20, 0x6e, 
+0x6f, 0x74, 0x20, 0x33, 0x1, 0x65, 0x5, 0x73, 0x74, 0x61, 0x63, 0x6b, 0x5, 
+0x66, 0x69, 0x6c, 0x65, 0x20, 0x8, 0x66, 0x69, 0x6c, 0x65, 0x6e, 0x61, 0x6d, 
+0x65, 0x7, 0x2c, 0x20, 0x6c, 0x69, 0x6e, 0x65, 0x20, 0x6, 0x6c, 0x69, 0x6e, 
+0x65, 0x6e, 0x6f, 0xd, 0x3c, 0x53, 0x74, 0x61, 0x63, 0x6b, 0x46, 0x72, 0x61, 
+0x6d, 0x65, 0x3a, 0x20, 0x3, 0x72, 0x75, 0x6e, 0x5, 0x53, 0x63, 0x6f, 0x70, 
+0x65, 0xd, 0x72, 0x65, 0x6d, 0x6f, 0x76, 0x65, 0x5f, 0x69, 0x6e, 0x64, 0x65, 
+0x6e, 0x74, 0x6, 0x73, 0x74, 0x72, 0x69, 0x6e, 0x67, 0x5, 0x73, 0x6c, 0x69, 
+0x63, 0x65, 0x1, 0x9, 0xf, 0x67, 0x65, 0x74, 0x5f, 0x73, 0x6f, 0x75, 0x72, 
+0x63, 0x65, 0x5f, 0x6c, 0x69, 0x6e, 0x65, 0xf, 0x66, 0x69, 0x6c, 0x65, 0x6e, 
+0x61, 0x6d, 0x65, 0x20, 0x6c, 0x69, 0x6e, 0x65, 0x6e, 0x6f, 0x6, 0x69, 0x6d, 
+0x70, 0x6f, 0x72, 0x74, 0x8, 0x3c, 0x73, 0x74, 0x64, 0x3e, 0x2f, 0x69, 0x6f, 
+0x4, 0x6f, 0x70, 0x65, 0x6e, 0x7, 0x72, 0x65, 0x61, 0x64, 0x69, 0x6e, 0x67, 
+0x2, 0x61, 0x73, 0x4, 0x66, 0x69, 0x6c, 0x65, 0x8, 0x69, 0x74, 0x65, 0x72, 
+0x61, 0x74, 0x6f, 0x72, 0xa, 0x72, 0x65, 0x61, 0x64, 0x5f, 0x6c, 0x69, 0x6e, 
+0x65, 0x73, 0x4, 0x6e, 0x65, 0x78, 0x74, 0xb, 0x70, 0x72, 0x69, 0x6e, 0x74, 
+0x5f, 0x73, 0x74, 0x61, 0x63, 0x6b, 0x5, 0x70, 0x72, 0x69, 0x6e, 0x74, 0x6, 
+0x70, 0x72, 0x65, 0x66, 0x69, 0x78, 0x2, 0x69, 0x6e, 0xa, 0x73, 0x74, 0x61, 
+0x63, 0x6b, 0x5f, 0x63, 0x6f, 0x70, 0x79, 0x5, 0x66, 0x72, 0x61, 0x6d, 0x65, 
+0x3, 0x70, 0x6f, 0x70, 0x2, 0x20, 0x20, 0xa, 0x3c, 0x62, 0x75, 0x69, 0x6c, 
+0x74, 0x69, 0x6e, 0x73, 0x3e, 0x4, 0x6c, 0x69, 0x6e, 0x65, 0x4, 0x20, 0x20, 
+0x20, 0x20, 0x2, 0x62, 0x79, 0x3c, 0x67, 0x6f, 0x74, 0x20, 0x61, 0x6e, 0x6f, 
+0x74, 0x68, 0x65, 0x72, 0x20, 0x65, 0x72, 0x72, 0x6f, 0x72, 0x20, 0x77, 0x68, 
+0x69, 0x6c, 0x65, 0x20, 0x70, 0x72, 0x69, 0x6e, 0x74, 0x69, 0x6e, 0x67, 0x20, 
+0x74, 0x68, 0x65, 0x20, 0x73, 0x74, 0x61, 0x63, 0x6b, 0x20, 0x74, 0x72, 0x61, 
+0x63, 0x65, 0x20, 0x6f, 0x66, 0x20, 0x61, 0x6e, 0x20, 0x65, 0x72, 0x72, 0x6f, 
+0x72, 0, 0x13, 0x6f, 0x72, 0x69, 0x67, 0x69, 0x6e, 0x61, 0x6c, 0x20, 0x65, 
+0x72, 0x72, 0x6f, 0x72, 0x20, 0x77, 0x61, 0x73, 0x3a, 0x4, 0x66, 0x75, 0x6e, 
+0x63, 0x26, 0x66, 0x75, 0x6e, 0x63, 0x6e, 0x61, 0x6d, 0x65, 0x5f, 0x61, 0x6e, 
+0x64, 0x5f, 0x61, 0x72, 0x67, 0x6e, 0x61, 0x6d, 0x65, 0x73, 0x20, 0x62, 0x6c, 
+0x6f, 0x63, 0x6b, 0x20, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x69, 0x6e, 0x67, 
+0x3f, 0x8, 0x73, 0x70, 0x6c, 0x69, 0x74, 0x74, 0x65, 0x64, 0x15, 0x66, 0x75, 
+0x6e, 0x63, 0x6e, 0x61, 0x6d, 0x65, 0x5f, 0x61, 0x6e, 0x64, 0x5f, 0x61, 0x72, 
+0x67, 0x6e, 0x61, 0x6d, 0x65, 0x73, 0x13, 0x73, 0x70, 0x6c, 0x69, 0x74, 0x5f, 
+0x62, 0x79, 0x5f, 0x77, 0x68, 0x69, 0x74, 0x65, 0x73, 0x70, 0x61, 0x63, 0x65, 
+0x28, 0x66, 0x75, 0x6e, 0x63, 0x27, 0x73, 0x20, 0x73, 0x74, 0x72, 0x69, 0x6e, 
+0x67, 0x20, 0x61, 0x72, 0x67, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x20, 0x6d, 0x75, 
+0x73, 0x74, 0x20, 0x6e, 0x6f, 0x74, 0x20, 0x62, 0x65, 0x20, 0x65, 0x6d, 0x70, 
+0x74, 0x79, 0x8, 0x61, 0x72, 0x67, 0x6e, 0x61, 0x6d, 0x65, 0x73, 0x4, 0x6a, 
+0x6f, 0x69, 0x6e, 0x5, 0x62, 0x6c, 0x6f, 0x63, 0x6b, 0x14, 0x77, 0x68, 0x69, 
+0x6c, 0x65, 0x20, 0x63, 0x6f, 0x6e, 0x64, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x20, 
+0x62, 0x6f, 0x64, 0x79, 0x9, 0x63, 0x6f, 0x6e, 0x64, 0x69, 0x74, 0x69, 0x6f, 
+0x6e, 0x4, 0x62, 0x6f, 0x64, 0x79, 0x18, 0x73, 0x77, 0x69, 0x74, 0x63, 0x68, 
+0x20, 0x76, 0x61, 0x6c, 0x75, 0x65, 0x20, 0x73, 0x77, 0x69, 0x74, 0x63, 0x68, 
+0x62, 0x6c, 0x6f, 0x63, 0x6b, 0xb, 0x73, 0x77, 0x69, 0x74, 0x63, 0x68, 0x73, 
+0x63, 0x6f, 0x70, 0x65, 0xb, 0x73, 0x77, 0x69, 0x74, 0x63, 0x68, 0x62, 0x6c, 
+0x6f, 0x63, 0x6b, 0x10, 0x63, 0x61, 0x73, 0x65, 0x20, 0x6d, 0x61, 0x74, 0x63, 
+0x68, 0x20, 0x62, 0x6c, 0x6f, 0x63, 0x6b, 0x5, 0x76, 0x61, 0x6c, 0x75, 0x65, 
+0x5, 0x6d, 0x61, 0x74, 0x63, 0x68, 0xd, 0x64, 0x65, 0x66, 0x61, 0x75, 0x6c, 
+0x74, 0x20, 0x62, 0x6c, 0x6f, 0x63, 0x6b, 0x4, 0x63, 0x61, 0x73, 0x65, 0x7, 
+0x72, 0x65, 0x70, 0x6c, 0x61, 0x63, 0x65, 0x1, 0x5c, 0x2, 0x5c, 0x5c, 0x1, 0xa, 
+0x2, 0x5c, 0x6e, 0x2, 0x5c, 0x74, 0x1, 0x22, 0x2, 0x5c, 0x22, 0x7, 0x64, 0x65, 
+0x62, 0x75, 0x67, 0x20, 0x78, 0x5, 0x6e, 0x6f, 0x74, 0x20, 0x78, 0x7, 0x61, 
+0x6e, 0x64, 0x20, 0x78, 0x20, 0x79, 0x1, 0x79, 0x4, 0x65, 0x6c, 0x73, 0x65, 
+0x3, 0x6e, 0x6f, 0x74, 0x6, 0x6f, 0x72, 0x20, 0x78, 0x20, 0x79, 0x3, 0x61, 
+0x6e, 0x64, 0x10, 0x61, 0x73, 0x73, 0x65, 0x72, 0x74, 0x20, 0x63, 0x6f, 0x6e, 
+0x64, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x10, 0x61, 0x73, 0x73, 0x65, 0x72, 0x74, 
+0x69, 0x6f, 0x6e, 0x20, 0x66, 0x61, 0x69, 0x6c, 0x65, 0x64, 0x1d, 0x69, 0x73, 
+0x5f, 0x69, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x5f, 0x6f, 0x66, 0x20, 
+0x69, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x20, 0x6b, 0x6c, 0x61, 0x73, 
+0x73, 0x8, 0x73, 0x75, 0x62, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x8, 0x69, 0x6e, 
+0x73, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x5, 0x77, 0x68, 0x69, 0x6c, 0x65, 0x9, 
+0x62, 0x61, 0x73, 0x65, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x14, 0x67, 0x65, 0x74, 
+0x5f, 0x61, 0x6e, 0x64, 0x5f, 0x68, 0x69, 0x64, 0x65, 0x5f, 0x62, 0x75, 0x69, 
+0x6c, 0x74, 0x69, 0x6e, 0xc, 0x70, 0x61, 0x72, 0x65, 0x6e, 0x74, 0x5f, 0x73, 
+0x63, 0x6f, 0x70, 0x65, 0xc, 0x67, 0x65, 0x74, 0x5f, 0x61, 0x74, 0x74, 0x72, 
+0x64, 0x61, 0x74, 0x61, 0x2c, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x20, 0x63, 0x6c, 
+0x61, 0x73, 0x73, 0x5f, 0x6e, 0x61, 0x6d, 0x65, 0x20, 0x69, 0x6e, 0x69, 0x74, 
+0x69, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x72, 0x5f, 0x62, 0x6c, 0x6f, 0x63, 0x6b, 
+0x20, 0x69, 0x6e, 0x68, 0x65, 0x72, 0x69, 0x74, 0x73, 0x3f, 0xa, 0x63, 0x6c, 
+0x61, 0x73, 0x73, 0x5f, 0x6e, 0x61, 0x6d, 0x65, 0x8, 0x69, 0x6e, 0x68, 0x65, 
+0x72, 0x69, 0x74, 0x73, 0x6, 0x4f, 0x62, 0x6a, 0x65, 0x63, 0x74, 0x11, 0x67, 
+0x65, 0x74, 0x74, 0x65, 0x72, 0x20, 0x6e, 0x61, 0x6d, 0x65, 0x20, 0x62, 0x6c, 
+0x6f, 0x63, 0x6b, 0x8, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x19, 
+0x73, 0x65, 0x74, 0x74, 0x65, 0x72, 0x20, 0x6e, 0x61, 0x6d, 0x65, 0x20, 0x76, 
+0x61, 0x72, 0x6e, 0x61, 0x6d, 0x65, 0x20, 0x62, 0x6c, 0x6f, 0x63, 0x6b, 0x5, 
+0x74, 0x68, 0x69, 0x73, 0x20, 0x7, 0x76, 0x61, 0x72, 0x6e, 0x61, 0x6d, 0x65, 
+0xa, 0x73, 0x65, 0x74, 0x74, 0x65, 0x72, 0x20, 0x6f, 0x66, 0x20, 0x7, 0x73, 
+0x65, 0x74, 0x74, 0x65, 0x72, 0x73, 0xd, 0x61, 0x62, 0x73, 0x74, 0x72, 0x61, 
+0x63, 0x74, 0x20, 0x6e, 0x61, 0x6d, 0x65, 0x1e, 0x63, 0x61, 0x6e, 0x6e, 0x6f, 
+0x74, 0x20, 0x67, 0x65, 0x74, 0x20, 0x61, 0x62, 0x73, 0x74, 0x72, 0x61, 0x63, 
+0x74, 0x20, 0x61, 0x74, 0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 0x65, 0x20, 0xb, 
+0x61, 0x74, 0x74, 0x72, 0x69, 0x62, 0x20, 0x6e, 0x61, 0x6d, 0x65, 0xd, 0x74, 
+0x68, 0x65, 0x20, 0x76, 0x61, 0x6c, 0x75, 0x65, 0x20, 0x6f, 0x66, 0x20, 0x10, 
+0x20, 0x68, 0x61, 0x73, 0x6e, 0x27, 0x74, 0x20, 0x62, 0x65, 0x65, 0x6e, 0x20, 
+0x73, 0x65, 0x74, 0x6, 0x73, 0x65, 0x74, 0x74, 0x65, 0x72, 0x9, 0x6e, 0x65, 
+0x77, 0x5f, 0x76, 0x61, 0x6c, 0x75, 0x65, 0x2d, 0x6d, 0x65, 0x74, 0x68, 0x6f, 
+0x64, 0x20, 0x6d, 0x65, 0x74, 0x68, 0x6e, 0x61, 0x6d, 0x65, 0x5f, 0x61, 0x6e, 
+0x64, 0x5f, 0x61, 0x72, 0x67, 0x6e, 0x61, 0x6d, 0x65, 0x73, 0x20, 0x62, 0x6c, 
+0x6f, 0x63, 0x6b, 0x20, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x69, 0x6e, 0x67, 
+0x3f, 0x15, 0x6d, 0x65, 0x74, 0x68, 0x6e, 0x61, 0x6d, 0x65, 0x5f, 0x61, 0x6e, 
+0x64, 0x5f, 0x61, 0x72, 0x67, 0x6e, 0x61, 0x6d, 0x65, 0x73, 0x27, 0x6d, 0x65, 
+0x74, 0x68, 0x6f, 0x64, 0x27, 0x73, 0x20, 0x73, 0x74, 0x72, 0x69, 0x6e, 0x67, 
+0x20, 0x61, 0x72, 0x67, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x20, 0x6d, 0x75, 0x73, 
+0x74, 0x20, 0x6e, 0x6f, 0x74, 0x20, 0x62, 0x65, 0x20, 0x22, 0x22, 0xd, 0x74, 
+0x68, 0x69, 0x73, 0x5f, 0x61, 0x6e, 0x64, 0x5f, 0x61, 0x72, 0x67, 0x73, 0xa, 
+0x69, 0x6e, 0x69, 0x74, 0x5f, 0x73, 0x63, 0x6f, 0x70, 0x65, 0x11, 0x69, 0x6e, 
+0x69, 0x74, 0x69, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x72, 0x5f, 0x62, 0x6c, 0x6f, 
+0x63, 0x6b, 0x8, 0x61, 0x62, 0x73, 0x74, 0x72, 0x61, 0x63, 0x74, 0x6, 0x61, 
+0x74, 0x74, 0x72, 0x69, 0x62, 0x6, 0x6d, 0x65, 0x74, 0x68, 0x6f, 0x64, 0x5, 
+0x63, 0x6c, 0x61, 0x73, 0x73, 0x17, 0x65, 0x72, 0x72, 0x6f, 0x72, 0x20, 0x69, 
+0x6d, 0x70, 0x6f, 0x72, 0x74, 0x65, 0x72, 0x20, 0x72, 0x65, 0x74, 0x75, 0x72, 
+0x6e, 0x65, 0x64, 0x3b, 0x69, 0x6d, 0x70, 0x6f, 0x72, 0x74, 0x65, 0x72, 0x73, 
+0x20, 0x73, 0x68, 0x6f, 0x75, 0x6c, 0x64, 0x20, 0x72, 0x65, 0x74, 0x75, 0x72, 
+0x6e, 0x20, 0x61, 0x6e, 0x20, 0x4f, 0x70, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x6f, 
+0x66, 0x20, 0x61, 0x20, 0x4c, 0x69, 0x62, 0x72, 0x61, 0x72, 0x79, 0x20, 0x6f, 
+0x62, 0x6a, 0x65, 0x63, 0x74, 0x2c, 0x20, 0x62, 0x75, 0x74, 0x20, 0x8, 0x69, 
+0x6d, 0x70, 0x6f, 0x72, 0x74, 0x65, 0x72, 0xa, 0x20, 0x72, 0x65, 0x74, 0x75, 
+0x72, 0x6e, 0x65, 0x64, 0x20, 0x8, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x65, 
+0x64, 0x9, 0x69, 0x6d, 0x70, 0x6f, 0x72, 0x74, 0x65, 0x72, 0x73, 0x7, 0x4c, 
+0x69, 0x62, 0x72, 0x61, 0x72, 0x79, 0xd, 0x69, 0x6d, 0x70, 0x6f, 0x72, 0x74, 
+0x20, 0x73, 0x74, 0x72, 0x69, 0x6e, 0x67, 0x5, 0x6f, 0x68, 0x20, 0x6e, 0x6f, 
+0x6, 0x61, 0x73, 0x73, 0x65, 0x72, 0x74, 0x3, 0x6c, 0x69, 0x62, 0xe, 0x69, 
+0x73, 0x5f, 0x69, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x5f, 0x6f, 0x66, 
+0x5, 0x65, 0x72, 0x72, 0x6f, 0x72, 0xe, 0x63, 0x61, 0x6e, 0x6e, 0x6f, 0x74, 
+0x20, 0x69, 0x6d, 0x70, 0x6f, 0x72, 0x74, 0x20, 0xf, 0x3c, 0x73, 0x74, 0x64, 
+0x3e, 0x2f, 0x6f, 0x70, 0x65, 0x72, 0x61, 0x74, 0x6f, 0x72, 0x73, 0xd, 0x3c, 
+0x73, 0x74, 0x64, 0x3e, 0x2f, 0x69, 0x6d, 0x70, 0x6f, 0x72, 0x74, 0x73, 0x11, 
+0x3c, 0x73, 0x74, 0x64, 0x3e, 0x2f, 0x63, 0x6f, 0x6c, 0x6c, 0x65, 0x63, 0x74, 
+0x69, 0x6f, 0x6e, 0x73, 0xf, 0x3c, 0x73, 0x74, 0x64, 0x3e, 0x2f, 0x65, 0x6e, 
+0x63, 0x6f, 0x64, 0x69, 0x6e, 0x67, 0x73, 0x6, 0x64, 0x65, 0x6c, 0x65, 0x74, 
+0x65, 0x2b, 0x76, 0x5, 0, 0x28, 0x5, 0x78, 0x5, 0x1, 0x1, 0x78, 0x5, 0x2, 0, 
+0x76, 0x8, 0x3, 0x28, 0x8, 0x78, 0x8, 0x4, 0x3, 0x78, 0x8, 0, 0x22, 0x8, 0x3, 
+0x78, 0x8, 0x5, 0, 0x76, 0x9, 0x6, 0x28, 0x9, 0x78, 0x9, 0x4, 0x3, 0x78, 0x9, 
+0, 0x22, 0x9, 0x6, 0x78, 0x9, 0x5, 0, 0x76, 0xa, 0x7, 0x28, 0xa, 0x78, 0xa, 
+0x4, 0x3, 0x78, 0xa, 0, 0x22, 0xa, 0x7, 0x78, 0xa, 0x5, 0, 0x76, 0xb, 0x8, 
+0x28, 0xb, 0x78, 0xb, 0x4, 0x3, 0x78, 0xb, 0, 0x22, 0xb, 0x8, 0x78, 0xb, 0x5, 
+0, 0x76, 0xc, 0x9, 0x28, 0xc, 0x78, 0xc, 0x4, 0x3, 0x78, 0xc, 0, 0x22, 0xc, 
+0x9, 0x78, 0xc, 0x5, 0, 0x76, 0xd, 0xa, 0x28, 0xd, 0x78, 0xd, 0x4, 0x3, 0x78, 
+0xd, 0, 0x22, 0xd, 0xa, 0x78, 0xd, 0x5, 0, 0x76, 0xe, 0xb, 0x28, 0xe, 0x78, 
+0xe, 0x4, 0x3, 0x78, 0xe, 0, 0x22, 0xe, 0xb, 0x78, 0xe, 0x5, 0, 0x76, 0xf, 0xc, 
+0x28, 0xf, 0x78, 0xf, 0x4, 0x3, 0x78, 0xf, 0, 0x22, 0xf, 0xc, 0x78, 0xf, 0x5, 
+0, 0x76, 0x10, 0xd, 0x28, 0x10, 0x78, 0x10, 0x4, 0x3, 0x78, 0x10, 0, 0x22, 
+0x10, 0xd, 0x78, 0x10, 0x5, 0, 0x28, 0x14, 0x28, 0x14, 0x78, 0x14, 0xe, 0x2, 
+0x22, 0x14, 0xf, 0x7b, 0x14, 0x1, 0x76, 0x14, 0x10, 0x28, 0x14, 0x78, 0x14, 
+0x11, 0x1, 0x78, 0x14, 0x12, 0, 0, 0x2, 0x2e, 0x14, 0x2e, 0x14, 0x2e, 0x14, 
+0x7b, 0x14, 0, 0x13, 0x14, 0x15, 0x22, 0x14, 0, 0, 0x76, 0x16, 0x16, 0x28, 
+0x16, 0x78, 0x16, 0xe, 0x2, 0x22, 0x16, 0x17, 0x7b, 0x16, 0x3, 0x76, 0x17, 
+0x18, 0x28, 0x17, 0x78, 0x17, 0xe, 0x2, 0x22, 0x17, 0x19, 0x7b, 0x17, 0x3, 
+0x76, 0x18, 0x1a, 0x28, 0x18, 0x2e, 0x18, 0x78, 0x18, 0x1b, 0x1c, 0x1, 0x78, 
+0x18, 0x19, 0, 0x2a, 0x19, 0x78, 0x19, 0x1a, 0x1d, 0x2b, 0x19, 0, 0x78, 0x19, 
+0x1d, 0x22, 0x19, 0x1e, 0x28, 0x1a, 0x78, 0x1a, 0x1f, 0x1, 0x78, 0x1a, 0x1a, 0, 
+0x1, 0x20, 0x78, 0x17, 0x21, 0x2a, 0x1d, 0x78, 0x1d, 0x18, 0x1d, 0x2b, 0x1d, 0, 
+0x22, 0x1d, 0x22, 0x78, 0x1d, 0x1d, 0x28, 0x1e, 0x2e, 0x1e, 0x2e, 0x1e, 0x78, 
+0x1e, 0x23, 0x24, 0x25, 0x2, 0x78, 0x1e, 0x1d, 0x78, 0x1e, 0x18, 0, 0, 0x28, 
+0x21, 0x78, 0x21, 0x16, 0x3, 0x28, 0x21, 0x78, 0x21, 0x1, 0x1, 0x78, 0x21, 
+0x16, 0, 0x22, 0x21, 0x26, 0x28, 0x21, 0x78, 0x21, 0xe, 0x2, 0x22, 0x21, 0x19, 
+0x7b, 0x21, 0x1, 0x28, 0x22, 0x78, 0x22, 0x1f, 0x1, 0x2b, 0x22, 0, 0x2b, 0x22, 
+0, 0x22, 0x22, 0x27, 0x28, 0x22, 0x2e, 0x22, 0x2e, 0x22, 0x78, 0x22, 0x19, 
+0x1d, 0x26, 0, 0, 0x22, 0x22, 0x28, 0, 0x1, 0x20, 0x78, 0x21, 0x21, 0, 0x28, 
+0x25, 0x78, 0x25, 0x16, 0x3, 0x28, 0x25, 0x78, 0x25, 0x1, 0x1, 0x78, 0x25, 0x2, 
+0, 0x22, 0x25, 0x26, 0x28, 0x25, 0x78, 0x25, 0xe, 0x2, 0x22, 0x25, 0x19, 0x7b, 
+0x25, 0x1, 0x28, 0x26, 0x78, 0x26, 0x1f, 0x1, 0x2b, 0x26, 0, 0x2b, 0x26, 0, 
+0x22, 0x26, 0x29, 0x28, 0x26, 0x2e, 0x26, 0x2e, 0x26, 0x78, 0x26, 0x19, 0x1d, 
+0x26, 0, 0, 0x22, 0x26, 0x28, 0, 0x1, 0x20, 0x78, 0x25, 0x21, 0, 0x28, 0x29, 
+0x78, 0x29, 0x16, 0x3, 0x78, 0x29, 0x5, 0x22, 0x29, 0x26, 0x28, 0x29, 0x78, 
+0x29, 0xe, 0x2, 0x22, 0x29, 0x19, 0x7b, 0x29, 0x1, 0x28, 0x2a, 0x78, 0x2a, 
+0x1f, 0x1, 0x2b, 0x2a, 0, 0x2b, 0x2a, 0, 0x2b, 0x2a, 0, 0x2b, 0x2a, 0, 0x22, 
+0x2a, 0x2a, 0x2e, 0x2a, 0x28, 0x2a, 0x78, 0x2a, 0x1, 0x1, 0x78, 0x2a, 0x19, 0, 
+0x1d, 0x22, 0x2a, 0x2b, 0x28, 0x2a, 0x2e, 0x2a, 0x2e, 0x2a, 0x78, 0x2a, 0x19, 
+0x2c, 0x26, 0, 0, 0x22, 0x2a, 0x28, 0, 0x1, 0x20, 0x78, 0x29, 0x21, 0, 0x28, 
+0x2d, 0x78, 0x2d, 0x16, 0x3, 0x78, 0x2d, 0x2d, 0x22, 0x2d, 0x2e, 0x28, 0x2d, 
+0x78, 0x2d, 0xe, 0x2, 0x22, 0x2d, 0x19, 0x7b, 0x2d, 0x1, 0x28, 0x2e, 0x78, 
+0x2e, 0x2f, 0x1, 0x28, 0x2e, 0x78, 0x2e, 0x4, 0x2, 0x78, 0x2e, 0xb, 0x22, 0x2e, 
+0x30, 0, 0, 0, 0, 0x28, 0x31, 0x78, 0x31, 0x16, 0x3, 0x78, 0x31, 0x2d, 0x22, 
+0x31, 0x26, 0x28, 0x31, 0x78, 0x31, 0xe, 0x2, 0x22, 0x31, 0x19, 0x7b, 0x31, 
+0x1, 0x28, 0x32, 0x78, 0x32, 0x1f, 0x1, 0x28, 0x32, 0x2e, 0x32, 0x28, 0x32, 
+0x78, 0x32, 0x4, 0x2, 0x78, 0x32, 0x31, 0x5b, 0x32, 0x2, 0x5b, 0x32, 0x2, 0x78, 
+0x32, 0x21, 0x22, 0x32, 0x21, 0x5b, 0x32, 0x2, 0x78, 0x32, 0x32, 0x22, 0x32, 
+0x32, 0, 0x33, 0x1, 0x78, 0x32, 0x19, 0, 0, 0x1, 0x20, 0x78, 0x31, 0x21, 0, 
+0x28, 0x35, 0x78, 0x35, 0x16, 0x3, 0x78, 0x35, 0x34, 0x22, 0x35, 0x26, 0x28, 
+0x35, 0x78, 0x35, 0xe, 0x2, 0x22, 0x35, 0x19, 0x7b, 0x35, 0x2, 0x28, 0x36, 
+0x78, 0x36, 0x35, 0x2, 0x28, 0x36, 0x78, 0x36, 0x36, 0x2, 0x78, 0x36, 0x19, 
+0x78, 0x36, 0x37, 0, 0x7b, 0x36, 0x1, 0x28, 0x37, 0x78, 0x37, 0x1f, 0x1, 0x22, 
+0x37, 0x37, 0, 0, 0x28, 0x39, 0x78, 0x39, 0x1f, 0x1, 0x2b, 0x39, 0, 0x2b, 0x39, 
+0, 0x22, 0x39, 0x38, 0x28, 0x39, 0x2e, 0x39, 0x28, 0x39, 0x2e, 0x39, 0x78, 
+0x39, 0x19, 0x39, 0, 0, 0x26, 0, 0, 0x22, 0x39, 0x28, 0, 0x1, 0x20, 0x78, 0x35, 
+0x21, 0, 0x28, 0x3c, 0x78, 0x3c, 0x16, 0x3, 0x78, 0x3c, 0x34, 0x22, 0x3c, 0x3a, 
+0x28, 0x3c, 0x78, 0x3c, 0xe, 0x2, 0x22, 0x3c, 0x3b, 0x7b, 0x3c, 0x2, 0x28, 
+0x3e, 0x78, 0x3e, 0x35, 0x2, 0x28, 0x3e, 0x78, 0x3e, 0x36, 0x2, 0x78, 0x3e, 
+0x19, 0x78, 0x3e, 0x37, 0, 0x7b, 0x3e, 0x1, 0x28, 0x3f, 0x78, 0x3f, 0x1f, 0x1, 
+0x78, 0x3f, 0x3c, 0, 0, 0x28, 0x41, 0x78, 0x41, 0x1f, 0x1, 0x28, 0x41, 0x2e, 
+0x41, 0x78, 0x41, 0x19, 0x39, 0, 0, 0, 0x1, 0x20, 0x78, 0x3c, 0x21, 0, 0x28, 
+0x45, 0x78, 0x45, 0x16, 0x3, 0x78, 0x45, 0x3d, 0x22, 0x45, 0x26, 0x28, 0x45, 
+0x78, 0x45, 0xe, 0x2, 0x22, 0x45, 0x19, 0x7b, 0x45, 0x2, 0x28, 0x46, 0x78, 
+0x46, 0x35, 0x2, 0x2b, 0x46, 0x8, 0x78, 0x46, 0x19, 0x31, 0x46, 0, 0, 0, 0, 0, 
+0, 0, 0, 0x7b, 0x46, 0x1, 0x28, 0x48, 0x78, 0x48, 0x1f, 0x1, 0x28, 0x48, 0x2e, 
+0x48, 0x78, 0x48, 0x19, 0x3e, 0, 0, 0, 0, 0x28, 0x4c, 0x78, 0x4c, 0x1f, 0x1, 
+0x2b, 0x4c, 0, 0x2b, 0x4c, 0, 0x22, 0x4c, 0x3f, 0x28, 0x4c, 0x2e, 0x4c, 0x78, 
+0x4c, 0x19, 0x3e, 0, 0, 0x22, 0x4c, 0x40, 0, 0x1, 0x20, 0x78, 0x45, 0x21, 0, 
+0x28, 0x4f, 0x78, 0x4f, 0x16, 0x3, 0x78, 0x4f, 0x41, 0x22, 0x4f, 0x26, 0x28, 
+0x4f, 0x78, 0x4f, 0xe, 0x2, 0x22, 0x4f, 0x19, 0x7b, 0x4f, 0x7, 0x28, 0x50, 
+0x78, 0x50, 0x35, 0x2, 0x2b, 0x50, 0x4, 0x2e, 0x50, 0x78, 0x50, 0x19, 0x42, 
+0x31, 0x50, 0, 0, 0, 0, 0, 0, 0, 0, 0x7b, 0x50, 0x1, 0x28, 0x51, 0x78, 0x51, 
+0x1f, 0x1, 0x22, 0x51, 0x43, 0, 0, 0x76, 0x54, 0x1a, 0x28, 0x54, 0x78, 0x54, 
+0x4, 0x1, 0x78, 0x54, 0x44, 0, 0x28, 0x55, 0x2e, 0x55, 0x78, 0x55, 0x1a, 0x45, 
+0x1, 0x22, 0x55, 0x46, 0, 0x28, 0x56, 0x2e, 0x56, 0x78, 0x56, 0x1a, 0x45, 0x1, 
+0x28, 0x56, 0x2e, 0x56, 0x28, 0x56, 0x2e, 0x56, 0x78, 0x56, 0x19, 0x33, 0x1, 
+0x31, 0x56, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x26, 0, 0, 0, 0x28, 0x57, 0x78, 0x57, 
+0x47, 0x4, 0x7b, 0x57, 0x1, 0x76, 0x57, 0x48, 0x31, 0x57, 0x1, 0, 0, 0, 0, 0, 
+0, 0, 0x7b, 0x57, 0x1, 0x28, 0x57, 0x78, 0x57, 0x1f, 0x1, 0x2b, 0x57, 0x7, 
+0x78, 0x57, 0x48, 0x2e, 0x57, 0x78, 0x57, 0x19, 0x42, 0, 0x7b, 0x57, 0x1, 0x3d, 
+0x57, 0x48, 0x2b, 0x57, 0, 0x78, 0x57, 0x48, 0x31, 0x57, 0x1, 0, 0, 0, 0, 0, 0, 
+0, 0x7b, 0x57, 0x2, 0x28, 0x58, 0x2e, 0x58, 0x78, 0x58, 0x1a, 0x45, 0x1, 0x22, 
+0x58, 0x49, 0, 0x28, 0x59, 0x2e, 0x59, 0x78, 0x59, 0x1a, 0x45, 0x1, 0x28, 0x59, 
+0x2e, 0x59, 0x28, 0x59, 0x2e, 0x59, 0x78, 0x59, 0x19, 0x33, 0x1, 0x78, 0x59, 
+0x48, 0, 0x26, 0, 0, 0, 0, 0x28, 0x5b, 0x2e, 0x5b, 0x78, 0x5b, 0x1a, 0x45, 0x1, 
+0x22, 0x5b, 0x4a, 0, 0x28, 0x5c, 0x78, 0x5c, 0x1f, 0x1, 0x28, 0x5c, 0x2e, 0x5c, 
+0x78, 0x5c, 0x1a, 0x4b, 0, 0, 0, 0x1, 0x20, 0x78, 0x4f, 0x21, 0, 0x28, 0x71, 
+0x2e, 0x71, 0x7b, 0x61, 0x4, 0x76, 0x63, 0x4c, 0x78, 0x63, 0x37, 0x28, 0x64, 
+0x78, 0x64, 0x4d, 0x3, 0x7b, 0x64, 0x1, 0x28, 0x65, 0x78, 0x65, 0x2f, 0x1, 
+0x28, 0x65, 0x78, 0x65, 0x4, 0x2, 0x78, 0x65, 0xa, 0x22, 0x65, 0x4e, 0, 0, 
+0x5b, 0x66, 0x2, 0x78, 0x66, 0xa, 0x22, 0x66, 0x4f, 0x7b, 0x66, 0x1, 0x3d, 
+0x67, 0x4c, 0x28, 0x67, 0x78, 0x67, 0x4, 0x2, 0x78, 0x67, 0x34, 0x28, 0x67, 
+0x78, 0x67, 0x1, 0x1, 0x28, 0x67, 0x2e, 0x67, 0x2e, 0x67, 0x78, 0x67, 0x4f, 
+0x50, 0x33, 0x1, 0x31, 0x67, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x28, 0x6a, 
+0x78, 0x6a, 0x16, 0x3, 0x28, 0x6a, 0x2e, 0x6a, 0x78, 0x6a, 0x4c, 0x39, 0, 0, 
+0x22, 0x6a, 0x3e, 0x28, 0x6a, 0x78, 0x6a, 0xe, 0x2, 0x22, 0x6a, 0x19, 0x7b, 
+0x6a, 0x1, 0x28, 0x6b, 0x78, 0x6b, 0x1f, 0x1, 0x2b, 0x6b, 0, 0x2b, 0x6b, 0, 
+0x2b, 0x6b, 0, 0x22, 0x6b, 0x51, 0x2e, 0x6b, 0x78, 0x6b, 0x19, 0x52, 0x22, 
+0x6b, 0x53, 0x28, 0x6b, 0x2e, 0x6b, 0x2e, 0x6b, 0x78, 0x6b, 0x19, 0x54, 0x3e, 
+0, 0, 0, 0x1, 0x20, 0x78, 0x6a, 0x21, 0, 0x28, 0x6e, 0x78, 0x6e, 0x16, 0x3, 
+0x28, 0x6e, 0x2e, 0x6e, 0x78, 0x6e, 0x4c, 0x39, 0, 0, 0x22, 0x6e, 0x26, 0x28, 
+0x6e, 0x78, 0x6e, 0xe, 0x2, 0x22, 0x6e, 0x19, 0x7b, 0x6e, 0x1, 0x28, 0x6f, 
+0x78, 0x6f, 0x1f, 0x1, 0x2b, 0x6f, 0, 0x2b, 0x6f, 0, 0x22, 0x6f, 0x55, 0x28, 
+0x6f, 0x2e, 0x6f, 0x78, 0x6f, 0x19, 0x3e, 0, 0, 0x22, 0x6f, 0x28, 0, 0x1, 0x20, 
+0x78, 0x6e, 0x21, 0, 0x56, 0x1, 0x28, 0x71, 0x78, 0x71, 0x4, 0x2, 0x78, 0x71, 
+0x57, 0x2e, 0x71, 0x7b, 0x71, 0, 0x13, 0, 0, 0x28, 0xbe, 0x1, 0x2e, 0xbe, 0x1, 
+0x7b, 0x74, 0x3, 0x76, 0x76, 0x58, 0x28, 0x76, 0x78, 0x76, 0xe, 0x2, 0x22, 
+0x76, 0x59, 0x7b, 0x76, 0x2, 0x28, 0x77, 0x78, 0x77, 0x35, 0x2, 0x2b, 0x77, 
+0x5, 0x2e, 0x77, 0x78, 0x77, 0x59, 0x42, 0x31, 0x77, 0, 0, 0, 0, 0, 0, 0, 0, 
+0x7b, 0x77, 0x2, 0x28, 0x78, 0x78, 0x78, 0x35, 0x2, 0x2b, 0x78, 0x4, 0x28, 
+0x78, 0x2e, 0x78, 0x78, 0x78, 0x59, 0x33, 0x1, 0x31, 0x78, 0, 0, 0, 0, 0, 0, 0, 
+0, 0, 0x22, 0x78, 0x49, 0x7b, 0x78, 0x1, 0x28, 0x79, 0x78, 0x79, 0x1f, 0x1, 
+0x28, 0x79, 0x78, 0x79, 0x58, 0x1, 0x28, 0x79, 0x2e, 0x79, 0x78, 0x79, 0x59, 
+0x5a, 0x2, 0x31, 0x79, 0x1, 0, 0, 0, 0, 0, 0, 0, 0x2e, 0x79, 0x78, 0x79, 0x59, 
+0x42, 0, 0, 0, 0, 0x28, 0x7b, 0x78, 0x7b, 0x35, 0x2, 0x2b, 0x7b, 0x4, 0x28, 
+0x7b, 0x2e, 0x7b, 0x78, 0x7b, 0x59, 0x33, 0x1, 0x31, 0x7b, 0, 0, 0, 0, 0, 0, 0, 
+0, 0, 0x22, 0x7b, 0x5b, 0x7b, 0x7b, 0x1, 0x28, 0x7c, 0x78, 0x7c, 0x1f, 0x1, 
+0x28, 0x7c, 0x78, 0x7c, 0x58, 0x1, 0x28, 0x7c, 0x2e, 0x7c, 0x78, 0x7c, 0x59, 
+0x5a, 0x2, 0x31, 0x7c, 0x1, 0, 0, 0, 0, 0, 0, 0, 0x2e, 0x7c, 0x78, 0x7c, 0x59, 
+0x42, 0, 0, 0, 0, 0, 0x28, 0x7f, 0x78, 0x7f, 0x1f, 0x1, 0x78, 0x7f, 0x59, 0, 
+0x1, 0x20, 0x78, 0x76, 0x21, 0x76, 0x82, 0x1, 0x5c, 0x28, 0x82, 0x1, 0x78, 
+0x82, 0x1, 0xe, 0x2, 0x22, 0x82, 0x1, 0x5d, 0x7b, 0x82, 0x1, 0x4, 0x76, 0x84, 
+0x1, 0x1a, 0x78, 0x84, 0x1, 0x37, 0x28, 0x86, 0x1, 0x78, 0x86, 0x1, 0x4d, 0x3, 
+0x7b, 0x86, 0x1, 0x1, 0x28, 0x87, 0x1, 0x2e, 0x87, 0x1, 0x28, 0x87, 0x1, 0x2e, 
+0x87, 0x1, 0x28, 0x87, 0x1, 0x78, 0x87, 0x1, 0x5e, 0x1, 0x22, 0x87, 0x1, 0x5f, 
+0, 0x60, 0x1, 0x78, 0x87, 0x1, 0x52, 0x1, 0x61, 0x78, 0x87, 0x1, 0x21, 0x62, 
+0x2, 0x22, 0x87, 0x1, 0x63, 0x7b, 0x87, 0x1, 0x3, 0x76, 0x88, 0x1, 0x64, 0x28, 
+0x88, 0x1, 0x2e, 0x88, 0x1, 0x78, 0x88, 0x1, 0x63, 0x65, 0, 0, 0x28, 0x8b, 0x1, 
+0x78, 0x8b, 0x1, 0x47, 0x4, 0x7b, 0x8b, 0x1, 0x1, 0x76, 0x8b, 0x1, 0x48, 0x31, 
+0x8b, 0x1, 0x1, 0, 0, 0, 0, 0, 0, 0, 0x7b, 0x8b, 0x1, 0x1, 0x28, 0x8b, 0x1, 
+0x78, 0x8b, 0x1, 0x1f, 0x1, 0x2b, 0x8b, 0x1, 0x7, 0x78, 0x8b, 0x1, 0x48, 0x78, 
+0x8b, 0x1, 0x54, 0, 0x7b, 0x8b, 0x1, 0x1, 0x3d, 0x8b, 0x1, 0x48, 0x2b, 0x8b, 
+0x1, 0, 0x78, 0x8b, 0x1, 0x48, 0x31, 0x8b, 0x1, 0x1, 0, 0, 0, 0, 0, 0, 0, 0x7b, 
+0x8b, 0x1, 0x1, 0x76, 0x8c, 0x1, 0x10, 0x28, 0x8c, 0x1, 0x2e, 0x8c, 0x1, 0x28, 
+0x8c, 0x1, 0x2e, 0x8c, 0x1, 0x78, 0x8c, 0x1, 0x64, 0x66, 0, 0, 0x39, 0, 0, 0, 
+0x3d, 0x8e, 0x1, 0x1a, 0x28, 0x8e, 0x1, 0x2e, 0x8e, 0x1, 0x78, 0x8e, 0x1, 0x64, 
+0x66, 0, 0, 0, 0x5b, 0x90, 0x1, 0x2, 0x78, 0x90, 0x1, 0x5, 0x22, 0x90, 0x1, 
+0x4f, 0x7b, 0x90, 0x1, 0, 0, 0x28, 0x92, 0x1, 0x78, 0x92, 0x1, 0x35, 0x2, 0x28, 
+0x92, 0x1, 0x78, 0x92, 0x1, 0x36, 0x2, 0x78, 0x92, 0x1, 0x1a, 0x78, 0x92, 0x1, 
+0x37, 0, 0x7b, 0x92, 0x1, 0x1, 0x28, 0x93, 0x1, 0x78, 0x93, 0x1, 0x1f, 0x1, 
+0x78, 0x93, 0x1, 0x1a, 0, 0, 0x28, 0x95, 0x1, 0x78, 0x95, 0x1, 0x1f, 0x1, 0x28, 
+0x95, 0x1, 0x78, 0x95, 0x1, 0x4, 0x2, 0x78, 0x95, 0x1, 0x34, 0x28, 0x95, 0x1, 
+0x78, 0x95, 0x1, 0x58, 0x1, 0x28, 0x95, 0x1, 0x2e, 0x95, 0x1, 0x78, 0x95, 0x1, 
+0x1a, 0x39, 0, 0, 0, 0, 0, 0x1, 0x20, 0x78, 0x82, 0x1, 0x21, 0x28, 0x98, 0x1, 
+0x78, 0x98, 0x1, 0x16, 0x3, 0x78, 0x98, 0x1, 0x5, 0x22, 0x98, 0x1, 0x67, 0x28, 
+0x98, 0x1, 0x78, 0x98, 0x1, 0xe, 0x2, 0x22, 0x98, 0x1, 0x19, 0x7b, 0x98, 0x1, 
+0x1, 0x28, 0x9a, 0x1, 0x78, 0x9a, 0x1, 0x4d, 0x3, 0x7b, 0x9a, 0x1, 0x3, 0x28, 
+0x9b, 0x1, 0x78, 0x9b, 0x1, 0x68, 0x1, 0x2b, 0x9b, 0x1, 0, 0x2b, 0x9b, 0x1, 0, 
+0x2e, 0x9b, 0x1, 0x28, 0x9b, 0x1, 0x78, 0x9b, 0x1, 0x1, 0x1, 0x78, 0x9b, 0x1, 
+0x19, 0, 0x1d, 0x22, 0x9b, 0x1, 0x2b, 0x2e, 0x9b, 0x1, 0x78, 0x9b, 0x1, 0x19, 
+0x2c, 0, 0x76, 0x9d, 0x1, 0x69, 0x22, 0x9d, 0x1, 0x6a, 0x28, 0x9e, 0x1, 0x78, 
+0x9e, 0x1, 0x47, 0x4, 0x7b, 0x9e, 0x1, 0x1, 0x76, 0x9e, 0x1, 0x6b, 0x28, 0x9e, 
+0x1, 0x2e, 0x9e, 0x1, 0x2e, 0x9e, 0x1, 0x78, 0x9e, 0x1, 0x19, 0x50, 0x5a, 0x1, 
+0x31, 0x9e, 0x1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x7b, 0x9e, 0x1, 0x1, 0x28, 0x9e, 
+0x1, 0x78, 0x9e, 0x1, 0x1f, 0x1, 0x2b, 0x9e, 0x1, 0x5, 0x2e, 0x9e, 0x1, 0x78, 
+0x9e, 0x1, 0x6b, 0x42, 0x31, 0x9e, 0x1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x7b, 0x9e, 
+0x1, 0, 0x7b, 0x9e, 0x1, 0x4, 0x76, 0x9f, 0x1, 0x6c, 0x28, 0x9f, 0x1, 0x2e, 
+0x9f, 0x1, 0x78, 0x9f, 0x1, 0x6b, 0x6d, 0, 0, 0x28, 0xa0, 0x1, 0x78, 0xa0, 0x1, 
+0x68, 0x1, 0x2b, 0xa0, 0x1, 0, 0x2b, 0xa0, 0x1, 0, 0x2b, 0xa0, 0x1, 0, 0x22, 
+0xa0, 0x1, 0x6e, 0x78, 0xa0, 0x1, 0x69, 0x22, 0xa0, 0x1, 0x49, 0x28, 0xa0, 0x1, 
+0x2e, 0xa0, 0x1, 0x78, 0xa0, 0x1, 0x6c, 0x3e, 0, 0, 0, 0x28, 0xa2, 0x1, 0x78, 
+0xa2, 0x1, 0x35, 0x2, 0x2b, 0xa2, 0x1, 0x5, 0x2e, 0xa2, 0x1, 0x78, 0xa2, 0x1, 
+0x6c, 0x52, 0x22, 0xa2, 0x1, 0x6f, 0x7b, 0xa2, 0x1, 0x2, 0x76, 0xa3, 0x1, 0x70, 
+0x28, 0xa3, 0x1, 0x78, 0xa3, 0x1, 0x5c, 0x2, 0x2e, 0xa3, 0x1, 0x78, 0xa3, 0x1, 
+0x6c, 0x52, 0x2e, 0xa3, 0x1, 0x78, 0xa3, 0x1, 0x6c, 0x54, 0, 0x28, 0xa4, 0x1, 
+0x78, 0xa4, 0x1, 0x35, 0x2, 0x28, 0xa4, 0x1, 0x78, 0xa4, 0x1, 0x36, 0x2, 0x28, 
+0xa4, 0x1, 0x78, 0xa4, 0x1, 0x36, 0x2, 0x78, 0xa4, 0x1, 0x70, 0x78, 0xa4, 0x1, 
+0x37, 0, 0x78, 0xa4, 0x1, 0x32, 0, 0x7b, 0xa4, 0x1, 0x1, 0x28, 0xa5, 0x1, 0x78, 
+0xa5, 0x1, 0x68, 0x1, 0x2b, 0xa5, 0x1, 0, 0x22, 0xa5, 0x1, 0x71, 0x28, 0xa5, 
+0x1, 0x2e, 0xa5, 0x1, 0x78, 0xa5, 0x1, 0x70, 0x39, 0, 0, 0, 0, 0, 0x28, 0xa9, 
+0x1, 0x78, 0xa9, 0x1, 0x35, 0x2, 0x2b, 0xa9, 0x1, 0x4, 0x78, 0xa9, 0x1, 0x69, 
+0x22, 0xa9, 0x1, 0x6a, 0x7b, 0xa9, 0x1, 0x1, 0x3d, 0xaa, 0x1, 0x69, 0x22, 0xaa, 
+0x1, 0x72, 0, 0, 0x5b, 0xad, 0x1, 0x2, 0x78, 0xad, 0x1, 0x5, 0x22, 0xad, 0x1, 
+0x4f, 0x7b, 0xad, 0x1, 0x1, 0x28, 0xae, 0x1, 0x78, 0xae, 0x1, 0x4d, 0x3, 0x7b, 
+0xae, 0x1, 0x7, 0x28, 0xaf, 0x1, 0x78, 0xaf, 0x1, 0x68, 0x1, 0x22, 0xaf, 0x1, 
+0x73, 0, 0x28, 0xb0, 0x1, 0x78, 0xb0, 0x1, 0x68, 0x1, 0x2e, 0xb0, 0x1, 0x28, 
+0xb0, 0x1, 0x78, 0xb0, 0x1, 0x1, 0x1, 0x78, 0xb0, 0x1, 0x4f, 0, 0x1d, 0, 0x28, 
+0xb1, 0x1, 0x78, 0xb1, 0x1, 0x68, 0x1, 0x2e, 0xb1, 0x1, 0x78, 0xb1, 0x1, 0x4f, 
+0x2c, 0, 0x28, 0xb2, 0x1, 0x78, 0xb2, 0x1, 0x68, 0x1, 0x22, 0xb2, 0x1, 0x74, 0, 
+0x28, 0xb3, 0x1, 0x78, 0xb3, 0x1, 0x68, 0x1, 0x22, 0xb3, 0x1, 0x75, 0, 0x28, 
+0xb4, 0x1, 0x78, 0xb4, 0x1, 0x68, 0x1, 0x2e, 0xb4, 0x1, 0x28, 0xb4, 0x1, 0x78, 
+0xb4, 0x1, 0x1, 0x1, 0x78, 0xb4, 0x1, 0x19, 0, 0x1d, 0, 0x28, 0xb5, 0x1, 0x78, 
+0xb5, 0x1, 0x68, 0x1, 0x2e, 0xb5, 0x1, 0x78, 0xb5, 0x1, 0x19, 0x2c, 0, 0x78, 
+0xb6, 0x1, 0x5, 0x7b, 0xb6, 0x1, 0, 0, 0, 0, 0, 0x56, 0x1, 0x28, 0xbe, 0x1, 
+0x78, 0xbe, 0x1, 0x4, 0x2, 0x78, 0xbe, 0x1, 0x57, 0x2e, 0xbe, 0x1, 0x7b, 0xbe, 
+0x1, 0, 0x13, 0, 0, 0x76, 0xc1, 0x1, 0x76, 0x28, 0xc1, 0x1, 0x78, 0xc1, 0x1, 
+0xe, 0x2, 0x22, 0xc1, 0x1, 0x77, 0x7b, 0xc1, 0x1, 0x6, 0x76, 0xc2, 0x1, 0x78, 
+0x28, 0xc2, 0x1, 0x2e, 0xc2, 0x1, 0x78, 0xc2, 0x1, 0x79, 0x7a, 0, 0, 0x28, 
+0xc3, 0x1, 0x78, 0xc3, 0x1, 0x35, 0x2, 0x2b, 0xc3, 0x1, 0x4, 0x2e, 0xc3, 0x1, 
+0x78, 0xc3, 0x1, 0x78, 0x42, 0x31, 0xc3, 0x1, 0, 0, 0, 0, 0, 0, 0, 0, 0x7b, 
+0xc3, 0x1, 0x1, 0x28, 0xc4, 0x1, 0x78, 0xc4, 0x1, 0x2f, 0x1, 0x28, 0xc4, 0x1, 
+0x78, 0xc4, 0x1, 0x4, 0x2, 0x78, 0xc4, 0x1, 0xc, 0x22, 0xc4, 0x1, 0x7b, 0, 0, 
+0, 0x76, 0xc8, 0x1, 0x7c, 0x28, 0xc8, 0x1, 0x2e, 0xc8, 0x1, 0x22, 0xc8, 0x1, 
+0x49, 0x7d, 0x1, 0x28, 0xc8, 0x1, 0x2e, 0xc8, 0x1, 0x78, 0xc8, 0x1, 0x78, 0x5a, 
+0x1, 0x31, 0xc8, 0x1, 0x1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x76, 0xca, 0x1, 0x1a, 
+0x28, 0xca, 0x1, 0x78, 0xca, 0x1, 0xe, 0x2, 0x78, 0xca, 0x1, 0x7c, 0x78, 0xca, 
+0x1, 0x7e, 0x1, 0x20, 0x28, 0xca, 0x1, 0x2e, 0xca, 0x1, 0x78, 0xca, 0x1, 0x20, 
+0x3a, 0x1, 0x78, 0xca, 0x1, 0x32, 0, 0x2a, 0xcb, 0x1, 0x78, 0xcb, 0x1, 0x1a, 
+0x1d, 0x28, 0xcb, 0x1, 0x2e, 0xcb, 0x1, 0x78, 0xcb, 0x1, 0x78, 0x33, 0x1, 0x31, 
+0xcb, 0x1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x28, 0xcc, 0x1, 0x2e, 0xcc, 0x1, 0x2e, 
+0xcc, 0x1, 0x2e, 0xcc, 0x1, 0x78, 0xcc, 0x1, 0x7e, 0x13, 0x14, 0x25, 0x2, 0x2e, 
+0xcc, 0x1, 0x78, 0xcc, 0x1, 0x1a, 0x1d, 0x78, 0xcc, 0x1, 0x1a, 0, 0, 0x2a, 
+0xce, 0x1, 0x78, 0xce, 0x1, 0x76, 0x1d, 0x22, 0xce, 0x1, 0x76, 0x28, 0xd0, 0x1, 
+0x78, 0xd0, 0x1, 0x76, 0x2, 0x22, 0xd0, 0x1, 0x7f, 0x7b, 0xd0, 0x1, 0x1, 0x28, 
+0xd1, 0x1, 0x78, 0xd1, 0x1, 0x47, 0x4, 0x7b, 0xd1, 0x1, 0, 0x78, 0xd1, 0x1, 
+0x80, 0x1, 0x7b, 0xd1, 0x1, 0, 0x78, 0xd1, 0x1, 0x81, 0x1, 0, 0, 0x28, 0xd5, 
+0x1, 0x78, 0xd5, 0x1, 0x76, 0x2, 0x22, 0xd5, 0x1, 0x82, 0x1, 0x7b, 0xd5, 0x1, 
+0x7, 0x76, 0xd6, 0x1, 0x83, 0x1, 0x28, 0xd6, 0x1, 0x78, 0xd6, 0x1, 0x4, 0x2, 
+0x78, 0xd6, 0x1, 0x57, 0x2e, 0xd6, 0x1, 0x78, 0xd6, 0x1, 0x84, 0x1, 0x13, 0, 
+0x28, 0xd8, 0x1, 0x78, 0xd8, 0x1, 0x76, 0x2, 0x22, 0xd8, 0x1, 0x85, 0x1, 0x7b, 
+0xd8, 0x1, 0x1, 0x28, 0xd9, 0x1, 0x78, 0xd9, 0x1, 0x35, 0x2, 0x2b, 0xd9, 0x1, 
+0x4, 0x78, 0xd9, 0x1, 0x86, 0x1, 0x78, 0xd9, 0x1, 0x87, 0x1, 0x7b, 0xd9, 0x1, 
+0x1, 0x28, 0xda, 0x1, 0x2e, 0xda, 0x1, 0x78, 0xda, 0x1, 0x7e, 0x56, 0x1, 0x28, 
+0xda, 0x1, 0x78, 0xda, 0x1, 0x4, 0x2, 0x78, 0xda, 0x1, 0x57, 0x78, 0xda, 0x1, 
+0x83, 0x1, 0, 0, 0, 0, 0x28, 0xde, 0x1, 0x78, 0xde, 0x1, 0x76, 0x2, 0x22, 0xde, 
+0x1, 0x88, 0x1, 0x7b, 0xde, 0x1, 0x1, 0x28, 0xe0, 0x1, 0x2e, 0xe0, 0x1, 0x78, 
+0xe0, 0x1, 0x7e, 0x56, 0x1, 0x28, 0xe0, 0x1, 0x78, 0xe0, 0x1, 0x4, 0x2, 0x78, 
+0xe0, 0x1, 0x57, 0x78, 0xe0, 0x1, 0x83, 0x1, 0, 0, 0, 0x28, 0xe3, 0x1, 0x2e, 
+0xe3, 0x1, 0x2e, 0xe3, 0x1, 0x78, 0xe3, 0x1, 0x83, 0x1, 0x14, 0x25, 0x2, 0x22, 
+0xe3, 0x1, 0x89, 0x1, 0x78, 0xe3, 0x1, 0x89, 0x1, 0, 0x28, 0xe4, 0x1, 0x2e, 
+0xe4, 0x1, 0x2e, 0xe4, 0x1, 0x78, 0xe4, 0x1, 0x83, 0x1, 0x14, 0x25, 0x2, 0x22, 
+0xe4, 0x1, 0x3c, 0x78, 0xe4, 0x1, 0x3c, 0, 0x28, 0xe5, 0x1, 0x2e, 0xe5, 0x1, 
+0x2e, 0xe5, 0x1, 0x78, 0xe5, 0x1, 0x83, 0x1, 0x14, 0x25, 0x2, 0x22, 0xe5, 0x1, 
+0x1f, 0x78, 0xe5, 0x1, 0x1f, 0, 0x28, 0xe6, 0x1, 0x2e, 0xe6, 0x1, 0x78, 0xe6, 
+0x1, 0x84, 0x1, 0x56, 0x1, 0x78, 0xe6, 0x1, 0x83, 0x1, 0, 0x1, 0x20, 0x78, 
+0xd5, 0x1, 0x21, 0x28, 0xee, 0x1, 0x78, 0xee, 0x1, 0x16, 0x3, 0x78, 0xee, 0x1, 
+0x2, 0x22, 0xee, 0x1, 0x26, 0x28, 0xee, 0x1, 0x78, 0xee, 0x1, 0xe, 0x2, 0x22, 
+0xee, 0x1, 0x19, 0x7b, 0xee, 0x1, 0x5, 0x76, 0xf0, 0x1, 0x1a, 0x28, 0xf0, 0x1, 
+0x2e, 0xf0, 0x1, 0x78, 0xf0, 0x1, 0x19, 0x8a, 0x1, 0x2, 0x22, 0xf0, 0x1, 0x8b, 
+0x1, 0x22, 0xf0, 0x1, 0x8c, 0x1, 0, 0x3d, 0xf1, 0x1, 0x1a, 0x28, 0xf1, 0x1, 
+0x2e, 0xf1, 0x1, 0x78, 0xf1, 0x1, 0x1a, 0x8a, 0x1, 0x2, 0x22, 0xf1, 0x1, 0x8d, 
+0x1, 0x22, 0xf1, 0x1, 0x8e, 0x1, 0, 0x3d, 0xf2, 0x1, 0x1a, 0x28, 0xf2, 0x1, 
+0x2e, 0xf2, 0x1, 0x78, 0xf2, 0x1, 0x1a, 0x8a, 0x1, 0x2, 0x22, 0xf2, 0x1, 0x5b, 
+0x22, 0xf2, 0x1, 0x8f, 0x1, 0, 0x3d, 0xf3, 0x1, 0x1a, 0x28, 0xf3, 0x1, 0x2e, 
+0xf3, 0x1, 0x78, 0xf3, 0x1, 0x1a, 0x8a, 0x1, 0x2, 0x22, 0xf3, 0x1, 0x90, 0x1, 
+0x22, 0xf3, 0x1, 0x91, 0x1, 0, 0x28, 0xf4, 0x1, 0x78, 0xf4, 0x1, 0x1f, 0x1, 
+0x2b, 0xf4, 0x1, 0, 0x2b, 0xf4, 0x1, 0, 0x22, 0xf4, 0x1, 0x90, 0x1, 0x78, 0xf4, 
+0x1, 0x1a, 0x22, 0xf4, 0x1, 0x90, 0x1, 0, 0x1, 0x20, 0x78, 0xee, 0x1, 0x21, 0, 
+0x28, 0xf8, 0x1, 0x78, 0xf8, 0x1, 0x76, 0x2, 0x22, 0xf8, 0x1, 0x92, 0x1, 0x7b, 
+0xf8, 0x1, 0x1, 0x28, 0xf9, 0x1, 0x78, 0xf9, 0x1, 0x68, 0x1, 0x28, 0xf9, 0x1, 
+0x2e, 0xf9, 0x1, 0x78, 0xf9, 0x1, 0x12, 0x26, 0, 0, 0, 0, 0x28, 0xfc, 0x1, 
+0x78, 0xfc, 0x1, 0x76, 0x2, 0x22, 0xfc, 0x1, 0x93, 0x1, 0x7b, 0xfc, 0x1, 0x2, 
+0x28, 0xfe, 0x1, 0x78, 0xfe, 0x1, 0x35, 0x2, 0x78, 0xfe, 0x1, 0x12, 0x7b, 0xfe, 
+0x1, 0x1, 0x28, 0xff, 0x1, 0x78, 0xff, 0x1, 0x1f, 0x1, 0x78, 0xff, 0x1, 0x32, 
+0, 0, 0x28, 0x81, 0x2, 0x78, 0x81, 0x2, 0x1f, 0x1, 0x78, 0x81, 0x2, 0x21, 0, 
+0x1, 0x20, 0x78, 0xfc, 0x1, 0x21, 0x28, 0x84, 0x2, 0x78, 0x84, 0x2, 0x76, 0x2, 
+0x22, 0x84, 0x2, 0x94, 0x1, 0x7b, 0x84, 0x2, 0x2, 0x28, 0x85, 0x2, 0x78, 0x85, 
+0x2, 0x35, 0x2, 0x78, 0x85, 0x2, 0x12, 0x7b, 0x85, 0x2, 0x1, 0x28, 0x86, 0x2, 
+0x78, 0x86, 0x2, 0x35, 0x2, 0x78, 0x86, 0x2, 0x95, 0x1, 0x7b, 0x86, 0x2, 0x1, 
+0x28, 0x87, 0x2, 0x78, 0x87, 0x2, 0x1f, 0x1, 0x78, 0x87, 0x2, 0x21, 0, 0, 0x1, 
+0x96, 0x1, 0x7b, 0x89, 0x2, 0x1, 0x76, 0x8c, 0x2, 0x10, 0x28, 0x8c, 0x2, 0x78, 
+0x8c, 0x2, 0x97, 0x1, 0x1, 0x78, 0x8c, 0x2, 0x95, 0x1, 0, 0x28, 0x8f, 0x2, 
+0x78, 0x8f, 0x2, 0x1f, 0x1, 0x78, 0x8f, 0x2, 0x32, 0, 0x1, 0x20, 0x78, 0x84, 
+0x2, 0x21, 0x28, 0x92, 0x2, 0x78, 0x92, 0x2, 0x76, 0x2, 0x22, 0x92, 0x2, 0x98, 
+0x1, 0x7b, 0x92, 0x2, 0x1, 0x28, 0x94, 0x2, 0x78, 0x94, 0x2, 0x1f, 0x1, 0x28, 
+0x94, 0x2, 0x78, 0x94, 0x2, 0x97, 0x1, 0x1, 0x28, 0x94, 0x2, 0x78, 0x94, 0x2, 
+0x99, 0x1, 0x2, 0x28, 0x94, 0x2, 0x78, 0x94, 0x2, 0x97, 0x1, 0x1, 0x78, 0x94, 
+0x2, 0x12, 0, 0x28, 0x94, 0x2, 0x78, 0x94, 0x2, 0x97, 0x1, 0x1, 0x78, 0x94, 
+0x2, 0x95, 0x1, 0, 0, 0, 0, 0x1, 0x20, 0x78, 0x92, 0x2, 0x21, 0x28, 0x97, 0x2, 
+0x78, 0x97, 0x2, 0x76, 0x2, 0x22, 0x97, 0x2, 0x9a, 0x1, 0x7b, 0x97, 0x2, 0x1, 
+0x28, 0x98, 0x2, 0x78, 0x98, 0x2, 0x35, 0x2, 0x28, 0x98, 0x2, 0x78, 0x98, 0x2, 
+0x97, 0x1, 0x1, 0x78, 0x98, 0x2, 0x80, 0x1, 0, 0x7b, 0x98, 0x2, 0x1, 0x28, 
+0x99, 0x2, 0x78, 0x99, 0x2, 0x2f, 0x1, 0x28, 0x99, 0x2, 0x78, 0x99, 0x2, 0x4, 
+0x2, 0x78, 0x99, 0x2, 0x6, 0x22, 0x99, 0x2, 0x9b, 0x1, 0, 0, 0, 0, 0x28, 0x9e, 
+0x2, 0x78, 0x9e, 0x2, 0x76, 0x2, 0x22, 0x9e, 0x2, 0x9c, 0x1, 0x7b, 0x9e, 0x2, 
+0x2, 0x76, 0x9f, 0x2, 0x9d, 0x1, 0x28, 0x9f, 0x2, 0x78, 0x9f, 0x2, 0x1, 0x1, 
+0x78, 0x9f, 0x2, 0x9e, 0x1, 0, 0x28, 0xa2, 0x2, 0x78, 0xa2, 0x2, 0x9f, 0x1, 
+0x2, 0x7b, 0xa2, 0x2, 0x1, 0x28, 0xa2, 0x2, 0x78, 0xa2, 0x2, 0x1f, 0x1, 0x78, 
+0xa2, 0x2, 0x21, 0, 0x7b, 0xa2, 0x2, 0x3, 0x28, 0xa3, 0x2, 0x78, 0xa3, 0x2, 
+0x35, 0x2, 0x28, 0xa3, 0x2, 0x78, 0xa3, 0x2, 0x36, 0x2, 0x78, 0xa3, 0x2, 0x9d, 
+0x1, 0x78, 0xa3, 0x2, 0x23, 0, 0x7b, 0xa3, 0x2, 0x1, 0x28, 0xa4, 0x2, 0x78, 
+0xa4, 0x2, 0x1f, 0x1, 0x78, 0xa4, 0x2, 0x21, 0, 0, 0x28, 0xa6, 0x2, 0x78, 0xa6, 
+0x2, 0x35, 0x2, 0x2b, 0xa6, 0x2, 0x4, 0x2e, 0xa6, 0x2, 0x78, 0xa6, 0x2, 0x9d, 
+0x1, 0xa0, 0x1, 0x78, 0xa6, 0x2, 0x37, 0x7b, 0xa6, 0x2, 0x1, 0x28, 0xa7, 0x2, 
+0x78, 0xa7, 0x2, 0x1f, 0x1, 0x78, 0xa7, 0x2, 0x32, 0, 0, 0x3d, 0xa9, 0x2, 0x9d, 
+0x1, 0x28, 0xa9, 0x2, 0x2e, 0xa9, 0x2, 0x2e, 0xa9, 0x2, 0x78, 0xa9, 0x2, 0x9d, 
+0x1, 0xa0, 0x1, 0x39, 0, 0, 0, 0x1, 0x20, 0x78, 0x9e, 0x2, 0x21, 0x28, 0xf4, 
+0x2, 0x2e, 0xf4, 0x2, 0x7b, 0xae, 0x2, 0x5, 0x76, 0xb0, 0x2, 0xa1, 0x1, 0x2e, 
+0xb0, 0x2, 0x2e, 0xb0, 0x2, 0x28, 0xb0, 0x2, 0x2e, 0xb0, 0x2, 0x2e, 0xb0, 0x2, 
+0x2e, 0xb0, 0x2, 0x7b, 0xb0, 0x2, 0, 0x13, 0xa2, 0x1, 0x39, 0, 0, 0x14, 0x15, 
+0x76, 0xb5, 0x2, 0xa3, 0x1, 0x28, 0xb5, 0x2, 0x78, 0xb5, 0x2, 0xa1, 0x1, 0x1, 
+0x22, 0xb5, 0x2, 0xa3, 0x1, 0, 0x76, 0xb6, 0x2, 0x16, 0x28, 0xb6, 0x2, 0x78, 
+0xb6, 0x2, 0xa1, 0x1, 0x1, 0x22, 0xb6, 0x2, 0x16, 0, 0x28, 0xb8, 0x2, 0x78, 
+0xb8, 0x2, 0x76, 0x2, 0x22, 0xb8, 0x2, 0xa4, 0x1, 0x7b, 0xb8, 0x2, 0xe, 0x76, 
+0xb9, 0x2, 0x23, 0x28, 0xb9, 0x2, 0x78, 0xb9, 0x2, 0x4, 0x3, 0x28, 0xb9, 0x2, 
+0x78, 0xb9, 0x2, 0x1, 0x1, 0x78, 0xb9, 0x2, 0x2, 0, 0x78, 0xb9, 0x2, 0xa5, 0x1, 
+0x28, 0xb9, 0x2, 0x2e, 0xb9, 0x2, 0x78, 0xb9, 0x2, 0xa6, 0x1, 0x3a, 0x1, 0x78, 
+0xb9, 0x2, 0xa7, 0x1, 0, 0, 0x28, 0xbb, 0x2, 0x78, 0xbb, 0x2, 0x76, 0x2, 0x22, 
+0xbb, 0x2, 0xa8, 0x1, 0x7b, 0xbb, 0x2, 0x3, 0x76, 0xbc, 0x2, 0xa9, 0x1, 0x28, 
+0xbc, 0x2, 0x78, 0xbc, 0x2, 0xe, 0x2, 0x22, 0xbc, 0x2, 0x19, 0x78, 0xbc, 0x2, 
+0x7e, 0x1, 0x20, 0x78, 0xbc, 0x2, 0x21, 0x2a, 0xbd, 0x2, 0x78, 0xbd, 0x2, 0xa9, 
+0x1, 0x1d, 0x2b, 0xbd, 0x2, 0, 0x22, 0xbd, 0x2, 0x22, 0x78, 0xbd, 0x2, 0x1d, 
+0x28, 0xbe, 0x2, 0x2e, 0xbe, 0x2, 0x2e, 0xbe, 0x2, 0x78, 0xbe, 0x2, 0x23, 0x24, 
+0x25, 0x2, 0x78, 0xbe, 0x2, 0x1d, 0x78, 0xbe, 0x2, 0xa9, 0x1, 0, 0, 0x28, 0xc1, 
+0x2, 0x78, 0xc1, 0x2, 0x76, 0x2, 0x22, 0xc1, 0x2, 0xaa, 0x1, 0x7b, 0xc1, 0x2, 
+0x3, 0x76, 0xc2, 0x2, 0xa9, 0x1, 0x28, 0xc2, 0x2, 0x78, 0xc2, 0x2, 0xe, 0x2, 
+0x2b, 0xc2, 0x2, 0, 0x22, 0xc2, 0x2, 0xab, 0x1, 0x78, 0xc2, 0x2, 0xac, 0x1, 
+0x78, 0xc2, 0x2, 0x7e, 0, 0x2a, 0xc3, 0x2, 0x78, 0xc3, 0x2, 0xa9, 0x1, 0x1d, 
+0x2b, 0xc3, 0x2, 0, 0x22, 0xc3, 0x2, 0xad, 0x1, 0x78, 0xc3, 0x2, 0x1d, 0x28, 
+0xc4, 0x2, 0x2e, 0xc4, 0x2, 0x2e, 0xc4, 0x2, 0x78, 0xc4, 0x2, 0x23, 0xae, 0x1, 
+0x25, 0x2, 0x78, 0xc4, 0x2, 0x1d, 0x78, 0xc4, 0x2, 0xa9, 0x1, 0, 0, 0x28, 0xc7, 
+0x2, 0x78, 0xc7, 0x2, 0x76, 0x2, 0x22, 0xc7, 0x2, 0xaf, 0x1, 0x7b, 0xc7, 0x2, 
+0x1, 0x28, 0xc8, 0x2, 0x78, 0xc8, 0x2, 0x18, 0x2, 0x78, 0xc8, 0x2, 0x1d, 0x7b, 
+0xc8, 0x2, 0x1, 0x28, 0xc9, 0x2, 0x78, 0xc9, 0x2, 0x2f, 0x1, 0x28, 0xc9, 0x2, 
+0x78, 0xc9, 0x2, 0x4, 0x2, 0x78, 0xc9, 0x2, 0x7, 0x2b, 0xc9, 0x2, 0, 0x22, 
+0xc9, 0x2, 0xb0, 0x1, 0x28, 0xc9, 0x2, 0x2e, 0xc9, 0x2, 0x78, 0xc9, 0x2, 0x1d, 
+0x26, 0, 0, 0, 0, 0, 0, 0x28, 0xcd, 0x2, 0x78, 0xcd, 0x2, 0x76, 0x2, 0x22, 
+0xcd, 0x2, 0xb1, 0x1, 0x7b, 0xcd, 0x2, 0x2, 0x28, 0xce, 0x2, 0x78, 0xce, 0x2, 
+0x18, 0x2, 0x78, 0xce, 0x2, 0x1d, 0x7b, 0xce, 0x2, 0x1, 0x28, 0xcf, 0x2, 0x78, 
+0xcf, 0x2, 0x4d, 0x3, 0x7b, 0xcf, 0x2, 0x1, 0x28, 0xd0, 0x2, 0x78, 0xd0, 0x2, 
+0x1f, 0x1, 0x28, 0xd0, 0x2, 0x2e, 0xd0, 0x2, 0x28, 0xd0, 0x2, 0x78, 0xd0, 0x2, 
+0xa3, 0x1, 0x1, 0x78, 0xd0, 0x2, 0x19, 0, 0x33, 0x1, 0x78, 0xd0, 0x2, 0x1d, 0, 
+0, 0x78, 0xd1, 0x2, 0x9, 0x7b, 0xd1, 0x2, 0x1, 0x28, 0xd2, 0x2, 0x78, 0xd2, 
+0x2, 0x2f, 0x1, 0x28, 0xd2, 0x2, 0x78, 0xd2, 0x2, 0x4, 0x2, 0x78, 0xd2, 0x2, 
+0x7, 0x2b, 0xd2, 0x2, 0, 0x2b, 0xd2, 0x2, 0, 0x22, 0xd2, 0x2, 0xb2, 0x1, 0x28, 
+0xd2, 0x2, 0x2e, 0xd2, 0x2, 0x78, 0xd2, 0x2, 0x1d, 0x26, 0, 0, 0x22, 0xd2, 0x2, 
+0xb3, 0x1, 0, 0, 0, 0, 0x28, 0xd5, 0x2, 0x78, 0xd5, 0x2, 0xb4, 0x1, 0x3, 0x78, 
+0xd5, 0x2, 0x1d, 0x22, 0xd5, 0x2, 0xb5, 0x1, 0x7b, 0xd5, 0x2, 0x1, 0x28, 0xd6, 
+0x2, 0x2e, 0xd6, 0x2, 0x28, 0xd6, 0x2, 0x78, 0xd6, 0x2, 0xa3, 0x1, 0x1, 0x78, 
+0xd6, 0x2, 0x19, 0, 0x25, 0x2, 0x78, 0xd6, 0x2, 0x1d, 0x78, 0xd6, 0x2, 0xb5, 
+0x1, 0, 0, 0, 0x28, 0xda, 0x2, 0x78, 0xda, 0x2, 0x76, 0x2, 0x22, 0xda, 0x2, 
+0xb6, 0x1, 0x7b, 0xda, 0x2, 0x4, 0x76, 0xdc, 0x2, 0x78, 0x28, 0xdc, 0x2, 0x2e, 
+0xdc, 0x2, 0x78, 0xdc, 0x2, 0xb7, 0x1, 0x7a, 0, 0, 0x28, 0xdd, 0x2, 0x78, 0xdd, 
+0x2, 0x35, 0x2, 0x2b, 0xdd, 0x2, 0x4, 0x2e, 0xdd, 0x2, 0x78, 0xdd, 0x2, 0x78, 
+0x42, 0x31, 0xdd, 0x2, 0, 0, 0, 0, 0, 0, 0, 0, 0x7b, 0xdd, 0x2, 0x1, 0x28, 
+0xde, 0x2, 0x78, 0xde, 0x2, 0x2f, 0x1, 0x28, 0xde, 0x2, 0x78, 0xde, 0x2, 0x4, 
+0x2, 0x78, 0xde, 0x2, 0xc, 0x22, 0xde, 0x2, 0xb8, 0x1, 0, 0, 0, 0x76, 0xe2, 
+0x2, 0xb9, 0x1, 0x2b, 0xe2, 0x2, 0, 0x22, 0xe2, 0x2, 0xab, 0x1, 0x28, 0xe2, 
+0x2, 0x2e, 0xe2, 0x2, 0x22, 0xe2, 0x2, 0x49, 0x7d, 0x1, 0x28, 0xe2, 0x2, 0x2e, 
+0xe2, 0x2, 0x78, 0xe2, 0x2, 0x78, 0x5a, 0x1, 0x31, 0xe2, 0x2, 0x1, 0, 0, 0, 0, 
+0, 0, 0, 0, 0, 0x28, 0xe4, 0x2, 0x78, 0xe4, 0x2, 0x16, 0x3, 0x78, 0xe4, 0x2, 
+0x23, 0x28, 0xe4, 0x2, 0x2e, 0xe4, 0x2, 0x78, 0xe4, 0x2, 0x78, 0x33, 0x1, 0x31, 
+0xe4, 0x2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x28, 0xe4, 0x2, 0x78, 0xe4, 0x2, 0xe, 
+0x2, 0x78, 0xe4, 0x2, 0xb9, 0x1, 0x78, 0xe4, 0x2, 0x7e, 0x1, 0x20, 0x28, 0xe4, 
+0x2, 0x2e, 0xe4, 0x2, 0x78, 0xe4, 0x2, 0x20, 0x3a, 0x1, 0x78, 0xe4, 0x2, 0x32, 
+0, 0, 0, 0x76, 0xe7, 0x2, 0xba, 0x1, 0x28, 0xe7, 0x2, 0x78, 0xe7, 0x2, 0x4, 
+0x2, 0x78, 0xe7, 0x2, 0x57, 0x2e, 0xe7, 0x2, 0x78, 0xe7, 0x2, 0xbb, 0x1, 0x13, 
+0, 0x28, 0xe8, 0x2, 0x2e, 0xe8, 0x2, 0x2e, 0xe8, 0x2, 0x78, 0xe8, 0x2, 0xba, 
+0x1, 0x14, 0x25, 0x2, 0x22, 0xe8, 0x2, 0x18, 0x78, 0xe8, 0x2, 0x18, 0, 0x28, 
+0xe9, 0x2, 0x2e, 0xe9, 0x2, 0x2e, 0xe9, 0x2, 0x78, 0xe9, 0x2, 0xba, 0x1, 0x14, 
+0x25, 0x2, 0x22, 0xe9, 0x2, 0xb4, 0x1, 0x78, 0xe9, 0x2, 0xb4, 0x1, 0, 0x28, 
+0xea, 0x2, 0x2e, 0xea, 0x2, 0x2e, 0xea, 0x2, 0x78, 0xea, 0x2, 0xba, 0x1, 0x14, 
+0x25, 0x2, 0x22, 0xea, 0x2, 0xbc, 0x1, 0x78, 0xea, 0x2, 0xbc, 0x1, 0, 0x28, 
+0xeb, 0x2, 0x2e, 0xeb, 0x2, 0x2e, 0xeb, 0x2, 0x78, 0xeb, 0x2, 0xba, 0x1, 0x14, 
+0x25, 0x2, 0x22, 0xeb, 0x2, 0xbd, 0x1, 0x78, 0xeb, 0x2, 0xbd, 0x1, 0, 0x28, 
+0xec, 0x2, 0x2e, 0xec, 0x2, 0x2e, 0xec, 0x2, 0x78, 0xec, 0x2, 0xba, 0x1, 0x14, 
+0x25, 0x2, 0x22, 0xec, 0x2, 0xbe, 0x1, 0x78, 0xec, 0x2, 0xbe, 0x1, 0, 0x28, 
+0xed, 0x2, 0x2e, 0xed, 0x2, 0x78, 0xed, 0x2, 0xbb, 0x1, 0x56, 0x1, 0x78, 0xed, 
+0x2, 0xba, 0x1, 0, 0x28, 0xef, 0x2, 0x2e, 0xef, 0x2, 0x2e, 0xef, 0x2, 0x2e, 
+0xef, 0x2, 0x78, 0xef, 0x2, 0xbb, 0x1, 0x13, 0x14, 0x25, 0x2, 0x78, 0xef, 0x2, 
+0xa5, 0x1, 0x78, 0xef, 0x2, 0x23, 0, 0, 0x28, 0xf3, 0x2, 0x2e, 0xf3, 0x2, 0x2e, 
+0xf3, 0x2, 0x28, 0xf3, 0x2, 0x2e, 0xf3, 0x2, 0x2e, 0xf3, 0x2, 0x2e, 0xf3, 0x2, 
+0x7b, 0xf3, 0x2, 0, 0x13, 0xa2, 0x1, 0x39, 0, 0, 0x14, 0x25, 0x2, 0x22, 0xf3, 
+0x2, 0xbf, 0x1, 0x78, 0xf3, 0x2, 0xbf, 0x1, 0, 0x56, 0x1, 0x28, 0xf4, 0x2, 
+0x78, 0xf4, 0x2, 0x4, 0x2, 0x78, 0xf4, 0x2, 0x57, 0x2e, 0xf4, 0x2, 0x7b, 0xf4, 
+0x2, 0, 0x13, 0, 0, 0x28, 0xaf, 0x3, 0x2e, 0xaf, 0x3, 0x7b, 0xf7, 0x2, 0x5, 
+0x28, 0xf9, 0x2, 0x78, 0xf9, 0x2, 0x76, 0x2, 0x22, 0xf9, 0x2, 0xc0, 0x1, 0x7b, 
+0xf9, 0x2, 0x1, 0x28, 0xfa, 0x2, 0x78, 0xfa, 0x2, 0x2f, 0x1, 0x28, 0xfa, 0x2, 
+0x78, 0xfa, 0x2, 0x4, 0x2, 0x78, 0xfa, 0x2, 0xb, 0x2b, 0xfb, 0x2, 0, 0x2b, 
+0xfb, 0x2, 0, 0x2b, 0xfa, 0x2, 0, 0x22, 0xfa, 0x2, 0xc1, 0x1, 0x28, 0xfb, 0x2, 
+0x2e, 0xfb, 0x2, 0x78, 0xfb, 0x2, 0xc2, 0x1, 0x26, 0, 0, 0x22, 0xfb, 0x2, 0xc3, 
+0x1, 0x28, 0xfb, 0x2, 0x2e, 0xfb, 0x2, 0x78, 0xfb, 0x2, 0xc4, 0x1, 0x26, 0, 0, 
+0, 0, 0, 0x76, 0xff, 0x2, 0xc5, 0x1, 0x78, 0xff, 0x2, 0xc5, 0x1, 0x76, 0x84, 
+0x3, 0xc6, 0x1, 0x78, 0x84, 0x3, 0xa7, 0x1, 0x28, 0x86, 0x3, 0x78, 0x86, 0x3, 
+0x76, 0x2, 0x22, 0x86, 0x3, 0xc7, 0x1, 0x7b, 0x86, 0x3, 0x6, 0x76, 0x88, 0x3, 
+0x50, 0x5b, 0x88, 0x3, 0, 0x28, 0x89, 0x3, 0x78, 0x89, 0x3, 0x4d, 0x3, 0x7b, 
+0x89, 0x3, 0x1, 0x28, 0x8a, 0x3, 0x78, 0x8a, 0x3, 0x2f, 0x1, 0x28, 0x8a, 0x3, 
+0x78, 0x8a, 0x3, 0x4, 0x2, 0x78, 0x8a, 0x3, 0x5, 0x22, 0x8a, 0x3, 0xc8, 0x1, 0, 
+0, 0x5b, 0x8b, 0x3, 0x2, 0x78, 0x8b, 0x3, 0x5, 0x22, 0x8b, 0x3, 0x4f, 0x7b, 
+0x8b, 0x3, 0x1, 0x3d, 0x8c, 0x3, 0x50, 0x2e, 0x8c, 0x3, 0x78, 0x8c, 0x3, 0x4f, 
+0x50, 0, 0x28, 0x8e, 0x3, 0x78, 0x8e, 0x3, 0xc9, 0x1, 0x1, 0x2b, 0x8e, 0x3, 
+0x6, 0x2e, 0x8e, 0x3, 0x78, 0x8e, 0x3, 0x50, 0x42, 0x31, 0x8e, 0x3, 0, 0, 0, 0, 
+0, 0, 0, 0, 0, 0x76, 0x93, 0x3, 0x6c, 0x28, 0x93, 0x3, 0x2e, 0x93, 0x3, 0x78, 
+0x93, 0x3, 0x50, 0x33, 0x1, 0x2b, 0x93, 0x3, 0x1, 0x2e, 0x93, 0x3, 0x78, 0x93, 
+0x3, 0x50, 0x42, 0x31, 0x93, 0x3, 0x3, 0, 0, 0, 0, 0, 0, 0, 0, 0x28, 0x96, 0x3, 
+0x78, 0x96, 0x3, 0x47, 0x4, 0x7b, 0x96, 0x3, 0x1, 0x76, 0x96, 0x3, 0x48, 0x31, 
+0x96, 0x3, 0, 0, 0, 0, 0, 0, 0, 0, 0x7b, 0x96, 0x3, 0x1, 0x28, 0x96, 0x3, 0x78, 
+0x96, 0x3, 0x1f, 0x1, 0x2b, 0x96, 0x3, 0x7, 0x78, 0x96, 0x3, 0x48, 0x2e, 0x96, 
+0x3, 0x78, 0x96, 0x3, 0xc5, 0x1, 0x42, 0, 0x7b, 0x96, 0x3, 0x1, 0x3d, 0x96, 
+0x3, 0x48, 0x2b, 0x96, 0x3, 0, 0x78, 0x96, 0x3, 0x48, 0x31, 0x96, 0x3, 0x1, 0, 
+0, 0, 0, 0, 0, 0, 0x7b, 0x96, 0x3, 0x4, 0x76, 0x97, 0x3, 0xc2, 0x1, 0x28, 0x97, 
+0x3, 0x2e, 0x97, 0x3, 0x78, 0x97, 0x3, 0xc5, 0x1, 0x33, 0x1, 0x78, 0x97, 0x3, 
+0x48, 0, 0x76, 0x99, 0x3, 0xca, 0x1, 0x28, 0x99, 0x3, 0x78, 0x99, 0x3, 0xc2, 
+0x1, 0x2, 0x78, 0x99, 0x3, 0x59, 0x78, 0x99, 0x3, 0x6c, 0, 0x28, 0x9a, 0x3, 
+0x78, 0x9a, 0x3, 0x35, 0x2, 0x28, 0x9a, 0x3, 0x78, 0x9a, 0x3, 0x97, 0x1, 0x1, 
+0x28, 0x9a, 0x3, 0x78, 0x9a, 0x3, 0xcb, 0x1, 0x2, 0x78, 0x9a, 0x3, 0xca, 0x1, 
+0x78, 0x9a, 0x3, 0x34, 0, 0, 0x7b, 0x9a, 0x3, 0x1, 0x28, 0x9b, 0x3, 0x78, 0x9b, 
+0x3, 0xcc, 0x1, 0x2, 0x78, 0x9b, 0x3, 0xc2, 0x1, 0x78, 0x9b, 0x3, 0xca, 0x1, 0, 
+0, 0x28, 0x9e, 0x3, 0x78, 0x9e, 0x3, 0x35, 0x2, 0x2b, 0x9e, 0x3, 0x5, 0x78, 
+0x9e, 0x3, 0xca, 0x1, 0x78, 0x9e, 0x3, 0x37, 0x7b, 0x9e, 0x3, 0x3, 0x28, 0x9f, 
+0x3, 0x78, 0x9f, 0x3, 0x35, 0x2, 0x28, 0x9f, 0x3, 0x78, 0x9f, 0x3, 0x97, 0x1, 
+0x1, 0x28, 0x9f, 0x3, 0x78, 0x9f, 0x3, 0xcb, 0x1, 0x2, 0x28, 0x9f, 0x3, 0x2e, 
+0x9f, 0x3, 0x78, 0x9f, 0x3, 0xca, 0x1, 0x39, 0, 0, 0x78, 0x9f, 0x3, 0xc6, 0x1, 
+0, 0, 0x7b, 0x9f, 0x3, 0x1, 0x28, 0xa0, 0x3, 0x78, 0xa0, 0x3, 0xcc, 0x1, 0x2, 
+0x78, 0xa0, 0x3, 0xc2, 0x1, 0x78, 0xa0, 0x3, 0xca, 0x1, 0, 0, 0x28, 0xa3, 0x3, 
+0x78, 0xa3, 0x3, 0x35, 0x2, 0x28, 0xa3, 0x3, 0x78, 0xa3, 0x3, 0x36, 0x2, 0x78, 
+0xa3, 0x3, 0xc6, 0x1, 0x78, 0xa3, 0x3, 0xa7, 0x1, 0, 0x7b, 0xa3, 0x3, 0x1, 
+0x3d, 0xa4, 0x3, 0xc6, 0x1, 0x28, 0xa4, 0x3, 0x78, 0xa4, 0x3, 0x1, 0x1, 0x28, 
+0xa4, 0x3, 0x2e, 0xa4, 0x3, 0x78, 0xa4, 0x3, 0xca, 0x1, 0x39, 0, 0, 0, 0, 0x28, 
+0xa6, 0x3, 0x78, 0xa6, 0x3, 0x1f, 0x1, 0x28, 0xa6, 0x3, 0x2e, 0xa6, 0x3, 0x78, 
+0xa6, 0x3, 0xca, 0x1, 0x39, 0, 0, 0, 0, 0, 0x28, 0xab, 0x3, 0x78, 0xab, 0x3, 
+0x2f, 0x1, 0x28, 0xab, 0x3, 0x78, 0xab, 0x3, 0x4, 0x2, 0x78, 0xab, 0x3, 0xc, 
+0x2b, 0xab, 0x3, 0, 0x22, 0xab, 0x3, 0xcd, 0x1, 0x28, 0xab, 0x3, 0x2e, 0xab, 
+0x3, 0x78, 0xab, 0x3, 0x59, 0x26, 0, 0, 0, 0, 0x1, 0x20, 0x78, 0x86, 0x3, 0x21, 
+0x28, 0xae, 0x3, 0x2e, 0xae, 0x3, 0x2e, 0xae, 0x3, 0x28, 0xae, 0x3, 0x2e, 0xae, 
+0x3, 0x2e, 0xae, 0x3, 0x2e, 0xae, 0x3, 0x7b, 0xae, 0x3, 0, 0x13, 0xa2, 0x1, 
+0x39, 0, 0, 0x14, 0x25, 0x2, 0x22, 0xae, 0x3, 0x5e, 0x78, 0xae, 0x3, 0x5e, 0, 
+0x56, 0x1, 0x28, 0xaf, 0x3, 0x78, 0xaf, 0x3, 0x4, 0x2, 0x78, 0xaf, 0x3, 0x57, 
+0x2e, 0xaf, 0x3, 0x7b, 0xaf, 0x3, 0, 0x13, 0, 0, 0x76, 0xb3, 0x3, 0x10, 0x28, 
+0xb3, 0x3, 0x78, 0xb3, 0x3, 0x5e, 0x1, 0x22, 0xb3, 0x3, 0xce, 0x1, 0, 0x76, 
+0xb4, 0x3, 0x10, 0x28, 0xb4, 0x3, 0x78, 0xb4, 0x3, 0x5e, 0x1, 0x22, 0xb4, 0x3, 
+0xcf, 0x1, 0, 0x76, 0xb5, 0x3, 0x10, 0x28, 0xb5, 0x3, 0x78, 0xb5, 0x3, 0x5e, 
+0x1, 0x22, 0xb5, 0x3, 0xd0, 0x1, 0, 0x76, 0xb6, 0x3, 0x10, 0x28, 0xb6, 0x3, 
+0x78, 0xb6, 0x3, 0x5e, 0x1, 0x22, 0xb6, 0x3, 0xd1, 0x1, 0, 0x76, 0xb7, 0x3, 
+0x10, 0x28, 0xb7, 0x3, 0x78, 0xb7, 0x3, 0x5e, 0x1, 0x22, 0xb7, 0x3, 0x5f, 0, 
+0x28, 0xb8, 0x3, 0x2e, 0xb8, 0x3, 0x2e, 0xb8, 0x3, 0x2e, 0xb8, 0x3, 0x7b, 0xb8, 
+0x3, 0, 0x13, 0x14, 0xd2, 0x1, 0x1, 0x22, 0xb8, 0x3, 0x10, 0, 0x28, 0xbc, 0x3, 
+0x2e, 0xbc, 0x3, 0x2e, 0xbc, 0x3, 0x28, 0xbc, 0x3, 0x78, 0xbc, 0x3, 0x1, 0x1, 
+0x78, 0xbc, 0x3, 0x2, 0, 0xae, 0x1, 0xd2, 0x1, 0x1, 0x22, 0xbc, 0x3, 0xa0, 0x1, 
+0
@@ -0,0 +1,459 @@
+#include "embed.h"
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "builtins.h"
+#include "gc.h"
+#include "heapimage.h"
+#include "interpreter.h"
+#include "objects/array.h"
+#include "objects/classobject.h"
+#include "objects/errors.h"
+#include "objects/mapping.h"
+#include "objects/scope.h"
+#include "objectsystem.h"
+#include "run.h"
+
+#define NOPARRAYS 6
+
+// the attributes of one object, as they were when the snapshot was taken
+struct SavedObject {
+	struct Object *obj;
+	struct Object *attrdata;            // copy of obj->attrdata, or NULL if obj->attrdata was NULL
+	struct Object *getters, *setters;   // same for classes, always NULL for other objects
+};
+
+struct EmbedSnapshot {
+	// copies of the arrays and mappings, the originals are restored in-place
+	struct Object *localvars;
+	struct Object *filelibcache;
+	struct Object *importers;
+	struct Object *oparrays[NOPARRAYS];
+
+	struct SavedObject *saved;
+	size_t nsaved;
+};
+
+static struct Object **get_oparray(struct Interpreter *interp, int i)
+{
+	struct Object **arrs[NOPARRAYS] = {
+		&interp->oparrays.add, &interp->oparrays.sub, &interp->oparrays.mul,
+		&interp->oparrays.div, &interp->oparrays.eq, &interp->oparrays.lt };
+	return arrs[i];
+}
+
+
+static void free_snapshot(struct Interpreter *interp, struct EmbedSnapshot *snap)
+{
+#define DECREF_IF_NOT_NULL(x) if (x) OBJECT_DECREF(interp, (x))
+	DECREF_IF_NOT_NULL(snap->localvars);
+	DECREF_IF_NOT_NULL(snap->filelibcache);
+	DECREF_IF_NOT_NULL(snap->importers);
+	for (int i=0; i < NOPARRAYS; i++)
+		DECREF_IF_NOT_NULL(snap->oparrays[i]);
+
+	for (size_t i=0; i < snap->nsaved; i++) {
+		OBJECT_DECREF(interp, snap->saved[i].obj);
+		DECREF_IF_NOT_NULL(snap->saved[i].attrdata);
+		DECREF_IF_NOT_NULL(snap->saved[i].getters);
+		DECREF_IF_NOT_NULL(snap->saved[i].setters);
+	}
+#undef DECREF_IF_NOT_NULL
+
+	free(snap->saved);
+	free(snap);
+}
+
+// copying NULL gives NULL, returns false on error
+static bool copy_mapping(struct Interpreter *interp, struct Object *map, struct Object **res)
+{
+	*res = NULL;
+	if (!map)
+		return true;
+
+	if (!(*res = mappingobject_newempty(interp)))
+		return false;
+
+	struct MappingObjectIter iter;
+	mappingobject_iterbegin(&iter, map);
+	while (mappingobject_iternext(&iter)) {
+		if (!mappingobject_set(interp, *res, iter.key, iter.value)) {
+			OBJECT_DECREF(interp, *res);
+			*res = NULL;
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool save_object(struct Interpreter *interp, struct EmbedSnapshot *snap, struct Object *obj)
+{
+	// the same object can be e.g. in interp->builtins and the built-in scope
+	for (size_t i=0; i < snap->nsaved; i++) {
+		if (snap->saved[i].obj == obj)
+			return true;
+	}
+
+	struct SavedObject *tmp = realloc(snap->saved, sizeof(struct SavedObject) * (snap->nsaved + 1));
+	if (!tmp) {
+		errorobject_thrownomem(interp);
+		return false;
+	}
+	snap->saved = tmp;
+
+	struct SavedObject *so = &snap->saved[snap->nsaved];
+	so->obj = obj;
+	so->attrdata = so->getters = so->setters = NULL;
+
+	if (!copy_mapping(interp, obj->attrdata, &so->attrdata))
+		return false;
+	if (classobject_isinstanceof(obj, interp->builtins.Class)) {
+		struct ClassObjectData *data = obj->objdata.data;
+		if (!copy_mapping(interp, data->getters, &so->getters) || !copy_mapping(interp, data->setters, &so->setters)) {
+			if (so->attrdata)
+				OBJECT_DECREF(interp, so->attrdata);
+			if (so->getters)
+				OBJECT_DECREF(interp, so->getters);
+			return false;
+		}
+	}
+
+	OBJECT_INCREF(interp, obj);
+	snap->nsaved++;
+	return true;
+}
+
+static bool save_mapping_values(struct Interpreter *interp, struct EmbedSnapshot *snap, struct Object *map)
+{
+	struct MappingObjectIter iter;
+	mappingobject_iterbegin(&iter, map);
+	while (mappingobject_iternext(&iter)) {
+		if (!save_object(interp, snap, iter.value))
+			return false;
+	}
+	return true;
+}
+
+static struct EmbedSnapshot *create_snapshot(struct Interpreter *interp)
+{
+	struct EmbedSnapshot *snap = calloc(1, sizeof(struct EmbedSnapshot));
+	if (!snap) {
+		errorobject_thrownomem(interp);
+		return NULL;
+	}
+
+	if (!copy_mapping(interp, SCOPEOBJECT_LOCALVARS(interp->builtinscope), &snap->localvars) ||
+		!copy_mapping(interp, interp->importstuff.filelibcache, &snap->filelibcache))
+		goto error;
+
+	struct Object *arr = interp->importstuff.importers;
+	if (!(snap->importers = arrayobject_slice(interp, arr, 0, ARRAYOBJECT_LEN(arr))))
+		goto error;
+	for (int i=0; i < NOPARRAYS; i++) {
+		arr = *get_oparray(interp, i);
+		if (!(snap->oparrays[i] = arrayobject_slice(interp, arr, 0, ARRAYOBJECT_LEN(arr))))
+			goto error;
+	}
+
+#define SAVE(x) if (!save_object(interp, snap, interp->builtins.x)) goto error
+	SAVE(ArbitraryAttribs);
+	SAVE(Array);
+	SAVE(AstNode);
+	SAVE(Block);
+	SAVE(Bool);
+	SAVE(ByteArray);
+	SAVE(Class);
+	SAVE(Error);
+	SAVE(File);
+	SAVE(Function);
+	SAVE(Integer);
+	SAVE(Library);
+	SAVE(Mapping);
+	SAVE(MarkerError);
+	SAVE(Object);
+	SAVE(Option);
+	SAVE(Scope);
+	SAVE(StackFrame);
+	SAVE(String);
+	SAVE(StringBuilder);
+#undef SAVE
+	if (!save_object(interp, snap, interp->builtinscope) ||
+		!save_mapping_values(interp, snap, SCOPEOBJECT_LOCALVARS(interp->builtinscope)) ||
+		!save_mapping_values(interp, snap, interp->importstuff.filelibcache))
+		goto error;
+	return snap;
+
+error:
+	free_snapshot(interp, snap);
+	return NULL;
+}
+
+
+// returns 1 if the mappings have the same keys and values, 0 if not and -1 on error
+static int mappings_same(struct Interpreter *interp, struct Object *a, struct Object *b)
+{
+	if (MAPPINGOBJECT_SIZE(a) != MAPPINGOBJECT_SIZE(b))
+		return 0;
+
+	struct MappingObjectIter iter;
+	mappingobject_iterbegin(&iter, a);
+	while (mappingobject_iternext(&iter)) {
+		struct Object *val;
+		int status = mappingobject_get(interp, b, iter.key, &val);
+		if (status != 1)
+			return status;
+		OBJECT_DECREF(interp, val);
+		if (val != iter.value)
+			return 0;
+	}
+	return 1;
+}
+
+// *map is set to a new empty mapping first if it's NULL, and set to NULL if saved is NULL
+static bool restore_mapping(struct Interpreter *interp, struct Object **map, struct Object *saved)
+{
+	if (!saved) {
+		if (*map) {
+			OBJECT_DECREF(interp, *map);
+			*map = NULL;
+		}
+		return true;
+	}
+
+	if (!*map && !(*map = mappingobject_newempty(interp)))
+		return false;
+
+	// most things are not modified, and this avoids allocating new items for them
+	int same = mappings_same(interp, *map, saved);
+	if (same != 0)
+		return (same == 1);
+
+	mappingobject_clear(interp, *map);
+	struct MappingObjectIter iter;
+	mappingobject_iterbegin(&iter, saved);
+	while (mappingobject_iternext(&iter)) {
+		if (!mappingobject_set(interp, *map, iter.key, iter.value))
+			return false;
+	}
+	return true;
+}
+
+static bool restore_array(struct Interpreter *interp, struct Object *arr, struct Object *saved)
+{
+	if (ARRAYOBJECT_LEN(arr) == ARRAYOBJECT_LEN(saved)) {
+		size_t i;
+		for (i=0; i < ARRAYOBJECT_LEN(arr); i++) {
+			if (ARRAYOBJECT_GET(arr, i) != ARRAYOBJECT_GET(saved, i))
+				break;
+		}
+		if (i == ARRAYOBJECT_LEN(arr))
+			return true;
+	}
+
+	struct Object *elem;
+	while ((elem = arrayobject_pop(interp, arr)))
+		OBJECT_DECREF(interp, elem);
+	for (size_t i=0; i < ARRAYOBJECT_LEN(saved); i++) {
+		if (!arrayobject_push(interp, arr, ARRAYOBJECT_GET(saved, i)))
+			return false;
+	}
+	return true;
+}
+
+static bool restore_snapshot(struct Interpreter *interp, struct EmbedSnapshot *snap)
+{
+	// dropping libraries first means that user code imported is not kept alive by anything below
+	if (!restore_mapping(interp, &interp->importstuff.filelibcache, snap->filelibcache) ||
+		!restore_mapping(interp, &SCOPEOBJECT_LOCALVARS(interp->builtinscope), snap->localvars) ||
+		!restore_array(interp, interp->importstuff.importers, snap->importers))
+		return false;
+	for (int i=0; i < NOPARRAYS; i++) {
+		if (!restore_array(interp, *get_oparray(interp, i), snap->oparrays[i]))
+			return false;
+	}
+
+	for (size_t i=0; i < snap->nsaved; i++) {
+		struct SavedObject so = snap->saved[i];
+		if (!restore_mapping(interp, &so.obj->attrdata, so.attrdata))
+			return false;
+		if (classobject_isinstanceof(so.obj, interp->builtins.Class)) {
+			struct ClassObjectData *data = so.obj->objdata.data;
+			if (!restore_mapping(interp, &data->getters, so.getters) || !restore_mapping(interp, &data->setters, so.setters))
+				return false;
+		}
+	}
+	return true;
+}
+
+
+static void print_and_reset_err(struct Interpreter *interp)
+{
+	struct Object *err = interp->err;
+	interp->err = NULL;
+	errorobject_print(interp, err);
+	OBJECT_DECREF(interp, err);
+}
+
+struct EmbedInterp *embed_new(char *argv0)
+{
+	struct EmbedInterp *ei = malloc(sizeof(struct EmbedInterp));
+	if (!ei) {
+		fprintf(stderr, "%s: not enough memory\n", argv0);
+		return NULL;
+	}
+	ei->snapshot = NULL;
+
+	if (!(ei->interp = interpreter_new(argv0))) {
+		free(ei);
+		return NULL;
+	}
+
+	// programs that embed ö usually don't have a heap image, so this typically falls back to running builtins.ö
+	// builtins_setup() prints its errors
+	bool loaded = heapimage_loadfromexe(ei->interp);
+	if (!loaded && !builtins_setup(ei->interp))
+		goto error;
+	if ((!loaded && !run_builtinsfile(ei->interp)) || !(ei->snapshot = create_snapshot(ei->interp))) {
+		print_and_reset_err(ei->interp);
+		goto error;
+	}
+	return ei;
+
+error:
+	builtins_teardown(ei->interp);
+	gc_run(ei->interp);
+	interpreter_free(ei->interp);
+	free(ei);
+	return NULL;
+}
+
+void embed_free(struct EmbedInterp *ei)
+{
+	if (ei->interp->err) {
+		OBJECT_DECREF(ei->interp, ei->interp->err);
+		ei->interp->err = NULL;
+	}
+	free_snapshot(ei->interp, ei->snapshot);
+	builtins_teardown(ei->interp);
+	gc_run(ei->interp);
+	interpreter_free(ei->interp);
+	free(ei);
+}
+
+bool embed_snapshot(struct EmbedInterp *ei)
+{
+	struct EmbedSnapshot *snap = create_snapshot(ei->interp);
+	if (!snap)
+		return false;
+	free_snapshot(ei->interp, ei->snapshot);
+	ei->snapshot = snap;
+	return true;
+}
+
+bool embed_run(struct EmbedInterp *ei, char *filepath, char *code, size_t codelen)
+{
+	struct Object *scope = scopeobject_newsub(ei->interp, ei->interp->builtinscope);
+	if (!scope)
+		return false;
+	bool ok = run_string(ei->interp, filepath, code, codelen, scope);
+	OBJECT_DECREF(ei->interp, scope);
+	return ok;
+}
+
+bool embed_reset(struct EmbedInterp *ei)
+{
+	struct Interpreter *interp = ei->interp;
+	assert(interp->stackptr == interp->stack);
+
+	if (interp->err) {
+		OBJECT_DECREF(interp, interp->err);
+		interp->err = NULL;
+	}
+	if (!restore_snapshot(interp, ei->snapshot))
+		return false;
+
+	// closures are reference cycles (function -> scope -> function), so refcounting doesn't free them
+	gc_collect(interp);
+	return true;
+}
+
+
+struct EmbedPool {
+	char *argv0;
+	size_t size;
+	struct EmbedInterp **interps;   // NULL means not created yet, or resetting failed
+	bool *busy;
+};
+
+struct EmbedPool *embedpool_new(char *argv0, size_t size)
+{
+	struct EmbedPool *pool = malloc(sizeof(struct EmbedPool));
+	if (!pool)
+		goto nomem;
+	pool->argv0 = argv0;
+	pool->size = size;
+	pool->interps = calloc(size, sizeof(struct EmbedInterp *));
+	pool->busy = calloc(size, sizeof(bool));
+	if ((!pool->interps || !pool->busy) && size != 0) {
+		free(pool->interps);
+		free(pool->busy);
+		free(pool);
+		goto nomem;
+	}
+
+	// everything is created here, so that checking out is fast
+	for (size_t i=0; i < size; i++) {
+		if (!(pool->interps[i] = embed_new(argv0))) {
+			embedpool_free(pool);
+			return NULL;
+		}
+	}
+	return pool;
+
+nomem:
+	fprintf(stderr, "%s: not enough memory\n", argv0);
+	return NULL;
+}
+
+void embedpool_free(struct EmbedPool *pool)
+{
+	for (size_t i=0; i < pool->size; i++) {
+		assert(!pool->busy[i]);
+		if (pool->interps[i])
+			embed_free(pool->interps[i]);
+	}
+	free(pool->interps);
+	free(pool->busy);
+	free(pool);
+}
+
+struct EmbedInterp *embedpool_checkout(struct EmbedPool *pool)
+{
+	for (size_t i=0; i < pool->size; i++) {
+		if (pool->busy[i])
+			continue;
+		if (!pool->interps[i] && !(pool->interps[i] = embed_new(pool->argv0)))
+			continue;
+		pool->busy[i] = true;
+		return pool->interps[i];
+	}
+	return NULL;
+}
+
+void embedpool_checkin(struct EmbedPool *pool, struct EmbedInterp *ei)
+{
+	for (size_t i=0; i < pool->size; i++) {
+		if (pool->interps[i] == ei) {
+			assert(pool->busy[i]);
+			pool->busy[i] = false;
+			if (!embed_reset(ei)) {
+				embed_free(ei);
+				pool->interps[i] = NULL;
+			}
+			return;
+		}
+	}
+	assert(0);   // ei is not from this pool
+}
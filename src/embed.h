@@ -0,0 +1,75 @@
+// for programs that run ö code many times, e.g. once per request in a server
+// creating an interpreter and running builtins.ö takes a few milliseconds, resetting a used interpreter is much faster
+#ifndef EMBED_H
+#define EMBED_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "interpreter.h"     // IWYU pragma: keep
+
+struct EmbedSnapshot;   // defined in embed.c
+
+struct EmbedInterp {
+	struct Interpreter *interp;
+	struct EmbedSnapshot *snapshot;   // what embed_reset() goes back to
+};
+
+// creates an interpreter and runs builtins.ö in it
+// prints a message to stderr and returns NULL on error, like main() does
+struct EmbedInterp *embed_new(char *argv0);
+
+// never fails
+void embed_free(struct EmbedInterp *ei);
+
+/* remembers the current state, so that embed_reset() goes back to it instead of the state after builtins.ö
+useful for importing libraries once instead of once per run, run code that imports them and then call this
+throws an error and returns false on failure, the old snapshot is kept then
+
+the snapshot contains:
+	* the variables of the built-in scope
+	* the operator arrays and the importer array
+	* what has been imported, i.e. importstuff.filelibcache
+	* attributes of built-in objects, imported libraries and values of built-in variables,
+	  including methods and other getters and setters of classes
+
+changes in anything else are not undone, e.g. pushing to an array that is in a built-in variable
+*/
+bool embed_snapshot(struct EmbedInterp *ei);
+
+// runs code in a new subscope of the built-in scope, see run_string() in run.h
+// throws an error and returns false on failure, the error is in ei->interp->err
+bool embed_run(struct EmbedInterp *ei, char *filepath, char *code, size_t codelen);
+
+// restores the snapshot, deletes interp->err if any and frees garbage reference cycles
+// must not be called while ö code is running
+// throws an error and returns false on failure, don't use the interpreter after that
+bool embed_reset(struct EmbedInterp *ei);
+
+
+/* a fixed number of ready-to-use interpreters
+
+	struct EmbedInterp *ei = embedpool_checkout(pool);
+	if (ei) {
+		if (!embed_run(ei, "<request>", code, codelen))
+			// handle ei->interp->err
+		embedpool_checkin(pool, ei);
+	}
+
+this doesn't lock anything, so use a mutex if many threads share a pool
+*/
+struct EmbedPool;   // defined in embed.c
+
+// prints a message to stderr and returns NULL on error
+struct EmbedPool *embedpool_new(char *argv0, size_t size);
+
+// never fails
+void embedpool_free(struct EmbedPool *pool);
+
+// returns NULL if all interpreters are checked out, or if there are none because creating them failed
+struct EmbedInterp *embedpool_checkout(struct EmbedPool *pool);
+
+// resets ei and makes it available again, never fails
+// if resetting fails, ei is replaced with a new interpreter when it's needed next time
+void embedpool_checkin(struct EmbedPool *pool, struct EmbedInterp *ei);
+
+#endif    // EMBED_H
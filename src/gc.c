@@ -4,8 +4,11 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "allobjects.h"
+#include "atomicincrdecr.h"
 #include "interpreter.h"
 #include "objectsystem.h"
+#include "stats.h"
+#include "objects/classobject.h"
 
 // this thing works by setting gcflag to what refcount SHOULD be and then checking it
 // Object.refcount and Object.gcflag are both longs
@@ -63,3 +66,96 @@ void gc_run(struct Interpreter *interp)
 
 #undef for_each_object
 }
+
+
+// gc_collect() sets gcflag to this for objects that must not be freed
+// refcounts can't be negative, so it can't be mixed up with a reference count
+#define REACHABLE -1
+
+struct Worklist {
+	struct Object **objs;
+	size_t len;
+};
+
+static void mark_reachable(struct Object *ref, void *worklist)
+{
+	if (ref->gcflag != REACHABLE) {
+		ref->gcflag = REACHABLE;
+		struct Worklist *wl = worklist;
+		wl->objs[wl->len++] = ref;
+	}
+}
+
+static void decref_if_reachable(struct Object *ref, void *junkdata)
+{
+	// the object is reachable through something that isn't garbage, so this can't drop the refcount to 0
+	if (ref->gcflag == REACHABLE) {
+		ATOMIC_DECR(ref->refcount);
+		assert(ref->refcount > 0);
+	}
+}
+
+static void foreach_reference(struct Object *obj, void (*cb)(struct Object *, void *), void *data)
+{
+	if (obj->klass)
+		cb(obj->klass, data);
+	if (obj->attrdata)
+		cb(obj->attrdata, data);
+	if (obj->objdata.foreachref)
+		obj->objdata.foreachref(obj->objdata.data, cb, data);
+}
+
+void gc_collect(struct Interpreter *interp)
+{
+	// every object goes to the worklist at most once
+	struct Worklist wl = { .objs = malloc(sizeof(struct Object *) * interp->allobjects.size), .len = 0 };
+	if (!wl.objs && interp->allobjects.size != 0)
+		return;
+
+	struct AllObjectsIter iter;
+#define for_each_object iter = allobjects_iterbegin(interp->allobjects); while (allobjects_iternext(&iter))
+
+	// like in gc_run(), gcflag becomes the number of references from other objects
+	for_each_object
+		iter.obj->gcflag = 0;
+	for_each_object
+		foreach_reference(iter.obj, mark_reference, NULL);
+
+	// if there are more references than the objects have, the rest come from C code
+	// this must not mark anything yet, because that would mess up the gcflags of objects not checked yet
+	for_each_object {
+		if (iter.obj->refcount > iter.obj->gcflag)
+			wl.objs[wl.len++] = iter.obj;
+	}
+	for (size_t i=0; i < wl.len; i++)
+		wl.objs[i]->gcflag = REACHABLE;
+
+	while (wl.len != 0) {
+		struct Object *obj = wl.objs[--wl.len];
+		foreach_reference(obj, mark_reachable, &wl);
+	}
+
+	// everything else is garbage
+	for_each_object {
+		if (iter.obj->gcflag != REACHABLE)
+			wl.objs[wl.len++] = iter.obj;
+	}
+
+	// references between garbage objects don't matter because all of them get freed
+	// this must be done before freeing anything because foreachref needs the data and the gcflags
+	// the classes must also be counted before freeing anything, because they may be garbage too
+	for (size_t i=0; i < wl.len; i++) {
+		foreach_reference(wl.objs[i], decref_if_reachable, NULL);
+		STATS_INCR(interp, objectsfreed);
+		if (wl.objs[i]->klass)
+			STATS_CLASSINCR(wl.objs[i]->klass, nfreed);
+	}
+
+	for (size_t i=0; i < wl.len; i++) {
+		assert(allobjects_remove(&interp->allobjects, wl.objs[i]));
+		object_free_impl(interp, wl.objs[i], true);
+	}
+
+#undef for_each_object
+	free(wl.objs);
+}
@@ -9,4 +9,10 @@
 // can't be invoked at runtime, never fails
 void gc_run(struct Interpreter *interp);
 
+// frees reference cycles that nothing outside the cycles refers to
+// objects referenced from C (e.g. interp->builtinscope) are kept, and so is everything they refer to
+// call this only when no ö code is running, e.g. between runs in embed.c
+// never fails, it just does nothing if there isn't enough memory
+void gc_collect(struct Interpreter *interp);
+
 #endif   // GC_H
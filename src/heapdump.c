@@ -0,0 +1,148 @@
+#include "heapdump.h"
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "allobjects.h"
+#include "interpreter.h"
+#include "objectsystem.h"
+#include "utf8.h"
+#include "objects/array.h"
+#include "objects/bytearray.h"
+#include "objects/classobject.h"
+#include "objects/errors.h"
+#include "objects/mapping.h"
+#include "objects/string.h"
+
+// things that can't be checked with classobject_isinstanceof() while iterating, e.g. if klass is NULL
+static bool is_instance(struct Object *obj, struct Object *klass)
+{
+	return obj->klass && klass && classobject_isinstanceof(obj, klass);
+}
+
+// approximate number of bytes that the object takes, not including objects that it references
+static size_t shallow_size(struct Interpreter *interp, struct Object *obj)
+{
+	size_t size = sizeof(struct Object);
+
+	if (is_instance(obj, interp->builtins.String)) {
+		struct StringObjectData *data = obj->objdata.data;
+		size += sizeof(*data);
+		if (!data->parent)   // substrings share the parent's characters
+			size += data->len * (size_t)data->kind;
+	} else if (is_instance(obj, interp->builtins.Array)) {
+		struct ArrayObjectData *data = obj->objdata.data;
+		size += sizeof(*data) + data->nallocated*sizeof(struct Object *);
+	} else if (is_instance(obj, interp->builtins.Mapping)) {
+		struct MappingObjectData *data = obj->objdata.data;
+		// items are a key, a value and a next pointer, but MappingObjectItem is private to mapping.c
+		size += sizeof(*data) + data->nbuckets*sizeof(void *) + data->size*3*sizeof(void *);
+	} else if (is_instance(obj, interp->builtins.ByteArray)) {
+		struct ByteArrayObjectData *data = obj->objdata.data;
+		size += sizeof(*data);
+		// the buffer is shared between slices, and mmapped buffers don't use malloc at all
+		if (data->buf && !data->buf->mapped)
+			size += data->buf->nallocated / data->buf->nusers;
+	} else if (is_instance(obj, interp->builtins.Class)) {
+		struct ClassObjectData *data = obj->objdata.data;
+		size += sizeof(*data) + data->name.len*sizeof(unicode_char);
+	}
+	return size;
+}
+
+struct RefWriter {
+	FILE *f;
+	bool first;
+};
+
+static void write_ref(struct Object *ref, void *writer)
+{
+	struct RefWriter *w = writer;
+	fprintf(w->f, w->first ? "\"%p\"" : ",\"%p\"", (void *)ref);
+	w->first = false;
+}
+
+// writes a json string, returns false on no mem
+static bool write_json_string(struct Interpreter *interp, struct UnicodeString ustr, FILE *f)
+{
+	char *utf8;
+	size_t utf8len;
+	if (!utf8_encode(interp, ustr, &utf8, &utf8len))
+		return false;
+
+	fputc('"', f);
+	for (size_t i=0; i < utf8len; i++) {
+		unsigned char c = utf8[i];
+		if (c == '"' || c == '\\')
+			fprintf(f, "\\%c", c);
+		else if (c < 0x20)
+			fprintf(f, "\\u%04x", (unsigned)c);
+		else
+			fputc(c, f);
+	}
+	fputc('"', f);
+	free(utf8);
+	return true;
+}
+
+static bool write_object(struct Interpreter *interp, struct Object *obj, FILE *f)
+{
+	fprintf(f, "{\"id\":\"%p\",", (void *)obj);
+	if (obj->klass)
+		fprintf(f, "\"class\":\"%p\",", (void *)obj->klass);
+	else
+		fputs("\"class\":null,", f);
+	fprintf(f, "\"size\":%zu,\"refcount\":%ld,", shallow_size(interp, obj), obj->refcount);
+
+	if (is_instance(obj, interp->builtins.Class)) {
+		fputs("\"name\":", f);
+		if (!write_json_string(interp, ((struct ClassObjectData *) obj->objdata.data)->name, f))
+			return false;
+		fputc(',', f);
+	}
+
+	struct RefWriter w = { .f = f, .first = true };
+	fputs("\"refs\":[", f);
+	if (obj->klass)
+		write_ref(obj->klass, &w);
+	if (obj->attrdata)
+		write_ref(obj->attrdata, &w);
+	if (obj->objdata.foreachref)
+		obj->objdata.foreachref(obj->objdata.data, write_ref, &w);
+	fputs("]}\n", f);
+	return true;
+}
+
+bool heapdump_write(struct Interpreter *interp, char *path)
+{
+	errno = 0;
+	FILE *f = fopen(path, "w");
+	if (!f) {
+		errorobject_throwfmt(interp, "IoError", "cannot open %s: %s", path, strerror(errno));
+		return false;
+	}
+
+	// nothing in the loop may create objects, because that would modify allobjects while iterating
+	// write_object() can only fail with errorobject_thrownomem(), and that doesn't create objects
+	fprintf(f, "{\"heapdump\":1,\"objects\":%zu}\n", interp->allobjects.size);
+	struct AllObjectsIter iter = allobjects_iterbegin(interp->allobjects);
+	while (allobjects_iternext(&iter)) {
+		if (!write_object(interp, iter.obj, f)) {
+			fclose(f);
+			return false;
+		}
+	}
+
+	errno = 0;
+	bool failed = ferror(f);
+	if (fclose(f) != 0)
+		failed = true;
+	if (failed) {
+		errorobject_throwfmt(interp, "IoError", "writing to %s failed: %s", path, strerror(errno));
+		return false;
+	}
+	return true;
+}
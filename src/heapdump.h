@@ -0,0 +1,29 @@
+// heap dumps for finding out what keeps objects alive, see docs/profiling.md and misc/heapanalyze.py
+#ifndef HEAPDUMP_H
+#define HEAPDUMP_H
+
+#include <stdbool.h>
+#include "interpreter.h"     // IWYU pragma: keep
+
+/*
+writes every object in interp->allobjects to a file, one json object per line
+the first line is a header:
+
+	{"heapdump":1,"objects":1234}
+
+then each object is like this, ids are addresses of objects as hex strings:
+
+	{"id":"0x55d0c8a4e2a0","class":"0x55d0c8a3f010","size":56,"refcount":2,"refs":["0x55d0c8a4e300"]}
+
+refs contains everything that the object references, including its class and attrdata
+size is approximate, it's known only for some built-in classes and is sizeof(struct Object) for others
+class objects also have "name", the name of the class, and the class of a few objects is null
+
+refcount minus the number of refs pointing to an object is the number of references from C code,
+so the analyzer can find roots the same way as gc_collect()
+
+throws an error and returns false on failure, the file may be partially written then
+*/
+bool heapdump_write(struct Interpreter *interp, char *path);
+
+#endif   // HEAPDUMP_H
@@ -0,0 +1,951 @@
+// open(), fstat() and pread() are posix, not c99
+#define _POSIX_C_SOURCE 200809L
+
+#include "heapimage.h"
+#include <assert.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include "allobjects.h"
+#include "gc.h"
+#include "interpreter.h"
+#include "objectsystem.h"
+#include "stats.h"
+#include "objects/errors.h"
+#include "objects/function.h"
+#include "objects/mapping.h"
+#include "objects/string.h"
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/*
+the image is a header followed by the objects, and numbers are LEB128 varints like in serialize.c
+
+header:
+	number that checks that function offsets work, see check_offset()
+	interp->stdpath, as a length and bytes
+	number of imported files, and path, size and mtime of each
+	number of C functions, and offset of each from heapimage_load()
+	number of strings for heapimage_writecstring(), and length and bytes of each
+	interp->objectsallocated and stats
+	number of objects
+	each root from get_roots() as a ref
+
+each object:
+	kind, 0 for no data and otherwise index+1 in kinds
+	class and attrdata as refs
+	hash, hashable and refcount
+	whatever the kind's write function wrote
+
+a ref is 0 for NULL and otherwise the index of the object plus 1
+
+heapimage_write() adds the length of the image as 8 little-endian bytes and MAGIC after the image
+*/
+#define MAGIC "oheapimg"
+#define MAGIC_LEN 8
+#define TRAILER_SIZE (8 + MAGIC_LEN)
+
+static const struct HeapImageKind *const kinds[] = {
+	&arrayobject_imagekind,
+	&astnodeobject_imagekind,
+	&blockobject_imagekind,
+	&blockobject_returnerimagekind,
+	&bytearrayobject_imagekind,
+	&classobject_imagekind,
+	&errorobject_imagekind,
+	&fileobject_imagekind,
+	&functionobject_imagekind,
+	&functionobject_partialimagekind,
+	&integerobject_imagekind,
+	&lambdabuiltin_imagekind,
+	&mappingobject_imagekind,
+	&method_getterimagekind,
+	&method_thisimagekind,
+	&optionobject_imagekind,
+	&run_exportimagekind,
+	&scopeobject_imagekind,
+	&scopeobject_builtinimagekind,
+	&stackframeobject_imagekind,
+	&stringobject_imagekind,
+};
+#define NKINDS (sizeof(kinds)/sizeof(kinds[0]))
+
+// returns index+1 in kinds, 0 for no data, or -1 if the data can't be in an image
+static int find_kind(struct ObjectData od)
+{
+	if (!od.foreachref && !od.destructor)
+		return od.data ? -1 : 0;
+	for (size_t i=0; i < NKINDS; i++) {
+		if (kinds[i]->foreachref == od.foreachref && kinds[i]->destructor == od.destructor)
+			return (int)i + 1;
+	}
+	return -1;
+}
+
+// everything that builtins_teardown() decrefs
+#define NROOTS 40
+static void get_roots(struct Interpreter *interp, struct Object **roots[NROOTS])
+{
+	size_t i = 0;
+#define ROOT(x) roots[i++] = &interp->x;
+	ROOT(builtins.ArbitraryAttribs)
+	ROOT(builtins.Array)
+	ROOT(builtins.AstNode)
+	ROOT(builtins.Block)
+	ROOT(builtins.Bool)
+	ROOT(builtins.ByteArray)
+	ROOT(builtins.Channel)
+	ROOT(builtins.Class)
+	ROOT(builtins.Error)
+	ROOT(builtins.File)
+	ROOT(builtins.Function)
+	ROOT(builtins.Integer)
+	ROOT(builtins.Library)
+	ROOT(builtins.Mapping)
+	ROOT(builtins.MarkerError)
+	ROOT(builtins.Object)
+	ROOT(builtins.Option)
+	ROOT(builtins.Scope)
+	ROOT(builtins.StackFrame)
+	ROOT(builtins.String)
+	ROOT(builtins.StringBuilder)
+	ROOT(builtins.Thread)
+	ROOT(builtins.yes)
+	ROOT(builtins.no)
+	ROOT(builtins.none)
+	ROOT(builtins.nomemerr)
+	ROOT(builtinscope)
+	ROOT(importstuff.filelibcache)
+	ROOT(importstuff.importers)
+	ROOT(oparrays.add)
+	ROOT(oparrays.sub)
+	ROOT(oparrays.mul)
+	ROOT(oparrays.div)
+	ROOT(oparrays.eq)
+	ROOT(oparrays.lt)
+	ROOT(strings.else_)
+	ROOT(strings.empty)
+	ROOT(strings.export)
+	ROOT(strings.return_)
+	ROOT(strings.returning)
+#undef ROOT
+	assert(i == NROOTS);
+}
+
+// C function pointers are stored relative to this, so that they work even if the executable is loaded to a different address
+#define ANCHOR ((uintptr_t)(void (*)(void))heapimage_load)
+
+// the offset of another function in the executable, for noticing images from a different executable early
+static long long check_offset(void)
+{
+	return (long long)((uintptr_t)(void (*)(void))heapimage_dump - ANCHOR);
+}
+
+
+struct Buffer {
+	unsigned char *data;
+	size_t len;
+	size_t nallocated;
+};
+
+// returns false on no mem
+static bool buffer_add(struct Buffer *buf, const void *bytes, size_t n)
+{
+	if (buf->nallocated - buf->len < n) {
+		size_t newsize = buf->nallocated == 0 ? 4096 : buf->nallocated;
+		while (newsize - buf->len < n) {
+			if (newsize > SIZE_MAX/2)
+				return false;
+			newsize *= 2;
+		}
+		unsigned char *ptr = realloc(buf->data, newsize);
+		if (!ptr)
+			return false;
+		buf->data = ptr;
+		buf->nallocated = newsize;
+	}
+	if (n != 0)    // bytes can be NULL for empty things
+		memcpy(buf->data + buf->len, bytes, n);
+	buf->len += n;
+	return true;
+}
+
+static bool buffer_adduint(struct Buffer *buf, uint64_t val)
+{
+	unsigned char bytes[10];    // ceil(64/7)
+	size_t n = 0;
+	do {
+		bytes[n] = val & 0x7f;
+		val >>= 7;
+		if (val)
+			bytes[n] |= 0x80;
+		n++;
+	} while (val);
+	return buffer_add(buf, bytes, n);
+}
+
+
+struct HeapImageWriter {
+	struct Interpreter *interp;
+	struct Buffer *buf;
+	struct Object *current;    // the object being written, for error messages
+
+	// maps object pointers to indexes, open addressing with linear probing
+	struct Object **tablekeys;
+	size_t *tablevals;
+	size_t tablesize;   // power of two, at least twice the number of objects
+
+	// these are linearly searched, there are a few hundred of each
+	void (**funcs)(void);
+	size_t nfuncs, funcsallocated;
+	const char **strings;
+	size_t nstrings, stringsallocated;
+};
+
+static size_t table_slot(struct HeapImageWriter *w, struct Object *obj)
+{
+	size_t i = (size_t)(((uintptr_t)obj >> 4) * 2654435761u) & (w->tablesize - 1);
+	while (w->tablekeys[i] && w->tablekeys[i] != obj)
+		i = (i+1) & (w->tablesize - 1);
+	return i;
+}
+
+static size_t table_get(struct HeapImageWriter *w, struct Object *obj)
+{
+	size_t i = table_slot(w, obj);
+	assert(w->tablekeys[i] == obj);   // everything is in interp->allobjects
+	return w->tablevals[i];
+}
+
+static bool nomem(struct HeapImageWriter *w)
+{
+	errorobject_thrownomem(w->interp);
+	return false;
+}
+
+bool heapimage_writeuint(struct HeapImageWriter *w, uint64_t val)
+{
+	return buffer_adduint(w->buf, val) || nomem(w);
+}
+
+bool heapimage_writeint(struct HeapImageWriter *w, long long val)
+{
+	// zigzag like in serialize.c, -(val+1) doesn't overflow
+	return heapimage_writeuint(w, val < 0 ? ((uint64_t)(-(val+1)) << 1) | 1 : (uint64_t)val << 1);
+}
+
+bool heapimage_writebytes(struct HeapImageWriter *w, const void *bytes, size_t n)
+{
+	return buffer_add(w->buf, bytes, n) || nomem(w);
+}
+
+bool heapimage_writecstring(struct HeapImageWriter *w, const char *s)
+{
+	size_t i;
+	for (i=0; i < w->nstrings; i++) {
+		if (strcmp(w->strings[i], s) == 0)
+			break;
+	}
+
+	if (i == w->nstrings) {
+		if (w->nstrings == w->stringsallocated) {
+			size_t newsize = w->stringsallocated == 0 ? 64 : 2*w->stringsallocated;
+			const char **ptr = realloc(w->strings, newsize * sizeof ptr[0]);
+			if (!ptr)
+				return nomem(w);
+			w->strings = ptr;
+			w->stringsallocated = newsize;
+		}
+		w->strings[w->nstrings++] = s;
+	}
+	return heapimage_writeuint(w, i);
+}
+
+bool heapimage_writeref(struct HeapImageWriter *w, struct Object *obj)
+{
+	return heapimage_writeuint(w, obj ? table_get(w, obj) + 1 : 0);
+}
+
+bool heapimage_writefuncptr(struct HeapImageWriter *w, void (*func)(void))
+{
+	if (!func)
+		return heapimage_writeuint(w, 0);
+
+	size_t i;
+	for (i=0; i < w->nfuncs; i++) {
+		if (w->funcs[i] == func)
+			break;
+	}
+
+	if (i == w->nfuncs) {
+		if (w->nfuncs == w->funcsallocated) {
+			size_t newsize = w->funcsallocated == 0 ? 256 : 2*w->funcsallocated;
+			void (**ptr)(void) = realloc(w->funcs, newsize * sizeof ptr[0]);
+			if (!ptr)
+				return nomem(w);
+			w->funcs = ptr;
+			w->funcsallocated = newsize;
+		}
+		w->funcs[w->nfuncs++] = func;
+	}
+	return heapimage_writeuint(w, i+1);
+}
+
+bool heapimage_writecfunc(struct HeapImageWriter *w, struct FunctionObjectCfunc cfunc)
+{
+	if (cfunc.returning)
+		return heapimage_writeuint(w, 1) && heapimage_writefuncptr(w, (void (*)(void)) cfunc.func.yesret);
+	return heapimage_writeuint(w, 0) && heapimage_writefuncptr(w, (void (*)(void)) cfunc.func.noret);
+}
+
+bool heapimage_cannotwrite(struct HeapImageWriter *w)
+{
+	errorobject_throwfmt(w->interp, "TypeError", "cannot write %D to a heap image", w->current);
+	return false;
+}
+
+bool heapimage_writeobjectdata(struct HeapImageWriter *w, struct ObjectData od)
+{
+	int k = find_kind(od);
+	if (k == -1)
+		return heapimage_cannotwrite(w);
+	if (!heapimage_writeuint(w, (uint64_t)k))
+		return false;
+	return k == 0 || kinds[k-1]->write(w, od.data);
+}
+
+bool heapimage_writerefdata(struct HeapImageWriter *w, void *data)
+{
+	return heapimage_writeref(w, data);
+}
+
+
+struct HeapImageReader {
+	const unsigned char *data;
+	size_t len;
+	size_t pos;
+
+	struct Object **objs;
+	size_t nobjs;
+	void (**funcs)(void);
+	size_t nfuncs;
+	const char **strings;    // point into data, not \0-terminated
+	size_t *stringlens;
+	size_t nstrings;
+};
+
+bool heapimage_readuint(struct HeapImageReader *r, uint64_t *val)
+{
+	*val = 0;
+	for (int shift = 0; shift < 64; shift += 7) {
+		if (r->pos == r->len)
+			return false;
+		unsigned char b = r->data[r->pos++];
+		*val |= (uint64_t)(b & 0x7f) << shift;
+		if (!(b & 0x80))
+			return true;
+	}
+	return false;
+}
+
+bool heapimage_readint(struct HeapImageReader *r, long long *val)
+{
+	uint64_t zigzag;
+	if (!heapimage_readuint(r, &zigzag))
+		return false;
+	*val = (zigzag & 1) ? -(long long)(zigzag >> 1) - 1 : (long long)(zigzag >> 1);
+	return true;
+}
+
+bool heapimage_readsize(struct HeapImageReader *r, size_t *val)
+{
+	uint64_t tmp;
+	if (!heapimage_readuint(r, &tmp) || tmp > r->len - r->pos)
+		return false;
+	*val = (size_t)tmp;
+	return true;
+}
+
+bool heapimage_readbytes(struct HeapImageReader *r, void *bytes, size_t n)
+{
+	if (n > r->len - r->pos)
+		return false;
+	if (n != 0)
+		memcpy(bytes, r->data + r->pos, n);
+	r->pos += n;
+	return true;
+}
+
+bool heapimage_readcstring(struct HeapImageReader *r, char **s)
+{
+	uint64_t i;
+	if (!heapimage_readuint(r, &i) || i >= r->nstrings)
+		return false;
+	if (!(*s = malloc(r->stringlens[i] + 1)))
+		return false;
+	memcpy(*s, r->strings[i], r->stringlens[i]);
+	(*s)[r->stringlens[i]] = '\0';
+	return true;
+}
+
+bool heapimage_readref(struct HeapImageReader *r, struct Object **obj)
+{
+	uint64_t i;
+	if (!heapimage_readuint(r, &i) || i > r->nobjs)
+		return false;
+	*obj = i == 0 ? NULL : r->objs[i-1];
+	return true;
+}
+
+bool heapimage_readfuncptr(struct HeapImageReader *r, void (**func)(void))
+{
+	uint64_t i;
+	if (!heapimage_readuint(r, &i) || i > r->nfuncs)
+		return false;
+	*func = i == 0 ? NULL : r->funcs[i-1];
+	return true;
+}
+
+bool heapimage_readcfunc(struct HeapImageReader *r, struct FunctionObjectCfunc *cfunc)
+{
+	uint64_t returning;
+	void (*func)(void);
+	if (!heapimage_readuint(r, &returning) || returning > 1 || !heapimage_readfuncptr(r, &func) || !func)
+		return false;
+
+	cfunc->returning = returning;
+	if (returning)
+		cfunc->func.yesret = (functionobject_cfunc_yesret) func;
+	else
+		cfunc->func.noret = (functionobject_cfunc_noret) func;
+	return true;
+}
+
+bool heapimage_readobjectdata(struct HeapImageReader *r, struct ObjectData *od)
+{
+	uint64_t k;
+	if (!heapimage_readuint(r, &k) || k > NKINDS)
+		return false;
+	if (k == 0) {
+		*od = (struct ObjectData){ .data = NULL, .foreachref = NULL, .destructor = NULL };
+		return true;
+	}
+
+	void *data;
+	if (!kinds[k-1]->read(r, &data))
+		return false;
+	*od = (struct ObjectData){ .data = data, .foreachref = kinds[k-1]->foreachref, .destructor = kinds[k-1]->destructor };
+	return true;
+}
+
+bool heapimage_readrefdata(struct HeapImageReader *r, void **data)
+{
+	struct Object *obj;
+	if (!heapimage_readref(r, &obj) || !obj)
+		return false;
+	*data = obj;
+	return true;
+}
+
+
+static void count_ref(struct Object *ref, void *writer)
+{
+	struct HeapImageWriter *w = writer;
+	w->tablevals[table_slot(w, ref)]++;
+}
+
+// checks that the image can restore all references, e.g. nothing in C code refers to objects without them being roots
+static bool check_refcounts(struct HeapImageWriter *w, struct Object **objs, size_t nobjs)
+{
+	// use the table for counting refs for a moment
+	for (size_t i=0; i < nobjs; i++)
+		w->tablevals[table_slot(w, objs[i])] = 0;
+
+	struct Object **roots[NROOTS];
+	get_roots(w->interp, roots);
+	for (size_t i=0; i < NROOTS; i++) {
+		if (*roots[i])
+			count_ref(*roots[i], w);
+	}
+	for (size_t i=0; i < nobjs; i++) {
+		if (objs[i]->klass)
+			count_ref(objs[i]->klass, w);
+		if (objs[i]->attrdata)
+			count_ref(objs[i]->attrdata, w);
+		if (objs[i]->objdata.foreachref)
+			objs[i]->objdata.foreachref(objs[i]->objdata.data, count_ref, w);
+	}
+
+	for (size_t i=0; i < nobjs; i++) {
+		size_t count = table_get(w, objs[i]);
+		if ((unsigned long)objs[i]->refcount != count) {
+			errorobject_throwfmt(w->interp, "ValueError", "%D has %L references, but only %L of them are known to the heap image",
+				objs[i], (long long)objs[i]->refcount, (long long)count);
+			return false;
+		}
+	}
+	return true;
+}
+
+// objects go to the image in an order where kinds can read their dependencies first
+// *n is the number of objects already in sorted, returns false and throws an error for a data that can't be in an image
+static bool add_sorted(struct HeapImageWriter *w, struct Object *obj, struct Object **sorted, size_t *n, bool *added)
+{
+	size_t i = table_get(w, obj);
+	if (added[i])
+		return true;
+	added[i] = true;
+
+	w->current = obj;
+	int k = find_kind(obj->objdata);
+	if (k == -1)
+		return heapimage_cannotwrite(w);
+
+	if (k != 0 && kinds[k-1]->dependency) {
+		struct Object *dep = kinds[k-1]->dependency(obj->objdata.data);
+		if (dep && !add_sorted(w, dep, sorted, n, added))
+			return false;
+	}
+	sorted[(*n)++] = obj;
+	return true;
+}
+
+static bool write_object(struct HeapImageWriter *w, struct Object *obj)
+{
+	w->current = obj;
+	return heapimage_writeobjectdata(w, obj->objdata) &&
+		heapimage_writeref(w, obj->klass) &&
+		heapimage_writeref(w, obj->attrdata) &&
+		heapimage_writeint(w, obj->hash) &&
+		heapimage_writeuint(w, obj->hashable) &&
+		heapimage_writeuint(w, (uint64_t)obj->refcount);
+}
+
+static bool write_files(struct HeapImageWriter *w)
+{
+	if (!heapimage_writeuint(w, MAPPINGOBJECT_SIZE(w->interp->importstuff.filelibcache)))
+		return false;
+
+	struct MappingObjectIter iter;
+	mappingobject_iterbegin(&iter, w->interp->importstuff.filelibcache);
+	while (mappingobject_iternext(&iter)) {
+		char *utf8, *path;
+		size_t pathlen;
+		if (!stringobject_toutf8(w->interp, iter.key, &utf8, &pathlen))
+			return false;
+
+		// utf8 isn't \0-terminated
+		if (!(path = realloc(utf8, pathlen + 1))) {
+			free(utf8);
+			return nomem(w);
+		}
+		path[pathlen] = '\0';
+
+		struct stat st;
+		errno = 0;
+		if (stat(path, &st) != 0) {
+			errorobject_throwfmt(w->interp, "IoError", "cannot get information about %s: %s", path, strerror(errno));
+			free(path);
+			return false;
+		}
+		bool ok = heapimage_writeuint(w, pathlen) && heapimage_writebytes(w, path, pathlen) &&
+			heapimage_writeuint(w, (uint64_t)st.st_size) && heapimage_writeint(w, (long long)st.st_mtime);
+		free(path);
+		if (!ok)
+			return false;
+	}
+	return true;
+}
+
+static bool write_header(struct HeapImageWriter *w, size_t nobjs)
+{
+	if (!heapimage_writeint(w, check_offset()) ||
+		!heapimage_writeuint(w, strlen(w->interp->stdpath)) ||
+		!heapimage_writebytes(w, w->interp->stdpath, strlen(w->interp->stdpath)) ||
+		!write_files(w))
+		return false;
+
+	if (!heapimage_writeuint(w, w->nfuncs))
+		return false;
+	for (size_t i=0; i < w->nfuncs; i++) {
+		if (!heapimage_writeint(w, (long long)((uintptr_t)w->funcs[i] - ANCHOR)))
+			return false;
+	}
+
+	if (!heapimage_writeuint(w, w->nstrings))
+		return false;
+	for (size_t i=0; i < w->nstrings; i++) {
+		size_t len = strlen(w->strings[i]);
+		if (!heapimage_writeuint(w, len) || !heapimage_writebytes(w, w->strings[i], len))
+			return false;
+	}
+
+	if (!heapimage_writeuint(w, w->interp->objectsallocated))
+		return false;
+#ifndef NO_STATS
+	struct Stats st = w->interp->stats;
+	if (!heapimage_writeuint(w, st.objectsfreed) ||
+		!heapimage_writeuint(w, st.peakobjects) ||
+		!heapimage_writeuint(w, st.increfs) ||
+		!heapimage_writeuint(w, st.mappingresizes) ||
+		!heapimage_writeuint(w, st.oparrayfallthroughs) ||
+		!heapimage_writeuint(w, st.framespushed) ||
+		!heapimage_writeuint(w, st.errorsthrown))
+		return false;
+#endif
+
+	if (!heapimage_writeuint(w, nobjs))
+		return false;
+	struct Object **roots[NROOTS];
+	get_roots(w->interp, roots);
+	for (size_t i=0; i < NROOTS; i++) {
+		if (!heapimage_writeref(w, *roots[i]))
+			return false;
+	}
+	return true;
+}
+
+bool heapimage_dump(struct Interpreter *interp, char **res, size_t *reslen)
+{
+	assert(!interp->err);
+	assert(interp->stackptr == interp->stack);    // stack frames hold references to scopes
+	assert(!interp->profiler && !interp->sampler && !interp->perfmap);
+
+	gc_collect(interp);
+
+	struct Buffer header = {0}, body = {0};
+	struct HeapImageWriter w = { .interp = interp, .buf = &body };
+	size_t nobjs = interp->allobjects.size;
+	w.tablesize = 16;
+	while (w.tablesize < 2*nobjs)
+		w.tablesize *= 2;
+
+	struct Object **objs = malloc(nobjs * sizeof objs[0]);
+	struct Object **sorted = malloc(nobjs * sizeof sorted[0]);
+	bool *added = calloc(nobjs, sizeof added[0]);
+	w.tablekeys = calloc(w.tablesize, sizeof w.tablekeys[0]);
+	w.tablevals = malloc(w.tablesize * sizeof w.tablevals[0]);
+	bool ok = false;
+	if (!objs || !sorted || !added || !w.tablekeys || !w.tablevals) {
+		errorobject_thrownomem(interp);
+		goto out;
+	}
+
+	// nothing may create objects while iterating, so the objects are copied to an array first
+	size_t n = 0;
+	struct AllObjectsIter iter = allobjects_iterbegin(interp->allobjects);
+	while (allobjects_iternext(&iter)) {
+		size_t slot = table_slot(&w, iter.obj);
+		w.tablekeys[slot] = iter.obj;
+		w.tablevals[slot] = n;
+		objs[n++] = iter.obj;
+	}
+	assert(n == nobjs);
+
+	if (!check_refcounts(&w, objs, nobjs))
+		goto out;
+
+	// add_sorted() and writing use the table differently, but both want indexes of objs
+	for (size_t i=0; i < nobjs; i++)
+		w.tablevals[table_slot(&w, objs[i])] = i;
+	n = 0;
+	for (size_t i=0; i < nobjs; i++) {
+		if (!add_sorted(&w, objs[i], sorted, &n, added))
+			goto out;
+	}
+	assert(n == nobjs);
+
+	for (size_t i=0; i < nobjs; i++)
+		w.tablevals[table_slot(&w, sorted[i])] = i;
+	for (size_t i=0; i < nobjs; i++) {
+		if (!write_object(&w, sorted[i]))
+			goto out;
+	}
+
+	w.buf = &header;
+	if (!write_header(&w, nobjs) || !heapimage_writebytes(&w, body.data, body.len))
+		goto out;
+
+	*res = (char *)header.data;
+	*reslen = header.len;
+	header.data = NULL;
+	ok = true;
+
+out:
+	free(objs);
+	free(sorted);
+	free(added);
+	free(w.tablekeys);
+	free(w.tablevals);
+	free(w.funcs);
+	free(w.strings);
+	free(header.data);
+	free(body.data);
+	return ok;
+}
+
+bool heapimage_write(struct Interpreter *interp, char *path)
+{
+	char *data;
+	size_t len;
+	if (!heapimage_dump(interp, &data, &len))
+		return false;
+
+	unsigned char trailer[TRAILER_SIZE];
+	for (int i=0; i < 8; i++)
+		trailer[i] = (unsigned char)((uint64_t)len >> (8*i));
+	memcpy(trailer + 8, MAGIC, MAGIC_LEN);
+
+	errno = 0;
+	FILE *f = fopen(path, "wb");
+	if (!f) {
+		errorobject_throwfmt(interp, "IoError", "cannot open %s: %s", path, strerror(errno));
+		free(data);
+		return false;
+	}
+
+	errno = 0;
+	bool failed = fwrite(data, 1, len, f) != len || fwrite(trailer, 1, TRAILER_SIZE, f) != TRAILER_SIZE;
+	free(data);
+	if (fclose(f) != 0)
+		failed = true;
+	if (failed) {
+		errorobject_throwfmt(interp, "IoError", "writing to %s failed: %s", path, strerror(errno));
+		return false;
+	}
+	return true;
+}
+
+
+// checks that files imported by builtins.ö haven't changed after writing the image
+static bool read_files(struct HeapImageReader *r)
+{
+	size_t nfiles;
+	if (!heapimage_readsize(r, &nfiles))
+		return false;
+
+	for (size_t i=0; i < nfiles; i++) {
+		size_t pathlen;
+		uint64_t size;
+		long long mtime;
+		if (!heapimage_readsize(r, &pathlen))
+			return false;
+
+		char *path = malloc(pathlen + 1);
+		if (!path)
+			return false;
+		struct stat st;
+		bool ok = heapimage_readbytes(r, path, pathlen) &&
+			heapimage_readuint(r, &size) &&
+			heapimage_readint(r, &mtime);
+		path[pathlen] = '\0';
+		ok = ok && stat(path, &st) == 0 && (uint64_t)st.st_size == size && (long long)st.st_mtime == mtime;
+		free(path);
+		if (!ok)
+			return false;
+	}
+	return true;
+}
+
+// returns false if the image is for another executable or another std directory
+static bool read_header(struct Interpreter *interp, struct HeapImageReader *r, uint64_t *rootrefs, size_t *nobjs)
+{
+	long long offset;
+	size_t stdpathlen;
+	if (!heapimage_readint(r, &offset) || offset != check_offset() || !heapimage_readsize(r, &stdpathlen))
+		return false;
+	if (stdpathlen != strlen(interp->stdpath) || memcmp(r->data + r->pos, interp->stdpath, stdpathlen) != 0)
+		return false;
+	r->pos += stdpathlen;
+	if (!read_files(r))
+		return false;
+
+	if (!heapimage_readsize(r, &r->nfuncs) || !(r->funcs = malloc(r->nfuncs * sizeof r->funcs[0] + 1)))
+		return false;
+	for (size_t i=0; i < r->nfuncs; i++) {
+		long long funcoffset;
+		if (!heapimage_readint(r, &funcoffset))
+			return false;
+		r->funcs[i] = (void (*)(void))(ANCHOR + (uintptr_t)funcoffset);
+	}
+
+	if (!heapimage_readsize(r, &r->nstrings) ||
+		!(r->strings = malloc(r->nstrings * sizeof r->strings[0] + 1)) ||
+		!(r->stringlens = malloc(r->nstrings * sizeof r->stringlens[0] + 1)))
+		return false;
+	for (size_t i=0; i < r->nstrings; i++) {
+		if (!heapimage_readsize(r, &r->stringlens[i]))
+			return false;
+		r->strings[i] = (const char *)r->data + r->pos;
+		r->pos += r->stringlens[i];
+	}
+
+	uint64_t allocated;
+	if (!heapimage_readuint(r, &allocated))
+		return false;
+	interp->objectsallocated = allocated;
+#ifndef NO_STATS
+	uint64_t st[7];
+	for (int i=0; i < 7; i++) {
+		if (!heapimage_readuint(r, &st[i]))
+			return false;
+	}
+	interp->stats = (struct Stats){ .objectsfreed = st[0], .peakobjects = st[1], .increfs = st[2], .mappingresizes = st[3],
+		.oparrayfallthroughs = st[4], .framespushed = st[5], .errorsthrown = st[6] };
+#endif
+
+	// the objects don't exist yet, so roots can't be read with heapimage_readref()
+	if (!heapimage_readsize(r, nobjs))
+		return false;
+	for (size_t i=0; i < NROOTS; i++) {
+		if (!heapimage_readuint(r, &rootrefs[i]) || rootrefs[i] > *nobjs)
+			return false;
+	}
+	return true;
+}
+
+static bool read_object(struct HeapImageReader *r, struct Object *obj)
+{
+	uint64_t hashable, refcount;
+	long long hash;
+	struct ObjectData od;
+	if (!heapimage_readobjectdata(r, &od))
+		return false;
+
+	if (!heapimage_readref(r, &obj->klass) ||
+		!heapimage_readref(r, &obj->attrdata) ||
+		!heapimage_readint(r, &hash) ||
+		!heapimage_readuint(r, &hashable) ||
+		!heapimage_readuint(r, &refcount) || refcount == 0 || refcount > LONG_MAX)
+	{
+		if (od.destructor)
+			od.destructor(od.data);
+		return false;
+	}
+
+	obj->objdata = od;
+	obj->hash = (long)hash;
+	obj->hashable = hashable;
+	obj->refcount = (long)refcount;
+	obj->gcflag = 0;
+	return true;
+}
+
+// frees the objects without decreffing anything, because they all go away at once
+static void free_objects(struct Interpreter *interp, struct Object **objs, size_t nobjs)
+{
+	for (size_t i=0; i < nobjs; i++) {
+		if (objs[i]->objdata.destructor)
+			objs[i]->objdata.destructor(objs[i]->objdata.data);
+		allobjects_remove(&interp->allobjects, objs[i]);
+		free(objs[i]);
+	}
+}
+
+bool heapimage_load(struct Interpreter *interp, const char *data, size_t len)
+{
+	assert(interp->allobjects.size == 0);
+	struct HeapImageReader r = { .data = (const unsigned char *)data, .len = len, .pos = 0 };
+	unsigned long long allocatedsave = interp->objectsallocated;
+#ifndef NO_STATS
+	struct Stats statssave = interp->stats;
+#endif
+
+	uint64_t rootrefs[NROOTS];
+	size_t nobjs;
+	size_t nallocated = 0;
+	bool ok = false;
+	if (!read_header(interp, &r, rootrefs, &nobjs) || !(r.objs = malloc(nobjs * sizeof r.objs[0] + 1)))
+		goto out;
+
+	for ( ; nallocated < nobjs; nallocated++) {
+		struct Object *obj = calloc(1, sizeof *obj);
+		if (!obj)
+			goto out;
+		if (!allobjects_add(&interp->allobjects, obj)) {
+			free(obj);
+			goto out;
+		}
+		r.objs[nallocated] = obj;
+	}
+	r.nobjs = nobjs;
+
+	for (size_t i=0; i < nobjs; i++) {
+		if (!read_object(&r, r.objs[i]))
+			goto out;
+	}
+	if (r.pos != r.len)
+		goto out;
+
+	struct Object **roots[NROOTS];
+	get_roots(interp, roots);
+	for (size_t i=0; i < NROOTS; i++)
+		*roots[i] = rootrefs[i] == 0 ? NULL : r.objs[rootrefs[i] - 1];
+	STATS_UPDATEPEAK(interp);
+	ok = true;
+
+out:
+	if (!ok) {
+		if (r.objs)
+			free_objects(interp, r.objs, nallocated);
+		interp->objectsallocated = allocatedsave;
+#ifndef NO_STATS
+		interp->stats = statssave;
+#endif
+	}
+	free(r.objs);
+	free(r.funcs);
+	free(r.strings);
+	free(r.stringlens);
+	return ok;
+}
+
+bool heapimage_loadfromexe(struct Interpreter *interp)
+{
+#ifdef __linux__
+	int fd = open("/proc/self/exe", O_RDONLY);
+	if (fd == -1)
+		return false;
+
+	char *data = NULL;
+	bool ok = false;
+	struct stat st;
+	unsigned char trailer[TRAILER_SIZE];
+	if (fstat(fd, &st) != 0 || st.st_size < TRAILER_SIZE ||
+		pread(fd, trailer, TRAILER_SIZE, st.st_size - TRAILER_SIZE) != TRAILER_SIZE ||
+		memcmp(trailer + 8, MAGIC, MAGIC_LEN) != 0)
+		goto out;
+
+	uint64_t len = 0;
+	for (int i=0; i < 8; i++)
+		len |= (uint64_t)trailer[i] << (8*i);
+	if (len > (uint64_t)st.st_size - TRAILER_SIZE || !(data = malloc(len + 1)))
+		goto out;
+
+	// pread() may return less than asked even for regular files, e.g. if a signal interrupts it
+	for (size_t done = 0; done < len; ) {
+		ssize_t n = pread(fd, data + done, len - done, st.st_size - TRAILER_SIZE - (off_t)len + (off_t)done);
+		if (n <= 0 && !(n == -1 && errno == EINTR))
+			goto out;
+		if (n > 0)
+			done += (size_t)n;
+	}
+	ok = heapimage_load(interp, data, len);
+
+out:
+	free(data);
+	close(fd);
+	return ok;
+#else
+	return false;
+#endif
+}
@@ -0,0 +1,124 @@
+// a snapshot of every object that exists after builtins.ö has ran, for starting up without running it
+#ifndef HEAPIMAGE_H
+#define HEAPIMAGE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "interpreter.h"           // IWYU pragma: keep
+#include "objectsystem.h"          // IWYU pragma: keep
+#include "objects/function.h"      // IWYU pragma: keep
+
+/*
+the Makefile runs 'ö --write-heap-image=PATH' and appends the image to the ö executable
+on startup, heapimage_loadfromexe() loads the image instead of running builtins_setup() and builtins.ö
+
+objects are referred to with indexes, and pointers to C functions are stored as offsets from a function
+in the executable, so an image works only with the exact same executable that wrote it
+it also contains paths, sizes and modification times of the files that builtins.ö imported
+if anything doesn't match, the image isn't loaded and the interpreter starts up as usual
+*/
+
+struct HeapImageWriter;   // defined in heapimage.c
+struct HeapImageReader;   // defined in heapimage.c
+
+/*
+each kind of ObjectData that can be in an image has one of these, defined next to its foreachref and destructor
+the kind of an ObjectData is found by comparing foreachref and destructor, so no two kinds can have the same pair
+data with NULL foreachref and destructor is supported without a HeapImageKind, but only if the data is NULL
+
+write and read are called for objdata.data of each object, and for userdata of functions
+refcounts are stored separately, so write and read must not incref or decref anything
+
+write throws an error and returns false on failure
+
+read sets *data to a copy of what write got, except that objects come from heapimage_readref()
+the objects that read gets may not have been read yet, so read shouldn't look inside them, see also dependency
+read returns false for invalid data or no mem without throwing an error, and it must not leak memory then
+
+dependency can be NULL, otherwise it returns an object that must be read before data, or NULL if there's none
+*/
+struct HeapImageKind {
+	void (*foreachref)(void *data, object_foreachrefcb cb, void *cbdata);
+	void (*destructor)(void *data);
+	bool (*write)(struct HeapImageWriter *w, void *data);
+	bool (*read)(struct HeapImageReader *r, void **data);
+	struct Object *(*dependency)(void *data);
+};
+
+// these are defined in the files that the data belongs to
+extern const struct HeapImageKind arrayobject_imagekind;
+extern const struct HeapImageKind astnodeobject_imagekind;
+extern const struct HeapImageKind blockobject_imagekind;
+extern const struct HeapImageKind blockobject_returnerimagekind;   // userdata of return functions
+extern const struct HeapImageKind bytearrayobject_imagekind;
+extern const struct HeapImageKind classobject_imagekind;
+extern const struct HeapImageKind errorobject_imagekind;
+extern const struct HeapImageKind fileobject_imagekind;
+extern const struct HeapImageKind functionobject_imagekind;
+extern const struct HeapImageKind functionobject_partialimagekind;   // userdata of partial functions
+extern const struct HeapImageKind integerobject_imagekind;
+extern const struct HeapImageKind lambdabuiltin_imagekind;           // userdata of lambda functions
+extern const struct HeapImageKind mappingobject_imagekind;
+extern const struct HeapImageKind method_getterimagekind;            // userdata of method getters
+extern const struct HeapImageKind method_thisimagekind;              // userdata of methods
+extern const struct HeapImageKind optionobject_imagekind;
+extern const struct HeapImageKind run_exportimagekind;               // userdata of export functions
+extern const struct HeapImageKind scopeobject_imagekind;
+extern const struct HeapImageKind scopeobject_builtinimagekind;
+extern const struct HeapImageKind stackframeobject_imagekind;
+extern const struct HeapImageKind stringobject_imagekind;
+
+
+// for write functions of HeapImageKinds, these throw an error and return false on failure
+bool heapimage_writeuint(struct HeapImageWriter *w, uint64_t val);
+bool heapimage_writeint(struct HeapImageWriter *w, long long val);
+bool heapimage_writebytes(struct HeapImageWriter *w, const void *bytes, size_t n);
+bool heapimage_writecstring(struct HeapImageWriter *w, const char *s);    // same strings are stored only once
+bool heapimage_writeref(struct HeapImageWriter *w, struct Object *obj);   // obj can be NULL
+bool heapimage_writefuncptr(struct HeapImageWriter *w, void (*func)(void));   // func can be NULL
+bool heapimage_writecfunc(struct HeapImageWriter *w, struct FunctionObjectCfunc cfunc);
+bool heapimage_writeobjectdata(struct HeapImageWriter *w, struct ObjectData od);
+// for data that can be in an image only sometimes, throws an error saying that the object can't be written
+bool heapimage_cannotwrite(struct HeapImageWriter *w);
+
+// for read functions of HeapImageKinds, these return false for invalid data or no mem
+bool heapimage_readuint(struct HeapImageReader *r, uint64_t *val);
+bool heapimage_readint(struct HeapImageReader *r, long long *val);
+bool heapimage_readsize(struct HeapImageReader *r, size_t *val);    // for lengths, fails if bigger than the rest of the image
+bool heapimage_readbytes(struct HeapImageReader *r, void *bytes, size_t n);
+bool heapimage_readcstring(struct HeapImageReader *r, char **s);    // *s must be free()'d
+bool heapimage_readref(struct HeapImageReader *r, struct Object **obj);
+bool heapimage_readfuncptr(struct HeapImageReader *r, void (**func)(void));
+bool heapimage_readcfunc(struct HeapImageReader *r, struct FunctionObjectCfunc *cfunc);
+bool heapimage_readobjectdata(struct HeapImageReader *r, struct ObjectData *od);
+
+// for kinds whose data is a pointer to an object and nothing else, e.g. Options
+bool heapimage_writerefdata(struct HeapImageWriter *w, void *data);
+bool heapimage_readrefdata(struct HeapImageReader *r, void **data);
+
+
+/*
+writes an image of everything in the interpreter, followed by what heapimage_loadfromexe() looks for at the end
+garbage reference cycles are freed first, and all other objects must be reachable from builtins_teardown() stuff
+call this right after builtins_setup() and run_builtinsfile(), when no ö code is running
+throws an error and returns false on failure
+*/
+bool heapimage_write(struct Interpreter *interp, char *path);
+
+// like heapimage_write(), but sets *res to the image without the stuff at the end, *res must be free()'d
+bool heapimage_dump(struct Interpreter *interp, char **res, size_t *reslen);
+
+/*
+loads an image into an interpreter from interpreter_new(), instead of builtins_setup() and run_builtinsfile()
+the image must be from heapimage_dump() of the same executable
+returns false if the image can't be used or there's not enough memory, and the interpreter is then unchanged
+no error is thrown on failure, because the interpreter doesn't have error classes yet
+*/
+bool heapimage_load(struct Interpreter *interp, const char *data, size_t len);
+
+// like heapimage_load(), but loads the image that the Makefile appended to the running executable
+// returns false if there is no image, or if it's outdated or unusable
+bool heapimage_loadfromexe(struct Interpreter *interp);
+
+#endif   // HEAPIMAGE_H
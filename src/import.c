@@ -67,7 +67,7 @@ static char *get_source_dir(struct Interpreter *interp, struct Object *stackfram
 
 	char *filename;
 	size_t filenamelen;
-	bool ok = utf8_encode(interp, *((struct UnicodeString*) filenameobj->objdata.data), &filename, &filenamelen);
+	bool ok = stringobject_toutf8(interp, filenameobj, &filename, &filenamelen);
 	OBJECT_DECREF(interp, filenameobj);
 	if (!ok)
 		return NULL;
@@ -176,9 +176,12 @@ static struct Object *file_importer(struct Interpreter *interp, struct ObjectDat
 {
 	if (!check_args(interp, args, interp->builtins.String, interp->builtins.StackFrame, NULL)) return NULL;
 	if (!check_no_opts(interp, opts)) return NULL;
-	struct UnicodeString name = *((struct UnicodeString*) ARRAYOBJECT_GET(args, 0)->objdata.data);
+	struct UnicodeString name;
+	if (!stringobject_getustr(interp, ARRAYOBJECT_GET(args, 0), &name))
+		return NULL;
 
 	char *fullpath = get_import_path(interp, name, ARRAYOBJECT_GET(args, 1));
+	free(name.val);
 	if (!fullpath)
 		return NULL;
 
@@ -4,10 +4,14 @@
 #include <stdbool.h>
 #include "allobjects.h"
 #include "stack.h"
+#include "stats.h"
 
 // these are defined in other files that need to include this file
 // stupid IWYU doesn't get this.....
 struct Object;
+struct PerfMap;
+struct Profiler;
+struct Sampler;
 struct StackFrame;
 
 struct Interpreter {
@@ -28,6 +32,19 @@ struct Interpreter {
 
 	struct AllObjects allobjects;
 
+	// number of objects created so far, never decreases
+	unsigned long long objectsallocated;
+
+	// see profiler.h, sampler.h and perfmap.h, NULL when not profiling
+	struct Profiler *profiler;
+	struct Sampler *sampler;
+	struct PerfMap *perfmap;
+
+	// see stats.h
+#ifndef NO_STATS
+	struct Stats stats;
+#endif
+
 	// this holds references to built-in classes, functions and stuff
 	struct {
 		struct Object *ArbitraryAttribs;
@@ -36,6 +53,7 @@ struct Interpreter {
 		struct Object *Block;
 		struct Object *Bool;
 		struct Object *ByteArray;
+		struct Object *Channel;  // std/threads.ö deletes this from the built-in scope
 		struct Object *Class;    // the class of class objects
 		struct Object *Error;
 		struct Object *File;     // std/io.ö does some stuff to this
@@ -49,6 +67,8 @@ struct Interpreter {
 		struct Object *Scope;
 		struct Object *StackFrame;
 		struct Object *String;
+		struct Object *StringBuilder;
+		struct Object *Thread;   // std/threads.ö deletes this too
 
 		struct Object *none;       // special Option with no value
 		struct Object *yes, *no;   // Bool objects, avoid name clash with stdbool.h
@@ -5,9 +5,11 @@
 #include <stdlib.h>
 #include "attribute.h"
 #include "check.h"
+#include "heapimage.h"
 #include "interpreter.h"
 #include "objectsystem.h"
 #include "objects/array.h"
+#include "objects/astnode.h"
 #include "objects/block.h"
 #include "objects/errors.h"
 #include "objects/function.h"
@@ -39,6 +41,36 @@ static void ldata_destructor(void *ldata)
 	free(ldata);
 }
 
+static bool ldata_writeimage(struct HeapImageWriter *w, void *ldata)
+{
+	struct LambdaData *ld = ldata;
+	return heapimage_writeref(w, ld->argnames) &&
+		heapimage_writeref(w, ld->optnames) &&
+		heapimage_writeref(w, ld->argtypes) &&
+		heapimage_writeref(w, ld->opttypes) &&
+		heapimage_writeref(w, ld->block);
+}
+
+static bool ldata_readimage(struct HeapImageReader *r, void **ldata)
+{
+	struct LambdaData *ld = malloc(sizeof *ld);
+	if (!ld)
+		return false;
+	if (!heapimage_readref(r, &ld->argnames) || !ld->argnames ||
+		!heapimage_readref(r, &ld->optnames) || !ld->optnames ||
+		!heapimage_readref(r, &ld->argtypes) || !ld->argtypes ||
+		!heapimage_readref(r, &ld->opttypes) || !ld->opttypes ||
+		!heapimage_readref(r, &ld->block) || !ld->block)
+	{
+		free(ld);
+		return false;
+	}
+	*ldata = ld;
+	return true;
+}
+
+const struct HeapImageKind lambdabuiltin_imagekind = { ldata_foreachref, ldata_destructor, ldata_writeimage, ldata_readimage, NULL };
+
 
 // sets scope to a new reference, but block is not a new reference
 static bool create_scope_for_runner(struct Interpreter *interp, struct ObjectData data, struct Object *args, struct Object *opts, struct Object **block, struct Object **scope)
@@ -123,6 +155,21 @@ static bool nonreturning_runner(struct Interpreter *interp, struct ObjectData da
 	return ok;
 }
 
+bool lambdabuiltin_getlocation(struct FunctionObjectCfunc cfunc, struct ObjectData userdata, char **filename, size_t *lineno)
+{
+	if (cfunc.returning ? (cfunc.func.yesret != returning_runner) : (cfunc.func.noret != nonreturning_runner))
+		return false;
+
+	struct Object *stmts = BLOCKOBJECT_ASTSTMTS(((struct LambdaData *) userdata.data)->block);
+	if (ARRAYOBJECT_LEN(stmts) == 0)
+		return false;
+
+	struct AstNodeObjectData *node = ARRAYOBJECT_GET(stmts, 0)->objdata.data;
+	*filename = node->filename;
+	*lineno = node->lineno;
+	return true;
+}
+
 
 static bool check_identifier(struct Interpreter *interp, struct UnicodeString u)
 {
@@ -153,8 +200,12 @@ static bool parse_arg_and_opt_names(struct Interpreter *interp, struct Object *s
 
 	// arguments must come before options, this is set to true when the first option is found
 	bool opts = false;
+	struct UnicodeString u = { .val = NULL, .len = 0 };
 	for (size_t i=0; i < ARRAYOBJECT_LEN(splitted); i++) {
-		struct UnicodeString u = *(struct UnicodeString *) ARRAYOBJECT_GET(splitted, i)->objdata.data;
+		free(u.val);    // from the previous iteration, free(NULL) does nothing
+		u.val = NULL;
+		if (!stringobject_getustr(interp, ARRAYOBJECT_GET(splitted, i), &u))
+			goto error;
 
 		if (u.len == 0) {
 			check_identifier(interp, u);   // sets an error
@@ -189,10 +240,12 @@ static bool parse_arg_and_opt_names(struct Interpreter *interp, struct Object *s
 		}
 	}
 
+	free(u.val);
 	OBJECT_DECREF(interp, splitted);
 	return true;
 
 error:
+	free(u.val);
 	OBJECT_DECREF(interp, splitted);
 	return false;
 }
@@ -2,9 +2,18 @@
 #ifndef LAMBDABUILTIN_H
 #define LAMBDABUILTIN_H
 
+#include <stdbool.h>
+#include <stddef.h>
 #include "interpreter.h"    // IWYU pragma: keep
 #include "objectsystem.h"   // IWYU pragma: keep
+#include "objects/function.h"
 
 struct Object *lambdabuiltin(struct Interpreter *interp, struct ObjectData dummydata, struct Object *args, struct Object *opts);
 
+// if cfunc and userdata are from a function created with lambdabuiltin(), sets *filename and *lineno
+// to the first statement of the function's body and returns true
+// returns false for other functions and functions with an empty body, never fails
+// the filename is owned by an ast node of the function, so copy it if you need it for long
+bool lambdabuiltin_getlocation(struct FunctionObjectCfunc cfunc, struct ObjectData userdata, char **filename, size_t *lineno);
+
 #endif    // LAMBDABUILTIN_H
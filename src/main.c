@@ -6,13 +6,17 @@
 #include <string.h>
 #include "builtins.h"
 #include "gc.h"
+#include "heapdump.h"
+#include "heapimage.h"
 #include "interpreter.h"
 #include "objectsystem.h"
 #include "objects/errors.h"
 #include "objects/scope.h"
+#include "perfmap.h"
+#include "profiler.h"
 #include "run.h"
-#include "unicode.h"
-#include "utf8.h"
+#include "sampler.h"
+#include "stats.h"
 #include "../config.h"
 
 // most of the readline code is taken from 'Programming with GNU Readline' in 'info readline'
@@ -90,60 +94,133 @@ static bool repl(struct Interpreter *interp)
 			return (status == 0);   // true on success, false on failure
 		}
 
-		struct UnicodeString code;
-		bool ok = utf8_decode(interp, line, strlen(line), &code);
+		// whitespace-only lines tokenize to nothing, so they don't need to be handled specially
+		bool ok = run_string(interp, "<repl>", line, strlen(line), scope);
 		free(line);
-		if (!ok) {
-			OBJECT_DECREF(interp, scope);
-			return false;
-		}
-
-		// if the line is nothing but whitespace, do nothing
-		bool wsonly = true;
-		for (size_t i=0; i<code.len; i++) {
-			if (!unicode_isspace(code.val[i])) {
-				wsonly = false;
-				break;
-			}
-		}
-		if (wsonly)
-			continue;
-
-		ok = run_string(interp, "<repl>", code, scope);
-		free(code.val);
 		if (!ok)
 			print_and_reset_err(interp);
 	}
 }
 
+struct Options {
+	char *file;          // NULL for repl
+	bool profile;
+	char *profilefile;   // NULL for not writing a file
+	char *samplefile;    // NULL for not sampling
+	unsigned int samplehz;
+	bool perfmap;
+	bool stats;
+	char *heapdumpfile;  // NULL for no heap dump
+	char *heapimagefile; // NULL for running normally, see heapimage.h
+};
+
+#define USAGE "Usage: %s [--profile] [--profile-file=PATH] [--sample-file=PATH] [--sample-hz=N] [--perf-map] [--stats] [--heap-dump-at-exit=PATH] [FILE]\n       %s --write-heap-image=PATH\n"
+
+// returns false if arg doesn't start with --name=, otherwise sets *val to what comes after =
+static bool get_value(char *arg, char *name, char **val)
+{
+	size_t len = strlen(name);
+	if (strncmp(arg, "--", 2) != 0 || strncmp(arg+2, name, len) != 0 || arg[2+len] != '=')
+		return false;
+	*val = arg + 2 + len + 1;
+	return true;
+}
+
+// returns false for invalid arguments
+static bool parse_options(int argc, char **argv, struct Options *opts)
+{
+	*opts = (struct Options){ .file = NULL, .profile = false, .profilefile = NULL, .samplefile = NULL, .samplehz = SAMPLER_DEFAULT_HZ, .perfmap = false, .stats = false, .heapdumpfile = NULL, .heapimagefile = NULL };
+
+	for (int i=1; i < argc; i++) {
+		char *arg = argv[i];
+		char *val;
+		if (opts->file)    // nothing is allowed after the file
+			return false;
+
+		if (strcmp(arg, "--profile") == 0)
+			opts->profile = true;
+		else if (strcmp(arg, "--perf-map") == 0)
+			opts->perfmap = true;
+		else if (strcmp(arg, "--stats") == 0)
+			opts->stats = true;
+		else if (get_value(arg, "profile-file", &val)) {
+			opts->profile = true;
+			opts->profilefile = val;
+		} else if (get_value(arg, "heap-dump-at-exit", &val))
+			opts->heapdumpfile = val;
+		else if (get_value(arg, "write-heap-image", &val))
+			opts->heapimagefile = val;
+		else if (get_value(arg, "sample-file", &val))
+			opts->samplefile = val;
+		else if (get_value(arg, "sample-hz", &val)) {
+			char *end;
+			unsigned long hz = strtoul(val, &end, 10);
+			if (*val == '\0' || *end != '\0' || hz == 0 || hz > 1000000)
+				return false;
+			opts->samplehz = (unsigned int)hz;
+		} else if (strncmp(arg, "--", 2) == 0)
+			return false;
+		else
+			opts->file = arg;
+	}
+
+	// the image must contain only what builtins.ö creates
+	return !(opts->heapimagefile && (opts->file || opts->profile || opts->samplefile || opts->perfmap || opts->stats || opts->heapdumpfile));
+}
+
 int main(int argc, char **argv)
 {
-	if (argc > 2) {
-		assert(argc >= 1);   // not sure if standards allow 0 args
-		fprintf(stderr, "Usage: %s [FILE]\n", argv[0]);
+	assert(argc >= 1);   // not sure if standards allow 0 args
+	struct Options opts;
+	if (!parse_options(argc, argv, &opts)) {
+		fprintf(stderr, USAGE, argv[0], argv[0]);
 		return 2;
 	}
-	assert(argc == 1 || argc == 2);
 
 	struct Interpreter *interp = interpreter_new(argv[0]);
 	if (!interp)
 		return 1;
 
+	// the image makes startup faster, but if it's missing or outdated, everything works without it too
 	int returnval = 0;
-	if (!builtins_setup(interp)) {
-		returnval = 1;
+	if (opts.heapimagefile || !heapimage_loadfromexe(interp)) {
+		if (!builtins_setup(interp)) {
+			returnval = 1;
+			goto end;
+		}
+
+		if (!run_builtinsfile(interp)) {
+			print_and_reset_err(interp);
+			returnval = 1;
+			goto end;
+		}
+	}
+
+	if (opts.heapimagefile) {
+		if (!heapimage_write(interp, opts.heapimagefile)) {
+			print_and_reset_err(interp);
+			returnval = 1;
+		}
 		goto end;
 	}
 
-	if (!run_builtinsfile(interp)) {
-		print_and_reset_err(interp);
+	// builtins.ö is not profiled, it runs the same way every time
+	if (opts.profile && !profiler_start(interp)) {
+		returnval = 1;
+		goto end;
+	}
+	if (opts.samplefile && !sampler_start(interp, opts.samplehz)) {
+		returnval = 1;
+		goto end;
+	}
+	if (opts.perfmap && !perfmap_start(interp)) {
 		returnval = 1;
 		goto end;
 	}
 
 	bool ok;
-	if (argc == 2) {
-		ok = run_mainfile(interp, argv[1]);
+	if (opts.file) {
+		ok = run_mainfile(interp, opts.file);
 		if (!ok)
 			print_and_reset_err(interp);
 	} else
@@ -151,9 +228,26 @@ int main(int argc, char **argv)
 
 	if (!ok)
 		returnval = 1;
+	if (opts.stats)
+		stats_print(interp, stderr);
+	if (opts.heapdumpfile && !heapdump_write(interp, opts.heapdumpfile)) {
+		print_and_reset_err(interp);
+		returnval = 1;
+	}
 	// "fall through" to end
 
 end:
+	if (interp->perfmap)
+		perfmap_stop(interp);
+	if (interp->sampler && !sampler_stop(interp, opts.samplefile))
+		returnval = 1;
+	if (interp->profiler) {
+		profiler_printtable(interp, stderr);
+		if (opts.profilefile && !profiler_writefile(interp, opts.profilefile))
+			returnval = 1;
+		profiler_stop(interp);
+	}
+
 	builtins_teardown(interp);
 	gc_run(interp);
 	interpreter_free(interp);
@@ -7,6 +7,7 @@
 #include <string.h>
 #include "attribute.h"
 #include "check.h"
+#include "heapimage.h"
 #include "interpreter.h"
 #include "objects/array.h"
 #include "objects/classobject.h"
@@ -41,6 +42,43 @@ void thisdata_foreachref(void *data, object_foreachrefcb cb, void *cbdata)
 	cb((struct Object*) data, cbdata);
 }
 
+static bool mgdata_writeimage(struct HeapImageWriter *w, void *data)
+{
+	struct MethodGetterData *mgdata = data;
+	return heapimage_writeref(w, mgdata->klass) &&
+		heapimage_writecfunc(w, mgdata->cfunc) &&
+		heapimage_writecstring(w, mgdata->name);
+}
+
+static bool mgdata_readimage(struct HeapImageReader *r, void **data)
+{
+	char *name;
+	struct MethodGetterData *mgdata = malloc(sizeof *mgdata);
+	if (!mgdata)
+		return false;
+	if (!heapimage_readref(r, &mgdata->klass) || !mgdata->klass ||
+		!heapimage_readcfunc(r, &mgdata->cfunc) ||
+		!heapimage_readcstring(r, &name))
+	{
+		free(mgdata);
+		return false;
+	}
+
+	bool ok = strlen(name) < NAME_SIZE;
+	if (ok)
+		strcpy(mgdata->name, name);
+	free(name);
+	if (!ok) {
+		free(mgdata);
+		return false;
+	}
+	*data = mgdata;
+	return true;
+}
+
+const struct HeapImageKind method_getterimagekind = { mgdata_foreachref, mgdata_destructor, mgdata_writeimage, mgdata_readimage, NULL };
+const struct HeapImageKind method_thisimagekind = { thisdata_foreachref, NULL, heapimage_writerefdata, heapimage_readrefdata, NULL };
+
 // when getting the method, this is called with the instance as an argument, see objects/classobject.h
 static struct Object *method_getter(struct Interpreter *interp, struct ObjectData objdata, struct Object *args, struct Object *opts)
 {
@@ -5,6 +5,7 @@
 #include <string.h>
 #include "../attribute.h"
 #include "../check.h"
+#include "../heapimage.h"
 #include "../interpreter.h"
 #include "../method.h"
 #include "../objectsystem.h"
@@ -24,6 +25,46 @@ static void array_destructor(void *data)
 	free(data);
 }
 
+static bool array_writeimage(struct HeapImageWriter *w, void *data)
+{
+	struct ArrayObjectData *ad = data;
+	if (!heapimage_writeuint(w, ad->len))
+		return false;
+	for (size_t i=0; i < ad->len; i++) {
+		if (!heapimage_writeref(w, ad->elems[i]))
+			return false;
+	}
+	return true;
+}
+
+static bool array_readimage(struct HeapImageReader *r, void **data)
+{
+	size_t len;
+	if (!heapimage_readsize(r, &len))
+		return false;
+
+	struct ArrayObjectData *ad = malloc(sizeof *ad);
+	if (!ad)
+		return false;
+	ad->len = len;
+	ad->nallocated = len ? len : 1;    // malloc(0) may return NULL
+	if (!(ad->elems = malloc(ad->nallocated * sizeof ad->elems[0]))) {
+		free(ad);
+		return false;
+	}
+
+	for (size_t i=0; i < len; i++) {
+		if (!heapimage_readref(r, &ad->elems[i]) || !ad->elems[i]) {
+			array_destructor(ad);
+			return false;
+		}
+	}
+	*data = ad;
+	return true;
+}
+
+const struct HeapImageKind arrayobject_imagekind = { array_foreachref, array_destructor, array_writeimage, array_readimage, NULL };
+
 
 static struct Object *newinstance(struct Interpreter *interp, struct Object *args, struct Object *opts)
 {
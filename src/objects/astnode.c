@@ -1,7 +1,9 @@
 #include "astnode.h"
 #include <assert.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include "../heapimage.h"
 #include "../interpreter.h"
 #include "../objectsystem.h"
 #include "classobject.h"
@@ -77,6 +79,154 @@ static void astnode_destructor(void *data)
 	free(data);
 }
 
+static bool astnode_writeimage(struct HeapImageWriter *w, void *data)
+{
+	struct AstNodeObjectData *ad = data;
+	if (!heapimage_writeuint(w, (unsigned char)ad->kind) ||
+		!heapimage_writecstring(w, ad->filename) ||
+		!heapimage_writeuint(w, ad->lineno))
+		return false;
+
+	switch (ad->kind) {
+#define info_as(X) ((struct X *) ad->info)
+	case AST_ARRAY:
+	case AST_BLOCK:
+	case AST_INT:
+	case AST_STR:
+		return heapimage_writeref(w, info_as(AstArrayOrBlockInfo));
+	case AST_GETVAR:
+		return heapimage_writeref(w, info_as(AstGetVarInfo)->varname);
+	case AST_GETATTR:
+		return heapimage_writeref(w, info_as(AstGetAttrInfo)->objnode) &&
+			heapimage_writeref(w, info_as(AstGetAttrInfo)->name);
+	case AST_CREATEVAR:
+	case AST_SETVAR:
+		return heapimage_writeref(w, info_as(AstCreateOrSetVarInfo)->varname) &&
+			heapimage_writeref(w, info_as(AstCreateOrSetVarInfo)->valnode);
+	case AST_SETATTR:
+		return heapimage_writeref(w, info_as(AstSetAttrInfo)->objnode) &&
+			heapimage_writeref(w, info_as(AstSetAttrInfo)->attr) &&
+			heapimage_writeref(w, info_as(AstSetAttrInfo)->valnode);
+	case AST_CALL:
+		return heapimage_writeref(w, info_as(AstCallInfo)->funcnode) &&
+			heapimage_writeref(w, info_as(AstCallInfo)->args) &&
+			heapimage_writeref(w, info_as(AstCallInfo)->opts);
+	case AST_OPCALL:
+		return heapimage_writeuint(w, info_as(AstOpCallInfo)->op) &&
+			heapimage_writeref(w, info_as(AstOpCallInfo)->lhs) &&
+			heapimage_writeref(w, info_as(AstOpCallInfo)->rhs);
+#undef info_as
+	default:
+		assert(0);      // unknown kind
+		return false;
+	}
+}
+
+// reads refs into an info struct, all refs must be non-NULL
+static bool read_refs(struct HeapImageReader *r, struct Object **a, struct Object **b, struct Object **c)
+{
+	return heapimage_readref(r, a) && *a &&
+		(!b || (heapimage_readref(r, b) && *b)) &&
+		(!c || (heapimage_readref(r, c) && *c));
+}
+
+static bool astnode_readimage(struct HeapImageReader *r, void **data)
+{
+	uint64_t kind, lineno;
+	struct AstNodeObjectData *ad = malloc(sizeof *ad);
+	if (!ad)
+		return false;
+	if (!heapimage_readuint(r, &kind) || !heapimage_readcstring(r, &ad->filename)) {
+		free(ad);
+		return false;
+	}
+	ad->kind = (char)kind;
+	ad->info = NULL;
+	if (!heapimage_readuint(r, &lineno) || lineno > SIZE_MAX) {
+		free(ad->filename);
+		free(ad);
+		return false;
+	}
+	ad->lineno = (size_t)lineno;
+
+	switch (kind) {
+#define new_info(X) ((struct X *) (ad->info = malloc(sizeof(struct X))))
+	case AST_ARRAY:
+	case AST_BLOCK:
+	case AST_INT:
+	case AST_STR:
+	{
+		struct Object *obj;
+		if (!read_refs(r, &obj, NULL, NULL))
+			goto error;
+		ad->info = obj;
+		break;
+	}
+	case AST_GETVAR:
+	{
+		struct AstGetVarInfo *info = new_info(AstGetVarInfo);
+		if (!info || !read_refs(r, &info->varname, NULL, NULL))
+			goto error;
+		break;
+	}
+	case AST_GETATTR:
+	{
+		struct AstGetAttrInfo *info = new_info(AstGetAttrInfo);
+		if (!info || !read_refs(r, &info->objnode, &info->name, NULL))
+			goto error;
+		break;
+	}
+	case AST_CREATEVAR:
+	case AST_SETVAR:
+	{
+		struct AstCreateOrSetVarInfo *info = new_info(AstCreateOrSetVarInfo);
+		if (!info || !read_refs(r, &info->varname, &info->valnode, NULL))
+			goto error;
+		break;
+	}
+	case AST_SETATTR:
+	{
+		struct AstSetAttrInfo *info = new_info(AstSetAttrInfo);
+		if (!info || !read_refs(r, &info->objnode, &info->attr, &info->valnode))
+			goto error;
+		break;
+	}
+	case AST_CALL:
+	{
+		struct AstCallInfo *info = new_info(AstCallInfo);
+		if (!info || !read_refs(r, &info->funcnode, &info->args, &info->opts))
+			goto error;
+		break;
+	}
+	case AST_OPCALL:
+	{
+		uint64_t op;
+		struct AstOpCallInfo *info = new_info(AstOpCallInfo);
+		if (!info || !heapimage_readuint(r, &op) || op > OPERATOR_LE || !read_refs(r, &info->lhs, &info->rhs, NULL))
+			goto error;
+		info->op = (enum Operator)op;
+		break;
+	}
+#undef new_info
+	default:
+		free(ad->filename);
+		free(ad);
+		return false;
+	}
+
+	*data = ad;
+	return true;
+
+error:
+	// ad->kind is valid, so the destructor knows whether info must be freed
+	if (kind == AST_ARRAY || kind == AST_BLOCK || kind == AST_INT || kind == AST_STR)
+		ad->info = NULL;
+	astnode_destructor(ad);
+	return false;
+}
+
+const struct HeapImageKind astnodeobject_imagekind = { astnode_foreachref, astnode_destructor, astnode_writeimage, astnode_readimage, NULL };
+
 static struct Object *newinstance(struct Interpreter *interp, struct Object *args, struct Object *opts)
 {
 	errorobject_throwfmt(interp, "TypeError", "new AstNode objects cannot be created yet, sorry :(");
@@ -4,6 +4,7 @@
 #include <stdlib.h>
 #include "../attribute.h"
 #include "../check.h"
+#include "../heapimage.h"
 #include "../interpreter.h"   // IWYU pragma: keep
 #include "../method.h"
 #include "../objectsystem.h"  // IWYU pragma: keep
@@ -29,6 +30,29 @@ static void blockdata_destructor(void *data) {
 	free(data);
 }
 
+static bool blockdata_writeimage(struct HeapImageWriter *w, void *data)
+{
+	struct BlockObjectData *bod = data;
+	return heapimage_writeref(w, bod->definition_scope) && heapimage_writeref(w, bod->ast_statements);
+}
+
+static bool blockdata_readimage(struct HeapImageReader *r, void **data)
+{
+	struct BlockObjectData *bod = malloc(sizeof *bod);
+	if (!bod)
+		return false;
+	if (!heapimage_readref(r, &bod->definition_scope) || !bod->definition_scope ||
+		!heapimage_readref(r, &bod->ast_statements) || !bod->ast_statements)
+	{
+		free(bod);
+		return false;
+	}
+	*data = bod;
+	return true;
+}
+
+const struct HeapImageKind blockobject_imagekind = { blockdata_foreachref, blockdata_destructor, blockdata_writeimage, blockdata_readimage, NULL };
+
 static struct Object *newinstance(struct Interpreter *interp, struct Object *args, struct Object *opts)
 {
 	if (!check_args(interp, args, interp->builtins.Class, interp->builtins.Scope, interp->builtins.Array, NULL)) return NULL;
@@ -92,6 +116,8 @@ void markerdata_foreachref(void *data, object_foreachrefcb cb, void *cbdata)
 	cb((struct Object*)data, cbdata);
 }
 
+const struct HeapImageKind blockobject_returnerimagekind = { markerdata_foreachref, NULL, heapimage_writerefdata, heapimage_readrefdata, NULL };
+
 static bool returner_cfunc(struct Interpreter *interp, struct ObjectData markerdata, struct Object *args, struct Object *opts)
 {
 
@@ -102,7 +128,12 @@ static bool returner_cfunc(struct Interpreter *interp, struct ObjectData markerd
 	if (!attribute_settoattrdata(interp, markererr, "value", ARRAYOBJECT_GET(args, 0)))
 		return false;
 
-	errorobject_throw(interp, markererr);
+	// returning is very common, and the marker is caught by blockobject_runwithreturn() unless
+	// something else catches it first, so errorobject_throw() creating a stack would be wasted work
+	// if someone else catches it, the stack attribute is empty and throwing it again creates a stack
+	assert(!interp->err);
+	OBJECT_INCREF(interp, markererr);
+	interp->err = markererr;
 	return false;
 }
 
@@ -1,24 +1,147 @@
 #include "bytearray.h"
+#include <assert.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include "../attribute.h"
 #include "../check.h"
+#include "../heapimage.h"
 #include "../interpreter.h"
 #include "../method.h"
 #include "../objectsystem.h"
+#include "../search.h"
 #include "array.h"
+#include "bool.h"
 #include "classobject.h"
 #include "errors.h"
 #include "function.h"
 #include "integer.h"
 #include "option.h"
 
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <sys/mman.h>
+#endif
+
+static void free_val(unsigned char *val, size_t nallocated, bool mapped)
+{
+	if (mapped) {
+#if !defined(_WIN32) && !defined(_WIN64)
+		munmap(val, nallocated);
+#else
+		assert(0);    // there's no mmap() on windows, io.map_file reads the file instead
+#endif
+	} else {
+		free(val);
+	}
+}
+
+static void free_buffer(struct ByteArrayBuffer *buf)
+{
+	free_val(buf->val, buf->nallocated, buf->mapped);
+	free(buf);
+}
+
 static void bytearray_destructor(void *data)
 {
-	free(((struct ByteArrayObjectData *)data)->val);
+	struct ByteArrayBuffer *buf = ((struct ByteArrayObjectData *)data)->buf;
+	if (buf && --buf->nusers == 0)
+		free_buffer(buf);
 	free(data);
 }
 
+// buffers are copy-on-write, so each byte array gets a buffer of its own when loading
+static bool bytearray_writeimage(struct HeapImageWriter *w, void *data)
+{
+	struct ByteArrayObjectData *bd = data;
+	return heapimage_writeuint(w, bd->len) && heapimage_writebytes(w, bd->val, bd->len);
+}
+
+static bool bytearray_readimage(struct HeapImageReader *r, void **data)
+{
+	struct ByteArrayObjectData *bd = malloc(sizeof *bd);
+	if (!bd)
+		return false;
+	if (!heapimage_readsize(r, &bd->len)) {
+		free(bd);
+		return false;
+	}
+	if (bd->len == 0) {
+		bd->val = NULL;
+		bd->buf = NULL;
+		*data = bd;
+		return true;
+	}
+
+	if (!(bd->buf = malloc(sizeof *bd->buf))) {
+		free(bd);
+		return false;
+	}
+	bd->buf->nallocated = bd->len;
+	bd->buf->nusers = 1;
+	bd->buf->mapped = false;
+	if (!(bd->buf->val = malloc(bd->len)) || !heapimage_readbytes(r, bd->buf->val, bd->len)) {
+		bytearray_destructor(bd);
+		return false;
+	}
+	bd->val = bd->buf->val;
+	*data = bd;
+	return true;
+}
+
+const struct HeapImageKind bytearrayobject_imagekind = { NULL, bytearray_destructor, bytearray_writeimage, bytearray_readimage, NULL };
+
+// creates a ByteArray that uses len bytes of buf starting at start
+// buf can be NULL if len is 0, and it's freed on error if nothing else uses it
+static struct Object *new_from_buffer(struct Interpreter *interp, struct Object *klass, struct ByteArrayBuffer *buf, size_t start, size_t len)
+{
+	assert(buf || len == 0);
+	struct ByteArrayObjectData *data = malloc(sizeof *data);
+	if (!data)
+		goto error;
+
+	data->val = len == 0 ? NULL : buf->val + start;
+	data->len = len;
+	data->buf = len == 0 ? NULL : buf;
+
+	struct Object *b = object_new_noerr(interp, klass, (struct ObjectData){.data=data, .foreachref=NULL, .destructor=bytearray_destructor});
+	if (!b) {
+		free(data);
+		goto error;
+	}
+	if (data->buf)
+		data->buf->nusers++;
+	b->hashable = false;    // FIXME
+	return b;
+
+error:
+	errorobject_thrownomem(interp);
+	if (buf && buf->nusers == 0)
+		free_buffer(buf);
+	return NULL;
+}
+
+// val must be from malloc(), or mmap() if mapped is true, and it's freed on error
+static struct Object *new_from_val(struct Interpreter *interp, struct Object *klass, unsigned char *val, size_t len, bool mapped)
+{
+	if (len == 0) {
+		assert(!mapped);
+		free(val);
+		return new_from_buffer(interp, klass, NULL, 0, 0);
+	}
+
+	struct ByteArrayBuffer *buf = malloc(sizeof *buf);
+	if (!buf) {
+		errorobject_thrownomem(interp);
+		free_val(val, len, mapped);
+		return NULL;
+	}
+	buf->val = val;
+	buf->nallocated = len;
+	buf->nusers = 0;
+	buf->mapped = mapped;
+	return new_from_buffer(interp, klass, buf, 0, len);
+}
+
 
 static struct Object *newinstance(struct Interpreter *interp, struct Object *args, struct Object *opts)
 {
@@ -27,52 +150,32 @@ static struct Object *newinstance(struct Interpreter *interp, struct Object *arg
 	struct Object *klass = ARRAYOBJECT_GET(args, 0);
 	struct Object *arr = ARRAYOBJECT_GET(args, 1);
 
-	struct ByteArrayObjectData *data = malloc(sizeof *data);
-	if (!data)
-	{
+	// malloc(0) may return NULL
+	size_t len = ARRAYOBJECT_LEN(arr);
+	unsigned char *val = NULL;
+	if (len != 0 && !(val = malloc(len))) {
 		errorobject_thrownomem(interp);
 		return NULL;
 	}
 
-	// malloc(0) may return NULL
-	if (ARRAYOBJECT_LEN(arr) == 0) {
-		data->len = 0;
-		data->val = NULL;   // free(NULL) does nothing
-	} else {
-		data->len = ARRAYOBJECT_LEN(arr);
-		if (!(data->val = malloc(data->len))) {
-			errorobject_thrownomem(interp);
-			free(data);
+	for (size_t i=0; i < len; i++)
+	{
+		struct Object *integer = ARRAYOBJECT_GET(arr, i);
+		if (!check_type(interp, interp->builtins.Integer, integer)) {
+			free(val);
 			return NULL;
 		}
 
-		for (size_t i=0; i < data->len; i++)
-		{
-			struct Object *integer = ARRAYOBJECT_GET(arr, i);
-			if (!check_type(interp, interp->builtins.Integer, integer)) {
-				free(data->val);
-				free(data);
-				return NULL;
-			}
-
-			long long val = integerobject_tolonglong(integer);
-			if (val < 0x00 || val > 0xff) {
-				errorobject_throwfmt(interp, "ValueError", "expected an integer between 0 and 255, got %D", integer);
-				free(data->val);
-				free(data);
-				return NULL;
-			}
-			data->val[i] = val;
+		long long byte = integerobject_tolonglong(integer);
+		if (byte < 0x00 || byte > 0xff) {
+			errorobject_throwfmt(interp, "ValueError", "expected an integer between 0 and 255, got %D", integer);
+			free(val);
+			return NULL;
 		}
+		val[i] = byte;
 	}
 
-	struct Object *b = object_new_noerr(interp, klass, (struct ObjectData){.data=data, .foreachref=NULL, .destructor=bytearray_destructor});
-	if (!b) {
-		free(data->val);
-		free(data);
-		return NULL;
-	}
-	return b;
+	return new_from_val(interp, klass, val, len, false);
 }
 
 // overrides Object's setup to allow arguments
@@ -106,6 +209,35 @@ static struct Object *get(struct Interpreter *interp, struct ObjectData thisdata
 	return integerobject_newfromlonglong(interp, BYTEARRAYOBJECT_DATA(b)[i]);
 }
 
+// creates a new ByteArray from a copy of len bytes starting at val
+static struct Object *new_copy(struct Interpreter *interp, unsigned char *val, size_t len)
+{
+	if (len == 0)
+		return bytearrayobject_new(interp, NULL, 0);
+
+	unsigned char *copy = malloc(len);
+	if (!copy) {
+		errorobject_thrownomem(interp);
+		return NULL;
+	}
+	memcpy(copy, val, len);
+	return bytearrayobject_new(interp, copy, len);
+}
+
+// see string.c, strings are sliced the same way
+#define SHARED_SLICE_MIN_LEN 64
+#define SHARED_SLICE_MAX_WASTE 4
+
+// creates a ByteArray of len bytes of b starting at start, sharing the bytes with b if it's worth it
+static struct Object *new_slice(struct Interpreter *interp, struct Object *b, size_t start, size_t len)
+{
+	struct ByteArrayObjectData *data = b->objdata.data;
+	// pages of mapped files that aren't used don't take memory, so sharing them wastes nothing
+	if (len < SHARED_SLICE_MIN_LEN || (len < data->buf->nallocated/SHARED_SLICE_MAX_WASTE && !data->buf->mapped))
+		return new_copy(interp, data->val + start, len);
+	return new_from_buffer(interp, interp->builtins.ByteArray, data->buf, (size_t)(data->val - data->buf->val) + start, len);
+}
+
 static struct Object *slice(struct Interpreter *interp, struct ObjectData thisdata, struct Object *args, struct Object *opts)
 {
 	struct Object *b = thisdata.data;
@@ -137,15 +269,253 @@ static struct Object *slice(struct Interpreter *interp, struct ObjectData thisda
 	if (start >= end)
 		return bytearrayobject_new(interp, NULL, 0);
 
-	// TODO: optimize magically instead of allocating more mem for each slice
-	// maybe a ByteArraySlice object like python's memoryview?
-	unsigned char *newdata = malloc(end - start);
-	if (!newdata) {
-		errorobject_thrownomem(interp);
+	return new_slice(interp, b, start, end - start);
+}
+
+static struct Object *find(struct Interpreter *interp, struct ObjectData thisdata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, interp->builtins.ByteArray, NULL)) return NULL;
+	if (!check_no_opts(interp, opts)) return NULL;
+	struct Object *b = thisdata.data;
+	struct Object *needle = ARRAYOBJECT_GET(args, 0);
+
+	struct Searcher s;
+	search_init(&s, BYTEARRAYOBJECT_DATA(needle), BYTEARRAYOBJECT_LEN(needle), 1);
+	size_t i = search_find(&s, BYTEARRAYOBJECT_DATA(b), BYTEARRAYOBJECT_LEN(b));
+	if (i == SEARCH_NOTFOUND) {
+		OBJECT_INCREF(interp, interp->builtins.none);
+		return interp->builtins.none;
+	}
+
+	struct Object *integer = integerobject_newfromlonglong(interp, (long long) i);
+	if (!integer)
+		return NULL;
+	struct Object *opt = optionobject_new(interp, integer);
+	OBJECT_DECREF(interp, integer);
+	return opt;
+}
+
+static struct Object *count(struct Interpreter *interp, struct ObjectData thisdata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, interp->builtins.ByteArray, NULL)) return NULL;
+	if (!check_no_opts(interp, opts)) return NULL;
+	struct Object *b = thisdata.data;
+	struct Object *needle = ARRAYOBJECT_GET(args, 0);
+
+	if (BYTEARRAYOBJECT_LEN(needle) == 0) {
+		errorobject_throwfmt(interp, "ValueError", "cannot count an empty byte array");
+		return NULL;
+	}
+
+	struct Searcher s;
+	search_init(&s, BYTEARRAYOBJECT_DATA(needle), BYTEARRAYOBJECT_LEN(needle), 1);
+
+	// matches don't overlap, just like with split
+	long long n = 0;
+	size_t offset = 0;
+	while (offset < BYTEARRAYOBJECT_LEN(b)) {
+		size_t i = search_find(&s, BYTEARRAYOBJECT_DATA(b) + offset, BYTEARRAYOBJECT_LEN(b) - offset);
+		if (i == SEARCH_NOTFOUND)
+			break;
+		n++;
+		offset += i + BYTEARRAYOBJECT_LEN(needle);
+	}
+	return integerobject_newfromlonglong(interp, n);
+}
+
+static struct Object *split(struct Interpreter *interp, struct ObjectData thisdata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, interp->builtins.ByteArray, NULL)) return NULL;
+	if (!check_no_opts(interp, opts)) return NULL;
+	struct Object *b = thisdata.data;
+	struct Object *sep = ARRAYOBJECT_GET(args, 0);
+
+	if (BYTEARRAYOBJECT_LEN(sep) == 0) {
+		errorobject_throwfmt(interp, "ValueError", "cannot split by an empty byte array");
 		return NULL;
 	}
-	memcpy(newdata, BYTEARRAYOBJECT_DATA(b)+start, end-start);
-	return bytearrayobject_new(interp, newdata, end - start);
+
+	struct Searcher s;
+	search_init(&s, BYTEARRAYOBJECT_DATA(sep), BYTEARRAYOBJECT_LEN(sep), 1);
+
+	struct Object *result = arrayobject_newempty(interp);
+	if (!result)
+		return NULL;
+
+	size_t offset = 0;
+	while (true) {
+		size_t i = SEARCH_NOTFOUND;
+		if (offset < BYTEARRAYOBJECT_LEN(b))
+			i = search_find(&s, BYTEARRAYOBJECT_DATA(b) + offset, BYTEARRAYOBJECT_LEN(b) - offset);
+		size_t partlen = (i == SEARCH_NOTFOUND) ? BYTEARRAYOBJECT_LEN(b) - offset : i;
+
+		struct Object *part = new_slice(interp, b, offset, partlen);
+		if (!part)
+			goto error;
+		bool ok = arrayobject_push(interp, result, part);
+		OBJECT_DECREF(interp, part);
+		if (!ok)
+			goto error;
+
+		if (i == SEARCH_NOTFOUND)
+			break;
+		offset += i + BYTEARRAYOBJECT_LEN(sep);    // matches don't overlap
+	}
+	return result;
+
+error:
+	OBJECT_DECREF(interp, result);
+	return NULL;
+}
+
+static struct Object *starts_with(struct Interpreter *interp, struct ObjectData thisdata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, interp->builtins.ByteArray, NULL)) return NULL;
+	if (!check_no_opts(interp, opts)) return NULL;
+	struct Object *b = thisdata.data;
+	struct Object *prefix = ARRAYOBJECT_GET(args, 0);
+
+	size_t len = BYTEARRAYOBJECT_LEN(prefix);
+	return boolobject_get(interp, len <= BYTEARRAYOBJECT_LEN(b) &&
+		(len == 0 || memcmp(BYTEARRAYOBJECT_DATA(b), BYTEARRAYOBJECT_DATA(prefix), len) == 0));
+}
+
+static struct Object *ends_with(struct Interpreter *interp, struct ObjectData thisdata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, interp->builtins.ByteArray, NULL)) return NULL;
+	if (!check_no_opts(interp, opts)) return NULL;
+	struct Object *b = thisdata.data;
+	struct Object *suffix = ARRAYOBJECT_GET(args, 0);
+
+	size_t len = BYTEARRAYOBJECT_LEN(suffix);
+	return boolobject_get(interp, len <= BYTEARRAYOBJECT_LEN(b) &&
+		(len == 0 || memcmp(BYTEARRAYOBJECT_DATA(b) + (BYTEARRAYOBJECT_LEN(b) - len), BYTEARRAYOBJECT_DATA(suffix), len) == 0));
+}
+
+// makes sure that data has a buffer of its own with room for n more bytes
+static bool make_room(struct Interpreter *interp, struct ByteArrayObjectData *data, size_t n)
+{
+	struct ByteArrayBuffer *buf = data->buf;
+	size_t offset = buf ? (size_t)(data->val - buf->val) : 0;
+	// a mapped buffer is never modified, so it's treated like a shared buffer
+	bool own = (buf && buf->nusers == 1 && !buf->mapped);
+	if (own && n <= buf->nallocated - offset - data->len)
+		return true;
+
+	if (n > SIZE_MAX - data->len) {
+		errorobject_thrownomem(interp);
+		return false;
+	}
+
+	// grow geometrically, so that appending in a loop is amortized O(1) per byte
+	size_t newsize = data->len < 8 ? 16 : data->len > SIZE_MAX/2 ? SIZE_MAX : 2*data->len;
+	if (newsize < data->len + n)
+		newsize = data->len + n;
+
+	if (own) {
+		// nothing else uses the buffer, so it can be modified
+		// get rid of stuff before data->val, left there by slicing
+		if (offset != 0) {
+			memmove(buf->val, data->val, data->len);
+			data->val = buf->val;
+			if (data->len + n <= buf->nallocated)
+				return true;
+		}
+
+		unsigned char *ptr = realloc(buf->val, newsize);
+		if (!ptr) {
+			errorobject_thrownomem(interp);
+			return false;
+		}
+		buf->val = data->val = ptr;
+		buf->nallocated = newsize;
+		return true;
+	}
+
+	// the buffer is shared with other byte arrays or mapped, or there is no buffer yet
+	struct ByteArrayBuffer *newbuf = malloc(sizeof *newbuf);
+	if (!newbuf) {
+		errorobject_thrownomem(interp);
+		return false;
+	}
+	if (!(newbuf->val = malloc(newsize))) {
+		errorobject_thrownomem(interp);
+		free(newbuf);
+		return false;
+	}
+	if (data->len != 0)
+		memcpy(newbuf->val, data->val, data->len);
+	newbuf->nallocated = newsize;
+	newbuf->nusers = 1;
+	newbuf->mapped = false;
+
+	if (buf && --buf->nusers == 0)
+		free_buffer(buf);    // a mapped buffer that only this byte array used
+	data->buf = newbuf;
+	data->val = newbuf->val;
+	return true;
+}
+
+bool bytearrayobject_extend(struct Interpreter *interp, struct Object *b, struct Object *other)
+{
+	struct ByteArrayObjectData *data = b->objdata.data;
+	size_t n = BYTEARRAYOBJECT_LEN(other);
+	if (n == 0)
+		return true;
+	if (!make_room(interp, data, n))
+		return false;
+
+	// make_room may move b's bytes, so this must be after it for (b.extend b)
+	memcpy(data->val + data->len, BYTEARRAYOBJECT_DATA(other), n);
+	data->len += n;
+	return true;
+}
+
+static bool extend(struct Interpreter *interp, struct ObjectData thisdata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, interp->builtins.ByteArray, NULL)) return false;
+	if (!check_no_opts(interp, opts)) return false;
+	return bytearrayobject_extend(interp, thisdata.data, ARRAYOBJECT_GET(args, 0));
+}
+
+static bool append(struct Interpreter *interp, struct ObjectData thisdata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, interp->builtins.Integer, NULL)) return false;
+	if (!check_no_opts(interp, opts)) return false;
+	struct ByteArrayObjectData *data = ((struct Object *) thisdata.data)->objdata.data;
+	struct Object *integer = ARRAYOBJECT_GET(args, 0);
+
+	long long val = integerobject_tolonglong(integer);
+	if (val < 0x00 || val > 0xff) {
+		errorobject_throwfmt(interp, "ValueError", "expected an integer between 0 and 255, got %D", integer);
+		return false;
+	}
+
+	if (!make_room(interp, data, 1))
+		return false;
+	data->val[data->len++] = (unsigned char) val;
+	return true;
+}
+
+static bool reserve(struct Interpreter *interp, struct ObjectData thisdata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, interp->builtins.Integer, NULL)) return false;
+	if (!check_no_opts(interp, opts)) return false;
+	struct ByteArrayObjectData *data = ((struct Object *) thisdata.data)->objdata.data;
+	struct Object *integer = ARRAYOBJECT_GET(args, 0);
+
+	long long size = integerobject_tolonglong(integer);
+	if (size < 0) {
+		errorobject_throwfmt(interp, "ValueError", "expected a non-negative integer, got %D", integer);
+		return false;
+	}
+	if ((unsigned long long) size <= data->len)
+		return true;
+	if ((unsigned long long) size > SIZE_MAX) {
+		errorobject_thrownomem(interp);
+		return false;
+	}
+	return make_room(interp, data, (size_t)size - data->len);
 }
 
 static struct Object *length_getter(struct Interpreter *interp, struct ObjectData nulldata, struct Object *args, struct Object *opts)
@@ -163,8 +533,16 @@ struct Object *bytearrayobject_createclass(struct Interpreter *interp)
 
 	if (!method_add_noret(interp, klass, "setup", setup)) goto error;
 	if (!attribute_add(interp, klass, "length", length_getter, NULL)) goto error;
+	if (!method_add_noret(interp, klass, "append", append)) goto error;
+	if (!method_add_yesret(interp, klass, "count", count)) goto error;
+	if (!method_add_yesret(interp, klass, "ends_with", ends_with)) goto error;
+	if (!method_add_noret(interp, klass, "extend", extend)) goto error;
+	if (!method_add_yesret(interp, klass, "find", find)) goto error;
 	if (!method_add_yesret(interp, klass, "get", get)) goto error;
+	if (!method_add_noret(interp, klass, "reserve", reserve)) goto error;
 	if (!method_add_yesret(interp, klass, "slice", slice)) goto error;
+	if (!method_add_yesret(interp, klass, "split", split)) goto error;
+	if (!method_add_yesret(interp, klass, "starts_with", starts_with)) goto error;
 	return klass;
 
 error:
@@ -175,25 +553,12 @@ error:
 
 struct Object *bytearrayobject_new(struct Interpreter *interp, unsigned char *val, size_t len)
 {
-	struct ByteArrayObjectData *data = malloc(sizeof(struct ByteArrayObjectData));
-	if (!data) {
-		errorobject_thrownomem(interp);
-		free(val);
-		return NULL;
-	}
-
-	data->len = len;
-	data->val = val;
+	return new_from_val(interp, interp->builtins.ByteArray, val, len, false);
+}
 
-	struct Object *b = object_new_noerr(interp, interp->builtins.ByteArray, (struct ObjectData){.data=data, .foreachref=NULL, .destructor=bytearray_destructor});
-	if (!b) {
-		errorobject_thrownomem(interp);
-		free(data);
-		free(val);
-		return NULL;
-	}
-	b->hashable = false;    // FIXME
-	return b;
+struct Object *bytearrayobject_newmapped(struct Interpreter *interp, unsigned char *val, size_t len)
+{
+	return new_from_val(interp, interp->builtins.ByteArray, val, len, true);
 }
 
 
@@ -246,6 +611,19 @@ static struct Object *add(struct Interpreter *interp, struct ObjectData nulldata
 	return opt;
 }
 
+int bytearrayobject_fastadd(struct Interpreter *interp, struct Object *func, struct Object *lhs, struct Object *rhs)
+{
+	if (lhs->refcount != 1 || lhs->klass != interp->builtins.ByteArray || rhs->klass != interp->builtins.ByteArray)
+		return 0;
+	if (func->klass != interp->builtins.Function)
+		return 0;
+
+	struct FunctionObjectCfunc cfunc = functionobject_getcfunc(func);
+	if (!cfunc.returning || cfunc.func.yesret != add)
+		return 0;
+	return bytearrayobject_extend(interp, lhs, rhs) ? 1 : -1;
+}
+
 bool bytearrayobject_initoparrays(struct Interpreter *interp)
 {
 	if (!functionobject_add2array(interp, interp->oparrays.eq, "bytearray_eq", functionobject_mkcfunc_yesret(eq))) return false;
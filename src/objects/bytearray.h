@@ -6,9 +6,19 @@
 #include "../interpreter.h"    // IWYU pragma: keep
 #include "../objectsystem.h"   // IWYU pragma: keep
 
-struct ByteArrayObjectData {
+// several byte arrays can share the same bytes, e.g. big slices don't copy anything
+// byte arrays can grow, and a shared buffer is copied before growing it (copy-on-write)
+struct ByteArrayBuffer {
 	unsigned char *val;
+	size_t nallocated;
+	unsigned long nusers;   // number of ByteArray objects using this buffer
+	bool mapped;            // val is from mmap(), not malloc(), and it's never modified
+};
+
+struct ByteArrayObjectData {
+	unsigned char *val;   // points into buf->val, NULL if buf is NULL
 	size_t len;
+	struct ByteArrayBuffer *buf;   // NULL if nothing has been allocated
 };
 
 // RETURNS A NEW REFERENCE or NULL on error
@@ -22,11 +32,25 @@ bool bytearrayobject_initoparrays(struct Interpreter *interp);
 // use bytearrayobject_new(interp, NULL, 0) to create an empty ByteArray
 struct Object *bytearrayobject_new(struct Interpreter *interp, unsigned char *val, size_t len);
 
+// RETURNS A NEW REFERENCE or NULL on error
+// like bytearrayobject_new, but val is from mmap() and it's munmapped when no byte array uses it anymore
+// val is never written to, changing the byte array (e.g. with append) copies the bytes first
+// on error, this munmaps val
+struct Object *bytearrayobject_newmapped(struct Interpreter *interp, unsigned char *val, size_t len);
+
+// adds the bytes of other to the end of b, other can be b
+// bad things happen if b or other is not a ByteArray
+// returns false on error
+bool bytearrayobject_extend(struct Interpreter *interp, struct Object *b, struct Object *other);
+
+// operator_call() calls this with each function of interp->oparrays.add before calling the function
+// if func is the built-in ByteArray add and nothing else has a reference to lhs, then (lhs + rhs) can be done by
+// adding rhs to the end of lhs, and nothing can notice the difference, so ((a + b) + c) doesn't copy (a + b) again
+// returns 1 after adding rhs to lhs, 0 if that can't be done and func must be called as usual, and -1 on error
+int bytearrayobject_fastadd(struct Interpreter *interp, struct Object *func, struct Object *lhs, struct Object *rhs);
+
 // bad things happen if arr is not an array object, otherwise these never fail
 #define BYTEARRAYOBJECT_DATA(arr) (((struct ByteArrayObjectData *) (arr)->objdata.data)->val)
 #define BYTEARRAYOBJECT_LEN(arr)  (((struct ByteArrayObjectData *) (arr)->objdata.data)->len)
 
-// RETURNS A NEW REFERENCE or NULL on error
-struct Object *bytearrayobject_slice(struct Interpreter *interp, struct Object *arr, long long start, long long end);
-
 #endif    // OBJECTS_BYTEARRAY_H
@@ -0,0 +1,227 @@
+#include "channel.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include "../atomicincrdecr.h"
+#include "../check.h"
+#include "../interpreter.h"
+#include "../method.h"
+#include "../objectsystem.h"
+#include "../serialize.h"
+#include "array.h"
+#include "classobject.h"
+#include "errors.h"
+#include "option.h"
+
+void channeldata_incref(struct ChannelData *data)
+{
+	ATOMIC_INCR(data->refcount);
+}
+
+void channeldata_decref(struct ChannelData *data)
+{
+	if (ATOMIC_DECR(data->refcount) != 0)
+		return;
+
+	// nothing else refers to the channel, so no need to lock
+	struct ChannelMessage *msg = data->first;
+	while (msg) {
+		struct ChannelMessage *next = msg->next;
+		// this may decref other channels, but not this one because it's not referenced anymore
+		serialize_discard(msg->data, msg->len);
+		free(msg->data);
+		free(msg);
+		msg = next;
+	}
+	pthread_cond_destroy(&data->cond);
+	pthread_mutex_destroy(&data->lock);
+	free(data);
+}
+
+int channeldata_send(struct ChannelData *chan, unsigned char *data, size_t len)
+{
+	struct ChannelMessage *msg = malloc(sizeof *msg);
+	if (!msg) {
+		serialize_discard(data, len);
+		free(data);
+		return -1;
+	}
+	msg->data = data;
+	msg->len = len;
+	msg->next = NULL;
+
+	pthread_mutex_lock(&chan->lock);
+	bool closed = chan->closed;
+	if (!closed) {
+		if (chan->last)
+			chan->last->next = msg;
+		else
+			chan->first = msg;
+		chan->last = msg;
+		pthread_cond_signal(&chan->cond);
+	}
+	pthread_mutex_unlock(&chan->lock);
+
+	if (closed) {
+		serialize_discard(data, len);
+		free(data);
+		free(msg);
+		return 0;
+	}
+	return 1;
+}
+
+bool channeldata_receive(struct ChannelData *chan, unsigned char **data, size_t *len)
+{
+	pthread_mutex_lock(&chan->lock);
+	while (!chan->first && !chan->closed)
+		pthread_cond_wait(&chan->cond, &chan->lock);
+
+	struct ChannelMessage *msg = chan->first;
+	if (msg) {
+		chan->first = msg->next;
+		if (!chan->first)
+			chan->last = NULL;
+	}
+	pthread_mutex_unlock(&chan->lock);
+
+	if (!msg)
+		return false;
+	*data = msg->data;
+	*len = msg->len;
+	free(msg);
+	return true;
+}
+
+void channeldata_close(struct ChannelData *chan)
+{
+	pthread_mutex_lock(&chan->lock);
+	chan->closed = true;
+	pthread_cond_broadcast(&chan->cond);
+	pthread_mutex_unlock(&chan->lock);
+}
+
+
+static void channel_destructor(void *data)
+{
+	channeldata_decref(data);
+}
+
+struct Object *channelobject_new(struct Interpreter *interp, struct ChannelData *data)
+{
+	struct Object *chan = object_new_noerr(interp, interp->builtins.Channel, (struct ObjectData){.data=data, .foreachref=NULL, .destructor=channel_destructor});
+	if (!chan) {
+		errorobject_thrownomem(interp);
+		channeldata_decref(data);
+		return NULL;
+	}
+	return chan;
+}
+
+static struct Object *newinstance(struct Interpreter *interp, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, interp->builtins.Class, NULL)) return NULL;
+	if (!check_no_opts(interp, opts)) return NULL;
+
+	struct ChannelData *data = malloc(sizeof *data);
+	if (!data) {
+		errorobject_thrownomem(interp);
+		return NULL;
+	}
+	data->refcount = 1;
+	data->first = NULL;
+	data->last = NULL;
+	data->closed = false;
+	if (pthread_mutex_init(&data->lock, NULL) != 0) {
+		free(data);
+		errorobject_thrownomem(interp);
+		return NULL;
+	}
+	if (pthread_cond_init(&data->cond, NULL) != 0) {
+		pthread_mutex_destroy(&data->lock);
+		free(data);
+		errorobject_thrownomem(interp);
+		return NULL;
+	}
+
+	struct Object *chan = object_new_noerr(interp, ARRAYOBJECT_GET(args, 0), (struct ObjectData){.data=data, .foreachref=NULL, .destructor=channel_destructor});
+	if (!chan) {
+		errorobject_thrownomem(interp);
+		channeldata_decref(data);
+		return NULL;
+	}
+	return chan;
+}
+
+static bool send_(struct Interpreter *interp, struct ObjectData thisdata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, interp->builtins.Object, NULL)) return false;
+	if (!check_no_opts(interp, opts)) return false;
+
+	struct SerializeBuf buf = {0};
+	if (!serialize_dump(interp, ARRAYOBJECT_GET(args, 0), &buf)) {
+		free(buf.data);
+		return false;
+	}
+
+	int status = channeldata_send(CHANNELOBJECT_DATA((struct Object *) thisdata.data), buf.data, buf.len);
+	if (status == 0) {
+		errorobject_throwfmt(interp, "ValueError", "cannot send to a closed channel");
+		return false;
+	}
+	if (status == -1) {
+		errorobject_thrownomem(interp);
+		return false;
+	}
+	return true;
+}
+
+// waits for a message, returns none if the channel is closed and there are no more messages
+static struct Object *receive(struct Interpreter *interp, struct ObjectData thisdata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, NULL)) return NULL;
+	if (!check_no_opts(interp, opts)) return NULL;
+
+	unsigned char *data;
+	size_t len;
+	if (!channeldata_receive(CHANNELOBJECT_DATA((struct Object *) thisdata.data), &data, &len)) {
+		OBJECT_INCREF(interp, interp->builtins.none);
+		return interp->builtins.none;
+	}
+
+	size_t pos = 0;
+	struct Object *val = serialize_load(interp, data, len, &pos);
+	serialize_discard(data, len);
+	free(data);
+	if (!val)
+		return NULL;
+
+	struct Object *res = optionobject_new(interp, val);
+	OBJECT_DECREF(interp, val);
+	return res;
+}
+
+static bool close_(struct Interpreter *interp, struct ObjectData thisdata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, NULL)) return false;
+	if (!check_no_opts(interp, opts)) return false;
+	channeldata_close(CHANNELOBJECT_DATA((struct Object *) thisdata.data));
+	return true;
+}
+
+struct Object *channelobject_createclass(struct Interpreter *interp)
+{
+	struct Object *klass = classobject_new(interp, "Channel", interp->builtins.Object, newinstance);
+	if (!klass)
+		return NULL;
+
+	if (!method_add_noret(interp, klass, "send", send_)) goto error;
+	if (!method_add_yesret(interp, klass, "receive", receive)) goto error;
+	if (!method_add_noret(interp, klass, "close", close_)) goto error;
+	return klass;
+
+error:
+	OBJECT_DECREF(interp, klass);
+	return NULL;
+}
@@ -0,0 +1,58 @@
+#ifndef OBJECTS_CHANNEL_H
+#define OBJECTS_CHANNEL_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "../interpreter.h"    // IWYU pragma: keep
+#include "../objectsystem.h"   // IWYU pragma: keep
+
+/* a queue of messages between interpreters running in different threads, see std/threads.ö
+
+objects can't be shared between interpreters, so messages are bytes from serialize_dump()
+the same ChannelData is used by a Channel object in each interpreter that has the channel,
+and it's freed when no Channel object or unreceived message refers to it anymore
+*/
+struct ChannelMessage {
+	unsigned char *data;
+	size_t len;
+	struct ChannelMessage *next;
+};
+
+struct ChannelData {
+	long refcount;    // use channeldata_incref() and channeldata_decref()
+	pthread_mutex_t lock;
+	pthread_cond_t cond;    // signaled when a message is added or the channel is closed
+	struct ChannelMessage *first, *last;   // NULL if there are no messages
+	bool closed;
+};
+
+// RETURNS A NEW REFERENCE or NULL on error
+struct Object *channelobject_createclass(struct Interpreter *interp);
+
+// RETURNS A NEW REFERENCE or NULL on error
+// this steals a reference to data, so data is decreffed on error
+struct Object *channelobject_new(struct Interpreter *interp, struct ChannelData *data);
+
+// bad things happen if obj is not a Channel
+#define CHANNELOBJECT_DATA(obj) ((struct ChannelData *) (obj)->objdata.data)
+
+// these can be called from any thread, the last decref frees the messages and the channel
+void channeldata_incref(struct ChannelData *data);
+void channeldata_decref(struct ChannelData *data);
+
+/* these can be called from any thread without an interpreter, e.g. std/threads.ö's pool workers use them
+
+channeldata_send() takes the data, and it must be from malloc() and serialize_dump()
+returns 1 on success, 0 if the channel is closed and -1 on no mem, data is freed in those cases
+*/
+int channeldata_send(struct ChannelData *chan, unsigned char *data, size_t len);
+
+// waits for a message, sets *data to a buffer that must be free()'d
+// returns false if the channel is closed and there are no more messages
+bool channeldata_receive(struct ChannelData *chan, unsigned char **data, size_t *len);
+
+// wakes up everything waiting in channeldata_receive(), closing twice does nothing
+void channeldata_close(struct ChannelData *chan);
+
+#endif    // OBJECTS_CHANNEL_H
@@ -2,10 +2,12 @@
 #include <assert.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include "../attribute.h"
 #include "../check.h"
+#include "../heapimage.h"
 #include "../interpreter.h"
 #include "../method.h"
 #include "../objectsystem.h"
@@ -31,6 +33,73 @@ static void class_destructor(void *data)
 	free(data);
 }
 
+static bool class_writeimage(struct HeapImageWriter *w, void *data)
+{
+	struct ClassObjectData *cd = data;
+	if (!heapimage_writeuint(w, cd->name.len))
+		return false;
+	for (size_t i=0; i < cd->name.len; i++) {
+		if (!heapimage_writeuint(w, cd->name.val[i]))
+			return false;
+	}
+
+	return heapimage_writeref(w, cd->baseclass) &&
+		heapimage_writeref(w, cd->setters) &&
+		heapimage_writeref(w, cd->getters) &&
+		heapimage_writefuncptr(w, (void (*)(void)) cd->newinstance)
+#ifndef NO_STATS
+		&& heapimage_writeuint(w, cd->nallocated)
+		&& heapimage_writeuint(w, cd->nfreed)
+#endif
+		;
+}
+
+static bool class_readimage(struct HeapImageReader *r, void **data)
+{
+	struct ClassObjectData *cd = malloc(sizeof *cd);
+	if (!cd)
+		return false;
+	cd->name.val = NULL;
+	if (!heapimage_readsize(r, &cd->name.len))
+		goto error;
+
+	if (cd->name.len != 0) {
+		if (!(cd->name.val = malloc(cd->name.len * sizeof cd->name.val[0])))
+			goto error;
+		for (size_t i=0; i < cd->name.len; i++) {
+			uint64_t c;
+			if (!heapimage_readuint(r, &c) || c > 0x10ffff)
+				goto error;
+			cd->name.val[i] = (unicode_char)c;
+		}
+	}
+
+	void (*newinstance)(void);
+	if (!heapimage_readref(r, &cd->baseclass) ||
+		!heapimage_readref(r, &cd->setters) ||
+		!heapimage_readref(r, &cd->getters) ||
+		!heapimage_readfuncptr(r, &newinstance))
+		goto error;
+	cd->newinstance = (struct Object* (*)(struct Interpreter *, struct Object *, struct Object *)) newinstance;
+
+#ifndef NO_STATS
+	uint64_t nallocated, nfreed;
+	if (!heapimage_readuint(r, &nallocated) || !heapimage_readuint(r, &nfreed))
+		goto error;
+	cd->nallocated = nallocated;
+	cd->nfreed = nfreed;
+#endif
+
+	*data = cd;
+	return true;
+
+error:
+	class_destructor(cd);
+	return false;
+}
+
+const struct HeapImageKind classobject_imagekind = { class_foreachref, class_destructor, class_writeimage, class_readimage, NULL };
+
 
 static struct ClassObjectData *create_data(struct Interpreter *interp, struct Object *baseclass)
 {
@@ -48,6 +117,10 @@ static struct ClassObjectData *create_data(struct Interpreter *interp, struct Ob
 		data->newinstance = NULL;
 	data->setters = NULL;
 	data->getters = NULL;
+#ifndef NO_STATS
+	data->nallocated = 0;
+	data->nfreed = 0;
+#endif
 	return data;
 }
 
@@ -133,7 +206,7 @@ static struct Object *class_newinstance(struct Interpreter *interp, struct Objec
 	}
 
 	assert(!data->name.val);   // shouldn't need a free() here
-	if (!unicodestring_copyinto(interp, *((struct UnicodeString *) name->objdata.data), &data->name)) {
+	if (!stringobject_getustr(interp, name, &data->name)) {
 		free_data(interp, data);
 		return NULL;
 	}
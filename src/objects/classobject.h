@@ -29,6 +29,12 @@ struct ClassObjectData {
 	// it's safe to assume that ARRAYOBJECT_LEN(args) >= 1 and the first arg is the class object
 	// NULL means that object_new_noerr() is used instead
 	struct Object* (*newinstance)(struct Interpreter *, struct Object *args, struct Object *opts);
+
+#ifndef NO_STATS
+	// instances created and destroyed so far, see stats.h
+	unsigned long long nallocated;
+	unsigned long long nfreed;
+#endif
 };
 
 // creates a new class
@@ -7,9 +7,11 @@
 #include <stdlib.h>
 #include "../attribute.h"
 #include "../check.h"
+#include "../heapimage.h"
 #include "../interpreter.h"
 #include "../method.h"
 #include "../objectsystem.h"
+#include "../stats.h"
 #include "../unicode.h"
 #include "../utf8.h"
 #include "array.h"
@@ -39,6 +41,27 @@ static void error_destructor(void *data)
 	free(data);
 }
 
+static bool error_writeimage(struct HeapImageWriter *w, void *data)
+{
+	struct ErrorData *edata = data;
+	return heapimage_writeref(w, edata->message) && heapimage_writeref(w, edata->stack);
+}
+
+static bool error_readimage(struct HeapImageReader *r, void **data)
+{
+	struct ErrorData *edata = malloc(sizeof *edata);
+	if (!edata)
+		return false;
+	if (!heapimage_readref(r, &edata->message) || !edata->message || !heapimage_readref(r, &edata->stack)) {
+		free(edata);
+		return false;
+	}
+	*data = edata;
+	return true;
+}
+
+const struct HeapImageKind errorobject_imagekind = { error_foreachref, error_destructor, error_writeimage, error_readimage, NULL };
+
 static struct Object *newinstance(struct Interpreter *interp, struct Object *args, struct Object *opts)
 {
 	struct ErrorData *data = malloc(sizeof(struct ErrorData));
@@ -115,16 +138,30 @@ static bool message_setter(struct Interpreter *interp, struct ObjectData nulldat
 	return true;
 }
 
+static void print_utf8(char *utf8, size_t utf8len)
+{
+	for (size_t i = 0; i < utf8len; i++)
+		fputc(utf8[i], stderr);
+	free(utf8);
+}
+
 static bool print_ustr(struct Interpreter *interp, struct UnicodeString u)
 {
 	char *utf8;
 	size_t utf8len;
 	if (!utf8_encode(interp, u, &utf8, &utf8len))
 		return false;
+	print_utf8(utf8, utf8len);
+	return true;
+}
 
-	for (size_t i = 0; i < utf8len; i++)
-		fputc(utf8[i], stderr);
-	free(utf8);
+static bool print_string(struct Interpreter *interp, struct Object *s)
+{
+	char *utf8;
+	size_t utf8len;
+	if (!stringobject_toutf8(interp, s, &utf8, &utf8len))
+		return false;
+	print_utf8(utf8, utf8len);
 	return true;
 }
 
@@ -145,7 +182,7 @@ static bool print_stack(struct Interpreter *interp, struct ObjectData thisdata,
 		return false;
 	fputs(": ", stderr);
 	struct ErrorData *data = err->objdata.data;
-	if (!print_ustr( interp, *((struct UnicodeString *) data->message->objdata.data) ))
+	if (!print_string(interp, data->message))
 		return false;
 	fputc('\n', stderr);
 	return true;
@@ -254,6 +291,7 @@ void errorobject_throw(struct Interpreter *interp, struct Object *err)
 
 	interp->err = err;
 	OBJECT_INCREF(interp, err);
+	STATS_INCR(interp, errorsthrown);
 }
 
 void errorobject_throwfmt(struct Interpreter *interp, char *classname, char *fmt, ...)
@@ -42,6 +42,7 @@ void errorobject_print(struct Interpreter *interp, struct Object *err);
 #define errorobject_thrownomem(interp) do { \
 		OBJECT_INCREF((interp), (interp)->builtins.nomemerr); \
 		(interp)->err = (interp)->builtins.nomemerr; \
+		STATS_INCR((interp), errorsthrown); \
 	} while (0)
 
 #endif    // OBJECTS_ERRORS_H
@@ -1,23 +1,55 @@
+// getdelim(), fileno() and friends are posix, not c99
+#define _POSIX_C_SOURCE 200809L
+// copy_file_range() and sendfile() are linux-specific
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
 #include "file.h"
 #include <assert.h>
 #include <errno.h>
 #include <limits.h>
+#include <pthread.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
 #include "../attribute.h"
 #include "../check.h"
+#include "../heapimage.h"
 #include "../interpreter.h"
 #include "../method.h"
 #include "../objectsystem.h"
-#include "../utf8.h"
 #include "array.h"
 #include "bool.h"
 #include "bytearray.h"
 #include "classobject.h"
 #include "errors.h"
 #include "integer.h"
+#include "option.h"
+#include "string.h"
+
+#if defined(_WIN32) || defined(_WIN64)
+#define WINDOWS
+#include <io.h>    // isatty()
+#else
+#undef WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <sys/sendfile.h>
+// glibc has copy_file_range() since 2.27
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 27))
+#define HAVE_COPY_FILE_RANGE
+#endif
+#endif
 
 
 /* usage:
@@ -42,9 +74,9 @@ TODO: these should go to errors.h
 
 #define THROW_FROM_ERRNO_FMT(interp, classname, fmt, ...) do { \
 	if (errno == 0) \
-		errorobject_throwfmt((interp), (classname), fmt": %s", __VA_ARGS__, strerror(errno)); \
-	else \
 		errorobject_throwfmt((interp), (classname), fmt, __VA_ARGS__); \
+	else \
+		errorobject_throwfmt((interp), (classname), fmt": %s", __VA_ARGS__, strerror(errno)); \
 } while(0)
 
 
@@ -53,40 +85,141 @@ struct FileData {
 	bool readable;
 	bool writable;
 	bool closed;
+
+	// read_until reads lines here with getdelim(), and copies each line to a buffer of its own for a ByteArray
+	// this is reused for the next line, so that getdelim() doesn't need to grow a new buffer for each line
+	// the FILE is buffered already, so there's no need to have another buffer for reading ahead
+	char *linebuf;
+	size_t linebufsize;
+
+	// stdin, stdout and stderr are never fclose()d because print, error messages etc use them
+	bool isstd;
+	// the FILE's buffer from set_buffering, or NULL for the buffer that stdio allocated
+	// always NULL for stdin, stdout and stderr, see stdvbufs
+	char *vbuf;
+	// true after the first read, write, seek etc, see set_buffering
+	bool used;
 };
 
+/*
+stdin, stdout and stderr are shared by all interpreters of the process, so their buffers from set_buffering
+can't belong to the FileData of any one interpreter, they belong to the process instead
+a buffer is freed when set_buffering replaces it, and the last one is never freed because stdio uses it until exit
+*/
+static char *stdvbufs[3];
+static pthread_mutex_t stdvbufs_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// 0, 1, 2 for stdin, stdout, stderr, -1 for other files
+static int std_index(FILE *f)
+{
+	return f == stdin ? 0 : f == stdout ? 1 : f == stderr ? 2 : -1;
+}
+
 static void file_destructor(void *data)
 {
 	// no need to close the file here, my stdio(3) man page says that open files are closed on exit
 	// ö code should close files, but not closing a file must not crash the interpreter even though it's bad
-	free(data);
+	struct FileData *fdata = data;
+	free(fdata->linebuf);
+
+	// the FILE uses vbuf until it's fclose()d, and that may happen at exit after this
+	if (fdata->closed)
+		free(fdata->vbuf);
+	free(fdata);
+}
+
+// only stdin, stdout and stderr can be in a heap image, because other files can't be opened again when loading
+static bool file_writeimage(struct HeapImageWriter *w, void *data)
+{
+	struct FileData *fdata = data;
+	int which = std_index(fdata->file);
+	if (!fdata->isstd || fdata->closed || which == -1)
+		return heapimage_cannotwrite(w);
+	return heapimage_writeuint(w, (uint64_t)which);
 }
 
+static bool file_readimage(struct HeapImageReader *r, void **data)
+{
+	uint64_t which;
+	if (!heapimage_readuint(r, &which) || which > 2)
+		return false;
+
+	struct FileData *fdata = malloc(sizeof *fdata);
+	if (!fdata)
+		return false;
+	fdata->file = which == 0 ? stdin : which == 1 ? stdout : stderr;
+	fdata->readable = (which == 0);
+	fdata->writable = (which != 0);
+	fdata->closed = false;
+	fdata->linebuf = NULL;
+	fdata->linebufsize = 0;
+	fdata->isstd = true;
+	fdata->vbuf = NULL;
+	fdata->used = false;
+	*data = fdata;
+	return true;
+}
 
-static struct Object *new_from_FILE(struct Interpreter *interp, struct Object *klass, FILE *f, bool reading, bool writing)
+const struct HeapImageKind fileobject_imagekind = { NULL, file_destructor, file_writeimage, file_readimage, NULL };
+
+
+static struct Object *new_from_FILE(struct Interpreter *interp, struct Object *klass, FILE *f, bool reading, bool writing, bool isstd)
 {
 	struct FileData *fdata = malloc(sizeof *fdata);
 	if (!fdata) {
 		errorobject_thrownomem(interp);
-		fclose(f);
+		if (!isstd)
+			fclose(f);
 		return NULL;
 	}
 	fdata->file = f;
 	fdata->readable = reading;
 	fdata->writable = writing;
 	fdata->closed = false;
+	fdata->linebuf = NULL;
+	fdata->linebufsize = 0;
+	fdata->isstd = isstd;
+	fdata->vbuf = NULL;
+	fdata->used = false;
 
 	struct Object *obj = object_new_noerr(interp, klass, (struct ObjectData){.data=fdata, .foreachref=NULL, .destructor=file_destructor});
 	if (!obj)
 	{
 		errorobject_thrownomem(interp);
 		free(fdata);
-		fclose(f);
+		if (!isstd)
+			fclose(f);
 		return NULL;
 	}
 	return obj;
 }
 
+struct Object *fileobject_newstd(struct Interpreter *interp, FILE *f)
+{
+	assert(f == stdin || f == stdout || f == stderr);
+	return new_from_FILE(interp, interp->builtins.File, f, f == stdin, f != stdin, true);
+}
+
+// returns a \0-terminated string that must be free()d, or NULL on error
+static char *string_to_cstr(struct Interpreter *interp, struct Object *s)
+{
+	char *res;
+	size_t len;
+	if (!stringobject_toutf8(interp, s, &res, &len))
+		return NULL;
+
+	// add terminating \0
+	void *tmp = realloc(res, len+1);
+	if (!tmp) {
+		free(res);
+		errorobject_thrownomem(interp);
+		return NULL;
+	}
+	res = tmp;
+	res[len] = 0;
+	return res;
+}
+
 // this should be used only in io.ö
 // TODO: allow writing so that the file is not overwritten, and the file may optionally be seeked to end [*]
 static struct Object *newinstance(struct Interpreter *interp, struct Object *args, struct Object *opts)
@@ -101,21 +234,10 @@ static struct Object *newinstance(struct Interpreter *interp, struct Object *arg
 	bool binary = (ARRAYOBJECT_GET(args, 4) == interp->builtins.yes);
 	assert(reading || writing);   // checked in io.ö, and this shouldn't be called elsewhere
 
-	char *path;
-	size_t pathlen;
-	if (!utf8_encode(interp, *(struct UnicodeString*) pathobj->objdata.data, &path, &pathlen))
+	char *path = string_to_cstr(interp, pathobj);
+	if (!path)
 		return NULL;
 
-	// add terminating \0
-	void *tmp = realloc(path, pathlen+1);
-	if (!tmp) {
-		free(path);
-		errorobject_thrownomem(interp);
-		return NULL;
-	}
-	path = tmp;
-	path[pathlen] = 0;
-
 	char *mode;
 	if (reading && writing)
 		mode = binary? "wb+" : "w+";   // see [*] above
@@ -135,7 +257,7 @@ static struct Object *newinstance(struct Interpreter *interp, struct Object *arg
 	}
 	free(path);
 
-	return new_from_FILE(interp, klass, f, reading, writing);
+	return new_from_FILE(interp, klass, f, reading, writing, false);
 }
 
 // newinstance does everything, this does nothing just to allow passing arguments handled by newinstance
@@ -194,6 +316,7 @@ static struct Object *read_chunk(struct Interpreter *interp, struct ObjectData t
 		return NULL;
 	}
 
+	fdata->used = true;
 	errno = 0;
 	size_t len = fread(buf, 1, maxsize, fdata->file);
 	if (len == 0) {
@@ -203,9 +326,260 @@ static struct Object *read_chunk(struct Interpreter *interp, struct ObjectData t
 		THROW_FROM_ERRNO(interp, "IoError", "reading from file failed");
 		return NULL;
 	}
+
+	// don't keep a big buffer alive in the ByteArray when e.g. read_chunk 4096 reads just a few bytes
+	if (len < maxsize/2) {
+		unsigned char *tmp = realloc(buf, len);
+		if (tmp)
+			buf = tmp;
+	}
 	return bytearrayobject_new(interp, buf, len);
 }
 
+static bool check_readable(struct Interpreter *interp, struct FileData fdata)
+{
+	if (!check_closed(interp, fdata))
+		return false;
+	if (!fdata.readable) {
+		errorobject_throwfmt(interp, "ValueError", "the file is not readable");
+		return false;
+	}
+	return true;
+}
+
+#ifdef WINDOWS
+// windows doesn't have getdelim(), this does the same thing one byte at a time
+static ssize_t getdelim(char **line, size_t *size, int delim, FILE *f)
+{
+	size_t len = 0;
+	int c;
+	while ((c = getc(f)) != EOF) {
+		if (len+1 >= *size) {   // +1 for the \0 that getdelim() adds
+			size_t newsize = *size ? 2 * *size : 128;
+			char *tmp = realloc(*line, newsize);
+			if (!tmp) {
+				errno = ENOMEM;
+				return -1;
+			}
+			*line = tmp;
+			*size = newsize;
+		}
+		(*line)[len++] = (char)c;
+		if (c == delim)
+			break;
+	}
+	if (len == 0)
+		return -1;
+	(*line)[len] = 0;
+	return (ssize_t)len;
+}
+#endif
+
+/* reads bytes until the end of sep, and sets *result to the bytes before sep
+
+the separator is not included in *result, but it's read from the file so that
+the next read starts after it
+
+*result is set to NULL if the file is already at the end, and the last bytes
+before the end of file are returned as is if they don't end with sep
+*/
+static bool read_until_sep(struct Interpreter *interp, struct FileData *fdata, const unsigned char *sep, size_t seplen, struct Object **result)
+{
+	assert(seplen > 0);
+	int last = sep[seplen-1];
+
+	// getdelim() finds the last byte of the separator with memchr() from the FILE's buffer
+	// most of the time the line is done after the first getdelim()
+	unsigned char *val = NULL;
+	size_t len = 0;
+	size_t nallocated = 0;
+	bool eof = false;
+	bool found = false;
+
+	clearerr(fdata->file);    // see read_rest()
+	while (!eof && !found) {
+		errno = 0;
+		ssize_t n = getdelim(&fdata->linebuf, &fdata->linebufsize, last, fdata->file);
+		if (n < 0) {
+			if (!feof(fdata->file)) {
+				if (errno == ENOMEM)
+					errorobject_thrownomem(interp);
+				else
+					THROW_FROM_ERRNO(interp, "IoError", "reading from file failed");
+				free(val);
+				return false;
+			}
+			break;
+		}
+		eof = ((unsigned char)fdata->linebuf[n-1] != last);
+
+		// the last byte of sep may appear in the data many times without the rest of sep, e.g. '>' of "</record>"
+		// so val grows geometrically, and the first chunk is allocated exactly because it's usually everything
+		if ((size_t)n > nallocated - len) {
+			if ((size_t)n > SIZE_MAX - len) {
+				free(val);
+				errorobject_thrownomem(interp);
+				return false;
+			}
+			size_t newsize = len + (size_t)n;
+			if (val && nallocated <= SIZE_MAX/2 && 2*nallocated > newsize)
+				newsize = 2*nallocated;
+
+			unsigned char *tmp = realloc(val, newsize);
+			if (!tmp) {
+				free(val);
+				errorobject_thrownomem(interp);
+				return false;
+			}
+			val = tmp;
+			nallocated = newsize;
+		}
+		memcpy(val + len, fdata->linebuf, (size_t)n);
+		len += (size_t)n;
+
+		found = (!eof && len >= seplen && memcmp(val + len - seplen, sep, seplen) == 0);
+	}
+
+	if (!val) {
+		*result = NULL;
+		return true;
+	}
+	if (found)
+		len -= seplen;
+	// bytearrayobject_new() frees val on error, and it's ok for val to be a bit bigger than len
+	return !!(*result = bytearrayobject_new(interp, val, len));
+}
+
+static struct Object *read_until_result(struct Interpreter *interp, struct FileData *fdata, const unsigned char *sep, size_t seplen)
+{
+	fdata->used = true;
+	struct Object *line;
+	if (!read_until_sep(interp, fdata, sep, seplen, &line))
+		return NULL;
+	if (!line) {
+		OBJECT_INCREF(interp, interp->builtins.none);
+		return interp->builtins.none;
+	}
+
+	struct Object *res = optionobject_new(interp, line);
+	OBJECT_DECREF(interp, line);
+	return res;
+}
+
+static struct Object *read_until(struct Interpreter *interp, struct ObjectData thisdata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, interp->builtins.ByteArray, NULL)) return NULL;
+	if (!check_no_opts(interp, opts)) return NULL;
+
+	struct FileData *fdata = ((struct Object *) thisdata.data)->objdata.data;
+	if (!check_readable(interp, *fdata))
+		return NULL;
+
+	struct Object *sep = ARRAYOBJECT_GET(args, 0);
+	if (BYTEARRAYOBJECT_LEN(sep) == 0) {
+		errorobject_throwfmt(interp, "ValueError", "cannot read until an empty byte array");
+		return NULL;
+	}
+	return read_until_result(interp, fdata, BYTEARRAYOBJECT_DATA(sep), BYTEARRAYOBJECT_LEN(sep));
+}
+
+static struct Object *read_line(struct Interpreter *interp, struct ObjectData thisdata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, NULL)) return NULL;
+	if (!check_no_opts(interp, opts)) return NULL;
+
+	struct FileData *fdata = ((struct Object *) thisdata.data)->objdata.data;
+	if (!check_readable(interp, *fdata))
+		return NULL;
+
+	static const unsigned char newline[] = { '\n' };
+	return read_until_result(interp, fdata, newline, 1);
+}
+
+/* reads everything from the current position to the end of file
+
+if this is a regular file, the size is known and everything fits in the first malloc
+special files (pipes, /proc etc) don't have a size, so the buffer is grown as needed
+
+*val is set to NULL if *len is set to 0, and the bytes must be free()d
+returns false on error
+*/
+static bool read_rest(struct Interpreter *interp, FILE *f, unsigned char **val, size_t *len)
+{
+	size_t nallocated = 0;
+	struct stat st;
+	long pos;
+	if (fstat(fileno(f), &st) == 0 && S_ISREG(st.st_mode) && (pos = ftell(f)) >= 0
+			&& (unsigned long long)st.st_size > (unsigned long long)pos
+			&& (unsigned long long)(st.st_size - pos) <= SIZE_MAX)
+		nallocated = (size_t)(st.st_size - pos);
+
+	*val = NULL;
+	if (nallocated > 0 && !(*val = malloc(nallocated))) {
+		errorobject_thrownomem(interp);
+		return false;
+	}
+	*len = 0;
+
+	// the file may have grown after reading to the end, getc() and friends don't read after eof without this
+	clearerr(f);
+	while (true) {
+		if (*len == nallocated) {
+			// don't grow the buffer if the size was exactly right, the file may have ended already
+			errno = 0;
+			int c = getc(f);
+			if (c == EOF) {
+				if (ferror(f))
+					goto error;
+				return true;
+			}
+
+			size_t newsize = nallocated ? 2*nallocated : 4096;
+			unsigned char *tmp = realloc(*val, newsize);
+			if (!tmp) {
+				free(*val);
+				errorobject_thrownomem(interp);
+				return false;
+			}
+			*val = tmp;
+			nallocated = newsize;
+			(*val)[(*len)++] = (unsigned char)c;
+		}
+
+		errno = 0;
+		*len += fread(*val + *len, 1, nallocated - *len, f);
+		if (*len < nallocated) {
+			// fread() reads everything it can, so a short read means end of file or an error
+			if (ferror(f))
+				goto error;
+			return true;
+		}
+	}
+
+error:
+	THROW_FROM_ERRNO(interp, "IoError", "reading from file failed");
+	free(*val);
+	return false;
+}
+
+// FileLike's read_all calls read_chunk many times, this reads everything into one buffer
+static struct Object *read_all(struct Interpreter *interp, struct ObjectData thisdata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, NULL)) return NULL;
+	if (!check_no_opts(interp, opts)) return NULL;
+
+	struct FileData *fdata = ((struct Object *) thisdata.data)->objdata.data;
+	if (!check_readable(interp, *fdata))
+		return NULL;
+
+	fdata->used = true;
+	unsigned char *val;
+	size_t len;
+	if (!read_rest(interp, fdata->file, &val, &len))
+		return NULL;
+	return bytearrayobject_new(interp, val, len);
+}
+
 static bool write_(struct Interpreter *interp, struct ObjectData thisdata, struct Object *args, struct Object *opts)
 {
 	if (!check_args(interp, args, interp->builtins.ByteArray, NULL)) return false;
@@ -219,10 +593,13 @@ static bool write_(struct Interpreter *interp, struct ObjectData thisdata, struc
 		errorobject_throwfmt(interp, "IoError", "the file is not writable");
 		return false;
 	}
+	fdata->used = true;
 
 	struct Object *b = ARRAYOBJECT_GET(args, 0);
 
-	// this doesn't need special casing when the bytearray is 0 bytes long
+	// fwrite returns 0 when the size is 0, just like on errors
+	if (BYTEARRAYOBJECT_LEN(b) == 0)
+		return true;
 	if (fwrite(BYTEARRAYOBJECT_DATA(b), BYTEARRAYOBJECT_LEN(b), 1, fdata->file) != 1) {
 		THROW_FROM_ERRNO(interp, "IoError", "writing to file failed");
 		return false;
@@ -230,6 +607,299 @@ static bool write_(struct Interpreter *interp, struct ObjectData thisdata, struc
 	return true;
 }
 
+#ifndef WINDOWS
+// after reading or writing the file descriptor directly, tell stdio where the fd's position is
+// this fails for pipes and terminals, but they don't have positions anyway
+static void sync_pos_from_fd(FILE *f)
+{
+	off_t pos = lseek(fileno(f), 0, SEEK_CUR);
+	if (pos >= 0 && pos <= LONG_MAX)
+		fseek(f, (long)pos, SEEK_SET);
+}
+
+// IOV_MAX is the limit of how many iovecs can be passed to writev() at once
+#if defined(IOV_MAX) && IOV_MAX < 1024
+#define WRITE_MANY_IOVS IOV_MAX
+#else
+#define WRITE_MANY_IOVS 1024
+#endif
+
+// writev() can write less than everything, e.g. with pipes or when a signal arrives
+static bool writev_all(int fd, struct iovec *iov, int n)
+{
+	while (n > 0) {
+		ssize_t written = writev(fd, iov, n);
+		if (written < 0) {
+			if (errno == EINTR)
+				continue;
+			return false;
+		}
+
+		while (n > 0 && (size_t)written >= iov->iov_len) {
+			written -= iov->iov_len;
+			iov++;
+			n--;
+		}
+		if (n > 0) {
+			iov->iov_base = (char *)iov->iov_base + written;
+			iov->iov_len -= (size_t)written;
+		}
+	}
+	return true;
+}
+#endif
+
+// small amounts of data are copied to the FILE's buffer, that's cheaper than a system call
+#define WRITE_MANY_MIN_WRITEV 8192
+
+static bool write_many(struct Interpreter *interp, struct ObjectData thisdata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, interp->builtins.Array, NULL)) return false;
+	if (!check_no_opts(interp, opts)) return false;
+
+	struct FileData *fdata = ((struct Object *) thisdata.data)->objdata.data;
+	if (!check_closed(interp, *fdata))
+		return false;
+	if (!fdata->writable) {
+		errorobject_throwfmt(interp, "IoError", "the file is not writable");
+		return false;
+	}
+	fdata->used = true;
+
+	struct Object *arr = ARRAYOBJECT_GET(args, 0);
+	size_t total = 0;
+	for (size_t i = 0; i < ARRAYOBJECT_LEN(arr); i++) {
+		if (!check_type(interp, interp->builtins.ByteArray, ARRAYOBJECT_GET(arr, i)))
+			return false;
+		total += BYTEARRAYOBJECT_LEN(ARRAYOBJECT_GET(arr, i));
+	}
+
+#ifndef WINDOWS
+	if (total >= WRITE_MANY_MIN_WRITEV) {
+		// writev() bypasses the FILE's buffer, so everything in the buffer must be written before it
+		errno = 0;
+		if (fflush(fdata->file) != 0)
+			goto error;
+
+		int fd = fileno(fdata->file);
+		struct iovec iov[WRITE_MANY_IOVS];
+		int n = 0;
+		for (size_t i = 0; i < ARRAYOBJECT_LEN(arr); i++) {
+			struct Object *b = ARRAYOBJECT_GET(arr, i);
+			if (BYTEARRAYOBJECT_LEN(b) == 0)
+				continue;
+			iov[n].iov_base = BYTEARRAYOBJECT_DATA(b);
+			iov[n].iov_len = BYTEARRAYOBJECT_LEN(b);
+			if (++n == WRITE_MANY_IOVS) {
+				errno = 0;
+				if (!writev_all(fd, iov, n))
+					goto error;
+				n = 0;
+			}
+		}
+		errno = 0;
+		if (!writev_all(fd, iov, n))
+			goto error;
+
+		// stdio may remember the position of the file
+		sync_pos_from_fd(fdata->file);
+		return true;
+	}
+#endif
+
+	for (size_t i = 0; i < ARRAYOBJECT_LEN(arr); i++) {
+		struct Object *b = ARRAYOBJECT_GET(arr, i);
+		errno = 0;
+		if (BYTEARRAYOBJECT_LEN(b) != 0 && fwrite(BYTEARRAYOBJECT_DATA(b), BYTEARRAYOBJECT_LEN(b), 1, fdata->file) != 1)
+			goto error;
+	}
+	return true;
+
+error:
+	THROW_FROM_ERRNO(interp, "IoError", "writing to file failed");
+	return false;
+}
+
+#ifdef __linux__
+// at most this many bytes are copied with one system call, so that ^C works reasonably soon
+#define KERNEL_COPY_CHUNK (1L << 30)
+
+/* copies from the position of infd to the end of the file, without going through user space
+
+returns 1 on success, 0 if it can't be done with these files (nothing copied), or -1 on error
+*ncopied is incremented by the number of bytes copied, even on error
+*/
+static int copy_in_kernel(int infd, int outfd, unsigned long long *ncopied)
+{
+#ifdef HAVE_COPY_FILE_RANGE
+	// copy_file_range() works only between regular files, and maybe only on the same file system
+	bool usesendfile = false;
+#else
+	bool usesendfile = true;
+#endif
+	unsigned long long before = *ncopied;
+
+	while (true) {
+		ssize_t n;
+#ifdef HAVE_COPY_FILE_RANGE
+		if (!usesendfile) {
+			n = copy_file_range(infd, NULL, outfd, NULL, KERNEL_COPY_CHUNK, 0);
+			if (n < 0 && *ncopied == before && (errno == EXDEV || errno == EINVAL || errno == ENOSYS || errno == EOPNOTSUPP || errno == EBADF)) {
+				usesendfile = true;
+				continue;
+			}
+		} else
+#endif
+		{
+			n = sendfile(outfd, infd, NULL, KERNEL_COPY_CHUNK);
+			if (n < 0 && *ncopied == before && (errno == EINVAL || errno == ENOSYS))
+				return 0;
+		}
+
+		if (n < 0) {
+			if (errno == EINTR)
+				continue;
+			return -1;
+		}
+		if (n == 0) {
+			// files in /proc and such say they're empty, but reading them the usual way works
+			return (*ncopied == before) ? 0 : 1;
+		}
+		*ncopied += (unsigned long long)n;
+	}
+}
+#endif
+
+// copies from the current position of in to the end of in, and returns false on error
+static bool copy_FILE(FILE *in, FILE *out, unsigned long long *ncopied)
+{
+	*ncopied = 0;
+	errno = 0;
+	if (fflush(out) != 0)
+		return false;
+
+#ifdef __linux__
+	// in may have buffered data that it has read from infd, so infd is moved to where ö code thinks in is
+	// kernel copying is not used if in isn't seekable, because then that's not possible
+	long inpos = ftell(in);
+	long outpos = ftell(out);
+	int infd = fileno(in);
+	int outfd = fileno(out);
+	if (inpos >= 0 && lseek(infd, inpos, SEEK_SET) == inpos && (outpos < 0 || lseek(outfd, outpos, SEEK_SET) == outpos)) {
+		errno = 0;
+		int status = copy_in_kernel(infd, outfd, ncopied);
+		int copyerrno = errno;
+		sync_pos_from_fd(in);
+		sync_pos_from_fd(out);
+		errno = copyerrno;
+
+		if (status == -1)
+			return false;
+		if (status == 1)
+			return true;
+	}
+#endif
+
+	// a big buffer that is reused for all chunks, so that there's one malloc for the whole copy
+	size_t bufsize = 1024*1024;
+	unsigned char *buf = malloc(bufsize);
+	if (!buf) {
+		errno = ENOMEM;
+		return false;
+	}
+
+	clearerr(in);
+	size_t n;
+	errno = 0;
+	while ((n = fread(buf, 1, bufsize, in)) > 0) {
+		if (fwrite(buf, n, 1, out) != 1) {
+			free(buf);
+			return false;
+		}
+		*ncopied += n;
+	}
+	free(buf);
+	return !ferror(in);
+}
+
+// for copying to file-likes that aren't Files, does the same thing as FileLike's copy_to in std/io.ö
+// returns false on error
+static bool copy_to_filelike(struct Interpreter *interp, FILE *in, struct Object *dst, unsigned long long *ncopied)
+{
+	*ncopied = 0;
+	clearerr(in);
+	while (true) {
+		// the ByteArray takes the buffer, so each chunk needs a new one
+		size_t bufsize = 1024*1024;
+		unsigned char *buf = malloc(bufsize);
+		if (!buf) {
+			errorobject_thrownomem(interp);
+			return false;
+		}
+
+		errno = 0;
+		size_t n = fread(buf, 1, bufsize, in);
+		if (n == 0) {
+			free(buf);
+			if (ferror(in)) {
+				THROW_FROM_ERRNO(interp, "IoError", "reading from file failed");
+				return false;
+			}
+			return true;
+		}
+		if (n < bufsize/2) {
+			unsigned char *tmp = realloc(buf, n);
+			if (tmp)
+				buf = tmp;
+		}
+
+		struct Object *chunk = bytearrayobject_new(interp, buf, n);
+		if (!chunk)
+			return false;
+		bool ok = method_call_noret(interp, dst, "write", chunk, NULL);
+		OBJECT_DECREF(interp, chunk);
+		if (!ok)
+			return false;
+		*ncopied += n;
+	}
+}
+
+static struct Object *copy_to(struct Interpreter *interp, struct ObjectData thisdata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, interp->builtins.Object, NULL)) return NULL;
+	if (!check_no_opts(interp, opts)) return NULL;
+
+	struct FileData *src = ((struct Object *) thisdata.data)->objdata.data;
+	if (!check_readable(interp, *src))
+		return NULL;
+
+	unsigned long long ncopied;
+	if (!classobject_isinstanceof(ARRAYOBJECT_GET(args, 0), interp->builtins.File)) {
+		src->used = true;
+		if (!copy_to_filelike(interp, src->file, ARRAYOBJECT_GET(args, 0), &ncopied))
+			return NULL;
+		return integerobject_newfromlonglong(interp, (long long)ncopied);
+	}
+
+	struct FileData *dst = ARRAYOBJECT_GET(args, 0)->objdata.data;
+	if (!check_closed(interp, *dst))
+		return NULL;
+	if (!dst->writable) {
+		errorobject_throwfmt(interp, "IoError", "the file is not writable");
+		return NULL;
+	}
+
+	src->used = dst->used = true;
+	if (!copy_FILE(src->file, dst->file, &ncopied)) {
+		if (errno == ENOMEM)
+			errorobject_thrownomem(interp);
+		else
+			THROW_FROM_ERRNO(interp, "IoError", "copying failed");
+		return NULL;
+	}
+	return integerobject_newfromlonglong(interp, (long long)ncopied);
+}
+
 static bool set_pos(struct Interpreter *interp, struct ObjectData thisdata, struct Object *args, struct Object *opts)
 {
 	if (!check_args(interp, args, interp->builtins.Integer, NULL)) return false;
@@ -250,6 +920,7 @@ static bool set_pos(struct Interpreter *interp, struct ObjectData thisdata, stru
 		return false;
 	}
 
+	fdata->used = true;
 	errno = 0;
 	if (fseek(fdata->file, (long) pos, SEEK_SET) != 0) {
 		THROW_FROM_ERRNO(interp, "IoError", "setting position of file failed");
@@ -268,6 +939,7 @@ static struct Object *get_pos(struct Interpreter *interp, struct ObjectData this
 	if (!check_closed(interp, *fdata))
 		return NULL;
 
+	fdata->used = true;
 	errno = 0;
 	long result = ftell(fdata->file);
 	if (result < 0) {
@@ -294,6 +966,7 @@ static bool flush(struct Interpreter *interp, struct ObjectData thisdata, struct
 		return false;
 	}
 
+	fdata->used = true;
 	errno = 0;
 	if (fflush(fdata->file) != 0) {
 		THROW_FROM_ERRNO(interp, "IoError", "flushing failed");
@@ -312,15 +985,188 @@ static bool close_(struct Interpreter *interp, struct ObjectData thisdata, struc
 	if (!check_closed(interp, *fdata))
 		return false;
 
+	free(fdata->linebuf);
+	fdata->linebuf = NULL;
+	fdata->linebufsize = 0;
+
+	// the FILE can't be used after fclose() even if it fails
+	// closing io.stdout must not break print, so that only flushes
 	errno = 0;
-	if (fclose(fdata->file) != 0) {
+	int ret;
+	if (fdata->isstd)
+		ret = fdata->writable ? fflush(fdata->file) : 0;
+	else
+		ret = fclose(fdata->file);
+	fdata->closed = true;
+	if (ret != 0) {
 		THROW_FROM_ERRNO(interp, "IoError", "closing failed");
 		return false;
 	}
+	free(fdata->vbuf);
+	fdata->vbuf = NULL;
 	return true;
 }
 
 
+static bool set_buffering(struct Interpreter *interp, struct ObjectData thisdata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, interp->builtins.String, interp->builtins.Integer, NULL)) return false;
+	if (!check_no_opts(interp, opts)) return false;
+
+	struct FileData *fdata = ((struct Object *) thisdata.data)->objdata.data;
+	if (!check_closed(interp, *fdata))
+		return false;
+
+	/*
+	c99 allows setvbuf() only before anything else is done with the FILE, so files from open() must not have been used
+	that can't be checked for stdin, stdout and stderr, because print, error messages etc use them without going through
+	FileData, so for them this relies on the C library allowing setvbuf() after flushing, glibc and musl allow it
+	*/
+	if (fdata->used && !fdata->isstd) {
+		errorobject_throwfmt(interp, "ValueError", "set_buffering must be called before reading, writing or seeking the file");
+		return false;
+	}
+
+	char *modestr = string_to_cstr(interp, ARRAYOBJECT_GET(args, 0));
+	if (!modestr)
+		return false;
+	int mode;
+	bool usedefault = false;
+	if (strcmp(modestr, "default") == 0) {
+		// what stdio does when the FILE is opened, so that e.g. tests can undo set_buffering
+		usedefault = true;
+		if (fdata->file == stderr)
+			mode = _IONBF;
+		else
+			mode = isatty(fileno(fdata->file)) ? _IOLBF : _IOFBF;
+	} else if (strcmp(modestr, "none") == 0)
+		mode = _IONBF;
+	else if (strcmp(modestr, "line") == 0)
+		mode = _IOLBF;
+	else if (strcmp(modestr, "full") == 0)
+		mode = _IOFBF;
+	else {
+		errorobject_throwfmt(interp, "ValueError", "the buffering mode must be \"none\", \"line\", \"full\" or \"default\", not %D", ARRAYOBJECT_GET(args, 0));
+		free(modestr);
+		return false;
+	}
+	free(modestr);
+
+	long long size = integerobject_tolonglong(ARRAYOBJECT_GET(args, 1));
+	if (!usedefault && mode != _IONBF && (size <= 0 || (unsigned long long)size > SIZE_MAX)) {
+		errorobject_throwfmt(interp, "ValueError", "invalid buffer size %L", size);
+		return false;
+	}
+
+	// setvbuf() with a NULL buffer ignores the size on some platforms, so the buffer is allocated here
+	// but the default buffer comes from stdio
+	char *buf = NULL;
+	if (!usedefault && mode != _IONBF && !(buf = malloc((size_t)size))) {
+		errorobject_thrownomem(interp);
+		return false;
+	}
+
+	// another interpreter must not replace the buffer of a std file between the setvbuf() and the free() below
+	int which = fdata->isstd ? std_index(fdata->file) : -1;
+	if (which != -1)
+		pthread_mutex_lock(&stdvbufs_lock);
+	char **oldbuf = which == -1 ? &fdata->vbuf : &stdvbufs[which];
+	bool ok = false;
+
+	// don't lose anything that is in the old buffer
+	errno = 0;
+	if (fdata->writable && fflush(fdata->file) != 0) {
+		THROW_FROM_ERRNO(interp, "IoError", "flushing failed");
+		free(buf);
+		goto out;
+	}
+
+	errno = 0;
+	if (setvbuf(fdata->file, buf, mode, buf ? (size_t)size : usedefault ? BUFSIZ : 0) != 0) {
+		THROW_FROM_ERRNO(interp, "IoError", "setting the buffering failed");
+		free(buf);
+		goto out;
+	}
+
+	free(*oldbuf);    // not used by the FILE anymore
+	*oldbuf = buf;
+	ok = true;
+
+out:
+	if (which != -1)
+		pthread_mutex_unlock(&stdvbufs_lock);
+	return ok;
+}
+
+
+// reads the whole file instead of mapping it, for files that can't be mapped
+static struct Object *read_whole_file(struct Interpreter *interp, const char *path)
+{
+	errno = 0;
+	FILE *f = fopen(path, "rb");
+	if (!f) {
+		THROW_FROM_ERRNO_FMT(interp, "IoError", "cannot open %s", path);
+		return NULL;
+	}
+
+	unsigned char *val;
+	size_t len;
+	bool ok = read_rest(interp, f, &val, &len);
+	fclose(f);   // nothing was written, so this doesn't fail in a way that matters
+	return ok ? bytearrayobject_new(interp, val, len) : NULL;
+}
+
+struct Object *fileobject_mapfile(struct Interpreter *interp, struct ObjectData nulldata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, interp->builtins.String, NULL)) return NULL;
+	if (!check_no_opts(interp, opts)) return NULL;
+
+	char *path = string_to_cstr(interp, ARRAYOBJECT_GET(args, 0));
+	if (!path)
+		return NULL;
+
+#ifdef WINDOWS
+	struct Object *res = read_whole_file(interp, path);
+#else
+	struct Object *res = NULL;
+	errno = 0;
+	int fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		THROW_FROM_ERRNO_FMT(interp, "IoError", "cannot open %s", path);
+		goto out;
+	}
+
+	struct stat st;
+	errno = 0;
+	if (fstat(fd, &st) != 0) {
+		THROW_FROM_ERRNO_FMT(interp, "IoError", "cannot map %s", path);
+		close(fd);
+		goto out;
+	}
+
+	// mmap() doesn't work with empty files or special files like pipes and things in /proc
+	if (!S_ISREG(st.st_mode) || st.st_size == 0 || (unsigned long long)st.st_size > SIZE_MAX) {
+		close(fd);
+		res = read_whole_file(interp, path);
+		goto out;
+	}
+
+	errno = 0;
+	void *ptr = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);    // the mapping stays valid after this
+	if (ptr == MAP_FAILED) {
+		THROW_FROM_ERRNO_FMT(interp, "IoError", "cannot map %s", path);
+		goto out;
+	}
+	res = bytearrayobject_newmapped(interp, ptr, (size_t)st.st_size);
+
+out:
+#endif
+	free(path);
+	return res;
+}
+
+
 struct Object *fileobject_createclass(struct Interpreter *interp)
 {
 	// the Object baseclass will be replaced with another class in io.ö
@@ -331,11 +1177,17 @@ struct Object *fileobject_createclass(struct Interpreter *interp)
 	if (!attribute_add(interp, klass, "closed", closed_getter, NULL)) goto error;
 	if (!method_add_noret(interp, klass, "setup", setup)) goto error;
 	if (!method_add_yesret(interp, klass, "read_chunk", read_chunk)) goto error;
+	if (!method_add_yesret(interp, klass, "read_until", read_until)) goto error;
+	if (!method_add_yesret(interp, klass, "read_line", read_line)) goto error;
+	if (!method_add_yesret(interp, klass, "read_all", read_all)) goto error;
 	if (!method_add_noret(interp, klass, "write", write_)) goto error;
+	if (!method_add_noret(interp, klass, "write_many", write_many)) goto error;
+	if (!method_add_yesret(interp, klass, "copy_to", copy_to)) goto error;
 	if (!method_add_noret(interp, klass, "set_pos", set_pos)) goto error;
 	if (!method_add_yesret(interp, klass, "get_pos", get_pos)) goto error;
 	if (!method_add_noret(interp, klass, "flush", flush)) goto error;
 	if (!method_add_noret(interp, klass, "close", close_)) goto error;
+	if (!method_add_noret(interp, klass, "set_buffering", set_buffering)) goto error;
 	return klass;
 
 error:
@@ -1,9 +1,17 @@
 #ifndef OBJECTS_FILE_H
 #define OBJECTS_FILE_H
 
+#include <stdio.h>
 #include "../interpreter.h"
 #include "../objectsystem.h"
 
 struct Object *fileobject_createclass(struct Interpreter *interp);
 
+// RETURNS A NEW REFERENCE or NULL on error
+// f must be stdin, stdout or stderr, and closing the File doesn't fclose() it
+struct Object *fileobject_newstd(struct Interpreter *interp, FILE *f);
+
+// the map_file function of std/io.ö, a built-in function that io.ö deletes from the built-in scope
+struct Object *fileobject_mapfile(struct Interpreter *interp, struct ObjectData nulldata, struct Object *args, struct Object *opts);
+
 #endif    // OBJECTS_FILE_H
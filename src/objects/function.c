@@ -4,9 +4,12 @@
 #include <stdlib.h>
 #include "../attribute.h"
 #include "../check.h"
+#include "../heapimage.h"
 #include "../interpreter.h"
 #include "../method.h"
 #include "../objectsystem.h"
+#include "../perfmap.h"
+#include "../profiler.h"
 #include "array.h"
 #include "bool.h"
 #include "classobject.h"
@@ -53,6 +56,32 @@ static void function_destructor(void *data)
 	free(data);
 }
 
+static bool function_writeimage(struct HeapImageWriter *w, void *data)
+{
+	struct FunctionData *fdata = data;
+	return heapimage_writeref(w, fdata->name) &&
+		heapimage_writecfunc(w, fdata->cfunc) &&
+		heapimage_writeobjectdata(w, fdata->userdata);
+}
+
+static bool function_readimage(struct HeapImageReader *r, void **data)
+{
+	struct FunctionData *fdata = malloc(sizeof *fdata);
+	if (!fdata)
+		return false;
+	if (!heapimage_readref(r, &fdata->name) || !fdata->name ||
+		!heapimage_readcfunc(r, &fdata->cfunc) ||
+		!heapimage_readobjectdata(r, &fdata->userdata))
+	{
+		free(fdata);
+		return false;
+	}
+	*data = fdata;
+	return true;
+}
+
+const struct HeapImageKind functionobject_imagekind = { function_foreachref, function_destructor, function_writeimage, function_readimage, NULL };
+
 
 static struct Object *newinstance(struct Interpreter *interp, struct Object *args, struct Object *opts)
 {
@@ -170,6 +199,53 @@ bool functionobject_add2array(struct Interpreter *interp, struct Object *arr, ch
 	return ok;
 }
 
+struct FunctionObjectCfunc functionobject_getcfunc(struct Object *func)
+{
+	return ((struct FunctionData *) func->objdata.data)->cfunc;
+}
+
+
+// fwd dcl
+static struct Object *partialrunner_yesret(struct Interpreter *interp, struct ObjectData pfuddata, struct Object *args, struct Object *opts);
+static bool partialrunner_noret(struct Interpreter *interp, struct ObjectData pfuddata, struct Object *args, struct Object *opts);
+
+// for calling functions with the profiler or perfmap enabled, see call_with_hooks()
+struct HookedCall {
+	struct FunctionData *fdata;
+	struct Object *args;
+	struct Object *opts;
+	struct Object *res;    // NULL on error, or a dummy non-NULL value for noret functions
+};
+
+static void run_hooked_call(struct Interpreter *interp, void *hcptr)
+{
+	struct HookedCall *hc = hcptr;
+	if (hc->fdata->cfunc.returning)
+		hc->res = hc->fdata->cfunc.func.yesret(interp, hc->fdata->userdata, hc->args, hc->opts);
+	else
+		hc->res = hc->fdata->cfunc.func.noret(interp, hc->fdata->userdata, hc->args, hc->opts) ? interp->builtins.none : NULL;
+}
+
+// partial functions (e.g. methods) call the original function, which is what gets profiled
+#define NEEDS_HOOKS(interp, fdata) (((interp)->profiler || (interp)->perfmap) && \
+	((fdata)->cfunc.returning ? ((fdata)->cfunc.func.yesret != partialrunner_yesret) : ((fdata)->cfunc.func.noret != partialrunner_noret)))
+
+// returns like the called function, and a dummy non-NULL value for success with noret functions
+static struct Object *call_with_hooks(struct Interpreter *interp, struct FunctionData *fdata, struct Object *args, struct Object *opts)
+{
+	if (interp->profiler && !profiler_enter(interp, fdata->name, fdata->cfunc, fdata->userdata))
+		return NULL;
+
+	struct HookedCall hc = { .fdata = fdata, .args = args, .opts = opts, .res = NULL };
+	if (interp->perfmap)
+		perfmap_call(interp, fdata->name, fdata->cfunc, fdata->userdata, run_hooked_call, &hc);  // leaves hc.res NULL on error
+	else
+		run_hooked_call(interp, &hc);
+
+	if (interp->profiler)
+		profiler_leave(interp);
+	return hc.res;
+}
 
 struct Object *functionobject_vcall_yesret(struct Interpreter *interp, struct Object *func, struct Object *args, struct Object *opts)
 {
@@ -178,6 +254,8 @@ struct Object *functionobject_vcall_yesret(struct Interpreter *interp, struct Ob
 		errorobject_throwfmt(interp, "TypeError", "expected a returning function, got %D", func);
 		return NULL;
 	}
+	if (NEEDS_HOOKS(interp, fdata))
+		return call_with_hooks(interp, fdata, args, opts);
 	return fdata->cfunc.func.yesret(interp, fdata->userdata, args, opts);
 }
 
@@ -188,6 +266,8 @@ bool functionobject_vcall_noret(struct Interpreter *interp, struct Object *func,
 		errorobject_throwfmt(interp, "TypeError", "expected a function that returns nothing, got %D", func);
 		return false;
 	}
+	if (NEEDS_HOOKS(interp, fdata))
+		return !!call_with_hooks(interp, fdata, args, opts);
 	return fdata->cfunc.func.noret(interp, fdata->userdata, args, opts);
 }
 
@@ -250,6 +330,32 @@ static void pfud_foreachref(void *data, object_foreachrefcb cb, void *cbdata)
 
 static void pfud_destructor(void *data) { free(data); }
 
+static bool pfud_writeimage(struct HeapImageWriter *w, void *data)
+{
+	struct PartialFunctionUserdata *pfud = data;
+	return heapimage_writeref(w, pfud->func) &&
+		heapimage_writeref(w, pfud->args) &&
+		heapimage_writeref(w, pfud->opts);
+}
+
+static bool pfud_readimage(struct HeapImageReader *r, void **data)
+{
+	struct PartialFunctionUserdata *pfud = malloc(sizeof *pfud);
+	if (!pfud)
+		return false;
+	if (!heapimage_readref(r, &pfud->func) || !pfud->func ||
+		!heapimage_readref(r, &pfud->args) || !pfud->args ||
+		!heapimage_readref(r, &pfud->opts) || !pfud->opts)
+	{
+		free(pfud);
+		return false;
+	}
+	*data = pfud;
+	return true;
+}
+
+const struct HeapImageKind functionobject_partialimagekind = { pfud_foreachref, pfud_destructor, pfud_writeimage, pfud_readimage, NULL };
+
 // keys in m2 override keys in m1
 // TODO: move this elsewhere
 static struct Object *merge_mappings(struct Interpreter *interp, struct Object *m1, struct Object *m2)
@@ -53,6 +53,10 @@ struct Object *functionobject_new(struct Interpreter *interp, struct ObjectData
 // returns false on error
 bool functionobject_add2array(struct Interpreter *interp, struct Object *arr, char *name, struct FunctionObjectCfunc cfunc);
 
+// returns the C function that calling func runs, never fails
+// bad things happen if func is not a function object
+struct FunctionObjectCfunc functionobject_getcfunc(struct Object *func);
+
 // example: functionobject_call(interp, func, a, b, c, NULL) calls func with arguments a, b, c
 // bad things happen if func is not a function object or you forget the NULL
 // an error is thrown and NULL or false is returned if func is of the wrong kind (returning / not returning)
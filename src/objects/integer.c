@@ -6,6 +6,7 @@
 #include <stddef.h>
 #include <stdlib.h>
 #include "../check.h"
+#include "../heapimage.h"
 #include "../interpreter.h"
 #include "../method.h"
 #include "../objectsystem.h"
@@ -86,6 +87,26 @@ static void integer_destructor(void *data)
 	free(data);
 }
 
+static bool integer_writeimage(struct HeapImageWriter *w, void *data)
+{
+	return heapimage_writeint(w, *(long long *)data);
+}
+
+static bool integer_readimage(struct HeapImageReader *r, void **data)
+{
+	long long *val = malloc(sizeof *val);
+	if (!val)
+		return false;
+	if (!heapimage_readint(r, val)) {
+		free(val);
+		return false;
+	}
+	*data = val;
+	return true;
+}
+
+const struct HeapImageKind integerobject_imagekind = { NULL, integer_destructor, integer_writeimage, integer_readimage, NULL };
+
 // (new Integer "123") converts a string to an integer
 static struct Object *newinstance(struct Interpreter *interp, struct Object *args, struct Object *opts)
 {
@@ -98,7 +119,14 @@ static struct Object *newinstance(struct Interpreter *interp, struct Object *arg
 		errorobject_thrownomem(interp);
 		return NULL;
 	}
-	if (!parse_ustr(interp, *((struct UnicodeString*) string->objdata.data), data)) {
+	struct UnicodeString ustr;
+	if (!stringobject_getustr(interp, string, &ustr)) {
+		free(data);
+		return NULL;
+	}
+	bool ok = parse_ustr(interp, ustr, data);
+	free(ustr.val);
+	if (!ok) {
 		free(data);
 		return NULL;
 	}
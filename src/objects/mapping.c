@@ -6,16 +6,19 @@
 #include <stdlib.h>
 #include "../attribute.h"
 #include "../check.h"
+#include "../heapimage.h"
 #include "../interpreter.h"
 #include "../objectsystem.h"
 #include "../operator.h"
 #include "../method.h"
+#include "../stats.h"
 #include "array.h"
 #include "classobject.h"
 #include "errors.h"
 #include "function.h"
 #include "integer.h"
 #include "option.h"
+#include "string.h"
 
 // hash should be a signed long, nbuckets should be an unsigned long
 // casting signed to unsigned is apparently well-defined 0_o
@@ -53,6 +56,73 @@ static void mapping_destructor(void *data)
 	free(data);
 }
 
+// buckets are written in order, so that the items end up in the same buckets when hashes are the same
+static bool mapping_writeimage(struct HeapImageWriter *w, void *data)
+{
+	struct MappingObjectData *md = data;
+	if (!heapimage_writeuint(w, md->nbuckets) || !heapimage_writeuint(w, md->size))
+		return false;
+
+	for (unsigned long i=0; i < md->nbuckets; i++) {
+		size_t n = 0;
+		for (struct MappingObjectItem *item = md->buckets[i]; item; item = item->next)
+			n++;
+		if (!heapimage_writeuint(w, n))
+			return false;
+		for (struct MappingObjectItem *item = md->buckets[i]; item; item = item->next) {
+			if (!heapimage_writeref(w, item->key) || !heapimage_writeref(w, item->value))
+				return false;
+		}
+	}
+	return true;
+}
+
+static bool mapping_readimage(struct HeapImageReader *r, void **data)
+{
+	size_t nbuckets, size;
+	if (!heapimage_readsize(r, &nbuckets) || nbuckets == 0 || nbuckets > ULONG_MAX || !heapimage_readsize(r, &size))
+		return false;
+
+	struct MappingObjectData *md = malloc(sizeof *md);
+	if (!md)
+		return false;
+	md->nbuckets = nbuckets;
+	md->size = 0;
+	if (!(md->buckets = calloc(nbuckets, sizeof md->buckets[0]))) {
+		free(md);
+		return false;
+	}
+
+	for (unsigned long i=0; i < md->nbuckets; i++) {
+		size_t n;
+		if (!heapimage_readsize(r, &n))
+			goto error;
+
+		struct MappingObjectItem **dst = &md->buckets[i];
+		for (size_t j=0; j < n; j++) {
+			if (!(*dst = malloc(sizeof **dst)))
+				goto error;
+			(*dst)->next = NULL;
+			if (!heapimage_readref(r, &(*dst)->key) || !(*dst)->key ||
+				!heapimage_readref(r, &(*dst)->value) || !(*dst)->value)
+				goto error;
+			dst = &(*dst)->next;
+			md->size++;
+		}
+	}
+	if (md->size != size)
+		goto error;
+
+	*data = md;
+	return true;
+
+error:
+	mapping_destructor(md);
+	return false;
+}
+
+const struct HeapImageKind mappingobject_imagekind = { mapping_foreachref, mapping_destructor, mapping_writeimage, mapping_readimage, NULL };
+
 static struct MappingObjectData *create_empty_data(void)
 {
 	struct MappingObjectData *data = malloc(sizeof(struct MappingObjectData));
@@ -180,6 +250,7 @@ static bool make_bigger(struct Interpreter *interp, struct MappingObjectData *da
 	free(data->buckets);
 	data->buckets = newbuckets;
 	data->nbuckets = newnbuckets;
+	STATS_INCR(interp, mappingresizes);
 	return true;
 }
 
@@ -190,6 +261,10 @@ static bool hashable_check(struct Interpreter *interp, struct Object *key)
 		errorobject_throwfmt(interp, "TypeError", "%U objects are not hashable, so %D can't be used as a Mapping key", keyclassdata->name, key);
 		return false;
 	}
+
+	// strings are the most common keys by far, so they're special-cased here
+	if (key->klass == interp->builtins.String)
+		stringobject_ensurehash(key);
 	return true;
 }
 
@@ -313,6 +388,34 @@ int mappingobject_getanddelete(struct Interpreter *interp, struct Object *map, s
 	return 0;
 }
 
+void mappingobject_clear(struct Interpreter *interp, struct Object *map)
+{
+	struct MappingObjectData *data = map->objdata.data;
+
+	// everything is removed from the mapping before decreffing anything
+	// so that destructors running because of the decrefs never see a half-cleared mapping
+	struct MappingObjectItem *items = NULL;
+	for (unsigned long i=0; i < data->nbuckets; i++) {
+		struct MappingObjectItem *item = data->buckets[i];
+		while (item) {
+			struct MappingObjectItem *next = item->next;
+			item->next = items;
+			items = item;
+			item = next;
+		}
+		data->buckets[i] = NULL;
+	}
+	data->size = 0;
+
+	while (items) {
+		struct MappingObjectItem *next = items->next;
+		OBJECT_DECREF(interp, items->key);
+		OBJECT_DECREF(interp, items->value);
+		free(items);
+		items = next;
+	}
+}
+
 
 static struct Object *get(struct Interpreter *interp, struct ObjectData thisdata, struct Object *args, struct Object *opts)
 {
@@ -50,6 +50,9 @@ int mappingobject_get(struct Interpreter *interp, struct Object *map, struct Obj
 // like mappingobject_get, but deletes the key from the mapping as well
 int mappingobject_getanddelete(struct Interpreter *interp, struct Object *map, struct Object *key, struct Object **val);
 
+// deletes all keys and values, never fails
+void mappingobject_clear(struct Interpreter *interp, struct Object *map);
+
 
 struct MappingObjectIter {
 	struct Object *key;
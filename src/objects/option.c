@@ -3,6 +3,7 @@
 #include <stddef.h>
 #include "../attribute.h"
 #include "../check.h"
+#include "../heapimage.h"
 #include "../interpreter.h"
 #include "../method.h"
 #include "../objectsystem.h"
@@ -18,6 +19,8 @@ void option_foreachref(void *data, object_foreachrefcb cb, void *cbdata)
 	cb((struct Object*)data, cbdata);
 }
 
+const struct HeapImageKind optionobject_imagekind = { option_foreachref, NULL, heapimage_writerefdata, heapimage_readrefdata, NULL };
+
 static struct Object *newinstance(struct Interpreter *interp, struct Object *args, struct Object *opts)
 {
 	if (!check_args(interp, args, interp->builtins.Class, interp->builtins.Object, NULL)) return NULL;
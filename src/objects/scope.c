@@ -4,6 +4,7 @@
 #include <stdlib.h>
 #include "../attribute.h"
 #include "../check.h"
+#include "../heapimage.h"
 #include "../interpreter.h"
 #include "../method.h"
 #include "../objectsystem.h"
@@ -29,6 +30,34 @@ static void scope_destructor(void *data)
 	free(data);
 }
 
+static bool scope_writeimage(struct HeapImageWriter *w, void *data)
+{
+	struct ScopeObjectData *sd = data;
+	return heapimage_writeref(w, sd->parent_scope) && heapimage_writeref(w, sd->local_vars);
+}
+
+// the built-in scope and subscopes are written the same way, but only subscopes have a parent scope
+static bool read_scope(struct HeapImageReader *r, void **data, bool builtin)
+{
+	struct ScopeObjectData *sd = malloc(sizeof *sd);
+	if (!sd)
+		return false;
+	if (!heapimage_readref(r, &sd->parent_scope) || !sd->parent_scope != builtin ||
+		!heapimage_readref(r, &sd->local_vars) || !sd->local_vars)
+	{
+		free(sd);
+		return false;
+	}
+	*data = sd;
+	return true;
+}
+
+static bool subscope_readimage(struct HeapImageReader *r, void **data) { return read_scope(r, data, false); }
+static bool builtin_scope_readimage(struct HeapImageReader *r, void **data) { return read_scope(r, data, true); }
+
+const struct HeapImageKind scopeobject_imagekind = { subscope_foreachref, scope_destructor, scope_writeimage, subscope_readimage, NULL };
+const struct HeapImageKind scopeobject_builtinimagekind = { builtin_scope_foreachref, scope_destructor, scope_writeimage, builtin_scope_readimage, NULL };
+
 
 static struct ScopeObjectData *create_data(struct Interpreter *interp, struct Object *parent_scope)
 {
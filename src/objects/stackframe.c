@@ -3,6 +3,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "../attribute.h"
+#include "../heapimage.h"
 #include "../interpreter.h"
 #include "../objectsystem.h"
 #include "../stack.h"
@@ -31,6 +32,32 @@ static void sf_foreachref(void *data, object_foreachrefcb cb, void *cbdata)
 
 static void sf_destructor(void *data) { free(data); }
 
+static bool sf_writeimage(struct HeapImageWriter *w, void *data)
+{
+	struct StackFrameData *sfdata = data;
+	return heapimage_writeref(w, sfdata->filename) &&
+		heapimage_writeref(w, sfdata->lineno) &&
+		heapimage_writeref(w, sfdata->scope);
+}
+
+static bool sf_readimage(struct HeapImageReader *r, void **data)
+{
+	struct StackFrameData *sfdata = malloc(sizeof *sfdata);
+	if (!sfdata)
+		return false;
+	if (!heapimage_readref(r, &sfdata->filename) || !sfdata->filename ||
+		!heapimage_readref(r, &sfdata->lineno) || !sfdata->lineno ||
+		!heapimage_readref(r, &sfdata->scope) || !sfdata->scope)
+	{
+		free(sfdata);
+		return false;
+	}
+	*data = sfdata;
+	return true;
+}
+
+const struct HeapImageKind stackframeobject_imagekind = { sf_foreachref, sf_destructor, sf_writeimage, sf_readimage, NULL };
+
 ATTRIBUTE_DEFINE_STRUCTDATA_GETTER(StackFrame, StackFrameData, filename)
 ATTRIBUTE_DEFINE_STRUCTDATA_GETTER(StackFrame, StackFrameData, lineno)
 ATTRIBUTE_DEFINE_STRUCTDATA_GETTER(StackFrame, StackFrameData, scope)
@@ -13,27 +13,246 @@ check these places instead:
 #include <stdarg.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include "../attribute.h"
 #include "../check.h"
+#include "../heapimage.h"
 #include "../interpreter.h"
 #include "../method.h"
 #include "../objectsystem.h"
+#include "../search.h"
 #include "../unicode.h"
 #include "../utf8.h"
 #include "array.h"
+#include "bool.h"
 #include "classobject.h"
 #include "errors.h"
 #include "function.h"
 #include "integer.h"
 #include "option.h"
 
+static void string_foreachref(void *data, object_foreachrefcb cb, void *cbdata)
+{
+	struct StringObjectData *sdata = data;
+	if (sdata->parent)
+		cb(sdata->parent, cbdata);
+}
+
 static void string_destructor(void *data)
 {
-	free(((struct UnicodeString *)data)->val);
-	free(data);
+	struct StringObjectData *sdata = data;
+	if (!sdata->parent)
+		free(sdata->val);
+	free(sdata);
+}
+
+static size_t kind_size(int kind);   // fwd dcl
+
+// slices are written as a parent and an offset, so that they share the parent's buffer after loading too
+static bool string_writeimage(struct HeapImageWriter *w, void *data)
+{
+	struct StringObjectData *sdata = data;
+	if (!heapimage_writeuint(w, (uint64_t)sdata->kind) ||
+		!heapimage_writeuint(w, sdata->len) ||
+		!heapimage_writeuint(w, sdata->hashed) ||
+		!heapimage_writeref(w, sdata->parent))
+		return false;
+
+	if (sdata->parent) {
+		struct StringObjectData *pdata = sdata->parent->objdata.data;
+		return heapimage_writeuint(w, (size_t)((char *)sdata->val - (char *)pdata->val) / kind_size(sdata->kind));
+	}
+	return heapimage_writebytes(w, sdata->val, sdata->len * kind_size(sdata->kind));
+}
+
+static bool string_readimage(struct HeapImageReader *r, void **data)
+{
+	// slices have no characters in the image, so the length can be bigger than the rest of the image
+	uint64_t kind, len, hashed;
+	struct StringObjectData sdata;
+	if (!heapimage_readuint(r, &kind) || (kind != 1 && kind != 2 && kind != 4) ||
+		!heapimage_readuint(r, &len) ||
+		!heapimage_readuint(r, &hashed) ||
+		!heapimage_readref(r, &sdata.parent))
+		return false;
+	sdata.kind = (int)kind;
+	sdata.hashed = hashed;
+
+	if (sdata.parent) {
+		// string_dependency() makes sure that the parent has been read already
+		uint64_t offset;
+		struct StringObjectData *pdata = sdata.parent->objdata.data;
+		if (sdata.parent->objdata.foreachref != string_foreachref || pdata->parent || pdata->kind != sdata.kind ||
+			!heapimage_readuint(r, &offset) || offset > pdata->len || len > pdata->len - offset)
+			return false;
+		sdata.len = (size_t)len;
+		sdata.val = (char *)pdata->val + (size_t)offset*kind_size(sdata.kind);
+	} else if (len == 0) {
+		sdata.len = 0;
+		sdata.val = NULL;
+	} else {
+		if (len > SIZE_MAX / kind_size(sdata.kind))
+			return false;
+		sdata.len = (size_t)len;
+		size_t nbytes = sdata.len * kind_size(sdata.kind);
+		if (!(sdata.val = malloc(nbytes)))
+			return false;
+		if (!heapimage_readbytes(r, sdata.val, nbytes)) {
+			free(sdata.val);
+			return false;
+		}
+	}
+
+	struct StringObjectData *ptr = malloc(sizeof *ptr);
+	if (!ptr) {
+		if (!sdata.parent)
+			free(sdata.val);
+		return false;
+	}
+	*ptr = sdata;
+	*data = ptr;
+	return true;
+}
+
+static struct Object *string_dependency(void *data)
+{
+	return ((struct StringObjectData *)data)->parent;
+}
+
+const struct HeapImageKind stringobject_imagekind = { string_foreachref, string_destructor, string_writeimage, string_readimage, string_dependency };
+
+
+// how many bytes each character of a kind takes
+static size_t kind_size(int kind)
+{
+	if (kind == 1)
+		return sizeof(unsigned char);
+	if (kind == 2)
+		return sizeof(uint_least16_t);
+	assert(kind == 4);
+	return sizeof(unicode_char);
+}
+
+size_t stringobject_kindsize(int kind)
+{
+	return kind_size(kind);
+}
+
+static unicode_char get_char(struct StringObjectData data, size_t i)
+{
+	if (data.kind == 1)
+		return ((unsigned char *) data.val)[i];
+	if (data.kind == 2)
+		return ((uint_least16_t *) data.val)[i];
+	return ((unicode_char *) data.val)[i];
+}
+
+// returns the smallest kind that can hold all characters of data
+static int find_kind(struct StringObjectData data)
+{
+	if (data.kind == 1)
+		return 1;
+
+	int res = 1;
+	for (size_t i=0; i < data.len; i++) {
+		unicode_char c = get_char(data, i);
+		if (c > 0xffff)
+			return 4;    // can't get any bigger than this
+		if (c > 0xff)
+			res = 2;
+	}
+	return res;
+}
+
+// copies the characters of src to dst, which must have room for them
+// dstkind must be big enough for all characters of src
+static void convert(void *dst, int dstkind, struct StringObjectData src)
+{
+	if (dstkind == src.kind) {
+		if (src.len != 0)
+			memcpy(dst, src.val, src.len * kind_size(src.kind));
+		return;
+	}
+
+	for (size_t i=0; i < src.len; i++) {
+		unicode_char c = get_char(src, i);
+		if (dstkind == 1)
+			((unsigned char *) dst)[i] = (unsigned char) c;
+		else if (dstkind == 2)
+			((uint_least16_t *) dst)[i] = (uint_least16_t) c;
+		else
+			((unicode_char *) dst)[i] = c;
+	}
+}
+
+// a part of another string as a StringObjectData, nothing is copied
+static struct StringObjectData subdata(struct StringObjectData data, size_t start, size_t len)
+{
+	assert(start + len <= data.len);
+	if (start != 0)   // val may be NULL, and NULL + 0 is undefined behaviour
+		data.val = (char *) data.val + start*kind_size(data.kind);
+	data.len = len;
+	return data;
+}
+
+static struct Object *new_from_data_noerr(struct Interpreter *interp, struct StringObjectData data);
+static struct Object *new_from_data(struct Interpreter *interp, struct StringObjectData data);
+
+// creates a new string with a copy of view, view can have any kind, the new string gets the smallest kind
+static struct Object *new_from_view(struct Interpreter *interp, struct StringObjectData view)
+{
+	struct StringObjectData data = { .val = NULL, .len = view.len, .kind = find_kind(view) };
+	if (view.len != 0) {
+		if (!(data.val = malloc(view.len * kind_size(data.kind)))) {
+			errorobject_thrownomem(interp);
+			return NULL;
+		}
+		convert(data.val, data.kind, view);
+	}
+	return new_from_data(interp, data);
+}
+
+void stringobject_copychars(void *dst, int dstkind, struct Object *s)
+{
+	assert(dstkind >= STRINGOBJECT_DATA(s)->kind);
+	convert(dst, dstkind, *STRINGOBJECT_DATA(s));
+}
+
+struct Object *stringobject_newfromchars(struct Interpreter *interp, const void *val, size_t len, int kind)
+{
+	return new_from_view(interp, (struct StringObjectData){ .val = (void *)val, .len = len, .kind = kind });
+}
+
+/* slices shorter than this are always copied
+
+a string object takes a lot more memory than a few characters, so sharing
+tiny slices wouldn't save much memory, and copying is cheap anyway
+*/
+#define SHARED_SLICE_MIN_LEN 64
+
+// a shared slice must contain at least 1/SHARED_SLICE_MAX_WASTE of its parent
+// this way a small slice doesn't keep a huge string alive
+#define SHARED_SLICE_MAX_WASTE 4
+
+// creates a substring of s, sharing the characters with s if it's worth it
+static struct Object *new_slice(struct Interpreter *interp, struct Object *s, size_t start, size_t len)
+{
+	struct StringObjectData sdata = *STRINGOBJECT_DATA(s);
+	struct StringObjectData view = subdata(sdata, start, len);
+
+	// slices of slices point directly to the parent, so there are never long chains of parents
+	struct Object *parent = sdata.parent ? sdata.parent : s;
+
+	// the slice must use the smallest possible kind, just like all other strings
+	if (len < SHARED_SLICE_MIN_LEN || len < STRINGOBJECT_LEN(parent)/SHARED_SLICE_MAX_WASTE || find_kind(view) != view.kind)
+		return new_from_view(interp, view);
+
+	view.parent = parent;
+	OBJECT_INCREF(interp, parent);
+	return new_from_data(interp, view);   // decrefs parent on error
 }
 
 static struct Object *newinstance(struct Interpreter *interp, struct Object *args, struct Object *opts)
@@ -65,7 +284,7 @@ static struct Object *length_getter(struct Interpreter *interp, struct ObjectDat
 	if (!check_args(interp, args, interp->builtins.String, NULL)) return NULL;
 	if (!check_no_opts(interp, opts)) return NULL;
 
-	return integerobject_newfromlonglong(interp, ((struct UnicodeString*) ARRAYOBJECT_GET(args, 0)->objdata.data)->len);
+	return integerobject_newfromlonglong(interp, STRINGOBJECT_LEN(ARRAYOBJECT_GET(args, 0)));
 }
 
 static struct Object *replace(struct Interpreter *interp, struct ObjectData thisdata, struct Object *args, struct Object *opts)
@@ -74,11 +293,23 @@ static struct Object *replace(struct Interpreter *interp, struct ObjectData this
 	if (!check_args(interp, args, interp->builtins.String, interp->builtins.String, NULL)) return NULL;
 	if (!check_no_opts(interp, opts)) return NULL;
 
-	struct UnicodeString src = *(struct UnicodeString*) ((struct Object*)thisdata.data)->objdata.data;
-	struct UnicodeString old = *(struct UnicodeString*) ARRAYOBJECT_GET(args, 0)->objdata.data;
-	struct UnicodeString new = *(struct UnicodeString*) ARRAYOBJECT_GET(args, 1)->objdata.data;
+	struct UnicodeString src, old, new;
+	if (!stringobject_getustr(interp, (struct Object*) thisdata.data, &src))
+		return NULL;
+	if (!stringobject_getustr(interp, ARRAYOBJECT_GET(args, 0), &old)) {
+		free(src.val);
+		return NULL;
+	}
+	if (!stringobject_getustr(interp, ARRAYOBJECT_GET(args, 1), &new)) {
+		free(src.val);
+		free(old.val);
+		return NULL;
+	}
 
 	struct UnicodeString *replaced = unicodestring_replace(interp, src, old, new);
+	free(src.val);
+	free(old.val);
+	free(new.val);
 	if (!replaced)
 		return NULL;
 
@@ -94,21 +325,19 @@ static struct Object *get(struct Interpreter *interp, struct ObjectData thisdata
 	if (!check_args(interp, args, interp->builtins.Integer, NULL)) return NULL;
 	if (!check_no_opts(interp, opts)) return NULL;
 
-	struct UnicodeString ustr = *(struct UnicodeString*) ((struct Object*) thisdata.data)->objdata.data;
+	struct StringObjectData data = *STRINGOBJECT_DATA((struct Object*) thisdata.data);
 	long long i = integerobject_tolonglong(ARRAYOBJECT_GET(args, 0));
 
 	if (i < 0) {
 		errorobject_throwfmt(interp, "ValueError", "%L is not a valid string index", i);
 		return NULL;
 	}
-	if ((unsigned long long) i >= ustr.len) {
-		errorobject_throwfmt(interp, "ValueError", "%L is not a valid index for a string of length %L", i, (long long) ustr.len);
+	if ((unsigned long long) i >= data.len) {
+		errorobject_throwfmt(interp, "ValueError", "%L is not a valid index for a string of length %L", i, (long long) data.len);
 		return NULL;
 	}
 
-	ustr.val += i;
-	ustr.len = 1;
-	return stringobject_newfromustr_copy(interp, ustr);
+	return new_from_view(interp, subdata(data, i, 1));
 }
 
 static struct Object *slice(struct Interpreter *interp, struct ObjectData thisdata, struct Object *args, struct Object *opts)
@@ -122,7 +351,7 @@ static struct Object *slice(struct Interpreter *interp, struct ObjectData thisda
 		if (!check_args(interp, args, interp->builtins.Integer, NULL))
 			return NULL;
 		start = integerobject_tolonglong(ARRAYOBJECT_GET(args, 0));
-		end = ((struct UnicodeString*)s->objdata.data)->len;
+		end = STRINGOBJECT_LEN(s);
 	} else {
 		// (s.slice start end)
 		if (!check_args(interp, args, interp->builtins.Integer, interp->builtins.Integer, NULL))
@@ -131,26 +360,24 @@ static struct Object *slice(struct Interpreter *interp, struct ObjectData thisda
 		end = integerobject_tolonglong(ARRAYOBJECT_GET(args, 1));
 	}
 
-	struct UnicodeString ustr = *(struct UnicodeString*) s->objdata.data;
+	struct StringObjectData data = *STRINGOBJECT_DATA(s);
 
 	if (start < 0)
 		start = 0;
 	if (end < 0)
 		return stringobject_newfromcharptr(interp, "");
 	// now end can be casted to size_t
-	if ((size_t) end > ustr.len)
-		end = ustr.len;
+	if ((size_t) end > data.len)
+		end = data.len;
 	if (start >= end)
 		return stringobject_newfromcharptr(interp, "");
 
-	if (start == 0 && (size_t) end == ustr.len) {
+	if (start == 0 && (size_t) end == data.len) {
 		OBJECT_INCREF(interp, s);
 		return s;
 	}
 
-	ustr.val += start;
-	ustr.len = end - start;
-	return stringobject_newfromustr_copy(interp, ustr);
+	return new_slice(interp, s, start, end - start);
 }
 
 struct Object *stringobject_splitbywhitespace(struct Interpreter *interp, struct Object *s)
@@ -173,10 +400,7 @@ struct Object *stringobject_splitbywhitespace(struct Interpreter *interp, struct
 				continue;
 
 			// slice it and push the slice to result
-			struct UnicodeString subu = *((struct UnicodeString*) s->objdata.data);
-			subu.val += offset;
-			subu.len = nows_end - offset;
-			struct Object *sub = stringobject_newfromustr_copy(interp, subu);
+			struct Object *sub = new_from_view(interp, subdata(*STRINGOBJECT_DATA(s), offset, nows_end - offset));
 			if (!sub)
 				goto error;
 			bool ok = arrayobject_push(interp, result, sub);
@@ -195,10 +419,7 @@ struct Object *stringobject_splitbywhitespace(struct Interpreter *interp, struct
 
 		if (!found_ws) {
 			// rest of the string is non-whitespace
-			struct UnicodeString lastu = *((struct UnicodeString*) s->objdata.data);
-			lastu.val += offset;
-			lastu.len -= offset;
-			struct Object *last = stringobject_newfromustr_copy(interp, lastu);
+			struct Object *last = new_from_view(interp, subdata(*STRINGOBJECT_DATA(s), offset, STRINGOBJECT_LEN(s) - offset));
 			if (!last)
 				goto error;
 			bool ok = arrayobject_push(interp, result, last);
@@ -224,14 +445,248 @@ static struct Object *split_by_whitespace(struct Interpreter *interp, struct Obj
 	return stringobject_splitbywhitespace(interp, (struct Object*) thisdata.data);
 }
 
+struct Object *stringobject_join(struct Interpreter *interp, struct Object *sep, struct Object *strings)
+{
+	// first pass: check types and figure out how big the result is
+	// this way the result is allocated just once, instead of creating lots of temporary strings
+	struct StringObjectData sepdata = *STRINGOBJECT_DATA(sep);
+	size_t n = ARRAYOBJECT_LEN(strings);
+	struct StringObjectData d = { .val = NULL, .len = 0, .kind = n > 1 ? sepdata.kind : 1 };
+	for (size_t i=0; i < n; i++) {
+		struct Object *s = ARRAYOBJECT_GET(strings, i);
+		if (!check_type(interp, interp->builtins.String, s))
+			return NULL;
+		if (STRINGOBJECT_DATA(s)->kind > d.kind)
+			d.kind = STRINGOBJECT_DATA(s)->kind;
+		// the strings can share their data, so the sum can overflow even though each string fits in memory
+		if (STRINGOBJECT_LEN(s) > SIZE_MAX - d.len)
+			goto nomem;
+		d.len += STRINGOBJECT_LEN(s);
+	}
+	if (n > 1 && sepdata.len != 0) {
+		if (n-1 > SIZE_MAX / sepdata.len || (n-1)*sepdata.len > SIZE_MAX - d.len)
+			goto nomem;
+		d.len += (n-1)*sepdata.len;
+	}
+	if (d.len > SIZE_MAX / kind_size(d.kind))
+		goto nomem;
+
+	if (d.len != 0) {
+		if (!(d.val = malloc(d.len * kind_size(d.kind))))
+			goto nomem;
+
+		char *ptr = d.val;
+		for (size_t i=0; i < n; i++) {
+			if (i != 0) {
+				convert(ptr, d.kind, sepdata);
+				ptr += sepdata.len*kind_size(d.kind);
+			}
+			struct StringObjectData part = *STRINGOBJECT_DATA(ARRAYOBJECT_GET(strings, i));
+			convert(ptr, d.kind, part);
+			ptr += part.len*kind_size(d.kind);
+		}
+	}
+	return new_from_data(interp, d);
+
+nomem:
+	errorobject_thrownomem(interp);
+	return NULL;
+}
+
+static struct Object *join(struct Interpreter *interp, struct ObjectData thisdata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, interp->builtins.Array, NULL)) return NULL;
+	if (!check_no_opts(interp, opts)) return NULL;
+	return stringobject_join(interp, (struct Object *) thisdata.data, ARRAYOBJECT_GET(args, 0));
+}
+
+
+/* sets up s for searching needle from hay
+
+the needle is converted to the kind of hay if needed, and then *tmp is set to
+a buffer that must be free()'d after using s, otherwise *tmp is set to NULL
+
+returns 1 on success, 0 if hay can't contain needle because needle has
+characters that are too big for hay's kind, and -1 on error
+*/
+static int init_searcher(struct Interpreter *interp, struct Searcher *s, struct StringObjectData hay, struct StringObjectData needle, void **tmp)
+{
+	*tmp = NULL;
+	if (needle.kind > hay.kind)
+		return 0;
+
+	if (needle.kind < hay.kind) {
+		assert(needle.len != 0);   // empty strings have kind 1, and hay.kind > 1 here
+		if (!(*tmp = malloc(needle.len * kind_size(hay.kind)))) {
+			errorobject_thrownomem(interp);
+			return -1;
+		}
+		convert(*tmp, hay.kind, needle);
+		needle.val = *tmp;
+	}
+
+	search_init(s, needle.val, needle.len, hay.kind);
+	return 1;
+}
+
+static struct Object *find(struct Interpreter *interp, struct ObjectData thisdata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, interp->builtins.String, NULL)) return NULL;
+	if (!check_no_opts(interp, opts)) return NULL;
+	struct StringObjectData hay = *STRINGOBJECT_DATA((struct Object *) thisdata.data);
+
+	struct Searcher s;
+	void *tmp;
+	int status = init_searcher(interp, &s, hay, *STRINGOBJECT_DATA(ARRAYOBJECT_GET(args, 0)), &tmp);
+	if (status < 0)
+		return NULL;
+	size_t i = status ? search_find(&s, hay.val, hay.len) : SEARCH_NOTFOUND;
+	free(tmp);
+
+	if (i == SEARCH_NOTFOUND) {
+		OBJECT_INCREF(interp, interp->builtins.none);
+		return interp->builtins.none;
+	}
+
+	struct Object *integer = integerobject_newfromlonglong(interp, (long long) i);
+	if (!integer)
+		return NULL;
+	struct Object *opt = optionobject_new(interp, integer);
+	OBJECT_DECREF(interp, integer);
+	return opt;
+}
+
+static struct Object *count(struct Interpreter *interp, struct ObjectData thisdata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, interp->builtins.String, NULL)) return NULL;
+	if (!check_no_opts(interp, opts)) return NULL;
+	struct StringObjectData hay = *STRINGOBJECT_DATA((struct Object *) thisdata.data);
+	struct StringObjectData needle = *STRINGOBJECT_DATA(ARRAYOBJECT_GET(args, 0));
+
+	if (needle.len == 0) {
+		errorobject_throwfmt(interp, "ValueError", "cannot count \"\"");
+		return NULL;
+	}
+
+	struct Searcher s;
+	void *tmp;
+	int status = init_searcher(interp, &s, hay, needle, &tmp);
+	if (status < 0)
+		return NULL;
+
+	// matches don't overlap, just like with split
+	long long n = 0;
+	size_t offset = 0;
+	while (status && offset < hay.len) {
+		size_t i = search_find(&s, subdata(hay, offset, hay.len - offset).val, hay.len - offset);
+		if (i == SEARCH_NOTFOUND)
+			break;
+		n++;
+		offset += i + needle.len;
+	}
+	free(tmp);
+	return integerobject_newfromlonglong(interp, n);
+}
+
+static struct Object *split(struct Interpreter *interp, struct ObjectData thisdata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, interp->builtins.String, NULL)) return NULL;
+	if (!check_no_opts(interp, opts)) return NULL;
+	struct StringObjectData hay = *STRINGOBJECT_DATA((struct Object *) thisdata.data);
+	struct StringObjectData sep = *STRINGOBJECT_DATA(ARRAYOBJECT_GET(args, 0));
+
+	// python throws an error for this as well :D
+	if (sep.len == 0) {
+		errorobject_throwfmt(interp, "ValueError", "cannot split by \"\"");
+		return NULL;
+	}
+
+	struct Searcher s;
+	void *tmp;
+	int status = init_searcher(interp, &s, hay, sep, &tmp);
+	if (status < 0)
+		return NULL;
+
+	struct Object *result = arrayobject_newempty(interp);
+	if (!result) {
+		free(tmp);
+		return NULL;
+	}
+
+	size_t offset = 0;
+	while (true) {
+		size_t i = status ? search_find(&s, subdata(hay, offset, hay.len - offset).val, hay.len - offset) : SEARCH_NOTFOUND;
+		size_t partlen = (i == SEARCH_NOTFOUND) ? hay.len - offset : i;
+
+		struct Object *part = new_slice(interp, (struct Object *) thisdata.data, offset, partlen);
+		if (!part)
+			goto error;
+		bool ok = arrayobject_push(interp, result, part);
+		OBJECT_DECREF(interp, part);
+		if (!ok)
+			goto error;
+
+		if (i == SEARCH_NOTFOUND)
+			break;
+		offset += i + sep.len;    // matches don't overlap
+	}
+
+	free(tmp);
+	return result;
+
+error:
+	free(tmp);
+	OBJECT_DECREF(interp, result);
+	return NULL;
+}
+
+// checks if the characters of hay starting at offset are the same as the characters of needle
+static bool matches_at(struct StringObjectData hay, size_t offset, struct StringObjectData needle)
+{
+	if (needle.kind > hay.kind)
+		return false;
+	if (hay.kind == 1)
+		return needle.len == 0 || memcmp((unsigned char *) hay.val + offset, needle.val, needle.len) == 0;
+
+	for (size_t i=0; i < needle.len; i++) {
+		if (get_char(hay, offset+i) != get_char(needle, i))
+			return false;
+	}
+	return true;
+}
+
+static struct Object *starts_with(struct Interpreter *interp, struct ObjectData thisdata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, interp->builtins.String, NULL)) return NULL;
+	if (!check_no_opts(interp, opts)) return NULL;
+	struct StringObjectData hay = *STRINGOBJECT_DATA((struct Object *) thisdata.data);
+	struct StringObjectData needle = *STRINGOBJECT_DATA(ARRAYOBJECT_GET(args, 0));
+	return boolobject_get(interp, needle.len <= hay.len && matches_at(hay, 0, needle));
+}
+
+static struct Object *ends_with(struct Interpreter *interp, struct ObjectData thisdata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, interp->builtins.String, NULL)) return NULL;
+	if (!check_no_opts(interp, opts)) return NULL;
+	struct StringObjectData hay = *STRINGOBJECT_DATA((struct Object *) thisdata.data);
+	struct StringObjectData needle = *STRINGOBJECT_DATA(ARRAYOBJECT_GET(args, 0));
+	return boolobject_get(interp, needle.len <= hay.len && matches_at(hay, hay.len - needle.len, needle));
+}
+
 bool stringobject_addmethods(struct Interpreter *interp)
 {
 	// TODO: create many more string methods
 	if (!attribute_add(interp, interp->builtins.String, "length", length_getter, NULL)) return false;
+	if (!method_add_yesret(interp, interp->builtins.String, "count", count)) return false;
+	if (!method_add_yesret(interp, interp->builtins.String, "ends_with", ends_with)) return false;
+	if (!method_add_yesret(interp, interp->builtins.String, "find", find)) return false;
 	if (!method_add_yesret(interp, interp->builtins.String, "get", get)) return false;
+	if (!method_add_yesret(interp, interp->builtins.String, "join", join)) return false;
 	if (!method_add_yesret(interp, interp->builtins.String, "replace", replace)) return false;
 	if (!method_add_yesret(interp, interp->builtins.String, "slice", slice)) return false;
+	if (!method_add_yesret(interp, interp->builtins.String, "split", split)) return false;
 	if (!method_add_yesret(interp, interp->builtins.String, "split_by_whitespace", split_by_whitespace)) return false;
+	if (!method_add_yesret(interp, interp->builtins.String, "starts_with", starts_with)) return false;
 	if (!method_add_yesret(interp, interp->builtins.String, "to_string", to_string)) return false;
 	return true;
 }
@@ -250,18 +705,7 @@ static struct Object *eq(struct Interpreter *interp, struct ObjectData nulldata,
 		return interp->builtins.none;
 	}
 
-	struct UnicodeString *u1 = s1->objdata.data;
-	struct UnicodeString *u2 = s2->objdata.data;
-	if (u1->len != u2->len)
-		return BOOL_OPTION(interp, false);
-
-	// memcmp is not reliable :( https://stackoverflow.com/a/11995514
-	// TODO: use memcmp on systems where it works reliably (i have an idea for checking it)
-	for (size_t i=0; i < u1->len; i++) {
-		if (u1->val[i] != u2->val[i])
-			return BOOL_OPTION(interp, false);
-	}
-	return BOOL_OPTION(interp, true);
+	return BOOL_OPTION(interp, stringobject_equal(s1, s2));
 }
 
 // concatenates strings
@@ -277,21 +721,25 @@ static struct Object *add(struct Interpreter *interp, struct ObjectData nulldata
 		return interp->builtins.none;
 	}
 
-	struct UnicodeString u1 = *((struct UnicodeString*) ARRAYOBJECT_GET(args, 0)->objdata.data);
-	struct UnicodeString u2 = *((struct UnicodeString*) ARRAYOBJECT_GET(args, 1)->objdata.data);
-
-	struct UnicodeString u;
-	u.len = u1.len + u2.len;
-	u.val = malloc(sizeof(unicode_char) * u.len);
-	if (!u.val) {
-		errorobject_thrownomem(interp);
-		return NULL;
+	struct StringObjectData d1 = *STRINGOBJECT_DATA(s1);
+	struct StringObjectData d2 = *STRINGOBJECT_DATA(s2);
+
+	// the biggest character of the result is the biggest character of d1 or d2
+	struct StringObjectData d;
+	d.kind = d1.kind > d2.kind ? d1.kind : d2.kind;
+	d.len = d1.len + d2.len;
+	d.val = NULL;
+	d.parent = NULL;
+	if (d.len != 0) {
+		if (!(d.val = malloc(d.len * kind_size(d.kind)))) {
+			errorobject_thrownomem(interp);
+			return NULL;
+		}
+		convert(d.val, d.kind, d1);
+		convert((char *) d.val + d1.len*kind_size(d.kind), d.kind, d2);
 	}
 
-	memcpy(u.val, u1.val, u1.len * sizeof(unicode_char));
-	memcpy(u.val+u1.len, u2.val, u2.len * sizeof(unicode_char));
-
-	struct Object *s = stringobject_newfromustr(interp, u);
+	struct Object *s = new_from_data(interp, d);
 	if (!s)
 		return NULL;
 	struct Object *opt = optionobject_new(interp, s);
@@ -306,34 +754,137 @@ bool stringobject_initoparrays(struct Interpreter *interp) {
 }
 
 
-static long string_hash(struct UnicodeString u)
+int stringobject_fasteq(struct Interpreter *interp, struct Object *s1, struct Object *s2)
+{
+	if (s1->klass != interp->builtins.String || s2->klass != interp->builtins.String)
+		return -1;
+
+	struct Object *oparray = interp->oparrays.eq;
+	if (ARRAYOBJECT_LEN(oparray) == 0)
+		return -1;
+	struct Object *first = ARRAYOBJECT_GET(oparray, 0);
+	if (first->klass != interp->builtins.Function)
+		return -1;
+
+	struct FunctionObjectCfunc cfunc = functionobject_getcfunc(first);
+	if (!cfunc.returning || cfunc.func.yesret != eq)
+		return -1;
+	return stringobject_equal(s1, s2);
+}
+
+bool stringobject_equal(struct Object *s1, struct Object *s2)
+{
+	struct StringObjectData *d1 = STRINGOBJECT_DATA(s1);
+	struct StringObjectData *d2 = STRINGOBJECT_DATA(s2);
+
+	// the kind depends on the characters, so different kinds mean different characters
+	if (d1->len != d2->len || d1->kind != d2->kind)
+		return false;
+
+	// unsigned char can't have padding bits, so memcmp works
+	// memcmp is not reliable for other types :( https://stackoverflow.com/a/11995514
+	// TODO: use memcmp on systems where it works reliably (i have an idea for checking it)
+	if (d1->kind == 1)
+		return d1->len == 0 || memcmp(d1->val, d2->val, d1->len) == 0;
+
+	for (size_t i=0; i < d1->len; i++) {
+		if (get_char(*d1, i) != get_char(*d2, i))
+			return false;
+	}
+	return true;
+}
+
+
+static long string_hash(struct StringObjectData data)
 {
 	// djb2 hash
 	// http://www.cse.yorku.ca/~oz/hash.html
+	// this is the same for all kinds, one loop for each kind to avoid checking the kind many times
 	unsigned long hash = 5381;
-	for (size_t i=0; i < u.len; i++)
-		hash = hash*33 + u.val[i];
+	size_t i;
+	switch (data.kind) {
+	case 1:
+		for (i=0; i < data.len; i++)
+			hash = hash*33 + ((unsigned char *) data.val)[i];
+		break;
+	case 2:
+		for (i=0; i < data.len; i++)
+			hash = hash*33 + ((uint_least16_t *) data.val)[i];
+		break;
+	default:
+		for (i=0; i < data.len; i++)
+			hash = hash*33 + ((unicode_char *) data.val)[i];
+		break;
+	}
 	return (long)hash;
 }
 
-struct Object *stringobject_newfromustr_noerr(struct Interpreter *interp, struct UnicodeString ustr)
+void stringobject_ensurehash(struct Object *s)
 {
-	struct UnicodeString *data = malloc(sizeof(struct UnicodeString));
-	if (!data)
-		return NULL;
-	data->len = ustr.len;
-	data->val = ustr.val;
+	struct StringObjectData *data = STRINGOBJECT_DATA(s);
+	if (!data->hashed) {
+		s->hash = string_hash(*data);
+		data->hashed = true;
+	}
+}
 
-	struct Object *s = object_new_noerr(interp, interp->builtins.String, (struct ObjectData){.data=data, .foreachref=NULL, .destructor=string_destructor});
+// data.val must be from malloc() or NULL, and this takes care of freeing it
+// if data.parent is not NULL, data.val points into the parent's buffer and this takes care of decreffing the parent instead
+// returning NULL means ran out of mem and no error thrown yet
+static struct Object *new_from_data_noerr(struct Interpreter *interp, struct StringObjectData data)
+{
+	data.hashed = false;
+
+	struct StringObjectData *ptr = malloc(sizeof(struct StringObjectData));
+	if (!ptr)
+		goto error;
+	*ptr = data;
+
+	struct Object *s = object_new_noerr(interp, interp->builtins.String, (struct ObjectData){.data=ptr, .foreachref=string_foreachref, .destructor=string_destructor});
 	if (!s) {
-		free(data->val);
-		free(data);
+		free(ptr);
+		goto error;
+	}
+	return s;
+
+error:
+	if (data.parent)
+		OBJECT_DECREF(interp, data.parent);
+	else
+		free(data.val);
+	return NULL;
+}
+
+static struct Object *new_from_data(struct Interpreter *interp, struct StringObjectData data)
+{
+	struct Object *s = new_from_data_noerr(interp, data);
+	if (!s) {
+		errorobject_thrownomem(interp);
 		return NULL;
 	}
-	s->hash = string_hash(ustr);
 	return s;
 }
 
+struct Object *stringobject_newfromustr_noerr(struct Interpreter *interp, struct UnicodeString ustr)
+{
+	struct StringObjectData data = { .val = ustr.val, .len = ustr.len, .kind = 4 };
+	data.kind = find_kind(data);
+	if (data.kind == 4)
+		return new_from_data_noerr(interp, data);
+
+	// the characters fit in less space, so ustr.val is replaced with a smaller array
+	data.val = NULL;
+	if (ustr.len != 0) {
+		if (!(data.val = malloc(ustr.len * kind_size(data.kind)))) {
+			free(ustr.val);
+			return NULL;
+		}
+		convert(data.val, data.kind, (struct StringObjectData){ .val = ustr.val, .len = ustr.len, .kind = 4 });
+	}
+	free(ustr.val);
+	return new_from_data_noerr(interp, data);
+}
+
 struct Object *stringobject_newfromustr(struct Interpreter *interp, struct UnicodeString ustr)
 {
 	struct Object *s = stringobject_newfromustr_noerr(interp, ustr);
@@ -346,26 +897,152 @@ struct Object *stringobject_newfromustr(struct Interpreter *interp, struct Unico
 
 struct Object *stringobject_newfromustr_copy(struct Interpreter *interp, struct UnicodeString ustr)
 {
-	struct UnicodeString copy;
-	if (!unicodestring_copyinto(interp, ustr, &copy))
-		return NULL;
-	return stringobject_newfromustr(interp, copy);
+	return new_from_view(interp, (struct StringObjectData){ .val = ustr.val, .len = ustr.len, .kind = 4 });
 }
 
-struct Object *stringobject_newfromcharptr(struct Interpreter *interp, char *ptr)
+struct Object *stringobject_newfromutf8(struct Interpreter *interp, char *utf8, size_t utf8len)
 {
 	// avoid allocating more memory for empty strings
-	if (!ptr[0] && interp->strings.empty) {
+	if (utf8len == 0 && interp->strings.empty) {
 		OBJECT_INCREF(interp, interp->strings.empty);
 		return interp->strings.empty;
 	}
 
+	// ascii is very common, and it can be copied as is without utf8_decode()
+	size_t i;
+	for (i=0; i < utf8len && (unsigned char)utf8[i] < 0x80; i++)
+		;
+	if (i == utf8len) {
+		struct StringObjectData data = { .val = NULL, .len = utf8len, .kind = 1 };
+		if (utf8len != 0) {
+			if (!(data.val = malloc(utf8len))) {
+				errorobject_thrownomem(interp);
+				return NULL;
+			}
+			memcpy(data.val, utf8, utf8len);
+		}
+		return new_from_data(interp, data);
+	}
+
 	struct UnicodeString data;
-	if (!utf8_decode(interp, ptr, strlen(ptr), &data))
+	if (!utf8_decode(interp, utf8, utf8len, &data))
 		return NULL;
 	return stringobject_newfromustr(interp, data);
 }
 
+struct Object *stringobject_newfromcharptr(struct Interpreter *interp, char *ptr)
+{
+	return stringobject_newfromutf8(interp, ptr, strlen(ptr));
+}
+
+
+bool stringobject_getustr(struct Interpreter *interp, struct Object *s, struct UnicodeString *res)
+{
+	struct StringObjectData data = *STRINGOBJECT_DATA(s);
+	if (data.len == 0) {
+		res->val = NULL;
+		res->len = 0;
+		return true;
+	}
+
+	unicode_char *val = malloc(data.len * sizeof(unicode_char));
+	if (!val) {
+		errorobject_thrownomem(interp);
+		return false;
+	}
+	convert(val, 4, data);
+	res->val = val;
+	res->len = data.len;
+	return true;
+}
+
+bool stringobject_toutf8(struct Interpreter *interp, struct Object *s, char **utf8, size_t *utf8len)
+{
+	struct StringObjectData data = *STRINGOBJECT_DATA(s);
+
+	if (data.kind == 4)
+		return utf8_encode(interp, (struct UnicodeString){ .val = data.val, .len = data.len }, utf8, utf8len);
+
+	if (data.kind == 1) {
+		// latin-1 is easy: ascii as is, and everything else is 2 bytes
+		if (data.len == 0) {
+			*utf8 = NULL;
+			*utf8len = 0;
+			return true;
+		}
+
+		unsigned char *val = data.val;
+		size_t len = data.len;
+		for (size_t i=0; i < data.len; i++) {
+			if (val[i] >= 0x80)
+				len++;
+		}
+
+		char *ptr = malloc(len);
+		if (!ptr) {
+			errorobject_thrownomem(interp);
+			return false;
+		}
+		*utf8 = ptr;
+		*utf8len = len;
+
+		for (size_t i=0; i < data.len; i++) {
+			if (val[i] < 0x80)
+				*ptr++ = val[i];
+			else {
+				*ptr++ = 0xc0 | val[i]>>6;
+				*ptr++ = 0x80 | (val[i] & 0x3f);
+			}
+		}
+		return true;
+	}
+
+	struct UnicodeString u;
+	if (!stringobject_getustr(interp, s, &u))
+		return false;
+	bool ok = utf8_encode(interp, u, utf8, utf8len);
+	free(u.val);
+	return ok;
+}
+
+
+// 8KB of stack space, small enough to be fine and big enough that fwrite() isn't called too often
+#define WRITE_CHUNK 1024
+
+int stringobject_writeutf8(struct Interpreter *interp, struct Object *s, FILE *f)
+{
+	struct StringObjectData data = *STRINGOBJECT_DATA(s);
+
+	// ascii is utf8 as is, and most strings are ascii
+	if (data.kind == 1) {
+		unsigned char *val = data.val;
+		size_t i = 0;
+		while (i < data.len && val[i] < 0x80)
+			i++;
+		if (i == data.len)
+			return (data.len == 0 || fwrite(val, data.len, 1, f) == 1) ? 1 : -1;
+	}
+
+	unicode_char tmp[WRITE_CHUNK];
+	char utf8[4*WRITE_CHUNK];
+	for (size_t start = 0; start < data.len; start += WRITE_CHUNK) {
+		size_t n = data.len - start < WRITE_CHUNK ? data.len - start : WRITE_CHUNK;
+		unicode_char *chars = tmp;
+		if (data.kind == 4)
+			chars = (unicode_char *)data.val + start;
+		else
+			for (size_t i = 0; i < n; i++)
+				tmp[i] = STRINGOBJECT_GET(s, start+i);
+
+		size_t utf8len;
+		if (!utf8_encodeinto(interp, (struct UnicodeString){ .val = chars, .len = n }, utf8, &utf8len))
+			return 0;
+		if (fwrite(utf8, utf8len, 1, f) != 1)
+			return -1;
+	}
+	return 1;
+}
+
 
 #define POINTER_MAXSTR 50            // should be big enough
 #define MAX_PARTS 20                 // feel free to make this bigger
@@ -431,8 +1108,8 @@ struct Object *stringobject_newfromvfmt(struct Interpreter *interp, char *fmt, v
 					goto error;
 				*gonnadecrefptr++ = strobj;
 
-				parts[nparts] = *((struct UnicodeString *) strobj->objdata.data);
-				skipfreeval[nparts] = true;
+				if (!stringobject_getustr(interp, strobj, parts + nparts))
+					goto error;
 			}
 
 			else if (*(fmt-1) == 'L') {   // long long
@@ -447,8 +1124,8 @@ struct Object *stringobject_newfromvfmt(struct Interpreter *interp, char *fmt, v
 					goto error;
 				*gonnadecrefptr++ = strobj;
 
-				parts[nparts] = *((struct UnicodeString *) strobj->objdata.data);
-				skipfreeval[nparts] = true;
+				if (!stringobject_getustr(interp, strobj, parts + nparts))
+					goto error;
 			}
 
 			else if (*(fmt-1) == '%') {   // literal %
@@ -3,15 +3,75 @@
 
 #include <stdarg.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
 #include "../interpreter.h"    // IWYU pragma: keep
 #include "../objectsystem.h"   // IWYU pragma: keep
 #include "../unicode.h"        // IWYU pragma: keep
 
+/* strings use 1, 2 or 4 bytes for each character, like latin-1, ucs-2 and utf-32
+the smallest kind that fits all characters is chosen when the string is created,
+and strings are immutable so it never changes after that
+this means that strings of different kinds are never equal
+
+most strings are ascii, so this saves a lot of memory compared to always using unicode_char
+use STRINGOBJECT_GET or stringobject_getustr() instead of messing with val directly
+
+big slices of strings don't copy anything, instead val points into the
+buffer of the parent string and the slice holds a reference to the parent
+*/
+struct StringObjectData {
+	void *val;    // unsigned char, uint_least16_t or unicode_char array depending on kind, NULL if len is 0
+	size_t len;   // number of characters, not bytes
+	int kind;     // 1, 2 or 4
+	bool hashed;  // see stringobject_ensurehash()
+	struct Object *parent;   // the string that owns val, or NULL if this string owns it
+};
+
 // bad things happen if s is not a string object or i < STRINGOBJECT_LEN(s)
 // otherwise these never fail
 // these DO NOT return a new reference!
-#define STRINGOBJECT_GET(s, i) (((struct UnicodeString*) (s)->objdata.data)->val[(i)])
-#define STRINGOBJECT_LEN(s)    (((struct UnicodeString*) (s)->objdata.data)->len)
+#define STRINGOBJECT_DATA(s)   ((struct StringObjectData *) (s)->objdata.data)
+#define STRINGOBJECT_LEN(s)    (STRINGOBJECT_DATA(s)->len)
+#define STRINGOBJECT_GET(s, i) ( \
+	STRINGOBJECT_DATA(s)->kind == 1 ? (unicode_char) ((unsigned char *) STRINGOBJECT_DATA(s)->val)[(i)] : \
+	STRINGOBJECT_DATA(s)->kind == 2 ? (unicode_char) ((uint_least16_t *) STRINGOBJECT_DATA(s)->val)[(i)] : \
+	((unicode_char *) STRINGOBJECT_DATA(s)->val)[(i)] )
+
+// copy the characters of a string object to a utf-32 string, for C code that needs a struct UnicodeString
+// res->val must be free()'d, it's NULL if the string is empty
+// returns false on error
+bool stringobject_getustr(struct Interpreter *interp, struct Object *s, struct UnicodeString *res);
+
+// like utf8_encode(), but this works directly with the string's characters without converting to utf-32 first
+// returns false on error
+bool stringobject_toutf8(struct Interpreter *interp, struct Object *s, char **utf8, size_t *utf8len);
+
+// writes the string to f as utf8 a piece at a time, without allocating memory for all of it
+// returns 1 on success, 0 on an encoding error (thrown) or -1 if fwrite() fails (not thrown, see errno)
+int stringobject_writeutf8(struct Interpreter *interp, struct Object *s, FILE *f);
+
+// how many bytes each character of a kind (1, 2 or 4) takes, never fails
+size_t stringobject_kindsize(int kind);
+
+// copies the characters of s to dst, which must have room for them, never fails
+// dstkind must be at least the kind of s, and characters are widened if it's bigger
+void stringobject_copychars(void *dst, int dstkind, struct Object *s);
+
+// compares characters of two strings, never fails
+bool stringobject_equal(struct Object *s1, struct Object *s2);
+
+// returns 1 or 0 if (s1 == s2) can be figured out without going through interp->oparrays.eq, otherwise -1
+// that's when both are strings and nothing has been added before the built-in string eq function
+// the result is then same as from the oparray, but much faster, and mappings compare string keys a lot
+// never fails
+int stringobject_fasteq(struct Interpreter *interp, struct Object *s1, struct Object *s2);
+
+// strings compute their hash when it's needed for the first time, so that
+// slicing doesn't need to look at every character
+// call this before using s->hash, never fails
+void stringobject_ensurehash(struct Object *s);
 
 // RETURNS A NEW REFERENCE or NULL on no mem, see builtins_setup()
 struct Object *stringobject_createclass_noerr(struct Interpreter *interp);
@@ -34,10 +94,18 @@ struct Object *stringobject_newfromustr_noerr(struct Interpreter *interp, struct
 // ustr can come from anywhere, it'll be copied
 struct Object *stringobject_newfromustr_copy(struct Interpreter *interp, struct UnicodeString ustr);
 
+// RETURNS A NEW REFERENCE or NULL on error
+// val is len characters of the given kind, it's copied, and the new string gets the smallest kind that fits
+struct Object *stringobject_newfromchars(struct Interpreter *interp, const void *val, size_t len, int kind);
+
 // ptr must be \0-terminated
 // RETURNS A NEW REFERENCE
 struct Object *stringobject_newfromcharptr(struct Interpreter *interp, char *ptr);
 
+// like stringobject_newfromcharptr, but utf8 doesn't need to be \0-terminated
+// RETURNS A NEW REFERENCE or NULL on error
+struct Object *stringobject_newfromutf8(struct Interpreter *interp, char *utf8, size_t utf8len);
+
 /* create a new string kinda like printf
 
 fmt must be valid UTF-8, and it can contain any of these format specifiers:
@@ -66,13 +134,14 @@ struct Object *stringobject_newfromfmt(struct Interpreter *interp, char *fmt, ..
 // like newfromfmt, but vprintf style
 struct Object *stringobject_newfromvfmt(struct Interpreter *interp, char *fmt, va_list ap);
 
-// the returned UnicodeString's val must NOT be free()'d
-// TODO: use this everywhere, now everything accesses ->objdata directly :(
-struct UnicodeString *stringobject_getustr(struct Object *s);
-
 // returns an array of substrings or NULL on error
 // bad things happen if the string is not a string object
 struct Object *stringobject_splitbywhitespace(struct Interpreter *interp, struct Object *s);
 
+// joins an Array of strings together with sep between them, like python's str.join
+// throws an error if the array contains something else than strings
+// RETURNS A NEW REFERENCE or NULL on error
+struct Object *stringobject_join(struct Interpreter *interp, struct Object *sep, struct Object *strings);
+
 
 #endif   // OBJECTS_STRING_H
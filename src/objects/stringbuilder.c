@@ -0,0 +1,159 @@
+#include "stringbuilder.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include "../attribute.h"
+#include "../check.h"
+#include "../interpreter.h"
+#include "../method.h"
+#include "../objectsystem.h"
+#include "../unicode.h"
+#include "array.h"
+#include "classobject.h"
+#include "errors.h"
+#include "integer.h"
+#include "string.h"
+
+#define STRINGBUILDEROBJECT_DATA(obj) ((struct StringBuilderObjectData *) (obj)->objdata.data)
+
+static void stringbuilder_destructor(void *data)
+{
+	free(((struct StringBuilderObjectData *)data)->val);
+	free(data);
+}
+
+static struct Object *newinstance(struct Interpreter *interp, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, interp->builtins.Class, NULL)) return NULL;
+	if (!check_no_opts(interp, opts)) return NULL;
+
+	struct StringBuilderObjectData *data = malloc(sizeof *data);
+	if (!data) {
+		errorobject_thrownomem(interp);
+		return NULL;
+	}
+	data->val = NULL;
+	data->len = 0;
+	data->nallocated = 0;
+	data->kind = 1;
+
+	struct Object *sb = object_new_noerr(interp, ARRAYOBJECT_GET(args, 0), (struct ObjectData){.data=data, .foreachref=NULL, .destructor=stringbuilder_destructor});
+	if (!sb) {
+		errorobject_thrownomem(interp);
+		free(data);
+		return NULL;
+	}
+	return sb;
+}
+
+// converts the characters in the buffer to a bigger kind, the buffer must have room for them
+// goes backwards, because each character takes more space than before and would overwrite the next ones
+static void widen(struct StringBuilderObjectData *data, int newkind)
+{
+	for (size_t i = data->len; i-- > 0; ) {
+		unicode_char c = data->kind == 1 ? ((unsigned char *) data->val)[i] : ((uint_least16_t *) data->val)[i];
+		if (newkind == 2)
+			((uint_least16_t *) data->val)[i] = (uint_least16_t) c;
+		else
+			((unicode_char *) data->val)[i] = c;
+	}
+	data->kind = newkind;
+}
+
+// makes sure that there's room for at least n more characters of the given kind, and widens the buffer if needed
+static bool make_room(struct Interpreter *interp, struct StringBuilderObjectData *data, size_t n, int kind)
+{
+	if (kind < data->kind)
+		kind = data->kind;
+	if (n > SIZE_MAX - data->len) {
+		errorobject_thrownomem(interp);
+		return false;
+	}
+	size_t needed = data->len + n;
+	size_t kindsize = stringobject_kindsize(kind);
+	if (needed > SIZE_MAX / kindsize) {
+		errorobject_thrownomem(interp);
+		return false;
+	}
+
+	if (needed*kindsize > data->nallocated) {
+		size_t newsize = data->nallocated == 0 ? 16 : data->nallocated;
+		while (newsize < needed*kindsize)
+			newsize = newsize > SIZE_MAX/2 ? needed*kindsize : newsize*2;
+
+		void *ptr = realloc(data->val, newsize);
+		if (!ptr) {
+			errorobject_thrownomem(interp);
+			return false;
+		}
+		data->val = ptr;
+		data->nallocated = newsize;
+	}
+
+	if (kind > data->kind)
+		widen(data, kind);
+	return true;
+}
+
+static bool append(struct Interpreter *interp, struct ObjectData thisdata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, interp->builtins.String, NULL)) return false;
+	if (!check_no_opts(interp, opts)) return false;
+
+	struct StringBuilderObjectData *data = STRINGBUILDEROBJECT_DATA((struct Object *) thisdata.data);
+	struct Object *s = ARRAYOBJECT_GET(args, 0);
+	size_t len = STRINGOBJECT_LEN(s);
+	if (len == 0)
+		return true;
+	if (!make_room(interp, data, len, STRINGOBJECT_DATA(s)->kind))
+		return false;
+
+	stringobject_copychars((char *) data->val + data->len*stringobject_kindsize(data->kind), data->kind, s);
+	data->len += len;
+	return true;
+}
+
+// the builder can still be used after this, so the characters are copied
+static struct Object *build(struct Interpreter *interp, struct ObjectData thisdata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, NULL)) return NULL;
+	if (!check_no_opts(interp, opts)) return NULL;
+
+	struct StringBuilderObjectData *data = STRINGBUILDEROBJECT_DATA((struct Object *) thisdata.data);
+	return stringobject_newfromchars(interp, data->val, data->len, data->kind);
+}
+
+static bool clear(struct Interpreter *interp, struct ObjectData thisdata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, NULL)) return false;
+	if (!check_no_opts(interp, opts)) return false;
+
+	// the buffer is kept around for reusing it, and it's in bytes so the kind can start over
+	struct StringBuilderObjectData *data = STRINGBUILDEROBJECT_DATA((struct Object *) thisdata.data);
+	data->len = 0;
+	data->kind = 1;
+	return true;
+}
+
+static struct Object *length_getter(struct Interpreter *interp, struct ObjectData nulldata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, interp->builtins.StringBuilder, NULL)) return NULL;
+	if (!check_no_opts(interp, opts)) return NULL;
+	return integerobject_newfromlonglong(interp, STRINGBUILDEROBJECT_DATA(ARRAYOBJECT_GET(args, 0))->len);
+}
+
+struct Object *stringbuilderobject_createclass(struct Interpreter *interp)
+{
+	struct Object *klass = classobject_new(interp, "StringBuilder", interp->builtins.Object, newinstance);
+	if (!klass)
+		return NULL;
+
+	if (!attribute_add(interp, klass, "length", length_getter, NULL)) goto error;
+	if (!method_add_noret(interp, klass, "append", append)) goto error;
+	if (!method_add_yesret(interp, klass, "build", build)) goto error;
+	if (!method_add_noret(interp, klass, "clear", clear)) goto error;
+	return klass;
+
+error:
+	OBJECT_DECREF(interp, klass);
+	return NULL;
+}
@@ -0,0 +1,28 @@
+#ifndef OBJECTS_STRINGBUILDER_H
+#define OBJECTS_STRINGBUILDER_H
+
+#include <stddef.h>
+#include "../interpreter.h"    // IWYU pragma: keep
+#include "../objectsystem.h"   // IWYU pragma: keep
+#include "../unicode.h"        // IWYU pragma: keep
+
+/* a mutable buffer for building strings piece by piece
+
+adding strings together with + in a loop copies everything that has been
+added so far on every iteration, so it's O(n^2); appending to a StringBuilder
+is amortized O(1) per character because the buffer grows geometrically
+
+like strings, the buffer uses 1, 2 or 4 bytes for each character
+it starts with 1, and it's widened when a string with bigger characters is appended
+*/
+struct StringBuilderObjectData {
+	void *val;           // NULL if nothing has been allocated yet
+	size_t len;          // number of characters
+	size_t nallocated;   // number of bytes, not characters
+	int kind;            // 1, 2 or 4, the biggest kind of the appended strings
+};
+
+// RETURNS A NEW REFERENCE or NULL on error
+struct Object *stringbuilderobject_createclass(struct Interpreter *interp);
+
+#endif    // OBJECTS_STRINGBUILDER_H
@@ -6,6 +6,8 @@
 #include <stdlib.h>
 #include "allobjects.h"
 #include "interpreter.h"
+#include "stats.h"
+#include "objects/classobject.h"
 
 struct Object *object_new_noerr(struct Interpreter *interp, struct Object *klass, struct ObjectData objdata)
 {
@@ -35,6 +37,10 @@ struct Object *object_new_noerr(struct Interpreter *interp, struct Object *klass
 		return NULL;
 	}
 
+	interp->objectsallocated++;
+	STATS_UPDATEPEAK(interp);
+	if (klass)
+		STATS_CLASSINCR(klass, nallocated);
 	return obj;
 }
 
@@ -48,6 +54,11 @@ void object_free_impl(struct Interpreter *interp, struct Object *obj, bool calle
 	// the refcount is > 0 if this is called from gc.c, so don't assert anything about that
 
 	if (!calledfromgc) {
+		// gc_collect() counts the objects it frees, gc_run() runs at exit when the counts don't matter anymore
+		STATS_INCR(interp, objectsfreed);
+		if (obj->klass)
+			STATS_CLASSINCR(obj->klass, nfreed);
+
 		// decref other objects that obj references to
 		// gc_run() takes care of calling this for each object
 		if (obj->attrdata)
@@ -1,9 +1,11 @@
 #ifndef OBJECTSYSTEM_H
 #define OBJECTSYSTEM_H
 
+#include <limits.h>
 #include <stdbool.h>
 #include "interpreter.h"   // IWYU pragma: keep
 #include "atomicincrdecr.h"
+#include "stats.h"
 
 
 typedef void (*object_foreachrefcb)(struct Object *ref, void *cbdata);
@@ -56,10 +58,18 @@ struct Object {
 // RETURNS A NEW REFERENCE, i.e. refcount is set to 1
 struct Object *object_new_noerr(struct Interpreter *interp, struct Object *klass, struct ObjectData objdata);
 
+// objects with a refcount this big are frozen, see parallel.c
+// OBJECT_{IN,DE}CREF don't touch frozen objects, so forked processes don't write to memory pages shared with the parent
+#define OBJECT_FROZEN_REFCOUNT (LONG_MAX/2)
+
 // these never fail
-#define OBJECT_INCREF(interp, obj) do { ATOMIC_INCR((obj)->refcount); } while(0)
+#define OBJECT_INCREF(interp, obj) do { \
+	if ((obj)->refcount < OBJECT_FROZEN_REFCOUNT) \
+		ATOMIC_INCR((obj)->refcount); \
+	STATS_INCR((interp), increfs); \
+} while(0)
 #define OBJECT_DECREF(interp, obj) do { \
-	if (ATOMIC_DECR((obj)->refcount) <= 0) \
+	if ((obj)->refcount < OBJECT_FROZEN_REFCOUNT && ATOMIC_DECR((obj)->refcount) <= 0) \
 		object_free_impl((interp), (obj), false); \
 } while (0)
 
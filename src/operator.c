@@ -4,13 +4,15 @@
 #include "check.h"
 #include "interpreter.h"
 #include "objectsystem.h"
+#include "stats.h"
 #include "objects/array.h"
 #include "objects/bool.h"
+#include "objects/bytearray.h"
 #include "objects/classobject.h"
 #include "objects/errors.h"
 #include "objects/function.h"
 #include "objects/option.h"
-#include "unicode.h"
+#include "objects/string.h"
 
 #define class_name(obj) (((struct ClassObjectData *) (obj)->klass->objdata.data)->name)
 
@@ -30,6 +32,12 @@ struct Object *operator_call(struct Interpreter *interp, enum Operator op, struc
 		return boolobject_get(interp, val1||val2);
 	}
 
+	if (op == OPERATOR_EQ) {
+		int res = stringobject_fasteq(interp, lhs, rhs);
+		if (res >= 0)
+			return boolobject_get(interp, res);
+	}
+
 	// these can be implemented with other stuff by flipping lhs and rhs
 	if (op == OPERATOR_GT)
 		return operator_call(interp, OPERATOR_LT, rhs, lhs);
@@ -64,6 +72,22 @@ struct Object *operator_call(struct Interpreter *interp, enum Operator op, struc
 		if (!check_type(interp, interp->builtins.Function, func))
 			return NULL;
 
+		/*
+		if nothing but the caller has a reference to lhs, then lhs is a temporary
+		object like the result of (a + b) in ((a + b) + c), and modifying it
+		in-place can't be noticed from anywhere, so (((a + b) + c) + d) is linear
+		this is done only when the built-in ByteArray add is the first function that would handle it
+		*/
+		if (op == OPERATOR_ADD) {
+			int fast = bytearrayobject_fastadd(interp, func, lhs, rhs);
+			if (fast < 0)
+				return NULL;
+			if (fast > 0) {
+				OBJECT_INCREF(interp, lhs);
+				return lhs;
+			}
+		}
+
 		struct Object *res = functionobject_call_yesret(interp, func, lhs, rhs, NULL);
 		if (!res)
 			return NULL;
@@ -76,6 +100,7 @@ struct Object *operator_call(struct Interpreter *interp, enum Operator op, struc
 
 		if (res == interp->builtins.none) {
 			OBJECT_DECREF(interp, res);
+			STATS_INCR(interp, oparrayfallthroughs);
 			continue;
 		}
 
@@ -98,19 +123,7 @@ int operator_eqint(struct Interpreter *interp, struct Object *lhs, struct Object
 		assert(lhs->klass == interp->builtins.String);
 		assert(rhs->klass == interp->builtins.String);
 
-		struct UnicodeString *astr = lhs->objdata.data;
-		struct UnicodeString *bstr = rhs->objdata.data;
-
-		if (astr->len != bstr->len)
-			return 0;
-
-		// memcmp isn't reliable :( grep for memcmp in the source for detailz
-		for (size_t i=0; i < astr->len; ++i)
-		{
-			if (astr->val[i]!=bstr->val[i])
-			 return 0;
-		}
-		return 1;
+		return stringobject_equal(lhs, rhs);
 	}
 
 	struct Object *res = operator_call(interp, OPERATOR_EQ, lhs, rhs);
@@ -20,6 +20,7 @@ enum Operator {
 };
 
 // implementation of "(lhs OPERATOR rhs)"
+// if lhs->refcount is 1, the caller's reference must be the only reference, and lhs may be modified in-place
 // returns NULL or a new reference
 struct Object *operator_call(struct Interpreter *interp, enum Operator op, struct Object *lhs, struct Object *rhs);
 
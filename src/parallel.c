@@ -0,0 +1,355 @@
+#include "parallel.h"
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "allobjects.h"
+#include "check.h"
+#include "interpreter.h"
+#include "objectsystem.h"
+#include "serialize.h"
+#include "threads.h"
+#include "objects/array.h"
+#include "objects/errors.h"
+#include "objects/function.h"
+#include "objects/integer.h"
+
+// workers write their results in pieces of about this size, so that the parent can read while they work
+// the parent also reads this much at a time
+#define CHUNK_SIZE 65536
+
+struct Worker {
+	pid_t pid;      // 0 if the process hasn't been started or it has been waited for
+	int fd;         // read end of the pipe, -1 when closed
+	size_t start, end;     // the worker maps items start, start+1, ..., end-1
+	int status;     // from waitpid()
+	unsigned char *output;
+	size_t outputlen, outputnallocated;
+};
+
+
+/*
+the parent must not run any ö code or create or destroy objects between freezing and thawing,
+because objects created after freezing would be holding references that freezing doesn't count
+
+thawing happens after all workers have exited, so that the parent doesn't write to shared pages either
+*/
+static void freeze(struct Interpreter *interp)
+{
+	struct AllObjectsIter iter = allobjects_iterbegin(interp->allobjects);
+	while (allobjects_iternext(&iter))
+		iter.obj->refcount += OBJECT_FROZEN_REFCOUNT;
+}
+
+static void thaw(struct Interpreter *interp)
+{
+	struct AllObjectsIter iter = allobjects_iterbegin(interp->allobjects);
+	while (allobjects_iternext(&iter))
+		iter.obj->refcount -= OBJECT_FROZEN_REFCOUNT;
+}
+
+
+static bool write_all(int fd, const unsigned char *data, size_t len)
+{
+	while (len > 0) {
+		ssize_t n = write(fd, data, len);
+		if (n < 0) {
+			if (errno == EINTR)
+				continue;
+			return false;
+		}
+		data += n;
+		len -= (size_t)n;
+	}
+	return true;
+}
+
+// runs in the worker process, returns an exit status
+// results are [true val] or [false errorclassname errormessage] from threads_dumpresult()
+static int run_worker(struct Interpreter *interp, struct Object *func, struct Object *items, size_t start, size_t end, int fd)
+{
+	struct SerializeBuf buf = {0};
+	for (size_t i = start; i < end; i++) {
+		struct Object *res = functionobject_call_yesret(interp, func, ARRAYOBJECT_GET(items, i), NULL);
+		bool ok = threads_dumpresult(interp, NULL, res, &buf, false);
+		if (res)
+			OBJECT_DECREF(interp, res);
+		if (!ok) {
+			errorobject_print(interp, interp->err);
+			return 1;
+		}
+		if (!res)
+			break;   // the parent throws the error, no need to map the rest
+
+		if (buf.len >= CHUNK_SIZE) {
+			if (!write_all(fd, buf.data, buf.len))
+				return 1;
+			buf.len = 0;
+		}
+	}
+
+	// no need to free anything, the process exits soon
+	return write_all(fd, buf.data, buf.len) ? 0 : 1;
+}
+
+// closes the pipes and waits for the workers, never fails
+static void wait_workers(struct Worker *workers, size_t nworkers, bool kill_them)
+{
+	for (size_t i = 0; i < nworkers; i++) {
+		if (workers[i].fd != -1) {
+			close(workers[i].fd);
+			workers[i].fd = -1;
+		}
+		if (workers[i].pid == 0)
+			continue;
+
+		if (kill_them)
+			kill(workers[i].pid, SIGKILL);
+		while (waitpid(workers[i].pid, &workers[i].status, 0) == -1 && errno == EINTR)
+			;
+		workers[i].pid = 0;
+	}
+}
+
+// returns false and sets errno on error, which the caller must throw after thawing
+static bool start_workers(struct Interpreter *interp, struct Object *func, struct Object *items, struct Worker *workers, size_t nworkers)
+{
+	// otherwise anything buffered would be printed once by each process
+	fflush(NULL);
+
+	for (size_t i = 0; i < nworkers; i++) {
+		int fds[2];
+		if (pipe(fds) != 0)
+			return false;
+
+		pid_t pid = fork();
+		if (pid == -1) {
+			int fork_errno = errno;
+			close(fds[0]);
+			close(fds[1]);
+			errno = fork_errno;
+			return false;
+		}
+
+		if (pid == 0) {
+			// pipes of other workers belong to the parent
+			for (size_t j = 0; j < i; j++)
+				close(workers[j].fd);
+			close(fds[0]);
+
+			int status = run_worker(interp, func, items, workers[i].start, workers[i].end, fds[1]);
+			fflush(NULL);
+			_exit(status);   // not exit(), atexit stuff belongs to the parent
+		}
+
+		close(fds[1]);
+		workers[i].pid = pid;
+		workers[i].fd = fds[0];
+	}
+	return true;
+}
+
+// reads from all workers at once, so that a worker with lots of output doesn't block others
+// returns false on no mem, and then the rest of the output is not read
+static bool read_outputs(struct Worker *workers, size_t nworkers)
+{
+	struct pollfd *pfds = malloc(nworkers * sizeof pfds[0]);
+	if (!pfds)
+		return false;
+
+	while (true) {
+		bool anyopen = false;
+		for (size_t i = 0; i < nworkers; i++) {
+			// poll() ignores negative fds
+			pfds[i].fd = workers[i].fd;
+			pfds[i].events = POLLIN;
+			pfds[i].revents = 0;
+			if (workers[i].fd != -1)
+				anyopen = true;
+		}
+		if (!anyopen)
+			break;
+
+		if (poll(pfds, nworkers, -1) == -1) {
+			if (errno == EINTR)
+				continue;
+			break;    // should never happen, treat it like all workers closed their pipes
+		}
+
+		for (size_t i = 0; i < nworkers; i++) {
+			if (!pfds[i].revents)
+				continue;
+
+			struct Worker *w = &workers[i];
+			if (w->outputnallocated - w->outputlen < CHUNK_SIZE) {
+				size_t newsize = w->outputnallocated*2 + CHUNK_SIZE;
+				unsigned char *ptr = realloc(w->output, newsize);
+				if (!ptr) {
+					free(pfds);
+					return false;
+				}
+				w->output = ptr;
+				w->outputnallocated = newsize;
+			}
+
+			ssize_t n = read(w->fd, w->output + w->outputlen, CHUNK_SIZE);
+			if (n > 0)
+				w->outputlen += (size_t)n;
+			else if (n == 0 || errno != EINTR) {
+				close(w->fd);
+				w->fd = -1;
+			}
+		}
+	}
+
+	free(pfds);
+	return true;
+}
+
+// appends the results of a worker to res, throws an error from the worker if it threw
+static bool load_results(struct Interpreter *interp, struct Worker *w, struct Object *res)
+{
+	size_t pos = 0;
+	for (size_t i = w->start; i < w->end; i++) {
+		if (pos == w->outputlen) {
+			// shouldn't happen, check_status() catches workers that didn't send everything
+			errorobject_throwfmt(interp, "ValueError", "a worker process failed");
+			return false;
+		}
+
+		struct Object *result = serialize_load(interp, w->output, w->outputlen, &pos);
+		if (!result)
+			return false;
+
+		if (ARRAYOBJECT_GET(result, 0) == interp->builtins.no) {
+			threads_throwlike(interp, ARRAYOBJECT_GET(result, 1), ARRAYOBJECT_GET(result, 2));
+			OBJECT_DECREF(interp, result);
+			return false;
+		}
+
+		bool ok = arrayobject_push(interp, res, ARRAYOBJECT_GET(result, 1));
+		OBJECT_DECREF(interp, result);
+		if (!ok)
+			return false;
+	}
+	return true;
+}
+
+static bool check_status(struct Interpreter *interp, int status)
+{
+	if (WIFSIGNALED(status)) {
+		errorobject_throwfmt(interp, "ValueError", "a worker process was killed by signal %L", (long long)WTERMSIG(status));
+		return false;
+	}
+	if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+		errorobject_throwfmt(interp, "ValueError", "a worker process failed");
+		return false;
+	}
+	return true;
+}
+
+struct Object *parallel_map(struct Interpreter *interp, struct ObjectData nulldata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, interp->builtins.Function, interp->builtins.Array, interp->builtins.Integer, interp->builtins.Bool, NULL)) return NULL;
+	if (!check_no_opts(interp, opts)) return NULL;
+
+	struct Object *func = ARRAYOBJECT_GET(args, 0);
+	struct Object *arr = ARRAYOBJECT_GET(args, 1);
+	long long nworkers = integerobject_tolonglong(ARRAYOBJECT_GET(args, 2));
+	bool dofreeze = (ARRAYOBJECT_GET(args, 3) == interp->builtins.yes);
+
+	if (nworkers <= 0) {
+		errorobject_throwfmt(interp, "ArgError", "workers must be positive, got %L", nworkers);
+		return NULL;
+	}
+	if (!functionobject_getcfunc(func).returning) {
+		errorobject_throwfmt(interp, "TypeError", "expected a returning function, got %D", func);
+		return NULL;
+	}
+
+	size_t len = ARRAYOBJECT_LEN(arr);
+	if (len == 0)
+		return arrayobject_newempty(interp);
+	if ((unsigned long long)nworkers > len)
+		nworkers = (long long)len;
+
+	// the function may modify the array in the workers, and workers shouldn't see items shifting around
+	struct Object *items = arrayobject_slice(interp, arr, 0, (long long)len);
+	if (!items)
+		return NULL;
+
+	struct Object *res = NULL;
+	struct Worker *workers = calloc(nworkers, sizeof workers[0]);
+	if (!workers) {
+		errorobject_thrownomem(interp);
+		goto out;
+	}
+	for (size_t i = 0; i < (size_t)nworkers; i++) {
+		workers[i].fd = -1;
+		workers[i].start = len*i / nworkers;
+		workers[i].end = len*(i+1) / nworkers;
+	}
+
+	// in a worker of another parallel_map(), the objects may be frozen already
+	// everything is frozen at once, so any object that existed before forking tells whether they are
+	if (dofreeze && interp->builtins.none->refcount >= OBJECT_FROZEN_REFCOUNT)
+		dofreeze = false;
+	if (dofreeze)
+		freeze(interp);
+	bool started = start_workers(interp, func, items, workers, nworkers);
+	int start_errno = errno;
+	bool readok = started && read_outputs(workers, nworkers);
+	wait_workers(workers, nworkers, !readok);
+	if (dofreeze)
+		thaw(interp);
+
+	if (!started) {
+		errorobject_throwfmt(interp, "ValueError", "cannot start a worker process: %s", strerror(start_errno));
+		goto out;
+	}
+	if (!readok) {
+		errorobject_thrownomem(interp);
+		goto out;
+	}
+	for (size_t i = 0; i < (size_t)nworkers; i++) {
+		if (!check_status(interp, workers[i].status))
+			goto out;
+	}
+
+	if (!(res = arrayobject_newwithcapacity(interp, len)))
+		goto out;
+	for (size_t i = 0; i < (size_t)nworkers; i++) {
+		if (!load_results(interp, &workers[i], res)) {
+			OBJECT_DECREF(interp, res);
+			res = NULL;
+			goto out;
+		}
+	}
+
+out:
+	if (workers) {
+		for (size_t i = 0; i < (size_t)nworkers; i++)
+			free(workers[i].output);
+		free(workers);
+	}
+	OBJECT_DECREF(interp, items);
+	return res;
+}
+
+struct Object *parallel_cpu_count(struct Interpreter *interp, struct ObjectData nulldata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, NULL)) return NULL;
+	if (!check_no_opts(interp, opts)) return NULL;
+
+	long n = sysconf(_SC_NPROCESSORS_ONLN);
+	if (n < 1)
+		n = 1;    // not known
+	return integerobject_newfromlonglong(interp, n);
+}
@@ -0,0 +1,23 @@
+// running a function for many values in forked processes, see std/parallel.ö
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include "interpreter.h"     // IWYU pragma: keep
+#include "objectsystem.h"    // IWYU pragma: keep
+
+/* built-in functions that std/parallel.ö deletes from the built-in scope
+
+parallel_map takes a Function, an Array, an Integer number of worker processes and a Bool for freezing
+it forks the worker processes, and each of them calls the function for a contiguous chunk of the array
+results come back through pipes, serialized with serialize_dump_nochannels()
+the return value is an Array of the results in the same order as the items
+
+if freezing is true, every object of the interpreter is frozen while the workers run (see OBJECT_FROZEN_REFCOUNT)
+then refcount changes in the workers don't make the kernel copy memory pages shared with the parent process
+
+parallel_cpu_count returns the number of online CPUs as an Integer
+*/
+struct Object *parallel_map(struct Interpreter *interp, struct ObjectData nulldata, struct Object *args, struct Object *opts);
+struct Object *parallel_cpu_count(struct Interpreter *interp, struct ObjectData nulldata, struct Object *args, struct Object *opts);
+
+#endif    // PARALLEL_H
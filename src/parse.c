@@ -13,6 +13,7 @@
 #include "operator.h"
 #include "tokenizer.h"
 #include "unicode.h"
+#include "utf8.h"
 #include "objects/array.h"
 #include "objects/astnode.h"
 #include "objects/errors.h"
@@ -24,8 +25,6 @@
 // this never fails
 static bool expression_coming_up(struct Token *curtok)
 {
-	if (!curtok)
-		return false;
 	if (curtok->kind == TOKEN_STR || curtok->kind == TOKEN_INT || curtok->kind == TOKEN_ID)
 		return true;
 	if (curtok->kind == TOKEN_OP)
@@ -44,47 +43,63 @@ static bool expression_coming_up(struct Token *curtok)
 static struct Object *parse_string(struct Interpreter *interp, char *filename, struct Token **curtok)
 {
 	// these should be checked by the caller
-	assert(*curtok);
 	assert((*curtok)->kind == TOKEN_STR);
 
-	// tokenizer.c makes sure that the escapes are valid, so there's no need to keep track of the source length
-	unicode_char *src = (*curtok)->str.val;
+	// the token includes a " on both sides, and it points to the utf8 source code
+	struct TokenString content = (*curtok)->str;
+	content.val++;
+	content.len -= 2;
 
-	// the new string's length is never more than (*curtok)->str.len - 2
-	// because (*curtok)->str.len includes a " in both sides
-	// and 2-character escape sequences represent 1 character in the string
-	// e.g. \n (2 characters) represents a newline (1 character)
-	// so length of a \n representation is bigger than length of a string with newlines
-	unicode_char *dst = malloc(sizeof(unicode_char) * ((*curtok)->str.len - 2));
-	if (!dst) {
-		errorobject_thrownomem(interp);
-		return NULL;
-	}
-	size_t dstlen = 0;
-
-	// skip initial "
-	src++;
-
-	while (*src != '"') {
-		if (*src == '\\') {
-			src++;
-			if (*src == 'n')
-				dst[dstlen++] = '\n';
-			else if (*src == 't')
-				dst[dstlen++] = '\t';
-			else if (*src == '\\')
-				dst[dstlen++] = '\\';
-			else if (*src == '"')
-				dst[dstlen++] = '"';
-			else
-				assert(0);
-			src++;
-		} else {
-			dst[dstlen++] = *src++;
+	bool hasescapes = false;
+	for (size_t i=0; i < content.len; i++) {
+		if (content.val[i] == '\\') {
+			hasescapes = true;
+			break;
 		}
 	}
 
-	struct Object *info = stringobject_newfromustr(interp, (struct UnicodeString) { .len = dstlen, .val = dst });
+	struct Object *info;
+	if (!hasescapes) {
+		// most string literals don't contain escapes, and they can be decoded as is
+		info = stringobject_newfromutf8(interp, content.val, content.len);
+	} else {
+		// tokenizer.c makes sure that the escapes are valid, so there's no need to keep track of the source length
+		char *src = content.val;
+
+		// the new string's length is never more than content.len
+		// because 2-byte escape sequences represent 1 byte in the string
+		// e.g. \n (2 bytes) represents a newline (1 byte)
+		// the escapes are ascii, so other bytes (including utf8 continuation bytes) are copied as is
+		// content.len isn't 0 because there's at least one escape
+		char *dst = malloc(content.len);
+		if (!dst) {
+			errorobject_thrownomem(interp);
+			return NULL;
+		}
+		size_t dstlen = 0;
+
+		while (src != content.val + content.len) {
+			if (*src == '\\') {
+				src++;
+				if (*src == 'n')
+					dst[dstlen++] = '\n';
+				else if (*src == 't')
+					dst[dstlen++] = '\t';
+				else if (*src == '\\')
+					dst[dstlen++] = '\\';
+				else if (*src == '"')
+					dst[dstlen++] = '"';
+				else
+					assert(0);
+				src++;
+			} else {
+				dst[dstlen++] = *src++;
+			}
+		}
+
+		info = stringobject_newfromutf8(interp, dst, dstlen);
+		free(dst);
+	}
 	if (!info)
 		return NULL;
 
@@ -94,7 +109,7 @@ static struct Object *parse_string(struct Interpreter *interp, char *filename, s
 		return NULL;
 	}
 
-	*curtok = (*curtok)->next;
+	(*curtok)++;
 	return res;
 }
 
@@ -102,10 +117,14 @@ static struct Object *parse_string(struct Interpreter *interp, char *filename, s
 // 123, -456
 static struct Object *parse_int(struct Interpreter *interp, char *filename, struct Token **curtok)
 {
-	assert(*curtok);
 	assert((*curtok)->kind == TOKEN_INT);
 
-	struct Object *info = integerobject_newfromustr(interp, (*curtok)->str);
+	// tokenizer.c makes sure that this is nothing but ascii digits
+	struct UnicodeString digits;
+	if (!utf8_decode(interp, (*curtok)->str.val, (*curtok)->str.len, &digits))
+		return NULL;
+	struct Object *info = integerobject_newfromustr(interp, digits);
+	free(digits.val);
 	if (!info)
 		return NULL;
 
@@ -115,7 +134,7 @@ static struct Object *parse_int(struct Interpreter *interp, char *filename, stru
 		return NULL;
 	}
 
-	*curtok = (*curtok)->next;
+	(*curtok)++;
 	return res;
 }
 
@@ -123,14 +142,13 @@ static struct Object *parse_int(struct Interpreter *interp, char *filename, stru
 // x
 static struct Object *parse_getvar(struct Interpreter *interp, char *filename, struct Token **curtok)
 {
-	assert(*curtok);
 	assert((*curtok)->kind == TOKEN_ID);
 
 	struct AstGetVarInfo *info = malloc(sizeof(struct AstGetVarInfo));
 	if (!info)
 		return NULL;
 
-	if (!(info->varname = stringobject_newfromustr_copy(interp, (*curtok)->str))) {
+	if (!(info->varname = stringobject_newfromutf8(interp, (*curtok)->str.val, (*curtok)->str.len))) {
 		free(info);
 		return NULL;
 	}
@@ -142,7 +160,7 @@ static struct Object *parse_getvar(struct Interpreter *interp, char *filename, s
 		return NULL;
 	}
 
-	*curtok = (*curtok)->next;
+	(*curtok)++;
 	return res;
 }
 
@@ -174,14 +192,14 @@ static struct Object *parse_call(struct Interpreter *interp, char *filename, str
 	OBJECT_INCREF(interp, funcnode);
 
 	while (expression_coming_up(*curtok)) {
-		if ((*curtok)->kind == TOKEN_ID && (*curtok)->next &&
-			(*curtok)->next->kind == TOKEN_OP && (*curtok)->next->str.len == 1 && (*curtok)->next->str.val[0] == ':')
+		if ((*curtok)->kind == TOKEN_ID &&
+			(*curtok)[1].kind == TOKEN_OP && (*curtok)[1].str.len == 1 && (*curtok)[1].str.val[0] == ':')
 		{
 			// opt:val
-			struct Object *optstr = stringobject_newfromustr_copy(interp, (*curtok)->str);
+			struct Object *optstr = stringobject_newfromutf8(interp, (*curtok)->str.val, (*curtok)->str.len);
 			if (!optstr)
 				goto error;
-			*curtok = (*curtok)->next->next;    // skip opt and :
+			*curtok += 2;    // skip opt and :
 
 			struct Object *valnode = parse_expression(interp, filename, curtok);
 			if (!valnode) {
@@ -232,8 +250,8 @@ static struct Object *parse_operator_call(struct Interpreter *interp, char *file
 	size_t lineno = (*curtok)->lineno;
 
 	assert((*curtok)->kind == TOKEN_OP);
-	struct UnicodeString op = (*curtok)->str;
-	*curtok = (*curtok)->next;
+	struct TokenString op = (*curtok)->str;
+	(*curtok)++;
 
 	struct Object *rhs = parse_expression(interp, filename, curtok);
 	if (!rhs)
@@ -297,7 +315,7 @@ static struct Object *parse_infix_call(struct Interpreter *interp, char *filenam
 
 	// this SHOULD be checked by parse_expression()
 	assert((*curtok)->str.len == 1 && (*curtok)->str.val[0] == '`');
-	*curtok = (*curtok)->next;
+	(*curtok)++;
 
 	struct Object *func = parse_expression(interp, filename, curtok);
 	if (!func)
@@ -307,7 +325,7 @@ static struct Object *parse_infix_call(struct Interpreter *interp, char *filenam
 		// TODO: report error "expected another `"
 		assert(0);
 	}
-	*curtok = (*curtok)->next;
+	(*curtok)++;
 
 	struct Object *arg2 = parse_expression(interp, filename, curtok);
 	if (!arg2) {
@@ -360,7 +378,7 @@ static struct Object *parse_call_expression(struct Interpreter *interp, char *fi
 {
 	// this SHOULD be checked by parse_expression()
 	assert((*curtok)->str.len == 1 && (*curtok)->str.val[0] == '(');
-	*curtok = (*curtok)->next;
+	(*curtok)++;
 
 	struct Object *first = parse_expression(interp, filename, curtok);
 	if (!first)
@@ -383,7 +401,7 @@ static struct Object *parse_call_expression(struct Interpreter *interp, char *fi
 
 	// TODO: report error "missing ')'"
 	assert((*curtok)->str.len == 1 && (*curtok)->str.val[0] == ')');
-	*curtok = (*curtok)->next;
+	(*curtok)++;
 
 	return res;
 }
@@ -392,19 +410,18 @@ static struct Object *parse_call_expression(struct Interpreter *interp, char *fi
 // [a b c]
 static struct Object *parse_array(struct Interpreter *interp, char *filename, struct Token **curtok)
 {
-	assert(*curtok);
 	assert((*curtok)->kind == TOKEN_OP);
 	assert((*curtok)->str.len == 1);
 	assert((*curtok)->str.val[0] == '[');
 	size_t lineno = (*curtok)->lineno;
-	*curtok = (*curtok)->next;
-	assert(*curtok);    // TODO: report error "unexpected end of file"
+	(*curtok)++;
+	assert((*curtok)->kind != TOKEN_END);    // TODO: report error "unexpected end of file"
 
 	struct Object *elements = arrayobject_newempty(interp);
 	if (!elements)
 		return NULL;
 
-	while ((*curtok) && !((*curtok)->kind == TOKEN_OP && (*curtok)->str.len == 1 && (*curtok)->str.val[0] == ']')) {
+	while ((*curtok)->kind != TOKEN_END && !((*curtok)->kind == TOKEN_OP && (*curtok)->str.len == 1 && (*curtok)->str.val[0] == ']')) {
 		struct Object *elem = parse_expression(interp, filename, curtok);
 		if(!elem) {
 			OBJECT_DECREF(interp, elements);
@@ -418,9 +435,9 @@ static struct Object *parse_array(struct Interpreter *interp, char *filename, st
 		}
 	}
 
-	assert(*curtok);   // TODO: report error "unexpected end of file"
+	assert((*curtok)->kind != TOKEN_END);   // TODO: report error "unexpected end of file"
 	assert((*curtok)->str.len == 1 && (*curtok)->str.val[0] == ']');
-	*curtok = (*curtok)->next;   // skip ']'
+	(*curtok)++;   // skip ']'
 
 	struct Object *res = astnodeobject_new(interp, AST_ARRAY, filename, lineno, elements);
 	if (!res) {
@@ -494,13 +511,12 @@ static struct Object *create_return_call(struct Interpreter *interp, struct Obje
 // { ... }
 static struct Object *parse_block(struct Interpreter *interp, char *filename, struct Token **curtok)
 {
-	assert(*curtok);
 	assert((*curtok)->kind == TOKEN_OP);
 	assert((*curtok)->str.len == 1);
 	assert((*curtok)->str.val[0] == '{');
 	size_t lineno = (*curtok)->lineno;
-	*curtok = (*curtok)->next;
-	assert(*curtok);    // TODO: report error "unexpected end of file"
+	(*curtok)++;
+	assert((*curtok)->kind != TOKEN_END);    // TODO: report error "unexpected end of file"
 
 	// figure out whether it contains a semicolon before }
 	// if not, this is an implicit return: { expr } is same as { return expr; }
@@ -515,7 +531,7 @@ static struct Object *parse_block(struct Interpreter *interp, char *filename, st
 		unsigned int bracecount = 1;
 		bool foundit = false;
 
-		for (struct Token *futtok = *curtok; futtok; futtok = futtok->next) {
+		for (struct Token *futtok = *curtok; futtok->kind != TOKEN_END; futtok++) {
 			if (futtok->kind != TOKEN_OP || futtok->str.len != 1)
 				continue;
 			if (futtok->str.val[0] == ';' && bracecount == 1) {
@@ -563,7 +579,7 @@ static struct Object *parse_block(struct Interpreter *interp, char *filename, st
 			return NULL;
 		}
 	} else {
-		while ((*curtok) && !((*curtok)->kind == TOKEN_OP && (*curtok)->str.len == 1 && (*curtok)->str.val[0] == '}')) {
+		while ((*curtok)->kind != TOKEN_END && !((*curtok)->kind == TOKEN_OP && (*curtok)->str.len == 1 && (*curtok)->str.val[0] == '}')) {
 			struct Object *stmt = parse_statement(interp, filename, curtok);
 			if (!stmt) {
 				OBJECT_DECREF(interp, statements);
@@ -578,9 +594,9 @@ static struct Object *parse_block(struct Interpreter *interp, char *filename, st
 		}
 	};
 
-	assert(*curtok);   // TODO: report error "unexpected end of file"
+	assert((*curtok)->kind != TOKEN_END);   // TODO: report error "unexpected end of file"
 	assert((*curtok)->str.len == 1 && (*curtok)->str.val[0] == '}');
-	*curtok = (*curtok)->next;   // skip ']'
+	(*curtok)++;   // skip ']'
 
 	struct Object *res = astnodeobject_new(interp, AST_BLOCK, filename, lineno, statements);
 	if (!res) {
@@ -605,12 +621,12 @@ struct Object *parse_attribute(struct Interpreter *interp, char *filename, struc
 	getattrinfo->objnode = attrofwhat;
 	OBJECT_INCREF(interp, attrofwhat);
 
-	if (!(getattrinfo->name = stringobject_newfromustr_copy(interp, (*curtok)->str))) {
+	if (!(getattrinfo->name = stringobject_newfromutf8(interp, (*curtok)->str.val, (*curtok)->str.len))) {
 		OBJECT_DECREF(interp, attrofwhat);
 		free(getattrinfo);
 		return NULL;
 	}
-	*curtok = (*curtok)->next;
+	(*curtok)++;
 
 	struct Object *getattr = astnodeobject_new(interp, AST_GETATTR, filename, lineno, getattrinfo);
 	if(!getattr) {
@@ -629,7 +645,7 @@ struct Object *parse_dotparen_method_call(struct Interpreter *interp, char *file
 {
 	// this should be checked by the caller
 	assert((*curtok)->kind == TOKEN_OP && (*curtok)->str.len == 1 && (*curtok)->str.val[0] == '(');
-	*curtok = (*curtok)->next;
+	(*curtok)++;
 
 	struct Object *getattr = parse_attribute(interp, filename, curtok, methodofwhat);
 	if (!getattr)
@@ -642,7 +658,7 @@ struct Object *parse_dotparen_method_call(struct Interpreter *interp, char *file
 
 	// TODO: report error "missing ')'"
 	assert((*curtok)->str.len == 1 && (*curtok)->str.val[0] == ')');
-	*curtok = (*curtok)->next;
+	(*curtok)++;
 
 	return call;
 }
@@ -683,9 +699,9 @@ struct Object *parse_expression(struct Interpreter *interp, char *filename, stru
 		return NULL;
 
 	// attributes and .( method calls
-	while ((*curtok) && (*curtok)->kind == TOKEN_OP && (*curtok)->str.len == 1 && (*curtok)->str.val[0] == '.') {
-		*curtok = (*curtok)->next;           // skip '.'
-		assert((*curtok));     // TODO: report error "expected an attribute name or (, but the file ended"
+	while ((*curtok)->kind == TOKEN_OP && (*curtok)->str.len == 1 && (*curtok)->str.val[0] == '.') {
+		(*curtok)++;           // skip '.'
+		assert((*curtok)->kind != TOKEN_END);     // TODO: report error "expected an attribute name or (, but the file ended"
 
 		struct Object *res2;
 		if ((*curtok)->kind == TOKEN_OP && (*curtok)->str.len == 1 && (*curtok)->str.val[0] == '(')
@@ -713,21 +729,21 @@ static struct Object *parse_var_statement(struct Interpreter *interp, char *file
 	assert((*curtok)->str.val[0] == 'v');
 	assert((*curtok)->str.val[1] == 'a');
 	assert((*curtok)->str.val[2] == 'r');
-	*curtok = (*curtok)->next;
+	(*curtok)++;
 
 	// TODO: report error
 	assert((*curtok)->kind == TOKEN_ID);
 
-	struct Object *varname = stringobject_newfromustr_copy(interp, (*curtok)->str);
+	struct Object *varname = stringobject_newfromutf8(interp, (*curtok)->str.val, (*curtok)->str.len);
 	if (!varname)
 		return NULL;
-	*curtok = (*curtok)->next;
+	(*curtok)++;
 
 	// TODO: should 'var x;' set x to null? or just be forbidden?
 	assert((*curtok)->kind == TOKEN_OP);
 	assert((*curtok)->str.len == 1);
 	assert((*curtok)->str.val[0] == '=');
-	*curtok = (*curtok)->next;
+	(*curtok)++;
 
 	struct Object *value = parse_expression(interp, filename, curtok);
 	if (!value) {
@@ -769,7 +785,7 @@ static struct Object *parse_assignment(struct Interpreter *interp, char *filenam
 	// these should be checked by the caller
 	assert((*curtok)->str.len == 1);
 	assert((*curtok)->str.val[0] == '=');
-	*curtok = (*curtok)->next;
+	(*curtok)++;
 
 	struct Object *rhs = parse_expression(interp, filename, curtok);
 	if (!rhs)
@@ -848,6 +864,6 @@ struct Object *parse_statement(struct Interpreter *interp, char *filename, struc
 	assert((*curtok)->kind == TOKEN_OP);
 	assert((*curtok)->str.len == 1);
 	assert((*curtok)->str.val[0] == ';');
-	*curtok = (*curtok)->next;
+	(*curtok)++;
 	return res;
 }
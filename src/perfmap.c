@@ -0,0 +1,320 @@
+// mmap() with MAP_ANONYMOUS and getpid(), perf map files are linux-only anyway
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+#include "perfmap.h"
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "interpreter.h"
+#include "lambdabuiltin.h"
+#include "objects/errors.h"
+#include "objects/string.h"
+#include "objectsystem.h"
+
+#if defined(__linux__) && (defined(__x86_64__) || defined(__aarch64__))
+#define SUPPORTED
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#ifdef SUPPORTED
+
+/*
+a trampoline is called like trampoline(interp, data, NULL, func), and it calls func(interp, data)
+it creates a stack frame, so that perf's frame pointer unwinding sees it between the C functions
+the NULL is unused, it's there just to get func in the 4th argument register
+*/
+typedef void (*trampoline_t)(struct Interpreter *, void *, void *, perfmap_func);
+
+#if defined(__x86_64__)
+static const unsigned char trampoline_code[] = {
+	0x55,                 // push %rbp
+	0x48, 0x89, 0xe5,     // mov %rsp,%rbp
+	0xff, 0xd1,           // call *%rcx
+	0x5d,                 // pop %rbp
+	0xc3,                 // ret
+};
+#else
+static const unsigned char trampoline_code[] = {
+	0xfd, 0x7b, 0xbf, 0xa9,   // stp x29, x30, [sp, #-16]!
+	0xfd, 0x03, 0x00, 0x91,   // mov x29, sp
+	0x60, 0x00, 0x3f, 0xd6,   // blr x3
+	0xfd, 0x7b, 0xc1, 0xa8,   // ldp x29, x30, [sp], #16
+	0xc0, 0x03, 0x5f, 0xd6,   // ret
+};
+#endif
+
+// each trampoline gets this many bytes, more than the code needs so that they are nicely aligned
+#define TRAMPOLINE_SIZE 32
+#define CHUNK_SIZE (64*1024)
+
+// trampolines are allocated in chunks that are filled with copies of trampoline_code when created
+// nothing is written to a chunk after it's made executable, so code is never writable and executable at once
+struct Chunk {
+	unsigned char *mem;
+	size_t used;   // number of bytes given to functions
+	struct Chunk *next;
+};
+
+// functions are identified like in profiler.c
+struct PerfMapEntry {
+	struct Object *name;
+	char *filename;    // NULL if the function isn't from ö code
+	size_t lineno;
+	unsigned long hash;
+	trampoline_t trampoline;
+	struct PerfMapEntry *next;
+};
+
+#endif   // SUPPORTED
+
+#define NBUCKETS 1024
+
+struct PerfMap {
+#ifdef SUPPORTED
+	struct PerfMapEntry *buckets[NBUCKETS];
+	struct Chunk *chunks;   // the first chunk is the one being used
+#endif
+	FILE *file;
+};
+
+
+bool perfmap_start(struct Interpreter *interp)
+{
+#ifndef SUPPORTED
+	fprintf(stderr, "%s: perf map files are supported only on linux with x86_64 or aarch64\n", interp->argv0);
+	return false;
+#else
+	struct PerfMap *pm = calloc(1, sizeof(struct PerfMap));
+	if (!pm) {
+		fprintf(stderr, "%s: not enough memory\n", interp->argv0);
+		return false;
+	}
+
+	// perf looks for this file, many interpreters in the same process can append to it
+	char path[100];
+	sprintf(path, "/tmp/perf-%ld.map", (long)getpid());
+	if (!(pm->file = fopen(path, "a"))) {
+		fprintf(stderr, "%s: cannot open '%s': %s\n", interp->argv0, path, strerror(errno));
+		free(pm);
+		return false;
+	}
+
+	interp->perfmap = pm;
+	return true;
+#endif
+}
+
+void perfmap_stop(struct Interpreter *interp)
+{
+	struct PerfMap *pm = interp->perfmap;
+	interp->perfmap = NULL;
+
+#ifdef SUPPORTED
+	for (size_t i=0; i < NBUCKETS; i++) {
+		struct PerfMapEntry *e = pm->buckets[i];
+		while (e) {
+			struct PerfMapEntry *next = e->next;
+			OBJECT_DECREF(interp, e->name);
+			free(e->filename);
+			free(e);
+			e = next;
+		}
+	}
+
+	struct Chunk *c = pm->chunks;
+	while (c) {
+		struct Chunk *next = c->next;
+		munmap(c->mem, CHUNK_SIZE);
+		free(c);
+		c = next;
+	}
+#endif
+
+	fclose(pm->file);
+	free(pm);
+}
+
+bool perfmap_addentry(struct Interpreter *interp, const void *start, size_t size, const char *name)
+{
+	struct PerfMap *pm = interp->perfmap;
+
+	// flushing makes the entries available even if the program crashes
+	if (fprintf(pm->file, "%lx %zx %s\n", (unsigned long)(uintptr_t)start, size, name) < 0 || fflush(pm->file) != 0) {
+		fprintf(stderr, "%s: writing the perf map file failed: %s\n", interp->argv0, strerror(errno));
+		return false;
+	}
+	return true;
+}
+
+
+#ifdef SUPPORTED
+
+// returns NULL on error
+static struct Chunk *new_chunk(void)
+{
+	struct Chunk *c = malloc(sizeof(struct Chunk));
+	if (!c)
+		return NULL;
+
+	c->mem = mmap(NULL, CHUNK_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (c->mem == MAP_FAILED) {
+		free(c);
+		return NULL;
+	}
+
+	for (size_t off = 0; off + TRAMPOLINE_SIZE <= CHUNK_SIZE; off += TRAMPOLINE_SIZE)
+		memcpy(c->mem + off, trampoline_code, sizeof(trampoline_code));
+	__builtin___clear_cache((char *)c->mem, (char *)c->mem + CHUNK_SIZE);
+
+	if (mprotect(c->mem, CHUNK_SIZE, PROT_READ | PROT_EXEC) != 0) {
+		munmap(c->mem, CHUNK_SIZE);
+		free(c);
+		return NULL;
+	}
+
+	c->used = 0;
+	return c;
+}
+
+// throws an error and returns NULL on failure
+static trampoline_t new_trampoline(struct Interpreter *interp)
+{
+	struct PerfMap *pm = interp->perfmap;
+	if (!pm->chunks || pm->chunks->used + TRAMPOLINE_SIZE > CHUNK_SIZE) {
+		struct Chunk *c = new_chunk();
+		if (!c) {
+			errorobject_thrownomem(interp);
+			return NULL;
+		}
+		c->next = pm->chunks;
+		pm->chunks = c;
+	}
+
+	void *mem = pm->chunks->mem + pm->chunks->used;
+	pm->chunks->used += TRAMPOLINE_SIZE;
+
+	// iso c doesn't allow casting between data pointers and function pointers, but memcpy is fine
+	trampoline_t res;
+	memcpy(&res, &mem, sizeof(res));
+	return res;
+}
+
+static bool entry_matches(struct PerfMapEntry *e, unsigned long hash, struct Object *name, char *filename, size_t lineno)
+{
+	if (e->hash != hash || e->lineno != lineno)
+		return false;
+	if (!e->filename || !filename) {
+		if (e->filename != filename)
+			return false;
+	} else if (strcmp(e->filename, filename) != 0)
+		return false;
+	return (e->name == name || stringobject_equal(e->name, name));
+}
+
+// throws an error and returns false on failure
+static bool write_entry(struct Interpreter *interp, struct PerfMapEntry *e)
+{
+	char *utf8;
+	size_t utf8len;
+	if (!stringobject_toutf8(interp, e->name, &utf8, &utf8len))
+		return false;
+
+	// filenames can be long, so no fixed-size buffer here
+	size_t size = strlen("ö ") + utf8len + (e->filename ? strlen(e->filename) + 30 : 0) + 1;
+	char *symbol = malloc(size);
+	if (!symbol) {
+		free(utf8);
+		errorobject_thrownomem(interp);
+		return false;
+	}
+	if (e->filename)
+		sprintf(symbol, "ö %.*s (%s:%zu)", (int)utf8len, utf8, e->filename, e->lineno);
+	else
+		sprintf(symbol, "ö %.*s", (int)utf8len, utf8);
+	free(utf8);
+	for (char *c = symbol; *c; c++) {
+		if (*c == '\n')    // would break the file format
+			*c = ' ';
+	}
+
+	void *start;
+	memcpy(&start, &e->trampoline, sizeof(start));
+
+	// a failed write means a missing name in perf's output, not a reason to stop the program
+	perfmap_addentry(interp, start, sizeof(trampoline_code), symbol);
+	free(symbol);
+	return true;
+}
+
+// throws an error and returns NULL on failure
+static struct PerfMapEntry *get_entry(struct Interpreter *interp, struct Object *name, char *filename, size_t lineno)
+{
+	struct PerfMap *pm = interp->perfmap;
+	stringobject_ensurehash(name);
+	unsigned long hash = (unsigned long)name->hash ^ (unsigned long)lineno*2654435761UL;
+
+	for (struct PerfMapEntry *e = pm->buckets[hash % NBUCKETS]; e; e = e->next) {
+		if (entry_matches(e, hash, name, filename, lineno))
+			return e;
+	}
+
+	struct PerfMapEntry *e = calloc(1, sizeof(struct PerfMapEntry));
+	if (!e) {
+		errorobject_thrownomem(interp);
+		return NULL;
+	}
+	if (filename) {
+		if (!(e->filename = malloc(strlen(filename) + 1))) {
+			free(e);
+			errorobject_thrownomem(interp);
+			return NULL;
+		}
+		strcpy(e->filename, filename);
+	}
+	e->name = name;
+	e->lineno = lineno;
+	e->hash = hash;
+
+	// if a trampoline is created but writing the entry fails, the trampoline is just never used
+	if (!(e->trampoline = new_trampoline(interp)) || !write_entry(interp, e)) {
+		free(e->filename);
+		free(e);
+		return NULL;
+	}
+
+	OBJECT_INCREF(interp, name);
+	e->next = pm->buckets[hash % NBUCKETS];
+	pm->buckets[hash % NBUCKETS] = e;
+	return e;
+}
+
+#endif   // SUPPORTED
+
+
+bool perfmap_call(struct Interpreter *interp, struct Object *name, struct FunctionObjectCfunc cfunc, struct ObjectData userdata, perfmap_func func, void *data)
+{
+#ifdef SUPPORTED
+	char *filename;
+	size_t lineno;
+	if (!lambdabuiltin_getlocation(cfunc, userdata, &filename, &lineno)) {
+		filename = NULL;
+		lineno = 0;
+	}
+
+	struct PerfMapEntry *e = get_entry(interp, name, filename, lineno);
+	if (!e)
+		return false;
+	e->trampoline(interp, data, NULL, func);
+#else
+	// perfmap_start() fails, so this never runs
+	func(interp, data);
+#endif
+	return true;
+}
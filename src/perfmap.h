@@ -0,0 +1,34 @@
+// support for linux perf, enabled with ö --perf-map
+// perf can't tell which ö function is running, because the same C functions run all ö code
+// so every ö function gets a tiny piece of machine code (a trampoline) that calls the C functions,
+// and perf reads the names of the trampolines from /tmp/perf-<pid>.map
+#ifndef PERFMAP_H
+#define PERFMAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "interpreter.h"         // IWYU pragma: keep
+#include "objectsystem.h"        // IWYU pragma: keep
+#include "objects/function.h"
+
+// sets interp->perfmap, prints a message to stderr and returns false on error
+// fails on cpus that there are no trampolines for, currently only x86_64 and aarch64 are supported
+bool perfmap_start(struct Interpreter *interp);
+
+// sets interp->perfmap to NULL, never fails
+// call this when no ö code is running, the trampolines are freed
+// call this before builtins_teardown(), the perfmap holds references to function names
+void perfmap_stop(struct Interpreter *interp);
+
+// calls func(interp, data) through the trampoline of an ö function
+// name, cfunc and userdata are like in profiler_enter()
+// throws an error and returns false if creating a trampoline fails, func is not called then
+typedef void (*perfmap_func)(struct Interpreter *interp, void *data);
+bool perfmap_call(struct Interpreter *interp, struct Object *name, struct FunctionObjectCfunc cfunc, struct ObjectData userdata, perfmap_func func, void *data);
+
+// adds a line to the map file, name must be utf8
+// function.c doesn't need this, it's for things that generate machine code
+// prints a message to stderr and returns false on error
+bool perfmap_addentry(struct Interpreter *interp, const void *start, size_t size, const char *name);
+
+#endif    // PERFMAP_H
@@ -0,0 +1,325 @@
+#include "profiler.h"
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "interpreter.h"
+#include "lambdabuiltin.h"
+#include "objects/errors.h"
+#include "objects/string.h"
+#include "objectsystem.h"
+#include "timing.h"
+
+// functions are identified by name and the location of their body
+// there's no good way to identify them by function objects, e.g. a new function object is created every time
+// a func statement runs, and all of them should be counted together
+struct ProfilerEntry {
+	struct Object *name;
+	char *filename;     // NULL for functions not defined in ö, e.g. built-in functions written in C
+	size_t lineno;
+	unsigned long hash;
+
+	unsigned long long ncalls;
+	uint64_t inclusive, exclusive;     // in nanoseconds
+	unsigned long long inclusiveallocs, exclusiveallocs;
+
+	// number of calls of this function that haven't returned yet
+	// recursive calls are not added to inclusive stuff, otherwise the same time would be counted many times
+	unsigned long active;
+
+	struct ProfilerEntry *next;
+};
+
+struct ProfilerFrame {
+	struct ProfilerEntry *entry;
+	uint64_t start;
+	uint64_t childtime;
+	unsigned long long startallocs;
+	unsigned long long childallocs;
+};
+
+struct Profiler {
+	struct ProfilerEntry **buckets;
+	size_t nbuckets;
+	size_t nentries;
+
+	struct ProfilerFrame *frames;
+	size_t nframes;
+	size_t maxframes;
+};
+
+#define INITIAL_NBUCKETS 256
+
+
+bool profiler_start(struct Interpreter *interp)
+{
+	struct Profiler *prof = malloc(sizeof(struct Profiler));
+	if (!prof)
+		goto nomem;
+	if (!(prof->buckets = calloc(INITIAL_NBUCKETS, sizeof(struct ProfilerEntry *)))) {
+		free(prof);
+		goto nomem;
+	}
+	prof->nbuckets = INITIAL_NBUCKETS;
+	prof->nentries = 0;
+	prof->frames = NULL;
+	prof->nframes = prof->maxframes = 0;
+
+	interp->profiler = prof;
+	return true;
+
+nomem:
+	fprintf(stderr, "%s: not enough memory for profiling\n", interp->argv0);
+	return false;
+}
+
+void profiler_stop(struct Interpreter *interp)
+{
+	struct Profiler *prof = interp->profiler;
+	interp->profiler = NULL;
+
+	for (size_t i=0; i < prof->nbuckets; i++) {
+		struct ProfilerEntry *e = prof->buckets[i];
+		while (e) {
+			struct ProfilerEntry *next = e->next;
+			OBJECT_DECREF(interp, e->name);
+			free(e->filename);
+			free(e);
+			e = next;
+		}
+	}
+	free(prof->buckets);
+	free(prof->frames);
+	free(prof);
+}
+
+
+static bool entry_matches(struct ProfilerEntry *e, unsigned long hash, struct Object *name, char *filename, size_t lineno)
+{
+	if (e->hash != hash || e->lineno != lineno)
+		return false;
+	if (!e->filename || !filename) {
+		if (e->filename != filename)
+			return false;
+	} else if (strcmp(e->filename, filename) != 0)
+		return false;
+	return (e->name == name || stringobject_equal(e->name, name));
+}
+
+static bool grow_buckets(struct Profiler *prof)
+{
+	size_t newnbuckets = prof->nbuckets*2;
+	struct ProfilerEntry **newbuckets = calloc(newnbuckets, sizeof(struct ProfilerEntry *));
+	if (!newbuckets)
+		return false;
+
+	for (size_t i=0; i < prof->nbuckets; i++) {
+		struct ProfilerEntry *e = prof->buckets[i];
+		while (e) {
+			struct ProfilerEntry *next = e->next;
+			e->next = newbuckets[e->hash % newnbuckets];
+			newbuckets[e->hash % newnbuckets] = e;
+			e = next;
+		}
+	}
+	free(prof->buckets);
+	prof->buckets = newbuckets;
+	prof->nbuckets = newnbuckets;
+	return true;
+}
+
+static struct ProfilerEntry *get_entry(struct Interpreter *interp, struct Object *name, char *filename, size_t lineno)
+{
+	struct Profiler *prof = interp->profiler;
+	stringobject_ensurehash(name);
+	unsigned long hash = (unsigned long)name->hash ^ (unsigned long)lineno*2654435761UL;
+
+	for (struct ProfilerEntry *e = prof->buckets[hash % prof->nbuckets]; e; e = e->next) {
+		if (entry_matches(e, hash, name, filename, lineno))
+			return e;
+	}
+
+	// growing is just an optimization, so failing is fine
+	if (prof->nentries >= prof->nbuckets*2)
+		grow_buckets(prof);
+
+	struct ProfilerEntry *e = calloc(1, sizeof(struct ProfilerEntry));
+	if (!e)
+		goto nomem;
+	if (filename) {
+		if (!(e->filename = malloc(strlen(filename) + 1))) {
+			free(e);
+			goto nomem;
+		}
+		strcpy(e->filename, filename);
+	}
+	e->name = name;
+	OBJECT_INCREF(interp, name);
+	e->lineno = lineno;
+	e->hash = hash;
+
+	e->next = prof->buckets[hash % prof->nbuckets];
+	prof->buckets[hash % prof->nbuckets] = e;
+	prof->nentries++;
+	return e;
+
+nomem:
+	errorobject_thrownomem(interp);
+	return NULL;
+}
+
+bool profiler_enter(struct Interpreter *interp, struct Object *name, struct FunctionObjectCfunc cfunc, struct ObjectData userdata)
+{
+	struct Profiler *prof = interp->profiler;
+	if (prof->nframes == prof->maxframes) {
+		size_t newmax = prof->maxframes ? prof->maxframes*2 : 64;
+		struct ProfilerFrame *tmp = realloc(prof->frames, sizeof(struct ProfilerFrame) * newmax);
+		if (!tmp) {
+			errorobject_thrownomem(interp);
+			return false;
+		}
+		prof->frames = tmp;
+		prof->maxframes = newmax;
+	}
+
+	char *filename;
+	size_t lineno;
+	if (!lambdabuiltin_getlocation(cfunc, userdata, &filename, &lineno)) {
+		filename = NULL;
+		lineno = 0;
+	}
+
+	struct ProfilerEntry *e = get_entry(interp, name, filename, lineno);
+	if (!e)
+		return false;
+	e->ncalls++;
+	e->active++;
+
+	// the clock is read last, so that the profiler's own work is not counted for the function
+	struct ProfilerFrame *frame = &prof->frames[prof->nframes++];
+	frame->entry = e;
+	frame->childtime = 0;
+	frame->childallocs = 0;
+	frame->startallocs = interp->objectsallocated;
+	frame->start = timing_monotonic_ns();
+	return true;
+}
+
+void profiler_leave(struct Interpreter *interp)
+{
+	uint64_t end = timing_monotonic_ns();
+	struct Profiler *prof = interp->profiler;
+	struct ProfilerFrame *frame = &prof->frames[--prof->nframes];
+	struct ProfilerEntry *e = frame->entry;
+
+	uint64_t elapsed = end - frame->start;
+	unsigned long long allocs = interp->objectsallocated - frame->startallocs;
+
+	e->exclusive += elapsed - frame->childtime;
+	e->exclusiveallocs += allocs - frame->childallocs;
+	if (--e->active == 0) {
+		e->inclusive += elapsed;
+		e->inclusiveallocs += allocs;
+	}
+
+	if (prof->nframes != 0) {
+		prof->frames[prof->nframes - 1].childtime += elapsed;
+		prof->frames[prof->nframes - 1].childallocs += allocs;
+	}
+}
+
+
+static int compare_entries(const void *a, const void *b)
+{
+	uint64_t x = (*(struct ProfilerEntry *const *)a)->exclusive;
+	uint64_t y = (*(struct ProfilerEntry *const *)b)->exclusive;
+	return (x < y) - (x > y);   // biggest first
+}
+
+// returns NULL on no mem, the array must be free()'d
+static struct ProfilerEntry **sorted_entries(struct Profiler *prof)
+{
+	struct ProfilerEntry **arr = malloc(sizeof(struct ProfilerEntry *) * (prof->nentries + 1));
+	if (!arr)
+		return NULL;
+
+	size_t n = 0;
+	for (size_t i=0; i < prof->nbuckets; i++) {
+		for (struct ProfilerEntry *e = prof->buckets[i]; e; e = e->next)
+			arr[n++] = e;
+	}
+	qsort(arr, n, sizeof(struct ProfilerEntry *), compare_entries);
+	return arr;
+}
+
+// writing a name can fail if there's not enough memory for converting it to utf8
+static void write_name(struct Interpreter *interp, struct Object *name, FILE *f)
+{
+	if (stringobject_writeutf8(interp, name, f) == 0) {
+		OBJECT_DECREF(interp, interp->err);
+		interp->err = NULL;
+		fputs("???", f);
+	}
+}
+
+void profiler_printtable(struct Interpreter *interp, FILE *f)
+{
+	struct Profiler *prof = interp->profiler;
+	struct ProfilerEntry **arr = sorted_entries(prof);
+	if (!arr) {
+		fprintf(stderr, "%s: not enough memory for printing profiling results\n", interp->argv0);
+		return;
+	}
+
+	fprintf(f, "%12s %12s %12s %12s %12s  %s\n", "calls", "incl ms", "excl ms", "incl allocs", "excl allocs", "function");
+	for (size_t i=0; i < prof->nentries; i++) {
+		struct ProfilerEntry *e = arr[i];
+		fprintf(f, "%12llu %12.3f %12.3f %12llu %12llu  ",
+			e->ncalls, e->inclusive / 1e6, e->exclusive / 1e6, e->inclusiveallocs, e->exclusiveallocs);
+		write_name(interp, e->name, f);
+		if (e->filename)
+			fprintf(f, " (%s:%zu)", e->filename, e->lineno);
+		fputc('\n', f);
+	}
+	free(arr);
+}
+
+bool profiler_writefile(struct Interpreter *interp, char *path)
+{
+	struct Profiler *prof = interp->profiler;
+	struct ProfilerEntry **arr = sorted_entries(prof);
+	if (!arr) {
+		fprintf(stderr, "%s: not enough memory for writing profiling results\n", interp->argv0);
+		return false;
+	}
+
+	FILE *f = fopen(path, "w");
+	if (!f) {
+		fprintf(stderr, "%s: cannot open '%s' for writing: %s\n", interp->argv0, path, strerror(errno));
+		free(arr);
+		return false;
+	}
+
+	fputs("calls\tinclusive_ns\texclusive_ns\tinclusive_allocs\texclusive_allocs\tname\tfile\tline\n", f);
+	for (size_t i=0; i < prof->nentries; i++) {
+		struct ProfilerEntry *e = arr[i];
+		fprintf(f, "%llu\t%llu\t%llu\t%llu\t%llu\t",
+			e->ncalls, (unsigned long long)e->inclusive, (unsigned long long)e->exclusive,
+			e->inclusiveallocs, e->exclusiveallocs);
+		write_name(interp, e->name, f);
+		if (e->filename)
+			fprintf(f, "\t%s\t%zu\n", e->filename, e->lineno);
+		else
+			fputs("\t\t\n", f);
+	}
+	free(arr);
+
+	if (fclose(f) != 0) {
+		fprintf(stderr, "%s: writing to '%s' failed: %s\n", interp->argv0, path, strerror(errno));
+		return false;
+	}
+	return true;
+}
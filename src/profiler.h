@@ -0,0 +1,39 @@
+// deterministic profiler, enabled with ö --profile
+// records every function call, so it's accurate but makes the program slower
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdbool.h>
+#include <stdio.h>
+#include "interpreter.h"         // IWYU pragma: keep
+#include "objectsystem.h"        // IWYU pragma: keep
+#include "objects/function.h"
+
+// sets interp->profiler, calls are recorded after this
+// prints a message to stderr and returns false on no mem
+bool profiler_start(struct Interpreter *interp);
+
+// sets interp->profiler to NULL, never fails
+// call this before builtins_teardown(), the profiler holds references to function names
+void profiler_stop(struct Interpreter *interp);
+
+// functionobject_vcall_{yes,no}ret() call these around each call when interp->profiler is set
+// name is the name of the function, cfunc and userdata are for finding where the function was defined
+// profiler_enter() throws an error and returns false on failure, profiler_leave() never fails
+bool profiler_enter(struct Interpreter *interp, struct Object *name, struct FunctionObjectCfunc cfunc, struct ObjectData userdata);
+void profiler_leave(struct Interpreter *interp);
+
+// writes a table sorted by exclusive time, never fails (write errors are ignored)
+void profiler_printtable(struct Interpreter *interp, FILE *f);
+
+/* writes one line of tab-separated values for each function, for processing with other programs:
+
+	calls	inclusive_ns	exclusive_ns	inclusive_allocs	exclusive_allocs	name	file	line
+
+there's a line with the above column names at the start of the file
+file and line are empty for functions that were not defined in ö code, e.g. built-in functions written in C
+prints a message to stderr and returns false on error
+*/
+bool profiler_writefile(struct Interpreter *interp, char *path);
+
+#endif    // PROFILER_H
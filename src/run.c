@@ -1,13 +1,20 @@
 #include "run.h"
 #include <assert.h>
 #include <errno.h>
+#include <limits.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include "astcache.h"
 #include "attribute.h"
 #include "check.h"
+#include "heapimage.h"
 #include "interpreter.h"
 #include "objects/array.h"
 #include "objects/astnode.h"
@@ -22,85 +29,239 @@
 #include "runast.h"
 #include "stack.h"
 #include "tokenizer.h"
-#include "unicode.h"
-#include "utf8.h"
 
-// see Makefile
-static unicode_char builtinscode[] = {
+#if defined(_WIN32) || defined(_WIN64)
+#define WINDOWS
+#include <io.h>
+#else
+#undef WINDOWS
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// windows opens files in text mode by default, posix doesn't have text mode
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif
+
+// see Makefile, this is src/builtins.ö parsed and serialized with astcache_dump()
+// misc/astgen.c creates it with a run.c compiled with ASTGEN defined, and that has no builtins yet
+#ifndef ASTGEN
+static unsigned char builtinscode[] = {
 #include "builtinscode.h"      // IWYU pragma: keep
 };
+#endif
 
 
-static bool run(struct Interpreter *interp, char *path, struct UnicodeString ucode, struct Object *scope, bool runningbuiltinsfile)
+// tokenizes and parses code
+// RETURNS A NEW REFERENCE to an Array of AstNodes, or NULL on error
+static struct Object *parse_code(struct Interpreter *interp, char *path, char *code, size_t codelen)
 {
 	// tokenize
-	// TODO: handle errors in tokenizer.c :(
-	struct Token *tok1st = token_ize(interp, ucode);
+	struct TokenArray tokens;
+	if (!token_ize(interp, code, codelen, &tokens))
+		return NULL;
 
 	// parse
 	struct Object *statements = arrayobject_newempty(interp);
 	if (!statements) {
-		token_freeall(tok1st);
-		return false;
+		tokenarray_free(tokens);
+		return NULL;
 	}
 
-	struct Token *curtok = tok1st;
-	while (curtok) {
+	struct Token *curtok = tokens.tokens;
+	while (curtok->kind != TOKEN_END) {
 		struct Object *stmtnode = parse_statement(interp, path, &curtok);
 		if (!stmtnode) {
-			token_freeall(tok1st);
+			tokenarray_free(tokens);
 			OBJECT_DECREF(interp, statements);
-			return false;
+			return NULL;
 		}
 
 		bool ok = arrayobject_push(interp, statements, stmtnode);
 		OBJECT_DECREF(interp, stmtnode);
 		if (!ok) {
-			token_freeall(tok1st);
+			tokenarray_free(tokens);
 			OBJECT_DECREF(interp, statements);
-			return false;
+			return NULL;
 		}
 	}
-	token_freeall(tok1st);
+	tokenarray_free(tokens);
+	return statements;
+}
 
-	// run
+static bool run_statements(struct Interpreter *interp, char *path, struct Object *statements, struct Object *scope)
+{
 	for (size_t i=0; i < ARRAYOBJECT_LEN(statements); i++) {
 		struct AstNodeObjectData *astdata = ARRAYOBJECT_GET(statements, i)->objdata.data;
-		if (!stack_push(interp, path, astdata->lineno, scope)) {
-			OBJECT_DECREF(interp, statements);
+		if (!stack_push(interp, path, astdata->lineno, scope))
 			return false;
-		}
 		bool ok = runast_statement(interp, scope, ARRAYOBJECT_GET(statements, i));
 		stack_pop(interp);
-		if (!ok) {
-			OBJECT_DECREF(interp, statements);
+		if (!ok)
 			return false;
-		}
 	}
+	return true;
+}
 
+static bool run(struct Interpreter *interp, char *path, char *code, size_t codelen, struct Object *scope)
+{
+	struct Object *statements = parse_code(interp, path, code, codelen);
+	if (!statements)
+		return false;
+
+	bool ok = run_statements(interp, path, statements, scope);
 	OBJECT_DECREF(interp, statements);
-	return true;
+	return ok;
 }
 
-bool run_string(struct Interpreter *interp, char *filepath, struct UnicodeString code, struct Object *scope)
+bool run_string(struct Interpreter *interp, char *filepath, char *code, size_t codelen, struct Object *scope)
 {
-	return run(interp, filepath, code, scope, false);
+	return run(interp, filepath, code, codelen, scope);
 }
 
+#ifndef ASTGEN
 bool run_builtinsfile(struct Interpreter *interp)
 {
-	struct UnicodeString code = { .len = sizeof(builtinscode)/sizeof(builtinscode[0]), .val = builtinscode };
-	return run(interp, "<builtins>", code, interp->builtinscope, true);
+	// builtinscode was parsed and serialized at build time, so only loading it is needed here
+	// it should always be valid, but if astgen and this interpreter disagree about the format, say so
+	// the source isn't in the executable, so there's nothing to fall back to
+	struct Object *statements;
+	int status = astcache_load(interp, (char *)builtinscode, sizeof(builtinscode), NULL, "<builtins>", &statements);
+	if (status == -1) {
+		// builtins.ö defines the other error classes, so Error is all there is
+		errorobject_throwfmt(interp, "Error", "the parsed builtins.ö in the executable is invalid, try 'make clean' and 'make'");
+		return false;
+	}
+	if (status == 0)
+		return false;
+
+	bool ok = run_statements(interp, "<builtins>", statements, interp->builtinscope);
+	OBJECT_DECREF(interp, statements);
+	return ok;
 }
+#else
+// threads.c needs this for starting new interpreters, but astgen never starts threads
+bool run_builtinsfile(struct Interpreter *interp)
+{
+	assert(0);
+	return false;
+}
+#endif
+
 
+// the content of a source file, tokenized without copying or decoding it
+struct SourceFile {
+	char *val;
+	size_t len;
+	bool mapped;    // true if val is from mmap(), false if it's from malloc()
+	int64_t mtime;
+};
 
-static int read_and_run_file(struct Interpreter *interp, char *path, struct Object *scope, bool runningbuiltinsfile, bool handleENOENT)
+// reads everything with read(), for pipes and other things that can't be mmap()ed
+// returns false and sets errno on failure
+static bool read_all(int fd, size_t sizehint, struct SourceFile *src)
 {
-	assert(path_isabsolute(path));
+	size_t nallocated = sizehint + 1;   // +1 avoids a realloc() when read() returns 0 at the end
+	if (nallocated < 4096)
+		nallocated = 4096;
+
+	char *buf = malloc(nallocated);
+	if (!buf) {
+		errno = ENOMEM;
+		return false;
+	}
+
+	size_t len = 0;
+	while (true) {
+		if (len == nallocated) {
+			// growing geometrically makes this O(n) instead of O(n^2) for huge pipes
+			if (nallocated > SIZE_MAX/2) {
+				free(buf);
+				errno = ENOMEM;
+				return false;
+			}
+			char *ptr = realloc(buf, 2*nallocated);
+			if (!ptr) {
+				free(buf);
+				errno = ENOMEM;
+				return false;
+			}
+			buf = ptr;
+			nallocated *= 2;
+		}
 
-	// read the file
-	FILE *f = fopen(path, "rb");   // b because the content is decoded below... i think this is good
-	if (!f) {
+		// read() wants an unsigned int on windows, and a huge size_t wouldn't fit
+		size_t chunksize = nallocated - len;
+		if (chunksize > INT_MAX)
+			chunksize = INT_MAX;
+
+		ssize_t nread = read(fd, buf + len, chunksize);
+		if (nread < 0) {
+			if (errno == EINTR)
+				continue;
+			free(buf);
+			return false;
+		}
+		if (nread == 0)
+			break;
+		len += (size_t)nread;
+	}
+
+	src->val = buf;
+	src->len = len;
+	src->mapped = false;
+	return true;
+}
+
+// never fails
+static void close_source_file(struct SourceFile src)
+{
+#ifndef WINDOWS
+	if (src.mapped) {
+		munmap(src.val, src.len);
+		return;
+	}
+#endif
+	free(src.val);
+}
+
+// maps or reads everything from fd, doesn't close it
+// returns false and sets errno on failure
+static bool load_fd(int fd, struct SourceFile *src)
+{
+	struct stat st;
+	if (fstat(fd, &st) != 0)
+		return false;
+	src->mtime = (int64_t)st.st_mtime;
+
+#ifndef WINDOWS
+	// regular files are mapped, so the tokenizer reads them directly from the page cache
+	// size 0 might be a special file (e.g. in /proc) that has content anyway, so that's read()
+	if (S_ISREG(st.st_mode) && st.st_size > 0 && (unsigned long long)st.st_size <= SIZE_MAX) {
+		void *ptr = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (ptr != MAP_FAILED) {
+			src->val = ptr;
+			src->len = (size_t)st.st_size;
+			src->mapped = true;
+			return true;
+		}
+		// mmap() can fail for e.g. some network file systems, so fall back to read()
+	}
+#endif
+
+	size_t sizehint = (S_ISREG(st.st_mode) && st.st_size > 0) ? (size_t)st.st_size : 0;
+	return read_all(fd, sizehint, src);
+}
+
+// return values:
+//  1   success, call close_source_file() when done
+//  0   an error has been thrown
+//  -1  opening the file returned ENOENT and handleENOENT is true
+static int open_source_file(struct Interpreter *interp, char *path, bool handleENOENT, struct SourceFile *src)
+{
+	int fd = open(path, O_RDONLY | O_BINARY);
+	if (fd < 0) {
 		// both windows and posix have ENOENT even though C99 doesn't have it
 		if (errno == ENOENT && handleENOENT) {
 			errno = 0;
@@ -111,44 +272,140 @@ static int read_and_run_file(struct Interpreter *interp, char *path, struct Obje
 		return 0;
 	}
 
-	char *huge = NULL;
-	char buf[4096];
-	size_t hugelen=0;
-	size_t nread;
-	while ((nread = fread(buf, 1, sizeof(buf), f))) {
-		// <jp> if s is NULL in realloc(s, sz), it acts like malloc
-		char *ptr = realloc(huge, hugelen+nread);
-		if (!ptr) {
-			free(huge);   // free(NULL) does nothing
+	if (!load_fd(fd, src)) {
+		if (errno == ENOMEM)
 			errorobject_thrownomem(interp);
-			return 0;
-		}
-		huge = ptr;
-		memcpy(huge+hugelen, buf, nread);
-		hugelen += nread;
-	}
-
-	if (ferror(f)) {    // ferror doesn't set errno
-		errorobject_throwfmt(interp, "IoError", "cannot read '%s': %s", path, strerror(errno));
-		free(huge);
+		else
+			errorobject_throwfmt(interp, "IoError", "cannot read '%s': %s", path, strerror(errno));
+		close(fd);
 		return 0;
 	}
 
-	if (fclose(f) != 0) {
+	if (close(fd) != 0) {
 		errorobject_throwfmt(interp, "IoError", "cannot close a file opened from '%s': %s", path, strerror(errno));
-		free(huge);
+		close_source_file(*src);
 		return 0;
 	}
+	return 1;
+}
+
+// the cache of foo.ö is foo.öc in the same directory
+// returns NULL on no mem
+static char *get_cache_path(char *path)
+{
+	size_t len = strlen(path);
+	char *res = malloc(len + 2);
+	if (!res)
+		return NULL;
+	memcpy(res, path, len);
+	memcpy(res + len, "c", 2);
+	return res;
+}
+
+// caching is an optimization, so this fails silently, e.g. when the directory isn't writable
+static void write_cache_file(struct Interpreter *interp, char *cachepath, struct Object *statements, struct AstCacheSource cachesrc)
+{
+#ifndef WINDOWS
+	char *data;
+	size_t datalen;
+	if (!astcache_dump(interp, statements, cachesrc, &data, &datalen)) {
+		OBJECT_DECREF(interp, interp->err);
+		interp->err = NULL;
+		return;
+	}
+
+	// writing to a temporary file and renaming makes sure that other processes never see half-written caches
+	char *tmppath = malloc(strlen(cachepath) + 50);
+	if (!tmppath) {
+		free(data);
+		return;
+	}
+	sprintf(tmppath, "%s.%ld.tmp", cachepath, (long)getpid());
+
+	int fd = open(tmppath, O_WRONLY | O_CREAT | O_EXCL | O_BINARY, 0644);
+	if (fd < 0) {
+		free(tmppath);
+		free(data);
+		return;
+	}
 
-	struct UnicodeString uhuge;
-	bool ok = utf8_decode(interp, huge, hugelen, &uhuge);
-	free(huge);
+	bool ok = true;
+	for (size_t off = 0; ok && off < datalen; ) {
+		ssize_t n = write(fd, data + off, datalen - off);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			ok = false;
+		else
+			off += (size_t)n;
+	}
+	ok = (close(fd) == 0) && ok;
+	ok = ok && rename(tmppath, cachepath) == 0;
 	if (!ok)
-		return false;
+		remove(tmppath);
 
-	int res = run(interp, path, uhuge, scope, runningbuiltinsfile);
-	free(uhuge.val);
-	return res;
+	free(tmppath);
+	free(data);
+	errno = 0;
+#endif
+}
+
+// returns an Array of AstNodes from the cache file if it's up to date, otherwise parses and updates the cache
+// RETURNS A NEW REFERENCE or NULL on error
+static struct Object *parse_file_cached(struct Interpreter *interp, char *path, struct SourceFile src)
+{
+	// the cache is used only if the source is exactly what it was when the cache was written
+	// mtime alone isn't enough because it has a resolution of 1 second
+	struct AstCacheSource cachesrc = { .hash = astcache_hash(src.val, src.len), .size = src.len, .mtime = src.mtime };
+
+	char *cachepath = get_cache_path(path);
+	if (!cachepath) {
+		errorobject_thrownomem(interp);
+		return NULL;
+	}
+
+	struct Object *statements;
+	int fd = open(cachepath, O_RDONLY | O_BINARY);
+	if (fd >= 0) {
+		struct SourceFile cachefile;
+		bool loaded = load_fd(fd, &cachefile);
+		close(fd);
+		if (loaded) {
+			int status = astcache_load(interp, cachefile.val, cachefile.len, &cachesrc, path, &statements);
+			close_source_file(cachefile);
+			if (status != -1) {
+				free(cachepath);
+				return status==1 ? statements : NULL;
+			}
+		}
+	}
+	errno = 0;
+
+	// the tokens point into src, so src must stay alive until everything has been parsed
+	if ((statements = parse_code(interp, path, src.val, src.len)))
+		write_cache_file(interp, cachepath, statements, cachesrc);
+	free(cachepath);
+	return statements;
+}
+
+// if cache is true, the parsed code is cached next to the file
+static int read_and_run_file(struct Interpreter *interp, char *path, struct Object *scope, bool cache, bool handleENOENT)
+{
+	assert(path_isabsolute(path));
+
+	struct SourceFile src;
+	int status = open_source_file(interp, path, handleENOENT, &src);
+	if (status != 1)
+		return status;
+
+	struct Object *statements = cache ? parse_file_cached(interp, path, src) : parse_code(interp, path, src.val, src.len);
+	close_source_file(src);
+	if (!statements)
+		return 0;
+
+	bool ok = run_statements(interp, path, statements, scope);
+	OBJECT_DECREF(interp, statements);
+	return ok;
 }
 
 static void libdata_foreachref(void *data, object_foreachrefcb cb, void *cbdata)
@@ -156,6 +413,8 @@ static void libdata_foreachref(void *data, object_foreachrefcb cb, void *cbdata)
 	cb((struct Object*)data, cbdata);
 }
 
+const struct HeapImageKind run_exportimagekind = { libdata_foreachref, NULL, heapimage_writerefdata, heapimage_readrefdata, NULL };
+
 static bool export_cfunc(struct Interpreter *interp, struct ObjectData libdata, struct Object *args, struct Object *opts)
 {
 	if (!check_args(interp, args, interp->builtins.Block, NULL)) return NULL;
@@ -226,7 +485,7 @@ int run_libfile(struct Interpreter *interp, char *abspath, struct Object *lib)
 		return 0;
 	}
 
-	int status = read_and_run_file(interp, abspath, scope, false, true);
+	int status = read_and_run_file(interp, abspath, scope, true, true);
 	OBJECT_DECREF(interp, scope);
 	return status;
 }
@@ -2,13 +2,13 @@
 #define RUN_H
 
 #include <stdbool.h>
+#include <stddef.h>
 #include "interpreter.h"     // IWYU pragma: keep
 #include "objectsystem.h"    // IWYU pragma: keep
-#include "unicode.h"         // IWYU pragma: keep
 
-// runs code from a string
+// runs code from a UTF-8 string, it doesn't need to be \0-terminated
 // filepath should be a path to the file that the code came from, or a dummy value like "<builtins>"
-bool run_string(struct Interpreter *interp, char *filepath, struct UnicodeString code, struct Object *scope);
+bool run_string(struct Interpreter *interp, char *filepath, char *code, size_t codelen, struct Object *scope);
 
 /* runs std/builtins.ö
 throws an error and returns false on failure
@@ -16,7 +16,7 @@ throws an error and returns false on failure
 builtins.ö can't be ran like imported files because:
 	* importing may set errors, but they're not available when running builtins.ö because it defines those errors
 	* builtins.ö must be ran directly in the built-in scope
-	* other files may contain any utf8 characters, but utf8_decode() also uses the errors
+	* other files may contain invalid utf8, and utf8.c uses the errors to report that
 
 this is in the same place with import stuff because reading and running the file is similar
 */
@@ -30,6 +30,7 @@ bool run_mainfile(struct Interpreter *interp, char *path);
 // for import.c, abspath must be absolute
 // runs a file in a scope that contains an export function
 // exported variables are added as attributes to lib
+// the parsed code is cached to abspath + "c" (e.g. foo.öc), see astcache.h
 //
 // return values:
 //  1   success
@@ -0,0 +1,283 @@
+// sigaction() is posix, and setitimer() is xsi
+#define _XOPEN_SOURCE 700
+
+#include "sampler.h"
+#include <errno.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "atomicincrdecr.h"
+#include "interpreter.h"
+#include "stack.h"
+
+#if defined(_WIN32) || defined(_WIN64)
+#define WINDOWS
+#else
+#include <sys/time.h>
+#undef WINDOWS
+#endif
+
+// how many innermost frames are kept from each sample, outer frames are replaced with "[truncated]"
+#define SAMPLE_MAXDEPTH 128
+
+// stack_pop() empties the ring often, so it doesn't need to be big
+#define RING_SIZE 64
+
+#define NBUCKETS 1024
+
+struct SampleFrame {
+	char *filename;   // points to a StackFrame's filename, valid only until that frame is popped
+	size_t lineno;
+};
+
+struct Sample {
+	size_t depth;
+	bool truncated;
+	struct SampleFrame frames[SAMPLE_MAXDEPTH];
+};
+
+// samples with the same stack are counted together
+struct FoldedStack {
+	char *stack;
+	unsigned long count;
+	struct FoldedStack *next;
+};
+
+/*
+the signal handler writes to ring[head] and then moves head, sampler_drain() reads ring[tail] and moves tail
+the handler interrupts the same thread that drains, so there are no locks, only fences between the steps
+one slot is always left unused, so that head == tail means empty and not full
+*/
+struct Sampler {
+	struct Sample ring[RING_SIZE];
+	volatile sig_atomic_t head;
+	volatile sig_atomic_t tail;
+	volatile sig_atomic_t dropped;   // samples that didn't fit in the ring
+
+	struct FoldedStack *buckets[NBUCKETS];
+	unsigned long nodrained;    // samples that couldn't be added because there was no memory
+	char *buf;                  // for building a folded stack string
+	size_t bufsize;
+
+#ifndef WINDOWS
+	struct sigaction oldaction;
+#endif
+};
+
+// signal handlers get no arguments, so this is how the handler finds the interpreter
+static struct Interpreter *sampledinterp = NULL;
+
+
+#ifndef WINDOWS
+static void handle_sigprof(int signum)
+{
+	struct Interpreter *interp = sampledinterp;
+	struct Sampler *smp = interp->sampler;
+
+	// stack_push() fences between writing a frame and incrementing stackptr, so every frame below it is complete
+	size_t depth = interp->stackptr - interp->stack;
+	if (depth == 0)
+		return;
+
+	int next = (smp->head + 1) % RING_SIZE;
+	if (next == smp->tail) {
+		smp->dropped++;
+		return;
+	}
+
+	struct Sample *sample = &smp->ring[smp->head];
+	size_t first = depth > SAMPLE_MAXDEPTH ? depth - SAMPLE_MAXDEPTH : 0;
+	sample->truncated = (first != 0);
+	sample->depth = depth - first;
+	for (size_t i=0; i < sample->depth; i++) {
+		sample->frames[i].filename = interp->stack[first + i].filename;
+		sample->frames[i].lineno = interp->stack[first + i].lineno;
+	}
+
+	ATOMIC_SIGNAL_FENCE();
+	smp->head = next;
+}
+#endif
+
+bool sampler_start(struct Interpreter *interp, unsigned int hz)
+{
+#ifdef WINDOWS
+	fprintf(stderr, "%s: sampling is not supported on windows\n", interp->argv0);
+	return false;
+#else
+	if (sampledinterp)
+		return false;
+	if (hz == 0 || hz > 1000000) {
+		fprintf(stderr, "%s: sampling frequency must be between 1 and 1000000\n", interp->argv0);
+		return false;
+	}
+
+	struct Sampler *smp = calloc(1, sizeof(struct Sampler));
+	if (!smp) {
+		fprintf(stderr, "%s: not enough memory for sampling\n", interp->argv0);
+		return false;
+	}
+	interp->sampler = smp;
+	sampledinterp = interp;
+
+	struct sigaction action;
+	memset(&action, 0, sizeof action);
+	action.sa_handler = handle_sigprof;
+	sigemptyset(&action.sa_mask);
+	action.sa_flags = SA_RESTART;   // ö code shouldn't need to deal with EINTR because of this
+	if (sigaction(SIGPROF, &action, &smp->oldaction) != 0)
+		goto error;
+
+	struct itimerval timer;
+	timer.it_interval.tv_sec = 0;
+	timer.it_interval.tv_usec = 1000000 / hz;
+	timer.it_value = timer.it_interval;
+	if (setitimer(ITIMER_PROF, &timer, NULL) != 0) {
+		sigaction(SIGPROF, &smp->oldaction, NULL);
+		goto error;
+	}
+	return true;
+
+error:
+	fprintf(stderr, "%s: starting the sampling timer failed: %s\n", interp->argv0, strerror(errno));
+	interp->sampler = NULL;
+	sampledinterp = NULL;
+	free(smp);
+	return false;
+#endif
+}
+
+
+static bool ensure_buf(struct Sampler *smp, size_t size)
+{
+	if (size <= smp->bufsize)
+		return true;
+
+	size_t newsize = smp->bufsize ? smp->bufsize : 256;
+	while (newsize < size)
+		newsize *= 2;
+	char *tmp = realloc(smp->buf, newsize);
+	if (!tmp)
+		return false;
+	smp->buf = tmp;
+	smp->bufsize = newsize;
+	return true;
+}
+
+// turns the sample to a string like "a.ö:1;b.ö:2" in smp->buf
+static bool fold_sample(struct Sampler *smp, struct Sample *sample)
+{
+	size_t len = 0;
+	if (sample->truncated) {
+		if (!ensure_buf(smp, sizeof("[truncated];")))
+			return false;
+		strcpy(smp->buf, "[truncated];");
+		len = strlen(smp->buf);
+	}
+
+	for (size_t i=0; i < sample->depth; i++) {
+		// ";" + filename + ":" + lineno + "\0", 30 is more than enough for any size_t
+		if (!ensure_buf(smp, len + strlen(sample->frames[i].filename) + 30))
+			return false;
+
+		if (i != 0)
+			smp->buf[len++] = ';';
+		for (char *c = sample->frames[i].filename; *c; c++) {
+			// these would break the file format
+			smp->buf[len++] = (*c == ';' || *c == '\n') ? '_' : *c;
+		}
+		len += sprintf(smp->buf + len, ":%zu", sample->frames[i].lineno);
+	}
+	return true;
+}
+
+static bool add_folded(struct Sampler *smp, char *stack)
+{
+	// djb2, like in string.c
+	unsigned long hash = 5381;
+	for (char *c = stack; *c; c++)
+		hash = hash*33 + (unsigned char)*c;
+
+	struct FoldedStack **bucket = &smp->buckets[hash % NBUCKETS];
+	for (struct FoldedStack *f = *bucket; f; f = f->next) {
+		if (strcmp(f->stack, stack) == 0) {
+			f->count++;
+			return true;
+		}
+	}
+
+	struct FoldedStack *f = malloc(sizeof(struct FoldedStack));
+	if (!f)
+		return false;
+	if (!(f->stack = malloc(strlen(stack) + 1))) {
+		free(f);
+		return false;
+	}
+	strcpy(f->stack, stack);
+	f->count = 1;
+	f->next = *bucket;
+	*bucket = f;
+	return true;
+}
+
+void sampler_drain(struct Interpreter *interp)
+{
+	struct Sampler *smp = interp->sampler;
+	while (smp->tail != smp->head) {
+		ATOMIC_SIGNAL_FENCE();
+		struct Sample *sample = &smp->ring[smp->tail];
+		if (!fold_sample(smp, sample) || !add_folded(smp, smp->buf))
+			smp->nodrained++;
+		ATOMIC_SIGNAL_FENCE();
+		smp->tail = (smp->tail + 1) % RING_SIZE;
+	}
+}
+
+
+bool sampler_stop(struct Interpreter *interp, char *path)
+{
+	struct Sampler *smp = interp->sampler;
+
+#ifndef WINDOWS
+	struct itimerval timer;
+	memset(&timer, 0, sizeof timer);
+	setitimer(ITIMER_PROF, &timer, NULL);
+	sigaction(SIGPROF, &smp->oldaction, NULL);
+#endif
+	sampler_drain(interp);
+	interp->sampler = NULL;
+	sampledinterp = NULL;
+
+	bool ok = true;
+	FILE *f = fopen(path, "w");
+	if (!f) {
+		fprintf(stderr, "%s: cannot open '%s' for writing: %s\n", interp->argv0, path, strerror(errno));
+		ok = false;
+	}
+
+	for (size_t i=0; i < NBUCKETS; i++) {
+		struct FoldedStack *fs = smp->buckets[i];
+		while (fs) {
+			if (f)
+				fprintf(f, "%s %lu\n", fs->stack, fs->count);
+			struct FoldedStack *next = fs->next;
+			free(fs->stack);
+			free(fs);
+			fs = next;
+		}
+	}
+
+	if (f && fclose(f) != 0) {
+		fprintf(stderr, "%s: writing to '%s' failed: %s\n", interp->argv0, path, strerror(errno));
+		ok = false;
+	}
+	if (smp->dropped != 0 || smp->nodrained != 0)
+		fprintf(stderr, "%s: %lu samples were lost\n", interp->argv0, (unsigned long)smp->dropped + smp->nodrained);
+
+	free(smp->buf);
+	free(smp);
+	return ok;
+}
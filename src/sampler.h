@@ -0,0 +1,35 @@
+// sampling profiler, enabled with ö --sample-file=PATH
+// a timer interrupts the program many times per second, and the stack is recorded each time
+// this is much less accurate than profiler.h, but it doesn't make the program noticably slower
+#ifndef SAMPLER_H
+#define SAMPLER_H
+
+#include <stdbool.h>
+#include "interpreter.h"     // IWYU pragma: keep
+
+#define SAMPLER_DEFAULT_HZ 1000
+
+// starts taking samples of interp->stack hz times per second of cpu time
+// only one interpreter can be sampled at a time, because this uses SIGPROF
+// if another interpreter is being sampled already, returns false without printing anything
+// that can't happen with ö --sample-file, but a program that embeds several interpreters must handle it
+// on other errors, prints a message to stderr and returns false
+// sets interp->sampler on success
+bool sampler_start(struct Interpreter *interp, unsigned int hz);
+
+// stops taking samples and writes them to a file in the folded stack format of flamegraph.pl, e.g.
+//
+//	/path/to/main.ö:10;/path/to/lib.ö:3 42
+//
+// means that 42 samples had two frames on the stack, main.ö line 10 called something in lib.ö line 3
+// frames are separated with ; and the outermost frame is first
+//
+// sets interp->sampler to NULL, prints a message to stderr and returns false if writing fails
+bool sampler_stop(struct Interpreter *interp, char *path);
+
+// stack_pop() calls this before popping, when interp->sampler is set
+// the signal handler only copies pointers, and this turns them into strings while they are still valid
+// never fails, samples are dropped if there's not enough memory
+void sampler_drain(struct Interpreter *interp);
+
+#endif    // SAMPLER_H
@@ -0,0 +1,100 @@
+#include "search.h"
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "unicode.h"
+
+/* memchr is usually vectorized by the C library, so the fastest way to find
+short needles is to memchr for the first byte and then check the rest
+
+that's slow for long needles in repetitive text because most first byte
+matches aren't real matches, so horspool is used for them instead
+https://en.wikipedia.org/wiki/Boyer%E2%80%93Moore%E2%80%93Horspool_algorithm
+*/
+#define HORSPOOL_MIN_LEN 16
+
+void search_init(struct Searcher *s, const void *needle, size_t needlelen, int kind)
+{
+	assert(kind == 1 || kind == 2 || kind == 4);
+	s->needle = needle;
+	s->len = needlelen;
+	s->kind = kind;
+	s->horspool = (kind == 1 && needlelen >= HORSPOOL_MIN_LEN);
+
+	if (s->horspool) {
+		const unsigned char *n = needle;
+		for (size_t i=0; i < 256; i++)
+			s->skip[i] = needlelen;
+		for (size_t i=0; i+1 < needlelen; i++)
+			s->skip[n[i]] = needlelen - 1 - i;
+	}
+}
+
+static size_t find_memchr(const unsigned char *hay, size_t haylen, const unsigned char *needle, size_t needlelen)
+{
+	// the last possible start of a match is at haylen-needlelen
+	size_t nstarts = haylen - needlelen + 1;
+	size_t i = 0;
+	while (i < nstarts) {
+		const unsigned char *p = memchr(hay + i, needle[0], nstarts - i);
+		if (!p)
+			return SEARCH_NOTFOUND;
+		i = (size_t)(p - hay);
+		if (memcmp(p + 1, needle + 1, needlelen - 1) == 0)
+			return i;
+		i++;
+	}
+	return SEARCH_NOTFOUND;
+}
+
+static size_t find_horspool(const struct Searcher *s, const unsigned char *hay, size_t haylen)
+{
+	const unsigned char *needle = s->needle;
+	unsigned char last = needle[s->len - 1];
+
+	for (size_t i=0; i + s->len <= haylen; ) {
+		unsigned char c = hay[i + s->len - 1];
+		if (c == last && memcmp(hay + i, needle, s->len - 1) == 0)
+			return i;
+		i += s->skip[c];
+	}
+	return SEARCH_NOTFOUND;
+}
+
+// memcmp isn't reliable for types that can have padding bits, see stringobject_equal()
+// wide strings are rare, so a simple loop is good enough for them
+#define WIDE_FIND(TYPE) do { \
+	const TYPE *h = hay; \
+	const TYPE *n = s->needle; \
+	for (size_t i=0; i + s->len <= haylen; i++) { \
+		if (h[i] != n[0]) \
+			continue; \
+		size_t j = 1; \
+		while (j < s->len && h[i+j] == n[j]) \
+			j++; \
+		if (j == s->len) \
+			return i; \
+	} \
+	return SEARCH_NOTFOUND; \
+} while(0)
+
+size_t search_find(const struct Searcher *s, const void *hay, size_t haylen)
+{
+	if (s->len == 0)
+		return 0;
+	if (s->len > haylen)
+		return SEARCH_NOTFOUND;
+
+	switch (s->kind) {
+	case 1:
+		if (s->horspool)
+			return find_horspool(s, hay, haylen);
+		return find_memchr(hay, haylen, s->needle, s->len);
+	case 2:
+		WIDE_FIND(uint_least16_t);
+	default:
+		WIDE_FIND(unicode_char);
+	}
+}
@@ -0,0 +1,35 @@
+// substring search for strings and byte arrays
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// search_find() returns this when the needle is not found
+#define SEARCH_NOTFOUND ((size_t) -1)
+
+/* everything needed for searching a needle, figured out once with search_init()
+
+split, count etc. search for the same needle many times, so this is
+computed just once instead of every time search_find() is called
+
+don't access the members outside search.c
+*/
+struct Searcher {
+	const void *needle;   // not copied, must stay alive while the searcher is used
+	size_t len;           // number of elements, not bytes
+	int kind;             // element size: 1, 2 or 4 like with strings
+	bool horspool;
+	size_t skip[256];     // for horspool, only initialized if horspool is true
+};
+
+// kind must be 1 for unsigned char, 2 for uint_least16_t or 4 for unicode_char
+// never fails
+void search_init(struct Searcher *s, const void *needle, size_t needlelen, int kind);
+
+// returns the index of the first element of the first match in haystack, or SEARCH_NOTFOUND
+// haystack must contain elements of the same kind as the needle
+// an empty needle is found at index 0
+size_t search_find(const struct Searcher *s, const void *haystack, size_t haylen);
+
+#endif   // SEARCH_H
@@ -0,0 +1,458 @@
+#include "serialize.h"
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "interpreter.h"
+#include "objectsystem.h"
+#include "objects/array.h"
+#include "objects/bytearray.h"
+#include "objects/channel.h"
+#include "objects/errors.h"
+#include "objects/integer.h"
+#include "objects/mapping.h"
+#include "objects/option.h"
+#include "objects/string.h"
+
+/*
+each object starts with one of these bytes, and lengths and integers are LEB128 varints
+integers are zigzag encoded first, so that small negative numbers are small too
+strings are utf8, and a channel is a ChannelData pointer
+*/
+#define TAG_INTEGER 'i'
+#define TAG_STRING 's'
+#define TAG_BYTEARRAY 'b'
+#define TAG_TRUE 'T'
+#define TAG_FALSE 'F'
+#define TAG_NONE 'N'
+#define TAG_OPTION 'O'     // followed by the value
+#define TAG_ARRAY 'a'      // length, then elements
+#define TAG_MAPPING 'm'    // number of items, then key and value of each item
+#define TAG_CHANNEL 'c'
+
+
+static bool make_room(struct Interpreter *interp, struct SerializeBuf *buf, size_t n)
+{
+	if (buf->len + n <= buf->nallocated)
+		return true;
+
+	size_t newsize = buf->nallocated == 0 ? 64 : buf->nallocated;
+	while (newsize < buf->len + n)
+		newsize *= 2;
+
+	unsigned char *ptr = realloc(buf->data, newsize);
+	if (!ptr) {
+		errorobject_thrownomem(interp);
+		return false;
+	}
+	buf->data = ptr;
+	buf->nallocated = newsize;
+	return true;
+}
+
+static bool write_bytes(struct Interpreter *interp, struct SerializeBuf *buf, const void *bytes, size_t n)
+{
+	if (!make_room(interp, buf, n))
+		return false;
+	if (n != 0)    // bytes can be NULL for empty things
+		memcpy(buf->data + buf->len, bytes, n);
+	buf->len += n;
+	return true;
+}
+
+static bool write_byte(struct Interpreter *interp, struct SerializeBuf *buf, unsigned char b)
+{
+	return write_bytes(interp, buf, &b, 1);
+}
+
+static bool write_varint(struct Interpreter *interp, struct SerializeBuf *buf, uint64_t val)
+{
+	unsigned char bytes[10];    // ceil(64/7)
+	size_t n = 0;
+	do {
+		bytes[n] = val & 0x7f;
+		val >>= 7;
+		if (val)
+			bytes[n] |= 0x80;
+		n++;
+	} while (val);
+	return write_bytes(interp, buf, bytes, n);
+}
+
+// *nchannels is incremented for each channel, so that serialize_dump() knows whether it needs to incref anything
+// nchannels is NULL for serialize_dump_nochannels()
+static bool dump(struct Interpreter *interp, struct Object *obj, struct SerializeBuf *buf, int depth, size_t *nchannels)
+{
+	if (depth > SERIALIZE_MAXDEPTH) {
+		errorobject_throwfmt(interp, "ValueError", "cannot serialize objects nested more than %L levels deep", (long long)SERIALIZE_MAXDEPTH);
+		return false;
+	}
+
+	if (obj->klass == interp->builtins.Integer) {
+		long long val = integerobject_tolonglong(obj);
+		// INTEGEROBJECT_MIN is -INTEGEROBJECT_MAX, so -(val+1) doesn't overflow
+		uint64_t zigzag = val < 0 ? ((uint64_t)(-(val+1)) << 1) | 1 : (uint64_t)val << 1;
+		return write_byte(interp, buf, TAG_INTEGER) && write_varint(interp, buf, zigzag);
+	}
+
+	if (obj->klass == interp->builtins.String) {
+		char *utf8;
+		size_t utf8len;
+		if (!stringobject_toutf8(interp, obj, &utf8, &utf8len))
+			return false;
+		bool ok = write_byte(interp, buf, TAG_STRING) && write_varint(interp, buf, utf8len) && write_bytes(interp, buf, utf8, utf8len);
+		free(utf8);
+		return ok;
+	}
+
+	if (obj->klass == interp->builtins.ByteArray)
+		return write_byte(interp, buf, TAG_BYTEARRAY) &&
+			write_varint(interp, buf, BYTEARRAYOBJECT_LEN(obj)) &&
+			write_bytes(interp, buf, BYTEARRAYOBJECT_DATA(obj), BYTEARRAYOBJECT_LEN(obj));
+
+	if (obj == interp->builtins.yes)
+		return write_byte(interp, buf, TAG_TRUE);
+	if (obj == interp->builtins.no)
+		return write_byte(interp, buf, TAG_FALSE);
+	if (obj == interp->builtins.none)
+		return write_byte(interp, buf, TAG_NONE);
+	if (obj->klass == interp->builtins.Option)
+		return write_byte(interp, buf, TAG_OPTION) && dump(interp, OPTIONOBJECT_VALUE(obj), buf, depth+1, nchannels);
+
+	if (obj->klass == interp->builtins.Array) {
+		if (!write_byte(interp, buf, TAG_ARRAY) || !write_varint(interp, buf, ARRAYOBJECT_LEN(obj)))
+			return false;
+		for (size_t i=0; i < ARRAYOBJECT_LEN(obj); i++) {
+			if (!dump(interp, ARRAYOBJECT_GET(obj, i), buf, depth+1, nchannels))
+				return false;
+		}
+		return true;
+	}
+
+	if (obj->klass == interp->builtins.Mapping) {
+		if (!write_byte(interp, buf, TAG_MAPPING) || !write_varint(interp, buf, MAPPINGOBJECT_SIZE(obj)))
+			return false;
+		struct MappingObjectIter iter;
+		mappingobject_iterbegin(&iter, obj);
+		while (mappingobject_iternext(&iter)) {
+			if (!dump(interp, iter.key, buf, depth+1, nchannels) || !dump(interp, iter.value, buf, depth+1, nchannels))
+				return false;
+		}
+		return true;
+	}
+
+	if (obj->klass == interp->builtins.Channel) {
+		if (!nchannels) {
+			errorobject_throwfmt(interp, "TypeError", "cannot send %D to another process", obj);
+			return false;
+		}
+		// serialize_dump() increfs this when everything has been dumped successfully
+		struct ChannelData *chan = CHANNELOBJECT_DATA(obj);
+		(*nchannels)++;
+		return write_byte(interp, buf, TAG_CHANNEL) && write_bytes(interp, buf, &chan, sizeof(chan));
+	}
+
+	errorobject_throwfmt(interp, "TypeError", "cannot send %D to another interpreter", obj);
+	return false;
+}
+
+
+struct Reader {
+	const unsigned char *data;
+	size_t len;
+	size_t pos;
+};
+
+static bool read_varint(struct Reader *r, uint64_t *res)
+{
+	*res = 0;
+	for (int shift = 0; shift < 64; shift += 7) {
+		if (r->pos == r->len)
+			return false;
+		unsigned char b = r->data[r->pos++];
+		*res |= (uint64_t)(b & 0x7f) << shift;
+		if (!(b & 0x80))
+			return true;
+	}
+	return false;
+}
+
+// checks that there are n more bytes
+static bool read_length(struct Reader *r, size_t *n)
+{
+	uint64_t val;
+	if (!read_varint(r, &val) || val > r->len - r->pos)
+		return false;
+	*n = (size_t)val;
+	return true;
+}
+
+// calls cb for each channel of the object, returns false for invalid data
+static bool walk(struct Reader *r, void (*cb)(struct ChannelData *))
+{
+	if (r->pos == r->len)
+		return false;
+
+	uint64_t n;
+	size_t len;
+	unsigned char tag = r->data[r->pos++];
+	switch(tag) {
+	case TAG_INTEGER:
+		return read_varint(r, &n);
+	case TAG_STRING:
+	case TAG_BYTEARRAY:
+		if (!read_length(r, &len))
+			return false;
+		r->pos += len;
+		return true;
+	case TAG_TRUE:
+	case TAG_FALSE:
+	case TAG_NONE:
+		return true;
+	case TAG_OPTION:
+		return walk(r, cb);
+	case TAG_ARRAY:
+	case TAG_MAPPING:
+		if (!read_varint(r, &n))
+			return false;
+		for (uint64_t i=0; i < (tag == TAG_MAPPING ? 2*n : n); i++) {
+			if (!walk(r, cb))
+				return false;
+		}
+		return true;
+	case TAG_CHANNEL:
+	{
+		struct ChannelData *chan;
+		if (r->len - r->pos < sizeof(chan))
+			return false;
+		memcpy(&chan, r->data + r->pos, sizeof(chan));
+		r->pos += sizeof(chan);
+		cb(chan);
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
+static void walk_all(const unsigned char *data, size_t len, void (*cb)(struct ChannelData *))
+{
+	struct Reader r = { .data = data, .len = len, .pos = 0 };
+	while (r.pos < r.len) {
+		bool ok = walk(&r, cb);
+		assert(ok);
+		(void)ok;   // for -DNDEBUG
+	}
+}
+
+bool serialize_dump(struct Interpreter *interp, struct Object *obj, struct SerializeBuf *buf)
+{
+	size_t start = buf->len;
+	size_t nchannels = 0;
+	if (!dump(interp, obj, buf, 0, &nchannels)) {
+		buf->len = start;
+		return false;
+	}
+	if (nchannels != 0)
+		walk_all(buf->data + start, buf->len - start, channeldata_incref);
+	return true;
+}
+
+bool serialize_dump_nochannels(struct Interpreter *interp, struct Object *obj, struct SerializeBuf *buf)
+{
+	size_t start = buf->len;
+	if (!dump(interp, obj, buf, 0, NULL)) {
+		buf->len = start;
+		return false;
+	}
+	return true;
+}
+
+void serialize_discard(const unsigned char *data, size_t len)
+{
+	walk_all(data, len, channeldata_decref);
+}
+
+struct ChannelData *serialize_peekchannel(const unsigned char *data, size_t len)
+{
+	struct Reader r = { .data = data, .len = len, .pos = 0 };
+	uint64_t n;
+	struct ChannelData *chan;
+	if (r.pos == r.len || r.data[r.pos++] != TAG_ARRAY || !read_varint(&r, &n) || n == 0 ||
+		r.pos == r.len || r.data[r.pos++] != TAG_CHANNEL || r.len - r.pos < sizeof(chan))
+		return NULL;
+	memcpy(&chan, r.data + r.pos, sizeof(chan));
+	return chan;
+}
+
+
+static struct Object *load(struct Interpreter *interp, struct Reader *r, int depth);
+
+static bool invalid(struct Interpreter *interp)
+{
+	errorobject_throwfmt(interp, "ValueError", "invalid serialized data");
+	return false;
+}
+
+static struct Object *load_array(struct Interpreter *interp, struct Reader *r, int depth)
+{
+	uint64_t n;
+	// every element takes at least 1 byte, so this also protects from allocating too much
+	if (!read_varint(r, &n) || n > r->len - r->pos) {
+		invalid(interp);
+		return NULL;
+	}
+
+	struct Object *arr = arrayobject_newwithcapacity(interp, (size_t)n);
+	if (!arr)
+		return NULL;
+	for (uint64_t i=0; i < n; i++) {
+		struct Object *elem = load(interp, r, depth+1);
+		if (!elem) {
+			OBJECT_DECREF(interp, arr);
+			return NULL;
+		}
+		bool ok = arrayobject_push(interp, arr, elem);
+		OBJECT_DECREF(interp, elem);
+		if (!ok) {
+			OBJECT_DECREF(interp, arr);
+			return NULL;
+		}
+	}
+	return arr;
+}
+
+static struct Object *load_mapping(struct Interpreter *interp, struct Reader *r, int depth)
+{
+	uint64_t n;
+	if (!read_varint(r, &n)) {
+		invalid(interp);
+		return NULL;
+	}
+
+	struct Object *map = mappingobject_newempty(interp);
+	if (!map)
+		return NULL;
+	for (uint64_t i=0; i < n; i++) {
+		struct Object *key = load(interp, r, depth+1);
+		if (!key) {
+			OBJECT_DECREF(interp, map);
+			return NULL;
+		}
+		struct Object *val = load(interp, r, depth+1);
+		if (!val) {
+			OBJECT_DECREF(interp, key);
+			OBJECT_DECREF(interp, map);
+			return NULL;
+		}
+		bool ok = mappingobject_set(interp, map, key, val);
+		OBJECT_DECREF(interp, key);
+		OBJECT_DECREF(interp, val);
+		if (!ok) {
+			OBJECT_DECREF(interp, map);
+			return NULL;
+		}
+	}
+	return map;
+}
+
+static struct Object *load(struct Interpreter *interp, struct Reader *r, int depth)
+{
+	if (depth > SERIALIZE_MAXDEPTH || r->pos == r->len) {
+		invalid(interp);
+		return NULL;
+	}
+
+	uint64_t n;
+	size_t len;
+	switch(r->data[r->pos++]) {
+	case TAG_INTEGER:
+		if (!read_varint(r, &n)) {
+			invalid(interp);
+			return NULL;
+		}
+		// the smallest value, INTEGEROBJECT_MIN, is encoded as 2*INTEGEROBJECT_MAX + 1
+		return integerobject_newfromlonglong(interp, (n & 1) ? -(long long)(n >> 1) - 1 : (long long)(n >> 1));
+
+	case TAG_STRING:
+		if (!read_length(r, &len)) {
+			invalid(interp);
+			return NULL;
+		}
+		r->pos += len;
+		return stringobject_newfromutf8(interp, (char *)(r->data + r->pos - len), len);
+
+	case TAG_BYTEARRAY:
+	{
+		if (!read_length(r, &len)) {
+			invalid(interp);
+			return NULL;
+		}
+		unsigned char *val = NULL;
+		if (len != 0) {
+			if (!(val = malloc(len))) {
+				errorobject_thrownomem(interp);
+				return NULL;
+			}
+			memcpy(val, r->data + r->pos, len);
+		}
+		r->pos += len;
+		return bytearrayobject_new(interp, val, len);
+	}
+
+	case TAG_TRUE:
+		OBJECT_INCREF(interp, interp->builtins.yes);
+		return interp->builtins.yes;
+	case TAG_FALSE:
+		OBJECT_INCREF(interp, interp->builtins.no);
+		return interp->builtins.no;
+	case TAG_NONE:
+		OBJECT_INCREF(interp, interp->builtins.none);
+		return interp->builtins.none;
+
+	case TAG_OPTION:
+	{
+		struct Object *val = load(interp, r, depth+1);
+		if (!val)
+			return NULL;
+		struct Object *res = optionobject_new(interp, val);
+		OBJECT_DECREF(interp, val);
+		return res;
+	}
+
+	case TAG_ARRAY:
+		return load_array(interp, r, depth);
+	case TAG_MAPPING:
+		return load_mapping(interp, r, depth);
+
+	case TAG_CHANNEL:
+	{
+		struct ChannelData *chan;
+		if (r->len - r->pos < sizeof(chan)) {
+			invalid(interp);
+			return NULL;
+		}
+		memcpy(&chan, r->data + r->pos, sizeof(chan));
+		r->pos += sizeof(chan);
+
+		// the data keeps its reference, this is for the new Channel object
+		channeldata_incref(chan);
+		return channelobject_new(interp, chan);
+	}
+
+	default:
+		invalid(interp);
+		return NULL;
+	}
+}
+
+struct Object *serialize_load(struct Interpreter *interp, const unsigned char *data, size_t len, size_t *pos)
+{
+	struct Reader r = { .data = data, .len = len, .pos = *pos };
+	struct Object *res = load(interp, &r, 0);
+	if (res)
+		*pos = r.pos;
+	return res;
+}
@@ -0,0 +1,54 @@
+// compact binary serialization of simple values, for moving them between interpreters
+#ifndef SERIALIZE_H
+#define SERIALIZE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "interpreter.h"     // IWYU pragma: keep
+#include "objectsystem.h"    // IWYU pragma: keep
+
+struct ChannelData;   // defined in objects/channel.h
+
+// nesting arrays and mappings deeper than this is an error, this also catches arrays that contain themselves
+#define SERIALIZE_MAXDEPTH 500
+
+// initialize with (struct SerializeBuf){0}, free data with free() when done
+struct SerializeBuf {
+	unsigned char *data;
+	size_t len;
+	size_t nallocated;
+};
+
+/* appends obj to buf
+
+supported objects are Integers, Strings, ByteArrays, Bools, Options and Channels,
+and Arrays and Mappings that contain supported objects
+everything else throws a TypeError, and subclasses count as everything else
+
+channels are shared instead of copied, and the data holds a reference to each channel in it
+call serialize_discard() for the data before freeing it
+
+throws an error and returns false on failure, buf->len is then same as before calling this
+*/
+bool serialize_dump(struct Interpreter *interp, struct Object *obj, struct SerializeBuf *buf);
+
+// like serialize_dump, but throws TypeError for channels
+// use this for data that goes to another process, channel pointers mean nothing there
+// the data doesn't need serialize_discard()
+bool serialize_dump_nochannels(struct Interpreter *interp, struct Object *obj, struct SerializeBuf *buf);
+
+// creates an object from data that came from serialize_dump(), starting at *pos
+// *pos is set to where the object ended in the data
+// RETURNS A NEW REFERENCE or NULL on error, throws ValueError for invalid data
+struct Object *serialize_load(struct Interpreter *interp, const unsigned char *data, size_t len, size_t *pos);
+
+// releases the references to channels that the data holds, never fails
+// data must be valid, and it must not be loaded after this
+void serialize_discard(const unsigned char *data, size_t len);
+
+// if the data is an Array whose first item is a Channel, returns that channel without creating any objects
+// the data holds the reference, so the channel must not be used after serialize_discard()
+// returns NULL for other data, never fails
+struct ChannelData *serialize_peekchannel(const unsigned char *data, size_t len);
+
+#endif   // SERIALIZE_H
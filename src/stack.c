@@ -4,9 +4,12 @@
 #include <string.h>
 #include "stack.h"
 
+#include "atomicincrdecr.h"
 #include "interpreter.h"
 #include "objectsystem.h"
 #include "objects/errors.h"
+#include "sampler.h"
+#include "stats.h"
 
 
 bool stack_push(struct Interpreter *interp, char *filename, size_t lineno, struct Object *scope)
@@ -31,14 +34,22 @@ bool stack_push(struct Interpreter *interp, char *filename, size_t lineno, struc
 	struct StackFrame f = { .filename = tmp, .lineno = lineno, .scope = scope };
 	if (scope)
 		OBJECT_INCREF(interp, scope);
-	*interp->stackptr++ = f;
+	*interp->stackptr = f;
+	ATOMIC_SIGNAL_FENCE();   // sampler.c must not see the frame before it's ready
+	interp->stackptr++;
+	STATS_INCR(interp, framespushed);
 	return true;
 }
 
 void stack_pop(struct Interpreter *interp)
 {
 	assert(interp->stack != interp->stackptr);   // stack must not be empty
+
+	// the frame must be popped before draining, otherwise a sample taken after draining could see it
 	struct StackFrame f = *--interp->stackptr;
+	ATOMIC_SIGNAL_FENCE();
+	if (interp->sampler)
+		sampler_drain(interp);   // samples may point to the filename that is freed below
 	free(f.filename);
 	if (f.scope)
 		OBJECT_DECREF(interp, f.scope);
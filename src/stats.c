@@ -0,0 +1,226 @@
+#include "stats.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "allobjects.h"
+#include "interpreter.h"
+#include "objectsystem.h"
+#include "unicode.h"
+#include "utf8.h"
+#include "objects/classobject.h"
+#include "objects/errors.h"
+#include "objects/integer.h"
+#include "objects/mapping.h"
+#include "objects/string.h"
+
+// returns false on error
+static bool set_integer(struct Interpreter *interp, struct Object *map, char *key, unsigned long long val)
+{
+	struct Object *keyobj = stringobject_newfromcharptr(interp, key);
+	if (!keyobj)
+		return false;
+	struct Object *valobj = integerobject_newfromlonglong(interp, (long long)val);
+	if (!valobj) {
+		OBJECT_DECREF(interp, keyobj);
+		return false;
+	}
+
+	bool ok = mappingobject_set(interp, map, keyobj, valobj);
+	OBJECT_DECREF(interp, keyobj);
+	OBJECT_DECREF(interp, valobj);
+	return ok;
+}
+
+#ifndef NO_STATS
+
+// returns an array of all class objects that have been instantiated, sets *n to its length
+// the objects are not increffed, the array must be freed, returns NULL on no mem
+static struct Object **get_classes(struct Interpreter *interp, size_t *n)
+{
+	// allobjects must not be modified while iterating, so this can't create the Mappings directly
+	struct Object **arr = malloc(sizeof(struct Object *) * (interp->allobjects.size + 1));
+	if (!arr)
+		return NULL;
+
+	*n = 0;
+	struct AllObjectsIter iter = allobjects_iterbegin(interp->allobjects);
+	while (allobjects_iternext(&iter)) {
+		if (iter.obj->klass && classobject_isinstanceof(iter.obj, interp->builtins.Class) &&
+			((struct ClassObjectData *) iter.obj->objdata.data)->nallocated != 0)
+		{
+			arr[(*n)++] = iter.obj;
+		}
+	}
+	return arr;
+}
+
+// different classes can have the same name, their counts are added together
+static bool add_class_count(struct Interpreter *interp, struct Object *map, struct Object *klass, unsigned long long count)
+{
+	struct Object *name = stringobject_newfromustr_copy(interp, ((struct ClassObjectData *) klass->objdata.data)->name);
+	if (!name)
+		return false;
+
+	struct Object *old;
+	int status = mappingobject_get(interp, map, name, &old);
+	if (status == -1) {
+		OBJECT_DECREF(interp, name);
+		return false;
+	}
+	if (status == 1) {
+		count += (unsigned long long)integerobject_tolonglong(old);
+		OBJECT_DECREF(interp, old);
+	}
+
+	struct Object *val = integerobject_newfromlonglong(interp, (long long)count);
+	if (!val) {
+		OBJECT_DECREF(interp, name);
+		return false;
+	}
+	bool ok = mappingobject_set(interp, map, name, val);
+	OBJECT_DECREF(interp, name);
+	OBJECT_DECREF(interp, val);
+	return ok;
+}
+
+static bool set_per_class(struct Interpreter *interp, struct Object *map, char *key, bool freed)
+{
+	size_t n;
+	struct Object **classes = get_classes(interp, &n);
+	if (!classes) {
+		errorobject_thrownomem(interp);
+		return false;
+	}
+
+	struct Object *keyobj = NULL, *sub = mappingobject_newempty(interp);
+	if (!sub)
+		goto error;
+
+	for (size_t i=0; i < n; i++) {
+		struct ClassObjectData *data = classes[i]->objdata.data;
+		if (!add_class_count(interp, sub, classes[i], freed ? data->nfreed : data->nallocated))
+			goto error;
+	}
+
+	if (!(keyobj = stringobject_newfromcharptr(interp, key)))
+		goto error;
+	if (!mappingobject_set(interp, map, keyobj, sub))
+		goto error;
+
+	OBJECT_DECREF(interp, keyobj);
+	OBJECT_DECREF(interp, sub);
+	free(classes);
+	return true;
+
+error:
+	if (keyobj)
+		OBJECT_DECREF(interp, keyobj);
+	if (sub)
+		OBJECT_DECREF(interp, sub);
+	free(classes);
+	return false;
+}
+
+#endif   // NO_STATS
+
+
+struct Object *stats_tomapping(struct Interpreter *interp)
+{
+	struct Object *map = mappingobject_newempty(interp);
+	if (!map)
+		return NULL;
+
+	// objects created for the result are counted too, but they're created after reading these
+	unsigned long long allocated = interp->objectsallocated;
+	size_t live = interp->allobjects.size;
+#ifndef NO_STATS
+	struct Stats st = interp->stats;
+#endif
+
+	if (!set_integer(interp, map, "objects_allocated", allocated) ||
+		!set_integer(interp, map, "live_objects", live))
+		goto error;
+
+#ifndef NO_STATS
+	if (!set_integer(interp, map, "objects_freed", st.objectsfreed) ||
+		!set_integer(interp, map, "peak_live_objects", st.peakobjects) ||
+		!set_integer(interp, map, "increfs", st.increfs) ||
+		!set_integer(interp, map, "mapping_resizes", st.mappingresizes) ||
+		!set_integer(interp, map, "oparray_fallthroughs", st.oparrayfallthroughs) ||
+		!set_integer(interp, map, "frames_pushed", st.framespushed) ||
+		!set_integer(interp, map, "errors_thrown", st.errorsthrown) ||
+		!set_per_class(interp, map, "allocated_per_class", false) ||
+		!set_per_class(interp, map, "freed_per_class", true))
+		goto error;
+#endif
+
+	return map;
+
+error:
+	OBJECT_DECREF(interp, map);
+	return NULL;
+}
+
+
+#ifndef NO_STATS
+
+static int compare_classes(const void *a, const void *b)
+{
+	struct ClassObjectData *x = (*(struct Object *const *)a)->objdata.data;
+	struct ClassObjectData *y = (*(struct Object *const *)b)->objdata.data;
+	if (x->nallocated != y->nallocated)
+		return x->nallocated > y->nallocated ? -1 : 1;
+	return 0;
+}
+
+static void print_classname(struct Interpreter *interp, struct Object *klass, FILE *f)
+{
+	char *utf8;
+	size_t utf8len;
+	if (!utf8_encode(interp, ((struct ClassObjectData *) klass->objdata.data)->name, &utf8, &utf8len)) {
+		OBJECT_DECREF(interp, interp->err);
+		interp->err = NULL;
+		fputs("???", f);
+		return;
+	}
+	fwrite(utf8, 1, utf8len, f);
+	free(utf8);
+}
+
+#endif   // NO_STATS
+
+void stats_print(struct Interpreter *interp, FILE *f)
+{
+	fprintf(f, "%-24s %llu\n", "objects allocated", interp->objectsallocated);
+	fprintf(f, "%-24s %zu\n", "live objects", interp->allobjects.size);
+
+#ifdef NO_STATS
+	fputs("(other counters were disabled with ./configure --disable-stats)\n", f);
+#else
+	fprintf(f, "%-24s %llu\n", "objects freed", interp->stats.objectsfreed);
+	fprintf(f, "%-24s %zu\n", "peak live objects", interp->stats.peakobjects);
+	fprintf(f, "%-24s %llu\n", "increfs", interp->stats.increfs);
+	fprintf(f, "%-24s %llu\n", "mapping resizes", interp->stats.mappingresizes);
+	fprintf(f, "%-24s %llu\n", "oparray fallthroughs", interp->stats.oparrayfallthroughs);
+	fprintf(f, "%-24s %llu\n", "stack frames pushed", interp->stats.framespushed);
+	fprintf(f, "%-24s %llu\n", "errors thrown", interp->stats.errorsthrown);
+
+	size_t n;
+	struct Object **classes = get_classes(interp, &n);
+	if (!classes) {
+		fprintf(stderr, "%s: not enough memory for printing per-class stats\n", interp->argv0);
+		return;
+	}
+	qsort(classes, n, sizeof(struct Object *), compare_classes);
+
+	fprintf(f, "\n%12s %12s  %s\n", "allocated", "freed", "class");
+	for (size_t i=0; i < n; i++) {
+		struct ClassObjectData *data = classes[i]->objdata.data;
+		fprintf(f, "%12llu %12llu  ", data->nallocated, data->nfreed);
+		print_classname(interp, classes[i], f);
+		fputc('\n', f);
+	}
+	free(classes);
+#endif
+}
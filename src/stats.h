@@ -0,0 +1,53 @@
+// counters for ö --stats and <std>/runtime
+// they are compiled in by default, and ./configure --disable-stats defines NO_STATS
+// with NO_STATS, the STATS_* macros do nothing and only interp->objectsallocated and the number of live objects are available
+#ifndef STATS_H
+#define STATS_H
+
+#include <stddef.h>
+#include <stdio.h>
+#include "../config.h"
+
+// stupid IWYU doesn't get these
+struct Interpreter;
+struct Object;
+
+#ifndef NO_STATS
+
+// interp->stats is one of these
+struct Stats {
+	unsigned long long objectsfreed;
+	size_t peakobjects;                      // biggest interp->allobjects.size seen
+	unsigned long long increfs;
+	unsigned long long mappingresizes;
+	unsigned long long oparrayfallthroughs;  // oparray functions that returned none, so the next function was tried
+	unsigned long long framespushed;
+	unsigned long long errorsthrown;
+};
+
+#define STATS_INCR(interp, field) ((void) ((interp)->stats.field++))
+#define STATS_UPDATEPEAK(interp) do { \
+	if ((interp)->allobjects.size > (interp)->stats.peakobjects) \
+		(interp)->stats.peakobjects = (interp)->allobjects.size; \
+} while (0)
+
+// counts objects of a class, see ClassObjectData, classobject.h must be included for this
+#define STATS_CLASSINCR(klass, field) ((void) (((struct ClassObjectData *) (klass)->objdata.data)->field++))
+
+#else
+
+#define STATS_INCR(interp, field) ((void) 0)
+#define STATS_UPDATEPEAK(interp) ((void) 0)
+#define STATS_CLASSINCR(klass, field) ((void) 0)
+
+#endif   // NO_STATS
+
+
+// RETURNS A NEW REFERENCE to a Mapping with String keys, or NULL on error
+// values are Integers, except that "allocated_per_class" and "freed_per_class" are Mappings of class names to Integers
+struct Object *stats_tomapping(struct Interpreter *interp);
+
+// for ö --stats, never fails
+void stats_print(struct Interpreter *interp, FILE *f);
+
+#endif   // STATS_H
@@ -0,0 +1,792 @@
+// pthread_sigmask() is posix, not c99
+#define _POSIX_C_SOURCE 200809L
+
+#include "threads.h"
+#include <assert.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "astcache.h"
+#include "atomicincrdecr.h"
+#include "attribute.h"
+#include "builtins.h"
+#include "check.h"
+#include "gc.h"
+#include "heapimage.h"
+#include "interpreter.h"
+#include "method.h"
+#include "objectsystem.h"
+#include "run.h"
+#include "serialize.h"
+#include "stack.h"
+#include "objects/array.h"
+#include "objects/astnode.h"
+#include "objects/block.h"
+#include "objects/channel.h"
+#include "objects/classobject.h"
+#include "objects/errors.h"
+#include "objects/function.h"
+#include "objects/mapping.h"
+#include "objects/scope.h"
+#include "objects/string.h"
+
+// the default stack size of a thread is only 128KB with some C libraries, and running ö code recurses a lot
+#define THREAD_STACK_SIZE (8*1024*1024)
+
+enum ThreadKind { THREAD_BLOCK, THREAD_FUNCTION, THREAD_WORKER };
+
+// shared between the thread and the Thread object that started it
+struct ThreadData {
+	long refcount;
+	pthread_t tid;
+	enum ThreadKind kind;
+	char *argv0;
+
+	// THREAD_BLOCK only, ast is from astcache_dump()
+	char *filename;
+	char *ast;
+	size_t astlen;
+
+	// serialized with serialize_dump()
+	// THREAD_BLOCK: Mapping of variables
+	// THREAD_FUNCTION: [filename path funcname args]
+	// THREAD_WORKER: the tasks Channel
+	struct SerializeBuf input;
+
+	// set by the thread, [true returnvalue] or [false errorclassname errormessage]
+	// empty if the thread couldn't even create an error, the reason has been printed to stderr then
+	struct SerializeBuf result;
+};
+
+struct ThreadObjectData {
+	struct ThreadData *td;
+	bool joined;
+	struct Object *result;   // return value of the thread after joining, NULL before that
+};
+
+static void threaddata_decref(struct ThreadData *td)
+{
+	if (ATOMIC_DECR(td->refcount) != 0)
+		return;
+
+	serialize_discard(td->input.data, td->input.len);
+	serialize_discard(td->result.data, td->result.len);
+	free(td->input.data);
+	free(td->result.data);
+	free(td->ast);
+	free(td->filename);
+	free(td->argv0);
+	free(td);
+}
+
+
+// returns a mallocced, \0-terminated copy of a String
+static char *to_cstring(struct Interpreter *interp, struct Object *s)
+{
+	char *utf8;
+	size_t len;
+	if (!stringobject_toutf8(interp, s, &utf8, &len))
+		return NULL;
+
+	char *res = realloc(utf8, len+1);
+	if (!res) {
+		free(utf8);
+		errorobject_thrownomem(interp);
+		return NULL;
+	}
+	res[len] = 0;
+	return res;
+}
+
+// RETURNS A NEW REFERENCE to an [errorclassname errormessage] Array or NULL on error
+static struct Object *describe_error(struct Interpreter *interp, struct Object *err)
+{
+	if (err == interp->builtins.nomemerr) {
+		// creating the strings will likely fail, but there's no other way to tell what happened
+		struct Object *klassname = stringobject_newfromcharptr(interp, "MemError");
+		if (!klassname)
+			return NULL;
+		struct Object *msg = stringobject_newfromcharptr(interp, "not enough memory");
+		if (!msg) {
+			OBJECT_DECREF(interp, klassname);
+			return NULL;
+		}
+		struct Object *res = arrayobject_new(interp, (struct Object *[]){ klassname, msg }, 2);
+		OBJECT_DECREF(interp, klassname);
+		OBJECT_DECREF(interp, msg);
+		return res;
+	}
+
+	struct Object *klassname = stringobject_newfromustr_copy(interp, ((struct ClassObjectData *) err->klass->objdata.data)->name);
+	if (!klassname)
+		return NULL;
+	struct Object *msg = attribute_get(interp, err, "message");
+	if (!msg) {
+		OBJECT_DECREF(interp, klassname);
+		return NULL;
+	}
+
+	struct Object *res = NULL;
+	if (check_type(interp, interp->builtins.String, msg))
+		res = arrayobject_new(interp, (struct Object *[]){ klassname, msg }, 2);
+	OBJECT_DECREF(interp, klassname);
+	OBJECT_DECREF(interp, msg);
+	return res;
+}
+
+bool threads_dumpresult(struct Interpreter *interp, struct Object *index, struct Object *val, struct SerializeBuf *buf, bool allowchannels)
+{
+	bool (*dumper)(struct Interpreter *, struct Object *, struct SerializeBuf *) = allowchannels ? serialize_dump : serialize_dump_nochannels;
+
+	struct Object *items[4];
+	size_t n = 0;
+	if (index)
+		items[n++] = index;
+
+	if (val) {
+		items[n] = interp->builtins.yes;
+		items[n+1] = val;
+		struct Object *arr = arrayobject_new(interp, items, n+2);
+		if (!arr)
+			return false;
+		bool ok = dumper(interp, arr, buf);
+		OBJECT_DECREF(interp, arr);
+		if (ok)
+			return true;
+		// e.g. a function returned something that can't be sent to another interpreter
+	}
+
+	struct Object *err = interp->err;
+	assert(err);
+	interp->err = NULL;
+	struct Object *desc = describe_error(interp, err);
+	OBJECT_DECREF(interp, err);
+	if (!desc)
+		return false;
+
+	items[n] = interp->builtins.no;
+	items[n+1] = ARRAYOBJECT_GET(desc, 0);
+	items[n+2] = ARRAYOBJECT_GET(desc, 1);
+	struct Object *arr = arrayobject_new(interp, items, n+3);
+	OBJECT_DECREF(interp, desc);
+	if (!arr)
+		return false;
+	bool ok = dumper(interp, arr, buf);
+	OBJECT_DECREF(interp, arr);
+	return ok;
+}
+
+// the error class is looked up by name, because the classes of different interpreters are different objects
+void threads_throwlike(struct Interpreter *interp, struct Object *klassname, struct Object *msg)
+{
+	struct Object *klass;
+	int status = mappingobject_get(interp, SCOPEOBJECT_LOCALVARS(interp->builtinscope), klassname, &klass);
+	if (status == -1)
+		return;
+
+	if (status == 1) {
+		if (classobject_isinstanceof(klass, interp->builtins.Class) && classobject_issubclassof(klass, interp->builtins.Error)) {
+			struct Object *err = errorobject_new(interp, klass, msg);
+			OBJECT_DECREF(interp, klass);
+			if (err) {
+				errorobject_throw(interp, err);
+				OBJECT_DECREF(interp, err);
+			}
+			return;
+		}
+		OBJECT_DECREF(interp, klass);
+	}
+
+	// e.g. a class defined in a library that the thread imported
+	errorobject_throwfmt(interp, "ValueError", "%S in another interpreter: %S", klassname, msg);
+}
+
+bool threads_throw(struct Interpreter *interp, struct ObjectData nulldata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, interp->builtins.String, interp->builtins.String, NULL)) return false;
+	if (!check_no_opts(interp, opts)) return false;
+	threads_throwlike(interp, ARRAYOBJECT_GET(args, 0), ARRAYOBJECT_GET(args, 1));
+	return false;
+}
+
+struct Object *threads_caller_filename(struct Interpreter *interp, struct ObjectData nulldata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, NULL)) return NULL;
+	if (!check_no_opts(interp, opts)) return NULL;
+
+	// the topmost frame is the statement that called this, and it's in std/threads.ö
+	// the caller may be nested in blocks of its file, so skip by filename instead of counting frames
+	if (interp->stackptr != interp->stack) {
+		char *thisfile = interp->stackptr[-1].filename;
+		for (struct StackFrame *f = interp->stackptr - 1; f >= interp->stack; f--) {
+			if (strcmp(f->filename, thisfile) != 0)
+				return stringobject_newfromcharptr(interp, f->filename);
+		}
+	}
+	errorobject_throwfmt(interp, "ValueError", "cannot find the file that called the threads library");
+	return NULL;
+}
+
+
+// imports path like the file named filename would import it, and returns the function named funcname
+// RETURNS A NEW REFERENCE or NULL on error
+static struct Object *get_function(struct Interpreter *interp, struct Object *filename, struct Object *path, struct Object *funcname)
+{
+	if (!check_type(interp, interp->builtins.String, filename)) return NULL;
+	if (!check_type(interp, interp->builtins.String, path)) return NULL;
+	if (!check_type(interp, interp->builtins.String, funcname)) return NULL;
+
+	char *cfilename = to_cstring(interp, filename);
+	if (!cfilename)
+		return NULL;
+
+	struct Object *scope = scopeobject_newsub(interp, interp->builtinscope);
+	if (!scope) {
+		free(cfilename);
+		return NULL;
+	}
+
+	struct Object *pathvar = stringobject_newfromcharptr(interp, "path");
+	if (!pathvar) {
+		OBJECT_DECREF(interp, scope);
+		free(cfilename);
+		return NULL;
+	}
+	bool ok = mappingobject_set(interp, SCOPEOBJECT_LOCALVARS(scope), pathvar, path);
+	OBJECT_DECREF(interp, pathvar);
+
+	// the import runs with a stack frame that has cfilename in it, so relative paths work
+	char code[] = "var lib = (import path);";
+	ok = ok && run_string(interp, cfilename, code, sizeof(code)-1, scope);
+	free(cfilename);
+	if (!ok) {
+		OBJECT_DECREF(interp, scope);
+		return NULL;
+	}
+
+	struct Object *libvar = stringobject_newfromcharptr(interp, "lib");
+	if (!libvar) {
+		OBJECT_DECREF(interp, scope);
+		return NULL;
+	}
+	struct Object *lib = scopeobject_getvar(interp, scope, libvar);
+	OBJECT_DECREF(interp, libvar);
+	OBJECT_DECREF(interp, scope);
+	if (!lib)
+		return NULL;
+
+	struct Object *func = attribute_getwithstringobj(interp, lib, funcname);
+	OBJECT_DECREF(interp, lib);
+	if (func && !check_type(interp, interp->builtins.Function, func)) {
+		OBJECT_DECREF(interp, func);
+		return NULL;
+	}
+	return func;
+}
+
+// RETURNS A NEW REFERENCE or NULL on error, the result is none for functions that don't return anything
+static struct Object *call_function(struct Interpreter *interp, struct Object *func, struct Object *args)
+{
+	struct Object *opts = mappingobject_newempty(interp);
+	if (!opts)
+		return NULL;
+
+	struct Object *res;
+	if (functionobject_getcfunc(func).returning)
+		res = functionobject_vcall_yesret(interp, func, args, opts);
+	else if (functionobject_vcall_noret(interp, func, args, opts)) {
+		res = interp->builtins.none;
+		OBJECT_INCREF(interp, res);
+	} else
+		res = NULL;
+
+	OBJECT_DECREF(interp, opts);
+	return res;
+}
+
+
+// RETURNS A NEW REFERENCE or NULL on error
+static struct Object *run_block(struct Interpreter *interp, struct ThreadData *td, struct Object *vars)
+{
+	if (!check_type(interp, interp->builtins.Mapping, vars))
+		return NULL;
+
+	struct Object *statements;
+	int status = astcache_load(interp, td->ast, td->astlen, NULL, td->filename, &statements);
+	if (status == 0)
+		return NULL;
+	assert(status == 1);   // the data came from astcache_dump() in the same process, so it's valid
+
+	struct Object *scope = scopeobject_newsub(interp, interp->builtinscope);
+	if (!scope) {
+		OBJECT_DECREF(interp, statements);
+		return NULL;
+	}
+
+	struct Object *block = blockobject_new(interp, scope, statements);
+	OBJECT_DECREF(interp, statements);
+	if (!block) {
+		OBJECT_DECREF(interp, scope);
+		return NULL;
+	}
+
+	bool ok = true;
+	struct MappingObjectIter iter;
+	mappingobject_iterbegin(&iter, vars);
+	while (ok && mappingobject_iternext(&iter))
+		ok = mappingobject_set(interp, SCOPEOBJECT_LOCALVARS(scope), iter.key, iter.value);
+
+	ok = ok && blockobject_run(interp, block, scope);
+	OBJECT_DECREF(interp, block);
+	OBJECT_DECREF(interp, scope);
+	if (!ok)
+		return NULL;
+
+	OBJECT_INCREF(interp, interp->builtins.none);
+	return interp->builtins.none;
+}
+
+// RETURNS A NEW REFERENCE or NULL on error
+static struct Object *run_function(struct Interpreter *interp, struct Object *input)
+{
+	// [filename path funcname args], created by threads_start_function()
+	assert(input->klass == interp->builtins.Array && ARRAYOBJECT_LEN(input) == 4);
+	struct Object *func = get_function(interp, ARRAYOBJECT_GET(input, 0), ARRAYOBJECT_GET(input, 1), ARRAYOBJECT_GET(input, 2));
+	if (!func)
+		return NULL;
+	struct Object *res = call_function(interp, func, ARRAYOBJECT_GET(input, 3));
+	OBJECT_DECREF(interp, func);
+	return res;
+}
+
+static void print_and_reset_err(struct Interpreter *interp)
+{
+	struct Object *err = interp->err;
+	interp->err = NULL;
+	errorobject_print(interp, err);
+	OBJECT_DECREF(interp, err);
+}
+
+// RETURNS A NEW REFERENCE or NULL on error
+// *func and *funcinfo are the function of the previous task and [filename path funcname] of it, or NULL
+static struct Object *call_task(struct Interpreter *interp, struct Object *task, struct Object **func, struct Object **funcinfo)
+{
+	// [results filename path funcname index item], std/threads.ö creates these
+	if (!check_type(interp, interp->builtins.Array, task))
+		return NULL;
+	if (ARRAYOBJECT_LEN(task) != 6) {
+		errorobject_throwfmt(interp, "ValueError", "invalid task: %D", task);
+		return NULL;
+	}
+	if (!check_type(interp, interp->builtins.Channel, ARRAYOBJECT_GET(task, 0)))
+		return NULL;
+	for (size_t i=1; i <= 3; i++) {
+		if (!check_type(interp, interp->builtins.String, ARRAYOBJECT_GET(task, i)))
+			return NULL;
+	}
+
+	// importing again for every task would be slow
+	bool same = !!*funcinfo;
+	for (size_t i=0; same && i < 3; i++)
+		same = stringobject_equal(ARRAYOBJECT_GET(*funcinfo, i), ARRAYOBJECT_GET(task, i+1));
+
+	if (!same) {
+		if (*func) {
+			OBJECT_DECREF(interp, *func);
+			OBJECT_DECREF(interp, *funcinfo);
+			*func = *funcinfo = NULL;
+		}
+		struct Object *f = get_function(interp, ARRAYOBJECT_GET(task, 1), ARRAYOBJECT_GET(task, 2), ARRAYOBJECT_GET(task, 3));
+		if (!f)
+			return NULL;
+		if (!(*funcinfo = arrayobject_slice(interp, task, 1, 4))) {
+			OBJECT_DECREF(interp, f);
+			return NULL;
+		}
+		*func = f;
+	}
+
+	struct Object *args = arrayobject_new(interp, &ARRAYOBJECT_GET(task, 5), 1);
+	if (!args)
+		return NULL;
+	struct Object *res = call_function(interp, *func, args);
+	OBJECT_DECREF(interp, args);
+	return res;
+}
+
+/*
+runs a task and sends [index true returnvalue] or [index false errorclassname errormessage] to its results channel
+if even that fails, the error is printed and the results channel is closed, so that the map doesn't wait forever
+never fails, so that one bad task doesn't kill the worker
+*/
+static void run_task(struct Interpreter *interp, struct Object *task, struct Object **func, struct Object **funcinfo)
+{
+	struct Object *res = call_task(interp, task, func, funcinfo);
+
+	// a task that is too broken to run may still have a results channel and an index
+	struct ChannelData *results = NULL;
+	struct Object *index = interp->builtins.none;
+	if (task->klass == interp->builtins.Array && ARRAYOBJECT_LEN(task) >= 1 && ARRAYOBJECT_GET(task, 0)->klass == interp->builtins.Channel)
+		results = CHANNELOBJECT_DATA(ARRAYOBJECT_GET(task, 0));
+	if (task->klass == interp->builtins.Array && ARRAYOBJECT_LEN(task) >= 5)
+		index = ARRAYOBJECT_GET(task, 4);
+
+	struct SerializeBuf buf = {0};
+	bool ok = threads_dumpresult(interp, index, res, &buf, true);
+	if (res)
+		OBJECT_DECREF(interp, res);
+
+	if (ok && results) {
+		// 0 means that the results channel was closed, e.g. the map gave up before getting all results
+		if (channeldata_send(results, buf.data, buf.len) != -1)
+			return;
+		errorobject_thrownomem(interp);
+	} else if (ok) {
+		serialize_discard(buf.data, buf.len);
+		free(buf.data);
+		errorobject_throwfmt(interp, "ValueError", "invalid task: %D", task);
+	} else {
+		free(buf.data);
+	}
+
+	fprintf(stderr, "%s: a worker thread failed, and sending the error to the pool failed too:\n", interp->argv0);
+	print_and_reset_err(interp);
+	if (results)
+		channeldata_close(results);
+}
+
+// RETURNS A NEW REFERENCE to none, errors from tasks go to their results channels instead
+static struct Object *run_worker(struct Interpreter *interp, struct Object *tasks)
+{
+	assert(tasks->klass == interp->builtins.Channel);
+	struct Object *func = NULL, *funcinfo = NULL;
+
+	unsigned char *data;
+	size_t len;
+	while (channeldata_receive(CHANNELOBJECT_DATA(tasks), &data, &len)) {
+		size_t pos = 0;
+		struct Object *task = serialize_load(interp, data, len, &pos);
+		if (task) {
+			run_task(interp, task, &func, &funcinfo);
+			OBJECT_DECREF(interp, task);
+		} else {
+			// the data came from serialize_dump(), so this is most likely no mem
+			// closing the results channel tells the map that it won't get a result for this task
+			fprintf(stderr, "%s: a worker thread failed to receive a task:\n", interp->argv0);
+			print_and_reset_err(interp);
+			struct ChannelData *results = serialize_peekchannel(data, len);
+			if (results)
+				channeldata_close(results);
+		}
+		serialize_discard(data, len);
+		free(data);
+	}
+
+	if (func) {
+		OBJECT_DECREF(interp, func);
+		OBJECT_DECREF(interp, funcinfo);
+	}
+	OBJECT_INCREF(interp, interp->builtins.none);
+	return interp->builtins.none;
+}
+
+static void run_thread(struct Interpreter *interp, struct ThreadData *td)
+{
+	size_t pos = 0;
+	struct Object *input = serialize_load(interp, td->input.data, td->input.len, &pos);
+	struct Object *res = NULL;
+	if (input) {
+		switch(td->kind) {
+		case THREAD_BLOCK:
+			res = run_block(interp, td, input);
+			break;
+		case THREAD_FUNCTION:
+			res = run_function(interp, input);
+			break;
+		case THREAD_WORKER:
+			res = run_worker(interp, input);
+			break;
+		}
+		OBJECT_DECREF(interp, input);
+	}
+
+	bool ok = threads_dumpresult(interp, NULL, res, &td->result, true);
+	if (res)
+		OBJECT_DECREF(interp, res);
+	if (!ok) {
+		// td->result stays empty, and joining the thread tells the user to look at this
+		fprintf(stderr, "%s: a thread failed, and sending the error to the thread that started it failed too:\n", interp->argv0);
+		print_and_reset_err(interp);
+	}
+}
+
+static void *thread_main(void *arg)
+{
+	struct ThreadData *td = arg;
+
+	// these print their errors
+	struct Interpreter *interp = interpreter_new(td->argv0);
+	if (interp) {
+		if (heapimage_loadfromexe(interp))
+			run_thread(interp, td);
+		else if (builtins_setup(interp)) {
+			if (run_builtinsfile(interp))
+				run_thread(interp, td);
+			else
+				print_and_reset_err(interp);
+		}
+		builtins_teardown(interp);
+		gc_run(interp);
+		interpreter_free(interp);
+	}
+
+	threaddata_decref(td);
+	return NULL;
+}
+
+
+static void thread_foreachref(void *data, object_foreachrefcb cb, void *cbdata)
+{
+	struct ThreadObjectData *tdata = data;
+	if (tdata->result)
+		cb(tdata->result, cbdata);
+}
+
+static void thread_destructor(void *data)
+{
+	struct ThreadObjectData *tdata = data;
+	if (!tdata->joined) {
+		// the thread keeps running, and the last threaddata_decref() frees stuff
+		pthread_detach(tdata->td->tid);
+	}
+	threaddata_decref(tdata->td);
+	free(tdata);
+}
+
+// creates a Thread object and starts running td in it, td->kind and input stuff must be set
+// RETURNS A NEW REFERENCE or NULL on error, td is freed on error
+static struct Object *start_thread(struct Interpreter *interp, struct ThreadData *td)
+{
+	td->refcount = 1;
+	td->result = (struct SerializeBuf){0};
+	if (!(td->argv0 = malloc(strlen(interp->argv0) + 1))) {
+		errorobject_thrownomem(interp);
+		threaddata_decref(td);
+		return NULL;
+	}
+	strcpy(td->argv0, interp->argv0);
+
+	struct ThreadObjectData *data = malloc(sizeof *data);
+	if (!data) {
+		errorobject_thrownomem(interp);
+		threaddata_decref(td);
+		return NULL;
+	}
+	data->td = td;
+	data->joined = true;    // there's nothing to join or detach until the thread is started
+	data->result = NULL;
+
+	struct Object *thread = object_new_noerr(interp, interp->builtins.Thread, (struct ObjectData){.data=data, .foreachref=thread_foreachref, .destructor=thread_destructor});
+	if (!thread) {
+		errorobject_thrownomem(interp);
+		free(data);
+		threaddata_decref(td);
+		return NULL;
+	}
+
+	pthread_attr_t attr;
+	int status = pthread_attr_init(&attr);
+	if (status == 0) {
+		// ignore errors, the default stack size is better than nothing
+		pthread_attr_setstacksize(&attr, THREAD_STACK_SIZE);
+		/*
+		the sampler's SIGPROF handler reads the stack of the sampled interpreter, and the kernel
+		can deliver the signal to any thread of the process, so new threads must never get it
+		the signal mask is inherited, so blocking it here means that the thread never runs unblocked
+		*/
+		sigset_t block, old;
+		sigemptyset(&block);
+		sigaddset(&block, SIGPROF);
+		int maskstatus = pthread_sigmask(SIG_BLOCK, &block, &old);
+
+		ATOMIC_INCR(td->refcount);    // for the thread
+		status = maskstatus != 0 ? maskstatus : pthread_create(&td->tid, &attr, thread_main, td);
+		if (status != 0)
+			ATOMIC_DECR(td->refcount);
+		if (maskstatus == 0)
+			pthread_sigmask(SIG_SETMASK, &old, NULL);
+		pthread_attr_destroy(&attr);
+	}
+	if (status != 0) {
+		errorobject_throwfmt(interp, "ValueError", "cannot start a thread: %s", strerror(status));
+		OBJECT_DECREF(interp, thread);
+		return NULL;
+	}
+
+	data->joined = false;
+	return thread;
+}
+
+static struct ThreadData *new_threaddata(struct Interpreter *interp, enum ThreadKind kind)
+{
+	struct ThreadData *td = calloc(1, sizeof *td);
+	if (!td) {
+		errorobject_thrownomem(interp);
+		return NULL;
+	}
+	td->kind = kind;
+	return td;
+}
+
+struct Object *threads_start_block(struct Interpreter *interp, struct ObjectData nulldata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, interp->builtins.Block, interp->builtins.Mapping, NULL)) return NULL;
+	if (!check_no_opts(interp, opts)) return NULL;
+
+	struct Object *statements = BLOCKOBJECT_ASTSTMTS(ARRAYOBJECT_GET(args, 0));
+	for (size_t i=0; i < ARRAYOBJECT_LEN(statements); i++) {
+		if (!check_type(interp, interp->builtins.AstNode, ARRAYOBJECT_GET(statements, i)))
+			return NULL;
+	}
+
+	// a block comes from one file, so the first statement's filename is good for all statements
+	char *filename = "<thread>";
+	if (ARRAYOBJECT_LEN(statements) != 0)
+		filename = ((struct AstNodeObjectData *) ARRAYOBJECT_GET(statements, 0)->objdata.data)->filename;
+
+	struct ThreadData *td = new_threaddata(interp, THREAD_BLOCK);
+	if (!td)
+		return NULL;
+	if (!(td->filename = malloc(strlen(filename) + 1))) {
+		errorobject_thrownomem(interp);
+		free(td);
+		return NULL;
+	}
+	strcpy(td->filename, filename);
+
+	if (!astcache_dump(interp, statements, (struct AstCacheSource){ .hash = 0, .size = 0, .mtime = 0 }, &td->ast, &td->astlen) ||
+		!serialize_dump(interp, ARRAYOBJECT_GET(args, 1), &td->input))
+	{
+		free(td->ast);
+		free(td->input.data);
+		free(td->filename);
+		free(td);
+		return NULL;
+	}
+	return start_thread(interp, td);
+}
+
+struct Object *threads_start_function(struct Interpreter *interp, struct ObjectData nulldata, struct Object *args, struct Object *opts)
+{
+	struct Object *String = interp->builtins.String;
+	if (!check_args(interp, args, String, String, String, interp->builtins.Array, NULL)) return NULL;
+	if (!check_no_opts(interp, opts)) return NULL;
+
+	struct ThreadData *td = new_threaddata(interp, THREAD_FUNCTION);
+	if (!td)
+		return NULL;
+	// args is [filename path funcname args], and that's what run_function() wants
+	if (!serialize_dump(interp, args, &td->input)) {
+		free(td->input.data);
+		free(td);
+		return NULL;
+	}
+	return start_thread(interp, td);
+}
+
+struct Object *threads_start_worker(struct Interpreter *interp, struct ObjectData nulldata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, interp->builtins.Channel, NULL)) return NULL;
+	if (!check_no_opts(interp, opts)) return NULL;
+
+	struct ThreadData *td = new_threaddata(interp, THREAD_WORKER);
+	if (!td)
+		return NULL;
+	if (!serialize_dump(interp, ARRAYOBJECT_GET(args, 0), &td->input)) {
+		free(td->input.data);
+		free(td);
+		return NULL;
+	}
+	return start_thread(interp, td);
+}
+
+
+#define THREADOBJECT_DATA(obj) ((struct ThreadObjectData *) (obj)->objdata.data)
+
+// waits for the thread to finish, then sets data->result or throws the thread's error
+static bool join_thread(struct Interpreter *interp, struct ThreadObjectData *data)
+{
+	if (!data->joined) {
+		pthread_join(data->td->tid, NULL);
+		data->joined = true;
+	}
+	if (data->result)
+		return true;
+
+	struct ThreadData *td = data->td;
+	if (td->result.len == 0) {
+		errorobject_throwfmt(interp, "ValueError", "the thread failed, see the error message that it printed");
+		return false;
+	}
+
+	// the result is loaded again on each call if it's an error, so that the error is thrown every time
+	size_t pos = 0;
+	struct Object *res = serialize_load(interp, td->result.data, td->result.len, &pos);
+	if (!res)
+		return false;
+
+	// [true returnvalue] or [false errorclassname errormessage] from threads_dumpresult()
+	if (ARRAYOBJECT_GET(res, 0) == interp->builtins.yes) {
+		data->result = ARRAYOBJECT_GET(res, 1);
+		OBJECT_INCREF(interp, data->result);
+		OBJECT_DECREF(interp, res);
+		return true;
+	}
+	threads_throwlike(interp, ARRAYOBJECT_GET(res, 1), ARRAYOBJECT_GET(res, 2));
+	OBJECT_DECREF(interp, res);
+	return false;
+}
+
+static bool join(struct Interpreter *interp, struct ObjectData thisdata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, NULL)) return false;
+	if (!check_no_opts(interp, opts)) return false;
+	return join_thread(interp, THREADOBJECT_DATA((struct Object *) thisdata.data));
+}
+
+static struct Object *result_getter(struct Interpreter *interp, struct ObjectData nulldata, struct Object *args, struct Object *opts)
+{
+	if (!check_args(interp, args, interp->builtins.Thread, NULL)) return NULL;
+	if (!check_no_opts(interp, opts)) return NULL;
+
+	struct ThreadObjectData *data = THREADOBJECT_DATA(ARRAYOBJECT_GET(args, 0));
+	if (!join_thread(interp, data))
+		return NULL;
+	OBJECT_INCREF(interp, data->result);
+	return data->result;
+}
+
+static struct Object *newinstance(struct Interpreter *interp, struct Object *args, struct Object *opts)
+{
+	errorobject_throwfmt(interp, "TypeError", "Thread objects can't be created with new, use threads.start or threads.start_function");
+	return NULL;
+}
+
+struct Object *threadobject_createclass(struct Interpreter *interp)
+{
+	struct Object *klass = classobject_new(interp, "Thread", interp->builtins.Object, newinstance);
+	if (!klass)
+		return NULL;
+
+	if (!attribute_add(interp, klass, "result", result_getter, NULL)) goto error;
+	if (!method_add_noret(interp, klass, "join", join)) goto error;
+	return klass;
+
+error:
+	OBJECT_DECREF(interp, klass);
+	return NULL;
+}
@@ -0,0 +1,56 @@
+// running ö code in other threads, each thread has an interpreter of its own, see std/threads.ö
+#ifndef THREADS_H
+#define THREADS_H
+
+#include <stdbool.h>
+#include "interpreter.h"     // IWYU pragma: keep
+#include "objectsystem.h"    // IWYU pragma: keep
+#include "serialize.h"
+
+// RETURNS A NEW REFERENCE or NULL on error
+struct Object *threadobject_createclass(struct Interpreter *interp);
+
+/* built-in functions that std/threads.ö deletes from the built-in scope
+
+threads_start_block takes a Block and a Mapping of variables for it
+the block runs in a new interpreter, in a subscope of its built-in scope that contains copies of the variables
+the block can't see other variables of the interpreter that started it, so e.g. libraries must be imported again in the block
+
+threads_start_function takes 4 arguments, filename, path, funcname and an Array of arguments
+it imports path in the new interpreter like a file named filename would import it,
+and calls the funcname function of the library with the args Array
+
+threads_start_worker takes a Channel, receives tasks from it and sends results until it's closed
+tasks are Arrays of [results filename path funcname index item], and results are sent to the results channel
+the result is [index true returnvalue] or [index false errorclassname errormessage]
+if the result can't be sent, the worker prints the error and closes the results channel, and keeps running
+
+these return Thread objects
+*/
+struct Object *threads_start_block(struct Interpreter *interp, struct ObjectData nulldata, struct Object *args, struct Object *opts);
+struct Object *threads_start_function(struct Interpreter *interp, struct ObjectData nulldata, struct Object *args, struct Object *opts);
+struct Object *threads_start_worker(struct Interpreter *interp, struct ObjectData nulldata, struct Object *args, struct Object *opts);
+
+// returns the filename of the innermost stack frame that isn't in the same file as the code that called this
+// std/threads.ö uses it for importing relative to the file that called a threads function, import does the same
+struct Object *threads_caller_filename(struct Interpreter *interp, struct ObjectData nulldata, struct Object *args, struct Object *opts);
+
+// takes the class name and message of an error from another interpreter as Strings, and throws a similar error
+// this one returns false like other non-returning functions
+bool threads_throw(struct Interpreter *interp, struct ObjectData nulldata, struct Object *args, struct Object *opts);
+
+/* dumps [index true val] to buf, or [index false errorclassname errormessage] if val is NULL
+if index is NULL, it's left out
+
+if val is NULL, interp->err must be set, and it's cleared when it has been turned into an error result
+if val can't be serialized, the resulting error is dumped instead
+channels in val are dumped with serialize_dump() if allowchannels is true, otherwise they are an error
+returns false on error
+*/
+bool threads_dumpresult(struct Interpreter *interp, struct Object *index, struct Object *val, struct SerializeBuf *buf, bool allowchannels);
+
+// throws an error like one that was thrown in another interpreter, given its class name and message as Strings
+// non-builtin error classes become ValueErrors
+void threads_throwlike(struct Interpreter *interp, struct Object *klassname, struct Object *msg);
+
+#endif    // THREADS_H
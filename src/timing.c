@@ -0,0 +1,82 @@
+// clock_gettime() is posix, not c99
+#define _POSIX_C_SOURCE 199309L
+
+#include "timing.h"
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+
+static uint64_t timespec_to_ns(struct timespec ts)
+{
+	return (uint64_t)ts.tv_sec*1000000000 + (uint64_t)ts.tv_nsec;
+}
+
+uint64_t timing_monotonic_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return timespec_to_ns(ts);
+}
+
+bool timing_threadcpu_ns(uint64_t *res)
+{
+#ifdef CLOCK_THREAD_CPUTIME_ID
+	struct timespec ts;
+	if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0)
+		return false;
+	*res = timespec_to_ns(ts);
+	return true;
+#else
+	return false;
+#endif
+}
+
+
+static int compare_uint64(const void *a, const void *b)
+{
+	uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+	return (x > y) - (x < y);
+}
+
+// sqrt() would need -lm
+static uint64_t isqrt(long double x)
+{
+	if (x < 1)
+		return 0;
+	long double guess = x;
+	for (int i=0; i < 100; i++) {
+		long double next = (guess + x/guess) / 2;
+		if (next >= guess)
+			break;
+		guess = next;
+	}
+	return (uint64_t)guess;
+}
+
+struct TimingSummary timing_summarize(uint64_t *values, size_t n)
+{
+	assert(n != 0);
+	qsort(values, n, sizeof(uint64_t), compare_uint64);
+
+	// long double because the sums can be too big for uint64_t
+	long double sum = 0;
+	for (size_t i=0; i < n; i++)
+		sum += values[i];
+	long double mean = sum / n;
+
+	long double sqsum = 0;
+	for (size_t i=0; i < n; i++)
+		sqsum += (values[i] - mean)*(values[i] - mean);
+
+	struct TimingSummary res;
+	res.min = values[0];
+	res.max = values[n-1];
+	res.mean = (uint64_t)mean;
+	res.median = (n % 2 == 1) ? values[n/2] : values[n/2 - 1] + (values[n/2] - values[n/2 - 1])/2;
+	res.p99 = values[(n*99 + 99) / 100 - 1];   // nearest rank, i.e. ceil(0.99*n)th smallest value
+	res.stddev = isqrt(sqsum / n);
+	return res;
+}
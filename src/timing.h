@@ -0,0 +1,27 @@
+// clocks and statistics for profiler.c and <std>/time
+#ifndef TIMING_H
+#define TIMING_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// nanoseconds since some unspecified point in the past, never goes backwards, never fails
+uint64_t timing_monotonic_ns(void);
+
+// cpu time used by the calling thread in nanoseconds
+// returns false if the operating system doesn't support this
+bool timing_threadcpu_ns(uint64_t *res);
+
+struct TimingSummary {
+	uint64_t min, max;
+	uint64_t mean;
+	uint64_t median;
+	uint64_t p99;       // 99% of the values are less than or equal to this
+	uint64_t stddev;    // population standard deviation, rounded down
+};
+
+// sorts the values in place, n must not be 0, never fails
+struct TimingSummary timing_summarize(uint64_t *values, size_t n);
+
+#endif   // TIMING_H
@@ -1,54 +1,72 @@
-// TODO: fix tokenizing empty files
-// TODO: add error objects
 #include "tokenizer.h"
 #include <assert.h>
 #include <stdbool.h>
-#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+#include "objects/errors.h"
 #include "unicode.h"
+#include "utf8.h"
 
 
-// creates a token of first nchars chars of hugestring
-static struct Token *new_token(struct Interpreter *interp, struct Token *prev, char kind, struct UnicodeString hugestring, size_t nchars, size_t lineno)
+// a guess of how many tokens a file has, it doesn't matter much if this is wrong
+// most tokens are short, and there's usually whitespace between them
+#define TOKENS_PER_BYTE_GUESS(nbytes) ((nbytes)/4 + 16)
+
+// adds a token of first nbytes bytes of hugestring to the end of arr
+// one extra slot is always left for the TOKEN_END token
+static bool add_token(struct Interpreter *interp, struct TokenArray *arr, char kind, struct TokenString hugestring, size_t nbytes, size_t lineno)
 {
-	struct Token *tok = malloc(sizeof (struct Token));
-	if (!tok)
-		return NULL;
-
-	hugestring.len = nchars;    // it's pass-by-value
-	if (!unicodestring_copyinto(interp, hugestring, &(tok->str))) {
-		free(tok);
-		return NULL;
+	if (arr->len + 2 > arr->nallocated) {
+		// allocating more than this is not possible because realloc takes size_t
+		if (arr->nallocated > (SIZE_MAX / sizeof(struct Token))/2) {
+			errorobject_thrownomem(interp);
+			return false;
+		}
+		size_t newnallocated = 2*arr->nallocated;
+		void *ptr = realloc(arr->tokens, newnallocated * sizeof(struct Token));
+		if (!ptr) {
+			errorobject_thrownomem(interp);
+			return false;
+		}
+		arr->tokens = ptr;
+		arr->nallocated = newnallocated;
 	}
 
-	tok->kind = kind;
-	tok->lineno = lineno;
-	tok->next = NULL;
-	if (prev)
-		prev->next = tok;
-	return tok;
+	hugestring.len = nbytes;    // it's pass-by-value
+	arr->tokens[arr->len++] = (struct Token){ .kind = kind, .str = hugestring, .lineno = lineno };
+	return true;
 }
 
 
-void token_freeall(struct Token *tok1st)
+void tokenarray_free(struct TokenArray arr)
 {
-	struct Token *tok = tok1st;
-	while (tok) {
-		struct Token *tok2 = tok->next;   // must be before free(tok)
-		free(tok->str.val);
-		free(tok);
-		tok = tok2;
+	// the tokens don't own anything, they just point to the source code
+	free(arr.tokens);
+}
+
+
+// decodes the first character of utf8 to *c, utf8len must not be 0
+// returns the number of bytes the character uses, or -1 on error
+// most code is ascii, and that's handled here without calling anything in utf8.c
+static int get_char(struct Interpreter *interp, char *utf8, size_t utf8len, unicode_char *c)
+{
+	if ((unsigned char)utf8[0] < 0x80) {
+		*c = utf8[0];
+		return 1;
 	}
+	return utf8_decodechar(interp, utf8, utf8len, c);
 }
 
 
 // returns true iff an integer literal is valid
-static bool check_integer(struct UnicodeString hugestring, size_t nchars, size_t lineno)
+static bool check_integer(struct Interpreter *interp, struct TokenString hugestring, size_t nbytes, size_t lineno)
 {
-	assert(nchars >= 1);  // token_ize() should handle this
+	assert(nbytes >= 1);  // token_ize() should handle this
 
 	// any single-digit integer is valid, including 0
-	if (nchars == 1)
+	if (nbytes == 1)
 		return 1;
 
 	/*
@@ -63,148 +81,161 @@ static bool check_integer(struct UnicodeString hugestring, size_t nchars, size_t
 	*/
 	if (hugestring.val[0] == '0') {
 		// FIXME: better error message
-		fprintf(stderr, "line %llu: leading zeros are not allowed\n", (unsigned long long) lineno);
+		errorobject_throwfmt(interp, "ValueError", "line %L: leading zeros are not allowed", (long long)lineno);
 		return 0;
 	}
 	return 1;
 }
 
 
-// TODO: better error handling than fprintf
 // TODO: test the error cases :(
-struct Token *token_ize(struct Interpreter *interp, struct UnicodeString hugestring)
+bool token_ize(struct Interpreter *interp, char *utf8, size_t utf8len, struct TokenArray *arr)
 {
+	// the utf8 is tokenized as is, decoding all of it to a UnicodeString first would be slow
+	struct TokenString hugestring = { .val = utf8, .len = utf8len };
 	size_t lineno=1;
-	struct Token *tok1st = NULL;
-	struct Token *curtok = NULL;
 	char kind;
-	size_t nchars;    // comparing size_t with size_t produces no warnings
+	size_t nbytes;    // comparing size_t with size_t produces no warnings
+	unicode_char c;
+	int clen;
+
+	arr->len = 0;
+	arr->nallocated = TOKENS_PER_BYTE_GUESS(utf8len);
+	if (!(arr->tokens = malloc(arr->nallocated * sizeof(struct Token)))) {
+		errorobject_thrownomem(interp);
+		return false;
+	}
 
 	while (hugestring.len) {
-		if (unicode_isspace(hugestring.val[0])) {
-			if (hugestring.val[0] == '\n')   // handles \r\n because the \r is ignored
+		if ((clen = get_char(interp, hugestring.val, hugestring.len, &c)) == -1)
+			goto error;
+
+		if (unicode_isspace(c)) {
+			if (c == '\n')   // handles \r\n because the \r is ignored
 				lineno++;
-			hugestring.val++;
-			hugestring.len--; 
+			hugestring.val += clen;
+			hugestring.len -= clen;
 			continue;
 		}
 
-		else if (hugestring.val[0] == '#') {
+		else if (c == '#') {
+			// the comment is decoded just to make sure that it's valid utf8
 			while (hugestring.len && hugestring.val[0] != '\n') {
-				hugestring.val++;
-				hugestring.len--;
+				if ((clen = get_char(interp, hugestring.val, hugestring.len, &c)) == -1)
+					goto error;
+				hugestring.val += clen;
+				hugestring.len -= clen;
 			}
 			continue;
 		}
 
 		// operators with 2 chars must be before 1-char operators
 		// e.g. == must be 1 operator, not 2
+		// these are all ascii, so the bytes can be compared directly
 #define f(x, y) (hugestring.len >= 2 && hugestring.val[0] == (x) && hugestring.val[1] == (y))
 		else if (f('=','=')||f('!','=')||f('>','=')||f('<','=')) {
 #undef f
 			kind = TOKEN_OP;
-			nchars = 2;
+			nbytes = 2;
 		}
 
-#define f(x) (hugestring.val[0]==(x))
+#define f(x) (c==(x))
 		else if (f('{')||f('}')||f('[')||f(']')||f('(')||f(')')||f('=')||f(';')||f('.')||f(':')||f('`')||
 				f('+')||f('-')||f('*')||f('/')||f('<')||f('>')) {
 #undef f
 			kind = TOKEN_OP;
-			nchars = 1;
-		}
-
-		else if (hugestring.len >= 4 &&
-				hugestring.val[0] == 'v' &&
-				hugestring.val[1] == 'a' &&
-				hugestring.val[2] == 'r' &&
-				!unicode_isidentifiernot1st(hugestring.val[3])) {
-			kind = TOKEN_KEYWORD;
-			nchars = 3;
+			nbytes = 1;
 		}
 
-		else if (hugestring.val[0] == '"') {
+		else if (c == '"') {
 			kind = TOKEN_STR;
-			nchars = 1;    // first "
+			nbytes = 1;    // first "
 
 			while (1) {
-				if (hugestring.len == nchars || hugestring.val[nchars] == '\n') {
+				if (hugestring.len == nbytes || hugestring.val[nbytes] == '\n') {
 					// end of line or file
-					fprintf(stderr, "line %llu: ending \" must be on the same line as starting \"\n", (unsigned long long)lineno);
+					errorobject_throwfmt(interp, "ValueError", "line %L: ending \" must be on the same line as starting \"", (long long)lineno);
 					goto error;
 				}
-				// now we know that hugestring.val[nchars] is not an error
-				if (hugestring.val[nchars] == '"') {
-					nchars++;
+				// now we know that hugestring.val[nbytes] is not an error
+				if (hugestring.val[nbytes] == '"') {
+					nbytes++;
 					break;
 				}
-				if (hugestring.val[nchars] == '\\') {
+				if (hugestring.val[nbytes] == '\\') {
 					// make sure that the escape is correct, it's actually parsed in parse.c
-					nchars++;
-					if (hugestring.len == nchars) {
-						fprintf(stderr, "line %llu: the file shouldn't end after \\\n", (unsigned long long)lineno);
+					nbytes++;
+					if (hugestring.len == nbytes) {
+						errorobject_throwfmt(interp, "ValueError", "line %L: the file shouldn't end after \\", (long long)lineno);
 						goto error;
 					}
 					// supported escapes:  \n \t \\ \"
-					if (hugestring.val[nchars] != 'n' &&
-						hugestring.val[nchars] != 't' &&
-						hugestring.val[nchars] != '\\' &&
-						hugestring.val[nchars] != '"')
+					if (hugestring.val[nbytes] != 'n' &&
+						hugestring.val[nbytes] != 't' &&
+						hugestring.val[nbytes] != '\\' &&
+						hugestring.val[nbytes] != '"')
 					{
-						fprintf(stderr, "line %llu: unknown escape\n", (unsigned long long)lineno);
+						errorobject_throwfmt(interp, "ValueError", "line %L: unknown escape", (long long)lineno);
 						goto error;
 					}
-					nchars++;
+					nbytes++;
+				}
+				else {
+					// parse.c decodes this later, but it must be valid utf8
+					if ((clen = get_char(interp, hugestring.val + nbytes, hugestring.len - nbytes, &c)) == -1)
+						goto error;
+					nbytes += clen;
 				}
-				else
-					nchars++;
 			}
 		}
 
-		else if ('0' <= hugestring.val[0] && hugestring.val[0] <= '9') {
+		else if ('0' <= c && c <= '9') {
 			kind = TOKEN_INT;
-			nchars = 0;
-			while (hugestring.len > nchars && '0' <= hugestring.val[nchars] && hugestring.val[nchars] <= '9')
-				nchars++;
-			if (!check_integer(hugestring, nchars, lineno))
+			nbytes = 0;
+			while (hugestring.len > nbytes && '0' <= hugestring.val[nbytes] && hugestring.val[nbytes] <= '9')
+				nbytes++;
+			if (!check_integer(interp, hugestring, nbytes, lineno))
 				goto error;
 		}
 
-		else if (unicode_isidentifier1st(hugestring.val[0])) {
+		else if (unicode_isidentifier1st(c)) {
 			kind = TOKEN_ID;
-			nchars = 0;
-			while (hugestring.len > nchars && unicode_isidentifiernot1st(hugestring.val[nchars]))
-				nchars++;
+			nbytes = clen;
+			while (hugestring.len > nbytes) {
+				if ((clen = get_char(interp, hugestring.val + nbytes, hugestring.len - nbytes, &c)) == -1)
+					goto error;
+				if (!unicode_isidentifiernot1st(c))
+					break;
+				nbytes += clen;
+			}
+
+			if (nbytes == 3 && memcmp(hugestring.val, "var", 3) == 0)
+				kind = TOKEN_KEYWORD;
 		}
 
 		else {
 			// TODO: better error message
-			fprintf(stderr, "line %llu: unknown token\n", (unsigned long long)lineno);
+			errorobject_throwfmt(interp, "ValueError", "line %L: unknown token", (long long)lineno);
 			goto error;
 		}
 
-		if (hugestring.len < nchars) {
-			fprintf(stderr, "unexpected end of file\n");
+		if (hugestring.len < nbytes) {
+			errorobject_throwfmt(interp, "ValueError", "unexpected end of file");
 			goto error;
 		}
 
-		if (tok1st)
-			curtok = new_token(interp, curtok, kind, hugestring, nchars, lineno);
-		else
-			tok1st = curtok = new_token(interp, NULL, kind, hugestring, nchars, lineno);
-		if (!curtok)
+		if (!add_token(interp, arr, kind, hugestring, nbytes, lineno))
 			goto error;
-		hugestring.val += nchars;    // must be after new_token()
-		hugestring.len -= nchars;
+		hugestring.val += nbytes;    // must be after add_token()
+		hugestring.len -= nbytes;
 	}
 
-	// new_token sets nexts correctly for everything except the last token
-	curtok->next = NULL;
-
-	return tok1st;
+	// add_token() always leaves room for this
+	hugestring.len = 0;
+	arr->tokens[arr->len] = (struct Token){ .kind = TOKEN_END, .str = hugestring, .lineno = lineno };
+	return true;
 
 error:
-	if (tok1st)
-		token_freeall(tok1st);
-	return NULL;
+	free(arr->tokens);
+	return false;
 }
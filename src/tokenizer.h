@@ -1,24 +1,50 @@
 #ifndef TOKENIZER_H
 #define TOKENIZER_H
 
+#include <stdbool.h>
 #include <stddef.h>
 #include "interpreter.h"    // IWYU pragma: keep
-#include "unicode.h"
 
 #define TOKEN_KEYWORD 'k'
 #define TOKEN_ID 'x'
 #define TOKEN_OP ';'
 #define TOKEN_STR '"'
 #define TOKEN_INT '1'
+#define TOKEN_END '\0'     // always the last token, there are no tokens after this
+
+// a part of the UTF-8 source code, NOT \0-terminated
+// len is in bytes, so e.g. the identifier ö has len 2
+struct TokenString {
+	char *val;
+	size_t len;
+};
 
 struct Token {
 	char kind;
-	struct UnicodeString str;
+
+	// points to the source code passed to token_ize(), nothing is copied
+	// so this must NOT be free()'d, and the source code must not be freed while the token is used
+	struct TokenString str;
+
 	size_t lineno;
-	struct Token *next;
 };
 
-struct Token *token_ize(struct Interpreter *interp, struct UnicodeString hugestring);
-void token_freeall(struct Token *tok1st);
+// all tokens are in one contiguous array instead of allocating each token separately
+// use tokens+1 to get the next token, the array always ends with a TOKEN_END token
+struct TokenArray {
+	struct Token *tokens;
+	size_t len;           // doesn't include the TOKEN_END token
+	size_t nallocated;    // implementation detail
+};
+
+// the tokens refer to utf8, so don't free it before you are done with the tokens
+// utf8 doesn't need to be \0-terminated, and it is never modified (it can be mmap()ed read-only)
+// invalid UTF-8 is an error, even in comments
+// throws an error and returns false on failure
+// on success, tokenarray_free() must be called
+bool token_ize(struct Interpreter *interp, char *utf8, size_t utf8len, struct TokenArray *arr);
+
+// never fails
+void tokenarray_free(struct TokenArray arr);
 
 #endif   // TOKENIZER_H
@@ -3,6 +3,7 @@
 #include <stdarg.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include "interpreter.h"   // IWYU pragma: keep
@@ -47,42 +48,357 @@ invalid_code_point:
 }
 
 
-// example: ONES(6) is 111111 in binary
-#define ONES(n) ((1<<(n))-1)
+/* most text is ascii or almost ascii (e.g. finnish or source code), so runs of ascii
+are converted with sse2 or avx2 when possible, and everything else is done one
+character at a time
 
-bool utf8_encode(struct Interpreter *interp, struct UnicodeString unicode, char **utf8, size_t *utf8len)
+with avx2, utf8_decode() also checks that the whole string is valid before
+decoding anything, so that decoding non-ascii characters doesn't need to check them
+that's done only when the compiler optimizes, because without optimizations every
+intrinsic goes through memory and checking is about as slow as decoding
+
+sse2 is always available on x86_64, avx2 is detected when the program runs
+the simd code assumes that unicode_char is exactly 32 bits, and it usually is
+*/
+#if defined(__SSE2__) && UINT_LEAST32_MAX == 0xffffffffUL
+#define HAVE_SSE2
+#include <emmintrin.h>
+#endif
+
+// __builtin_cpu_supports() and __attribute__((target)) are gcc and clang only
+#if defined(HAVE_SSE2) && defined(__GNUC__) && defined(__x86_64__)
+#define HAVE_AVX2
+#include <immintrin.h>
+#define AVX2_FUNCTION __attribute__((target("avx2")))
+#ifdef __OPTIMIZE__
+#define CHECK_WITH_AVX2
+#endif
+#endif
+
+
+#ifdef HAVE_AVX2
+AVX2_FUNCTION static size_t decode_ascii_avx2(const unsigned char *utf8, size_t utf8len, unicode_char *dst)
 {
-	if (unicode.len == 0) {
-		*utf8 = NULL;
-		*utf8len = 0;
-		return true;
+	size_t i = 0;
+	for (; i+32 <= utf8len; i += 32) {
+		__m256i bytes = _mm256_loadu_si256((const __m256i *)(utf8 + i));
+		if (_mm256_movemask_epi8(bytes) != 0)   // highest bit is set in non-ascii bytes
+			break;
+
+		__m128i lo = _mm256_castsi256_si128(bytes);
+		__m128i hi = _mm256_extracti128_si256(bytes, 1);
+		_mm256_storeu_si256((__m256i *)(dst + i),    _mm256_cvtepu8_epi32(lo));
+		_mm256_storeu_si256((__m256i *)(dst + i+8),  _mm256_cvtepu8_epi32(_mm_srli_si128(lo, 8)));
+		_mm256_storeu_si256((__m256i *)(dst + i+16), _mm256_cvtepu8_epi32(hi));
+		_mm256_storeu_si256((__m256i *)(dst + i+24), _mm256_cvtepu8_epi32(_mm_srli_si128(hi, 8)));
 	}
+	return i;
+}
 
-	// don't set utf8len if this fails
-	size_t utf8len_val = 0;
-	for (size_t i=0; i < unicode.len; i++) {
-		int part = how_many_bytes(interp, unicode.val[i]);
-		if (part == -1)
-			return false;
-		utf8len_val += part;
+AVX2_FUNCTION static size_t encode_ascii_avx2(const unicode_char *src, size_t srclen, char *dst)
+{
+	const __m256i nonascii = _mm256_set1_epi32(~0x7f);
+	// _mm256_packus_* work separately on the 128-bit halves, this puts things back in order
+	const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+	size_t i = 0;
+	for (; i+32 <= srclen; i += 32) {
+		__m256i a = _mm256_loadu_si256((const __m256i *)(src + i));
+		__m256i b = _mm256_loadu_si256((const __m256i *)(src + i+8));
+		__m256i c = _mm256_loadu_si256((const __m256i *)(src + i+16));
+		__m256i d = _mm256_loadu_si256((const __m256i *)(src + i+24));
+		__m256i all = _mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d));
+		if (!_mm256_testz_si256(all, nonascii))
+			break;
+
+		__m256i ab = _mm256_packus_epi32(a, b);
+		__m256i cd = _mm256_packus_epi32(c, d);
+		__m256i abcd = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(ab, cd), order);
+		_mm256_storeu_si256((__m256i *)(dst + i), abcd);
 	}
+	return i;
+}
 
-	char *ptr = malloc(utf8len_val);
-	if (!ptr) {
-		errorobject_thrownomem(interp);
-		return false;
+#ifdef CHECK_WITH_AVX2
+/* checks utf8 like utf8_decodechar() does, 32 bytes at a time
+
+this is the lookup algorithm from "Validating UTF-8 In Less Than One Instruction
+Per Byte" by John Keiser and Daniel Lemire, https://arxiv.org/abs/2010.03090
+each byte is looked up from 3 tables with the high and low 4 bits of the previous
+byte and the high 4 bits of the byte itself, and every bit in the results means
+some kind of error that those bits can have, so anding them together gives
+nonzero only for actual errors
+
+too long or too short sequences with 3 or 4 bytes are found separately, by
+checking that the bytes 2 or 3 bytes after a 3 or 4 byte start are continuations
+*/
+#define TOO_SHORT   (1<<0)    // start byte or ascii after a start byte
+#define TOO_LONG    (1<<1)    // continuation after ascii
+#define OVERLONG_3  (1<<2)    // 3 byte sequence that fits in 2 bytes
+#define TOO_LARGE   (1<<3)    // bigger than U+10FFFF
+#define SURROGATE   (1<<4)    // U+D800 to U+DFFF
+#define OVERLONG_2  (1<<5)    // 2 byte sequence that fits in 1 byte
+#define TOO_LARGE_1000 (1<<6) // bigger than U+10FFFF, with the start byte 0xf5 or bigger
+#define OVERLONG_4  (1<<6)    // 4 byte sequence that fits in 3 bytes
+#define TWO_CONTS   (1<<7)    // two continuations in a row, ok if they're in a 3 or 4 byte sequence
+#define CARRY (TOO_SHORT | TOO_LONG | TWO_CONTS)
+
+// _mm256_shuffle_epi8() looks up from each 128-bit half separately, so the table is repeated
+#define TABLE(a,b,c,d,e,f,g,h,i,j,k,l,m,n,o,p) _mm256_setr_epi8( \
+	(char)(a),(char)(b),(char)(c),(char)(d),(char)(e),(char)(f),(char)(g),(char)(h), \
+	(char)(i),(char)(j),(char)(k),(char)(l),(char)(m),(char)(n),(char)(o),(char)(p), \
+	(char)(a),(char)(b),(char)(c),(char)(d),(char)(e),(char)(f),(char)(g),(char)(h), \
+	(char)(i),(char)(j),(char)(k),(char)(l),(char)(m),(char)(n),(char)(o),(char)(p))
+
+// the last n bytes of previnput followed by input without its last n bytes
+#define PREV(input, previnput, n) _mm256_alignr_epi8((input), _mm256_permute2x128_si256((previnput), (input), 0x21), 16-(n))
+
+struct CheckTables { __m256i byte1high, byte1low, byte2high; };
+
+// creating these for each block would be slow without optimizations
+AVX2_FUNCTION static struct CheckTables create_check_tables(void)
+{
+	struct CheckTables t;
+	t.byte1high = TABLE(
+		// ascii
+		TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+		// continuation
+		TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+		// 2 byte start, 0xc0 and 0xc1 are always overlong
+		TOO_SHORT | OVERLONG_2,
+		TOO_SHORT,
+		// 3 byte start
+		TOO_SHORT | OVERLONG_3 | SURROGATE,
+		// 4 byte start
+		TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4);
+	t.byte1low = TABLE(
+		CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+		CARRY | OVERLONG_2,
+		CARRY,
+		CARRY,
+		CARRY | TOO_LARGE,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000);
+	t.byte2high = TABLE(
+		// ascii
+		TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+		// continuations 0x80 to 0x8f, 0x90 to 0x9f and 0xa0 to 0xbf
+		TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+		TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+		TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+		TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+		// start bytes
+		TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT);
+	return t;
+}
+
+// returns nonzero bytes where input is invalid, previnput is the 32 bytes before it
+AVX2_FUNCTION static __m256i check_block_avx2(const struct CheckTables *t, __m256i input, __m256i previnput)
+{
+	const __m256i lownibble = _mm256_set1_epi8(0x0f);
+	__m256i prev1 = PREV(input, previnput, 1);
+	__m256i special = _mm256_and_si256(
+		_mm256_and_si256(
+			_mm256_shuffle_epi8(t->byte1high, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), lownibble)),
+			_mm256_shuffle_epi8(t->byte1low, _mm256_and_si256(prev1, lownibble))),
+		_mm256_shuffle_epi8(t->byte2high, _mm256_and_si256(_mm256_srli_epi16(input, 4), lownibble)));
+
+	// the highest bit is set where 2 bytes before is a 3 or 4 byte start, or 3 bytes before is a 4 byte start
+	// those must be continuations, and byte2high set TWO_CONTS for them, so xor clears it
+	__m256i third = _mm256_subs_epu8(PREV(input, previnput, 2), _mm256_set1_epi8((char)(0xe0 - 0x80)));
+	__m256i fourth = _mm256_subs_epu8(PREV(input, previnput, 3), _mm256_set1_epi8((char)(0xf0 - 0x80)));
+	__m256i must23 = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8((char)0x80));
+	return _mm256_xor_si256(must23, special);
+}
+
+#undef TOO_SHORT
+#undef TOO_LONG
+#undef OVERLONG_3
+#undef TOO_LARGE
+#undef SURROGATE
+#undef OVERLONG_2
+#undef TOO_LARGE_1000
+#undef OVERLONG_4
+#undef TWO_CONTS
+#undef CARRY
+#undef TABLE
+#undef PREV
+
+// returns true if all of utf8 is valid
+AVX2_FUNCTION static bool check_avx2(const unsigned char *utf8, size_t utf8len)
+{
+	struct CheckTables t = create_check_tables();
+	// bytes bigger than these at the end of a block start a sequence that continues in the next block
+	const __m256i notincomplete = _mm256_setr_epi8(
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, (char)(0xf0-1), (char)(0xe0-1), (char)(0xc0-1));
+
+	__m256i prev = _mm256_setzero_si256();
+	__m256i err = _mm256_setzero_si256();
+	size_t i = 0;
+	for (; i+32 <= utf8len; i += 32) {
+		__m256i input = _mm256_loadu_si256((const __m256i *)(utf8 + i));
+		if (_mm256_movemask_epi8(input) == 0) {
+			// ascii is valid, unless the previous block ended in the middle of a sequence
+			err = _mm256_or_si256(err, _mm256_subs_epu8(prev, notincomplete));
+		} else {
+			err = _mm256_or_si256(err, check_block_avx2(&t, input, prev));
+		}
+		prev = input;
+	}
+
+	// the rest is padded with zeros, so a sequence cut off at the end is followed by ascii, and that's an error
+	// if nothing is left, this checks the end of the last block in the same way
+	unsigned char last[32] = {0};
+	for (size_t j = 0; i+j < utf8len; j++)
+		last[j] = utf8[i+j];
+	err = _mm256_or_si256(err, check_block_avx2(&t, _mm256_loadu_si256((const __m256i *)last), prev));
+	return _mm256_testz_si256(err, err);
+}
+#endif   // CHECK_WITH_AVX2
+#endif   // HAVE_AVX2
+
+
+#ifdef HAVE_SSE2
+static size_t decode_ascii_sse2(const unsigned char *utf8, size_t utf8len, unicode_char *dst)
+{
+	const __m128i zero = _mm_setzero_si128();
+
+	size_t i = 0;
+	for (; i+16 <= utf8len; i += 16) {
+		__m128i bytes = _mm_loadu_si128((const __m128i *)(utf8 + i));
+		if (_mm_movemask_epi8(bytes) != 0)
+			break;
+
+		__m128i lo = _mm_unpacklo_epi8(bytes, zero);   // 8 16-bit values
+		__m128i hi = _mm_unpackhi_epi8(bytes, zero);
+		_mm_storeu_si128((__m128i *)(dst + i),    _mm_unpacklo_epi16(lo, zero));
+		_mm_storeu_si128((__m128i *)(dst + i+4),  _mm_unpackhi_epi16(lo, zero));
+		_mm_storeu_si128((__m128i *)(dst + i+8),  _mm_unpacklo_epi16(hi, zero));
+		_mm_storeu_si128((__m128i *)(dst + i+12), _mm_unpackhi_epi16(hi, zero));
+	}
+	return i;
+}
+
+static size_t encode_ascii_sse2(const unicode_char *src, size_t srclen, char *dst)
+{
+	const __m128i nonascii = _mm_set1_epi32(~0x7f);
+	const __m128i zero = _mm_setzero_si128();
+
+	size_t i = 0;
+	for (; i+16 <= srclen; i += 16) {
+		__m128i a = _mm_loadu_si128((const __m128i *)(src + i));
+		__m128i b = _mm_loadu_si128((const __m128i *)(src + i+4));
+		__m128i c = _mm_loadu_si128((const __m128i *)(src + i+8));
+		__m128i d = _mm_loadu_si128((const __m128i *)(src + i+12));
+		__m128i all = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(all, nonascii), zero)) != 0xffff)
+			break;
+
+		// sse2 has only signed 32-bit packing, but ascii values are small enough for that
+		__m128i ab = _mm_packs_epi32(a, b);
+		__m128i cd = _mm_packs_epi32(c, d);
+		_mm_storeu_si128((__m128i *)(dst + i), _mm_packus_epi16(ab, cd));
+	}
+	return i;
+}
+#endif   // HAVE_SSE2
+
+
+// converts ascii from the beginning of utf8 to dst, stops at the first non-ascii byte
+// returns the number of bytes converted, they're all valid utf8 because ascii is always valid
+static size_t decode_ascii(const unsigned char *utf8, size_t utf8len, unicode_char *dst)
+{
+	size_t i = 0;
+#ifdef HAVE_AVX2
+	if (__builtin_cpu_supports("avx2"))
+		i = decode_ascii_avx2(utf8, utf8len, dst);
+	else
+#endif
+#ifdef HAVE_SSE2
+		i = decode_ascii_sse2(utf8, utf8len, dst);
+#endif
+
+	// the simd functions leave at most a few bytes for this, and it also works without simd
+	for (; i < utf8len && utf8[i] < 0x80; i++)
+		dst[i] = utf8[i];
+	return i;
+}
+
+#ifdef CHECK_WITH_AVX2
+// decodes utf8 that check_avx2() has checked already, returns the number of characters
+static size_t decode_checked(const unsigned char *utf8, size_t utf8len, unicode_char *dst)
+{
+	size_t i = 0, n = 0;
+	while (i < utf8len) {
+		if (utf8[i] < 0x80) {
+			size_t k = decode_ascii(utf8 + i, utf8len - i, dst + n);
+			i += k;
+			n += k;
+		} else if (utf8[i] < 0xe0) {
+			dst[n++] = (unicode_char)(utf8[i] & 0x1f)<<6 | (utf8[i+1] & 0x3f);
+			i += 2;
+		} else if (utf8[i] < 0xf0) {
+			dst[n++] = (unicode_char)(utf8[i] & 0x0f)<<12 | (unicode_char)(utf8[i+1] & 0x3f)<<6 | (utf8[i+2] & 0x3f);
+			i += 3;
+		} else {
+			dst[n++] = (unicode_char)(utf8[i] & 0x07)<<18 | (unicode_char)(utf8[i+1] & 0x3f)<<12 |
+				(unicode_char)(utf8[i+2] & 0x3f)<<6 | (utf8[i+3] & 0x3f);
+			i += 4;
+		}
 	}
+	return n;
+}
+#endif
+
+// like decode_ascii, but the other way
+static size_t encode_ascii(const unicode_char *src, size_t srclen, char *dst)
+{
+	size_t i = 0;
+#ifdef HAVE_AVX2
+	if (__builtin_cpu_supports("avx2"))
+		i = encode_ascii_avx2(src, srclen, dst);
+	else
+#endif
+#ifdef HAVE_SSE2
+		i = encode_ascii_sse2(src, srclen, dst);
+#endif
+
+	for (; i < srclen && src[i] < 0x80; i++)
+		dst[i] = (char)src[i];
+	return i;
+}
+
+
+// example: ONES(6) is 111111 in binary
+#define ONES(n) ((1<<(n))-1)
 
-	// rest of this will not fail
-	*utf8 = ptr;
-	*utf8len = utf8len_val;
+bool utf8_encodeinto(struct Interpreter *interp, struct UnicodeString unicode, char *utf8, size_t *utf8len)
+{
+	char *ptr = utf8;
+	size_t i = 0;
+	while (i < unicode.len) {
+		if (unicode.val[i] <= 0x7f) {
+			size_t n = encode_ascii(unicode.val + i, unicode.len - i, ptr);
+			ptr += n;
+			i += n;
+			continue;
+		}
 
-	for (size_t i=0; i < unicode.len; i++) {
 		int nbytes = how_many_bytes(interp, unicode.val[i]);
 		switch (nbytes) {
-		case 1:
-			ptr[0] = unicode.val[i];
-			break;
+		case -1:
+			// how_many_bytes has already set an error
+			return false;
 		case 2:
 			ptr[0] = ONES(2)<<6 | unicode.val[i]>>6;
 			ptr[1] = 1<<7 | (unicode.val[i] & ONES(6));
@@ -99,11 +415,45 @@ bool utf8_encode(struct Interpreter *interp, struct UnicodeString unicode, char
 			ptr[3] = 1<<7 | (unicode.val[i] & ONES(6));
 			break;
 		default:
-			// computing the length didn't work or how_many_bytes is inconsistent
+			// ascii is handled above
 			assert(0);
 		}
 		ptr += nbytes;
+		i++;
+	}
+
+	*utf8len = ptr - utf8;
+	return true;
+}
+
+bool utf8_encode(struct Interpreter *interp, struct UnicodeString unicode, char **utf8, size_t *utf8len)
+{
+	if (unicode.len == 0) {
+		*utf8 = NULL;
+		*utf8len = 0;
+		return true;
 	}
+
+	// each unicode character is at most 4 utf8 bytes
+	// this is realloc'd later to the correct size, like in utf8_decode
+	if (unicode.len > SIZE_MAX/4) {
+		errorobject_thrownomem(interp);
+		return false;
+	}
+	char *result = malloc(4*unicode.len);
+	if (!result) {
+		errorobject_thrownomem(interp);
+		return false;
+	}
+
+	if (!utf8_encodeinto(interp, unicode, result, utf8len)) {
+		free(result);
+		return false;
+	}
+
+	// shrinking shouldn't fail, but if it does, the bigger buffer works too
+	char *tmp = realloc(result, *utf8len);    // *utf8len isn't 0 because unicode.len isn't 0
+	*utf8 = tmp ? tmp : result;
 	return true;
 }
 
@@ -112,6 +462,75 @@ bool utf8_encode(struct Interpreter *interp, struct UnicodeString unicode, char
 // i don't want to cast a char pointer to unsigned char pointer because i'm not sure if that's standardy
 #define U(x) ((unsigned char)(x))
 
+int utf8_decodechar(struct Interpreter *interp, char *utf8, size_t utf8len, unicode_char *result)
+{
+	assert(utf8len > 0);
+	int nbytes;
+
+#define CHECK_UTF8LEN()       do{ if (utf8len < (size_t)nbytes) { error_printf(interp, "unexpected end of string");           return -1; }}while(0)
+#define CHECK_CONTINUATION(c) do{ if ((c)>>6 != 1<<1)           { error_printf(interp, "invalid continuation byte %#x", (c)); return -1; }}while(0)
+	if (U(utf8[0]) >> 7 == 0) {
+		*result = U(utf8[0]);
+		return 1;    // ascii is always valid
+	}
+
+	else if (U(utf8[0]) >> 5 == ONES(2) << 1) {
+		nbytes = 2;
+		CHECK_UTF8LEN();
+		CHECK_CONTINUATION(U(utf8[1]));
+		*result = (ONES(5) & U(utf8[0]))<<6 |
+			(ONES(6) & U(utf8[1]));
+	}
+
+	else if (U(utf8[0]) >> 4 == ONES(3) << 1) {
+		nbytes = 3;
+		CHECK_UTF8LEN();
+		CHECK_CONTINUATION(U(utf8[1]));
+		CHECK_CONTINUATION(U(utf8[2]));
+		*result = ((unicode_char)(ONES(4) & U(utf8[0])))<<12UL |
+			((unicode_char)(ONES(6) & U(utf8[1])))<<6UL |
+			((unicode_char)(ONES(6) & U(utf8[2])));
+	}
+
+	else if (U(utf8[0]) >> 3 == ONES(4) << 1) {
+		nbytes = 4;
+		CHECK_UTF8LEN();
+		CHECK_CONTINUATION(U(utf8[1]));
+		CHECK_CONTINUATION(U(utf8[2]));
+		CHECK_CONTINUATION(U(utf8[3]));
+		*result = ((unicode_char)(ONES(3) & U(utf8[0])))<<18UL |
+			((unicode_char)(ONES(6) & U(utf8[1])))<<12UL |
+			((unicode_char)(ONES(6) & U(utf8[2])))<<6UL |
+			((unicode_char)(ONES(6) & U(utf8[3])));
+	}
+#undef CHECK_UTF8LEN
+#undef CHECK_CONTINUATION
+
+	else {
+		error_printf(interp, "invalid start byte %#x", (int) U(utf8[0]));
+		return -1;
+	}
+
+	int expected_nbytes = how_many_bytes(interp, *result);
+	if (expected_nbytes == -1) {
+		// how_many_bytes has already set an error
+		return -1;
+	}
+	assert(!(nbytes < expected_nbytes));
+	if (nbytes > expected_nbytes) {
+		if (nbytes == 2)
+			error_printf(interp, "overlong encoding: %#x %#x", (int) U(utf8[0]), (int) U(utf8[1]));
+		else if (nbytes == 3)
+			error_printf(interp, "overlong encoding: %#x %#x %#x", (int) U(utf8[0]), (int) U(utf8[1]), (int) U(utf8[2]));
+		else if (nbytes == 4)
+			error_printf(interp, "overlong encoding: %#x %#x %#x %#x", (int) U(utf8[0]), (int) U(utf8[1]), (int) U(utf8[2]), (int) U(utf8[3]));
+		else
+			assert(0);
+		return -1;
+	}
+	return nbytes;
+}
+
 bool utf8_decode(struct Interpreter *interp, char *utf8, size_t utf8len, struct UnicodeString *unicode)
 {
 	if (utf8len == 0) {
@@ -132,71 +551,27 @@ bool utf8_decode(struct Interpreter *interp, char *utf8, size_t utf8len, struct
 		return false;
 	}
 
-	while (utf8len > 0) {
-		unicode_char *ptr = result + resultlen;
-		int nbytes;
-
-#define CHECK_UTF8LEN()       do{ if (utf8len < (size_t)nbytes) { error_printf(interp, "unexpected end of string");           goto error; }}while(0)
-#define CHECK_CONTINUATION(c) do{ if ((c)>>6 != 1<<1)           { error_printf(interp, "invalid continuation byte %#x", (c)); goto error; }}while(0)
-		if (U(utf8[0]) >> 7 == 0) {
-			nbytes = 1;
-			assert(!(utf8len < 1));   // otherwise the while loop shouldn't run...
-			*ptr = U(utf8[0]);
-		}
-
-		else if (U(utf8[0]) >> 5 == ONES(2) << 1) {
-			nbytes = 2;
-			CHECK_UTF8LEN();
-			CHECK_CONTINUATION(U(utf8[1]));
-			*ptr = (ONES(5) & U(utf8[0]))<<6 |
-				(ONES(6) & U(utf8[1]));
-		}
-
-		else if (U(utf8[0]) >> 4 == ONES(3) << 1) {
-			nbytes = 3;
-			CHECK_UTF8LEN();
-			CHECK_CONTINUATION(U(utf8[1]));
-			CHECK_CONTINUATION(U(utf8[2]));
-			*ptr = ((unicode_char)(ONES(4) & U(utf8[0])))<<12UL |
-				((unicode_char)(ONES(6) & U(utf8[1])))<<6UL |
-				((unicode_char)(ONES(6) & U(utf8[2])));
-		}
-
-		else if (U(utf8[0]) >> 3 == ONES(4) << 1) {
-			nbytes = 4;
-			CHECK_UTF8LEN();
-			CHECK_CONTINUATION(U(utf8[1]));
-			CHECK_CONTINUATION(U(utf8[2]));
-			CHECK_CONTINUATION(U(utf8[3]));
-			*ptr = ((unicode_char)(ONES(3) & U(utf8[0])))<<18UL |
-				((unicode_char)(ONES(6) & U(utf8[1])))<<12UL |
-				((unicode_char)(ONES(6) & U(utf8[2])))<<6UL |
-				((unicode_char)(ONES(6) & U(utf8[3])));
-		}
-#undef CHECK_UTF8LEN
-#undef CHECK_CONTINUATION
+#ifdef CHECK_WITH_AVX2
+	// invalid utf8 goes to the loop below, which figures out what exactly is wrong with it
+	if (__builtin_cpu_supports("avx2") && check_avx2((const unsigned char *)utf8, utf8len)) {
+		resultlen = decode_checked((const unsigned char *)utf8, utf8len, result);
+		utf8len = 0;
+	}
+#endif
 
-		else {
-			error_printf(interp, "invalid start byte %#x", (int) U(utf8[0]));
-			goto error;
+	while (utf8len > 0) {
+		if (U(utf8[0]) < 0x80) {
+			size_t n = decode_ascii((const unsigned char *)utf8, utf8len, result + resultlen);
+			resultlen += n;
+			utf8 += n;
+			utf8len -= n;
+			continue;
 		}
 
-		int expected_nbytes = how_many_bytes(interp, *ptr);
-		if (expected_nbytes == -1) {
-			// how_many_bytes has already set an error
-			goto error;
-		}
-		assert(!(nbytes < expected_nbytes));
-		if (nbytes > expected_nbytes) {
-			if (nbytes == 2)
-				error_printf(interp, "overlong encoding: %#x %#x", (int) U(utf8[0]), (int) U(utf8[1]));
-			else if (nbytes == 3)
-				error_printf(interp, "overlong encoding: %#x %#x %#x", (int) U(utf8[0]), (int) U(utf8[1]), (int) U(utf8[2]));
-			else if (nbytes == 4)
-				error_printf(interp, "overlong encoding: %#x %#x %#x %#x", (int) U(utf8[0]), (int) U(utf8[1]), (int) U(utf8[2]), (int) U(utf8[3]));
-			else
-				assert(0);
-			goto error;
+		int nbytes = utf8_decodechar(interp, utf8, utf8len, result + resultlen);
+		if (nbytes == -1) {
+			free(result);
+			return false;
 		}
 
 		resultlen += 1;
@@ -204,16 +579,34 @@ bool utf8_decode(struct Interpreter *interp, char *utf8, size_t utf8len, struct
 		utf8len -= nbytes;
 	}
 
-	// this realloc can't fail because it frees memory, never allocates more
-	unicode->val = realloc(result, resultlen*sizeof(unicode_char));
-	assert(resultlen ? !!unicode->val : 1);    // realloc(result, 0) may return NULL
+	// shrinking shouldn't fail, but if it does, the bigger buffer works too
+	assert(resultlen != 0);    // utf8len isn't 0, and every character is at least 1 byte
+	unicode_char *tmp = realloc(result, resultlen*sizeof(unicode_char));
+	unicode->val = tmp ? tmp : result;
 	unicode->len = resultlen;
 	return true;
-
-error:
-	if (result)
-		free(result);
-	return false;
 }
 
 #undef U
+
+size_t utf8_incompletelen(const unsigned char *utf8, size_t utf8len)
+{
+	// go back over continuation bytes (10xxxxxx) to the first byte of the last character
+	for (size_t n = 1; n <= 3 && n <= utf8len; n++) {
+		unsigned char c = utf8[utf8len - n];
+		if (c >> 6 == 2)
+			continue;
+
+		size_t needed;
+		if (c >> 5 == 6)
+			needed = 2;
+		else if (c >> 4 == 14)
+			needed = 3;
+		else if (c >> 3 == 30)
+			needed = 4;
+		else
+			return 0;    // ascii or invalid
+		return n < needed ? n : 0;
+	}
+	return 0;
+}
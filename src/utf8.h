@@ -11,9 +11,25 @@
 // returns false on error
 bool utf8_encode(struct Interpreter *interp, struct UnicodeString unicode, char **utf8, size_t *utf8len);
 
+// like utf8_encode, but this writes to utf8 instead of allocating memory
+// utf8 must have room for 4*unicode.len bytes, and *utf8len is set to the number of bytes used
+// returns false on error
+bool utf8_encodeinto(struct Interpreter *interp, struct UnicodeString unicode, char *utf8, size_t *utf8len);
+
 // convert a UTF-8 string to a Unicode string
 // if utf8 is \0-terminated, pass strlen(utf8) for utf8len
 // returns false on error
 bool utf8_decode(struct Interpreter *interp, char *utf8, size_t utf8len, struct UnicodeString *unicode);
 
+// decode the first character of a UTF-8 string into *result, utf8len must not be 0
+// returns the number of bytes that the character uses (1 to 4), or -1 on error
+// handy for going through UTF-8 without decoding all of it into a UnicodeString
+int utf8_decodechar(struct Interpreter *interp, char *utf8, size_t utf8len, unicode_char *result);
+
+// returns the number of bytes at the end of utf8 that start a character without all of its bytes
+// that's 0 if utf8 ends with a complete character, and at most 3
+// handy for decoding UTF-8 that comes in chunks, the bytes can be decoded with the next chunk
+// never fails, invalid UTF-8 is left for utf8_decode() to complain about
+size_t utf8_incompletelen(const unsigned char *utf8, size_t utf8len);
+
 #endif   // UTF8_H